@@ -141,6 +141,13 @@ AC_MSG_RESULT($WITH_TRACE)
 AC_SUBST(WITH_TRACE)
 ])
 
+AC_DEFUN([OSSIE_ENABLE_LOG_RELEASE],
+[AC_MSG_CHECKING([to see if debug logging should be compiled out])
+AC_ARG_ENABLE(log-release, AS_HELP_STRING([--enable-log-release], [Remove TRACE and DEBUG log statements at compile time]) , WITH_LOG_RELEASE=yes ; AC_DEFINE(RH_LOG_RELEASE), WITH_LOG_RELEASE=no)
+AC_MSG_RESULT($WITH_LOG_RELEASE)
+AC_SUBST(WITH_LOG_RELEASE)
+])
+
 AC_DEFUN([OSSIE_ENABLE_LOG4CXX],
 [AC_ARG_ENABLE(log4cxx, AS_HELP_STRING([--disable-log4cxx], [Disable log4cxx support]))
 if test "x$enable_log4cxx" != "xno"; then
@@ -320,82 +320,158 @@ void Device_impl::validateCapacities (const CF::Properties& capacities)
     }
 }
 
-bool Device_impl::allocateCapacityLegacy (const CF::Properties& capacities)
+CORBA::Any* Device_impl::getLegacyCapacity (LegacyCapacities& capacities, const std::string& id)
 {
-    LOG_TRACE(Device_impl, "Using legacy capacity allocation");
-    
-    CF::Properties currentCapacities;
+    // Repeated requests for the same property accumulate on the working value
+    for (LegacyCapacities::iterator capacity = capacities.begin(); capacity != capacities.end(); ++capacity) {
+        if (capacity->first->id == id) {
+            return &capacity->second;
+        }
+    }
 
-    bool extraCap = false;  // Flag to check remaining extra capacity to allocate
-    bool foundProperty;     // Flag to indicate if the requested property was found
+    // Only properties that query() and configure() would accept take part
+    PropertyInterface* property = getPropertyFromId(id);
+    if (!property || !property->isQueryable() || !property->isConfigurable()) {
+        return 0;
+    }
+    capacities.push_back(std::make_pair(property, CORBA::Any()));
+    if (!property->isNilEnabled() || !property->isNil()) {
+        property->getValue(capacities.back().second);
+    }
+    return &capacities.back().second;
+}
+
+bool Device_impl::getLegacyValue (LegacyCapacities& capacities, const std::string& id, CORBA::Any& value)
+{
+    for (LegacyCapacities::iterator capacity = capacities.begin(); capacity != capacities.end(); ++capacity) {
+        if (capacity->first->id == id) {
+            value = capacity->second;
+            return true;
+        }
+    }
+    PropertyInterface* property = getPropertyFromId(id);
+    if (!property || !property->isQueryable()) {
+        return false;
+    }
+    if (property->isNilEnabled() && property->isNil()) {
+        value = CORBA::Any();
+    } else {
+        property->getValue(value);
+    }
+    return true;
+}
+
+bool Device_impl::hasRemainingCapacity (LegacyCapacities& capacities)
+{
+    // The allocated properties are the most likely to have capacity left
+    for (LegacyCapacities::iterator capacity = capacities.begin(); capacity != capacities.end(); ++capacity) {
+        if (compareAnyToZero(capacity->second) == POSITIVE) {
+            return true;
+        }
+    }
+
+    // Any other positive short, long or ulong property also counts; skip the
+    // other types without reading their values
+    for (PropertyMap::iterator property = propTable.begin(); property != propTable.end(); ++property) {
+        PropertyInterface* prop = property->second;
+        const CORBA::TCKind kind = prop->type->kind();
+        if ((kind != CORBA::tk_short) && (kind != CORBA::tk_long) && (kind != CORBA::tk_ulong)) {
+            continue;
+        }
+        if (!prop->isQueryable() || (prop->isNilEnabled() && prop->isNil())) {
+            continue;
+        }
+        CORBA::Any value;
+        if (!getLegacyValue(capacities, prop->id, value)) {
+            continue;
+        }
+        if (compareAnyToZero(value) == POSITIVE) {
+            return true;
+        }
+    }
+    return false;
+}
 
-    if (!isBusy ()) {
-        // The try is just a formality in this case
+void Device_impl::commitLegacyCapacities (LegacyCapacities& capacities, const CF::Properties& request)
+{
+    for (LegacyCapacities::iterator capacity = capacities.begin(); capacity != capacities.end(); ++capacity) {
         try {
-            // Get all properties currently in device
-            query (currentCapacities);
-        } catch (CF::UnknownProperties) {
+            configureProperty(capacity->first, capacity->second);
+        } catch (const std::exception& ex) {
+            LOG_ERROR(Device_impl, "Setting capacity " << capacity->first->id << " failed. Cause: " << ex.what());
+            throw CF::Device::InvalidCapacity(ex.what(), request);
         }
+    }
 
-        /* Look in propertySet for the properties requested */
-        for (unsigned i = 0; i < capacities.length (); i++) {
-            foundProperty = false;
-
-            for (unsigned j = 0; j < currentCapacities.length (); j++) {
-                LOG_TRACE(Device_impl, "Comparing IDs: " << capacities[i].id << ", " << currentCapacities[j].id );
-                if (strcmp (capacities[i].id, currentCapacities[j].id) == 0) {
-                    // Verify that both values have the same type
-                    if (!ossie::corba::isValidType (currentCapacities[j].value, capacities[i].value)) {
-                        LOG_ERROR(Device_impl, "Cannot allocate capacity: Incorrect data type.");
-                        throw (CF::Device::InvalidCapacity("Cannot allocate capacity. Incorrect Data Type.", capacities));
-                    } else {
-                        // Check for sufficient capacity and allocate it
-                        if (!allocate (currentCapacities[j].value, capacities[i].value)) {
-                            LOG_ERROR(Device_impl, "Cannot allocate capacity: Insufficient capacity.");
-                            return false;
-                        }
-                        CORBA::Short capValue;
-                        currentCapacities[j].value >>= capValue;
-                        LOG_TRACE(Device_impl, "Device Capacity ID: " << currentCapacities[j].id << ", New Capacity: " << capValue);
-                    }
-
-                    foundProperty = true;     // Report that the requested property was found
-                    break;
-                }
+    if (initialConfiguration) {
+        // Never configured: the original capacities are the full property
+        // set, as the first configure() call would have recorded them
+        initialConfiguration = false;
+        originalCap.length(0);
+        for (PropertyMap::iterator property = propTable.begin(); property != propTable.end(); ++property) {
+            CF::DataType current;
+            current.id = property->first.c_str();
+            if (getLegacyValue(capacities, property->first, current.value)) {
+                ossie::corba::push_back(originalCap, current);
             }
+        }
+    }
+}
+
+bool Device_impl::allocateCapacityLegacy (const CF::Properties& capacities)
+{
+    LOG_TRACE(Device_impl, "Using legacy capacity allocation");
+
+    if (isBusy ()) {
+        /* Not sure */
+        LOG_WARN(Device_impl, "Cannot allocate capacity: System is BUSY");
+        return false;
+    }
 
-            if (!foundProperty) {
+    bool extraCap = false;  // Flag to check remaining extra capacity to allocate
+
+    {
+        // Read, check and write back only the requested properties, without
+        // letting a configure() or another allocation in between
+        boost::mutex::scoped_lock lock(propertySetAccess);
+        LegacyCapacities currentCapacities;
+
+        for (unsigned i = 0; i < capacities.length (); i++) {
+            CORBA::Any* current = getLegacyCapacity(currentCapacities, static_cast<const char*>(capacities[i].id));
+            if (!current) {
                 LOG_ERROR(Device_impl, "Cannot allocate capacity: Invalid property ID: " << capacities[i].id);
                 throw (CF::Device::InvalidCapacity("Cannot allocate capacity. Invalid property ID", capacities));
             }
-        }
 
-        // Check for remaining capacity.
-        for (unsigned i = 0; i < currentCapacities.length (); i++) {
-            if (compareAnyToZero (currentCapacities[i].value) == POSITIVE) {
-                extraCap = true;
+            // Verify that both values have the same type
+            if (!ossie::corba::isValidType (*current, capacities[i].value)) {
+                LOG_ERROR(Device_impl, "Cannot allocate capacity: Incorrect data type.");
+                throw (CF::Device::InvalidCapacity("Cannot allocate capacity. Incorrect Data Type.", capacities));
+            }
 
-                // No need to keep going. if after allocation there is any capacity available, the device is ACTIVE.
-                break;
+            // Check for sufficient capacity and allocate it
+            if (!allocate (*current, capacities[i].value)) {
+                LOG_ERROR(Device_impl, "Cannot allocate capacity: Insufficient capacity.");
+                return false;
             }
+            LOG_TRACE(Device_impl, "Device Capacity ID: " << capacities[i].id << ", New Capacity: " << ossie::any_to_string(*current));
         }
 
-        // Store new capacities, here is when the allocation takes place
-        configure (currentCapacities);
+        // Check for remaining capacity.
+        extraCap = hasRemainingCapacity(currentCapacities);
 
-        /* Update usage state */
-        if (!extraCap) {
-            setUsageState (CF::Device::BUSY);
-        } else {
-            setUsageState (CF::Device::ACTIVE);   /* Assumes it allocated something. Not considering zero allocations */
-        }
+        // Store new capacities, here is when the allocation takes place
+        commitLegacyCapacities(currentCapacities, capacities);
+    }
 
-        return true;
+    /* Update usage state */
+    if (!extraCap) {
+        setUsageState (CF::Device::BUSY);
     } else {
-        /* Not sure */
-        LOG_WARN(Device_impl, "Cannot allocate capacity: System is BUSY");
-        return false;
+        setUsageState (CF::Device::ACTIVE);   /* Assumes it allocated something. Not considering zero allocations */
     }
+
+    return true;
 }
 
 bool Device_impl::allocateCapacityNew (const CF::Properties& capacities)
@@ -457,74 +533,57 @@ void Device_impl::deallocateCapacityLegacy (const CF::Properties& capacities)
 {
     LOG_TRACE(Device_impl, "Using legacy capacity deallocation");
 
-    CF::Properties currentCapacities;
+    /* Now verify that there is capacity currently being used */
+    if (isIdle ()) {
+        /* Not sure */
+        throw (CF::Device::InvalidCapacity ("Cannot deallocate capacity. System is IDLE.", capacities));
+    }
 
     bool totalCap = true;                         /* Flag to check remaining extra capacity to allocate */
-    bool foundProperty;                           /* Flag to indicate if the requested property was found */
-    AnyComparisonType compResult;
 
-    /* Now verify that there is capacity currently being used */
-    if (!isIdle ()) {
-        query (currentCapacities);
+    {
+        boost::mutex::scoped_lock lock(propertySetAccess);
+        LegacyCapacities currentCapacities;
 
-        /* Look in propertySet for the properties requested */
         for (unsigned i = 0; i < capacities.length (); i++) {
-            foundProperty = false;
-
-            for (unsigned j = 0; j < currentCapacities.length (); j++) {
-                if (strcmp (capacities[i].id, currentCapacities[j].id) == 0) {
-
-                    // Verify that both values have the same type
-                    if (!ossie::corba::isValidType (currentCapacities[j].value, capacities[i].value)) {
-                        LOG_WARN(Device_impl, "Cannot deallocate capacity. Incorrect Data Type.");
-                        throw (CF::Device::InvalidCapacity("Cannot deallocate capacity. Incorrect Data Type.", capacities));
-                    } else {
-                        deallocate (currentCapacities[j].value, capacities[i].value);
-                    }
-
-                    foundProperty = true;     /* Report that the requested property was found */
-                    break;
-                }
-            }
-
-            if (!foundProperty) {
+            CORBA::Any* current = getLegacyCapacity(currentCapacities, static_cast<const char*>(capacities[i].id));
+            if (!current) {
                 LOG_WARN(Device_impl, "Cannot deallocate capacity. Invalid property ID");
                 throw (CF::Device::InvalidCapacity("Cannot deallocate capacity. Invalid property ID",   capacities));
             }
+
+            // Verify that both values have the same type
+            if (!ossie::corba::isValidType (*current, capacities[i].value)) {
+                LOG_WARN(Device_impl, "Cannot deallocate capacity. Incorrect Data Type.");
+                throw (CF::Device::InvalidCapacity("Cannot deallocate capacity. Incorrect Data Type.", capacities));
+            }
+            deallocate (*current, capacities[i].value);
         }
 
         // Check for exceeding dealLocations and back-to-total capacity
-        for (unsigned i = 0; i < currentCapacities.length (); i++) {
-            for (unsigned j = 0; j < originalCap.length (); j++) {
-                if (strcmp (currentCapacities[i].id, originalCap[j].id) == 0) {
-                    compResult = compareAnys (currentCapacities[i].value, originalCap[j].value);
-
-                    if (compResult == FIRST_BIGGER) {
-                        LOG_WARN(Device_impl, "Cannot deallocate capacity. New capacity would exceed original bound.");
-                        throw (CF::Device::InvalidCapacity("Cannot deallocate capacity. New capacity would exceed original bound.", capacities));
-                    } else if (compResult == SECOND_BIGGER) {
-                        totalCap = false;
-                        break;
-                    }
-                }
+        for (unsigned j = 0; j < originalCap.length (); j++) {
+            CORBA::Any current;
+            if (!getLegacyValue(currentCapacities, static_cast<const char*>(originalCap[j].id), current)) {
+                continue;
+            }
+            AnyComparisonType compResult = compareAnys (current, originalCap[j].value);
+            if (compResult == FIRST_BIGGER) {
+                LOG_WARN(Device_impl, "Cannot deallocate capacity. New capacity would exceed original bound.");
+                throw (CF::Device::InvalidCapacity("Cannot deallocate capacity. New capacity would exceed original bound.", capacities));
+            } else if (compResult == SECOND_BIGGER) {
+                totalCap = false;
             }
         }
 
         /* Write new capacities */
-        configure (currentCapacities);
-
-        /* Update usage state */
-        if (!totalCap) {
-            setUsageState (CF::Device::ACTIVE);
-        } else {
-            setUsageState (CF::Device::IDLE);     /* Assumes it allocated something. Not considering zero allocations */
-        }
+        commitLegacyCapacities(currentCapacities, capacities);
+    }
 
-        return;
+    /* Update usage state */
+    if (!totalCap) {
+        setUsageState (CF::Device::ACTIVE);
     } else {
-        /* Not sure */
-        throw (CF::Device::InvalidCapacity ("Cannot deallocate capacity. System is IDLE.", capacities));
-        return;
+        setUsageState (CF::Device::IDLE);     /* Assumes it allocated something. Not considering zero allocations */
     }
 }
 
@@ -889,8 +889,180 @@ namespace events {
     Publisher                                  &parent;
   };
 
+  //
+  // Batcher
+  //
+  // Queues events for a Publisher and delivers them to the event channel from
+  // a background thread, either when a batch fills up or when the flush
+  // interval expires.
+  //
+  class Publisher::Batcher {
+
+  public:
+
+    Batcher( Publisher &parent, const Publisher::BatchSettings &settings ) :
+      _parent(parent),
+      _settings(settings),
+      _running(false),
+      _thread(NULL)
+    {
+      if ( _settings.max_batch < 1 ) _settings.max_batch = 1;
+      if ( _settings.flush_interval < 1 ) _settings.flush_interval = 1;
+    }
+
+    ~Batcher() {
+      stop();
+
+      // deliver anything that was queued before shutdown
+      flush();
+    }
+
+    void start() {
+      SCOPED_LOCK(_lock);
+      if ( _thread ) return;
+      _running = true;
+      _thread = new boost::thread( &Batcher::_run, this );
+    }
+
+    // stops the background thread, leaving any queued events for flush()
+    void stop() {
+      boost::thread *thread = NULL;
+      {
+        SCOPED_LOCK(_lock);
+        _running = false;
+        _cond.notify_all();
+        std::swap(thread, _thread);
+      }
+      if ( thread ) {
+        thread->join();
+        delete thread;
+      }
+    }
+
+    const Publisher::BatchSettings &settings() const {
+      return _settings;
+    }
+
+    bool enqueue( const CORBA::Any &data ) {
+      SCOPED_LOCK(_lock);
+      if ( _settings.max_queue > 0 && _queue.size() >= _settings.max_queue ) {
+        _stats.dropped++;
+        if ( !_settings.drop_oldest ) {
+          return false;
+        }
+        _queue.pop_front();
+      }
+      _queue.push_back(data);
+      _stats.queued++;
+      _stats.high_water_mark = std::max( _stats.high_water_mark, _queue.size() );
+      if ( _queue.size() >= _settings.max_batch ) {
+        _cond.notify_one();
+      }
+      return true;
+    }
+
+    int flush() {
+      // only one flush at a time, so that events are delivered in order
+      ScopedLock send_lock(_sendLock);
+      std::deque< CORBA::Any > pending;
+      {
+        SCOPED_LOCK(_lock);
+        pending.swap(_queue);
+      }
+      if ( pending.empty() ) return 0;
+
+      RH_NL_TRACE("Publisher::Batcher", "Flushing " << pending.size() << " events.");
+      size_t sent = 0;
+      if ( _settings.mode == Publisher::BATCH_SEQUENCE ) {
+        // limit each push to max_batch events to bound the message size
+        std::deque< CORBA::Any >::iterator iter = pending.begin();
+        while ( iter != pending.end() ) {
+          const size_t count = std::min( _settings.max_batch, static_cast<size_t>(pending.end() - iter) );
+          ExtendedEvent::EventBatchType batch;
+          batch.events.length(count);
+          for ( size_t index = 0; index < count; ++index, ++iter ) {
+            batch.events[index] = *iter;
+          }
+          CORBA::Any data;
+          data <<= batch;
+          if ( _parent._send(data) == 0 ) sent += count;
+        }
+      }
+      else {
+        std::deque< CORBA::Any >::iterator iter = pending.begin();
+        for ( ; iter != pending.end(); iter++ ) {
+          if ( _parent._send(*iter) == 0 ) sent++;
+        }
+      }
+
+      SCOPED_LOCK(_lock);
+      _stats.sent += sent;
+      _stats.failed += pending.size() - sent;
+      _stats.flushes++;
+      return ( sent == pending.size() ) ? 0 : -1;
+    }
+
+    Publisher::BatchStatistics statistics() {
+      SCOPED_LOCK(_lock);
+      Publisher::BatchStatistics stats = _stats;
+      stats.queue_depth = _queue.size();
+      return stats;
+    }
+
+  private:
+
+    void _run() {
+      ULock lock(_lock);
+      while ( _running ) {
+        if ( _queue.size() < _settings.max_batch ) {
+          boost::system_time const timeout=boost::get_system_time()+ boost::posix_time::milliseconds(_settings.flush_interval);
+          _cond.timed_wait( lock, timeout );
+        }
+        if ( !_running || _queue.empty() ) continue;
+
+        lock.unlock();
+        flush();
+        lock.lock();
+      }
+    }
+
+    Publisher                        &_parent;
+    Publisher::BatchSettings          _settings;
+    Publisher::BatchStatistics        _stats;
+    std::deque< CORBA::Any >          _queue;
+    bool                              _running;
+    Mutex                             _lock;
+    Mutex                             _sendLock;
+    boost::condition_variable         _cond;
+    boost::thread                    *_thread;
+  };
+
+
+  Publisher::BatchSettings::BatchSettings() :
+    mode(BATCH_NONE),
+    max_batch(100),
+    max_queue(10000),
+    flush_interval(100),
+    drop_oldest(false)
+  {
+  }
+
+
+  Publisher::BatchStatistics::BatchStatistics() :
+    queue_depth(0),
+    high_water_mark(0),
+    queued(0),
+    sent(0),
+    dropped(0),
+    failed(0),
+    flushes(0)
+  {
+  }
+
+
   Publisher::Publisher( ossie::events::EventChannel_ptr   inChannel ) :
-    _disconnectReceiver(NULL)
+    _disconnectReceiver(NULL),
+    _batching(0)
     {
       // if user passes a bad param then throw...
       if ( CORBA::is_nil(inChannel) == true ) throw (CF::EventChannelManager::OperationNotAllowed());
@@ -920,6 +1092,14 @@ namespace events {
 
     RH_NL_TRACE("Publisher", "DTOR - START." );
 
+    // stop batching, delivering any queued events while still connected
+    try {
+      SCOPED_LOCK(_settingsLock);
+      _stopBatcher(_swapBatcher(BatcherPtr()));
+    }
+    catch(...){
+    }
+
     try {
       if ( _disconnectReceiver && !_disconnectReceiver->get_disconnect() ) {
         RH_NL_DEBUG("Publisher::DTOR", "DISCONNECT." );
@@ -1083,29 +1263,35 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
 
 
   int     Publisher::push( const std::string &msg ) {
-      int retval=0;
-      try {
-        CORBA::Any data;
-        data <<= msg.c_str();
-        if (!CORBA::is_nil(proxy)) {
-          proxy->push(data);
-        }
-        else{
-          retval=-1;
+      CORBA::Any data;
+      data <<= msg.c_str();
+      return _push(data);
+    }
+
+
+  int     Publisher::push( CORBA::Any &data ) {
+      return _push(data);
+    }
+
+
+  int     Publisher::_push( const CORBA::Any &data ) {
+      // unbatched publishers never touch the batch lock
+      if ( __sync_fetch_and_add( &_batching, 0 ) ) {
+        SCOPED_LOCK(_batchLock);
+        if ( _batcher ) {
+          return _batcher->enqueue(data) ? 0 : -1;
         }
       }
-      catch( CORBA::Exception& ex) {
-        retval=-1;
-      }
-      return retval;
+      return _send(data);
     }
 
 
-  int     Publisher::push( CORBA::Any &data ) {
+  int     Publisher::_send( const CORBA::Any &data ) {
       int retval=0;
       try {
         if (!CORBA::is_nil(proxy)) {
           proxy->push(data);
+          RH_NL_TRACE("Publisher", "Message sent downstream......");
         }
         else{
           retval=-1;
@@ -1115,7 +1301,75 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
         retval=-1;
       }
       return retval;
+    }
 
+
+  Publisher::BatcherPtr  Publisher::_swapBatcher( BatcherPtr batcher ) {
+      SCOPED_LOCK(_batchLock);
+      _batcher.swap(batcher);
+      __sync_lock_test_and_set( &_batching, _batcher ? 1 : 0 );
+      return batcher;
+    }
+
+
+  void    Publisher::_stopBatcher( BatcherPtr batcher ) {
+      // the batcher is no longer reachable from push, so its queue can be
+      // delivered without holding the batch lock
+      if ( batcher ) {
+        batcher->stop();
+        batcher->flush();
+      }
+    }
+
+
+  void    Publisher::setBatching( const BatchSettings &settings ) {
+      // serialize changes, so that the old queue is flushed before any
+      // later settings are applied
+      SCOPED_LOCK(_settingsLock);
+      BatcherPtr batcher;
+      if ( settings.mode != BATCH_NONE ) {
+        RH_NL_DEBUG("Publisher", "Enable batching, mode:" << settings.mode << " max batch:" << settings.max_batch
+                    << " max queue:" << settings.max_queue << " flush interval:" << settings.flush_interval );
+        batcher.reset( new Batcher( *this, settings ) );
+      }
+
+      // new events go to the new queue while the old one is flushed; the new
+      // batcher's thread only starts afterwards, so it cannot overtake it
+      _stopBatcher(_swapBatcher(batcher));
+      if ( batcher ) {
+        batcher->start();
+      }
+    }
+
+
+  Publisher::BatchSettings    Publisher::getBatching() {
+      SCOPED_LOCK(_batchLock);
+      if ( _batcher ) {
+        return _batcher->settings();
+      }
+      return BatchSettings();
+    }
+
+
+  int     Publisher::flush() {
+      BatcherPtr batcher;
+      {
+        SCOPED_LOCK(_batchLock);
+        batcher = _batcher;
+      }
+      if ( batcher ) {
+        return batcher->flush();
+      }
+      return 0;
+    }
+
+
+  Publisher::BatchStatistics  Publisher::getBatchStatistics() {
+      SCOPED_LOCK(_batchLock);
+      if ( _batcher ) {
+        return _batcher->statistics();
+      }
+      return BatchStatistics();
     }
 
 
@@ -1194,6 +1448,19 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
       };
 
     virtual void push( const CORBA::Any &data ) {};
+
+    //
+    // Events from a batching publisher may arrive as a sequence; deliver
+    // each one individually, in order
+    //
+    bool unbatch( const CORBA::Any &data ) {
+      const ExtendedEvent::EventBatchType *batch;
+      if ( !(data >>= batch) ) return false;
+      for ( CORBA::ULong index = 0; index < batch->events.length(); ++index ) {
+        push( batch->events[index] );
+      }
+      return true;
+    }
       
     virtual void disconnect_push_consumer ()
       {
@@ -1241,6 +1508,7 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
   public:
     virtual ~CallbackConsumer() {};
     virtual void push( const CORBA::Any &data ) {
+      if ( unbatch(data) ) return;
       if ( callback ) {
         try{
           (*callback)( data );
@@ -1270,8 +1538,13 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
   public:
     virtual ~DefaultConsumer() {};
     virtual void push( const CORBA::Any &data ) {
+      if ( unbatch(data) ) return;
       // if parent defines a callback
       if ( parent.dataArrivedCB ) {
+        {
+          SCOPED_LOCK(parent._eventsLock);
+          parent._stats.received++;
+        }
         try{
           RH_NL_DEBUG("Subscriber", "DefaultConsumer --> send to callback." );
             (*parent.dataArrivedCB)( data );
@@ -1281,7 +1554,7 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
       }
       else {
         RH_NL_DEBUG("Subscriber", "DefaultConsumer --> push onto event queue." );
-        parent.events.push_back(data);
+        parent._queueEvent(data);
       }
     };
 
@@ -1298,8 +1571,20 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
 
 
 
+  Subscriber::QueueStatistics::QueueStatistics() :
+    queue_depth(0),
+    high_water_mark(0),
+    received(0),
+    dropped(0)
+  {
+  }
+
+
   Subscriber::Subscriber(  ossie::events::EventChannel_ptr  inChannel ):
-    consumer(NULL)
+    consumer(NULL),
+    _capacity(DEFAULT_QUEUE_CAPACITY),
+    _overflowPolicy(DROP_OLDEST),
+    _waitAbort(false)
   {
     if ( CORBA::is_nil(inChannel) == true ) throw (CF::EventChannelManager::OperationNotAllowed());
     _init( inChannel );
@@ -1308,7 +1593,10 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
 
   Subscriber::Subscriber(  ossie::events::EventChannel_ptr  inChannel,
                            DataArrivedListener *newListener ):
-    consumer(NULL)
+    consumer(NULL),
+    _capacity(DEFAULT_QUEUE_CAPACITY),
+    _overflowPolicy(DROP_OLDEST),
+    _waitAbort(false)
   {
     dataArrivedCB =  boost::shared_ptr< DataArrivedListener >(newListener, null_deleter());
     if ( CORBA::is_nil(inChannel) == true ) throw (CF::EventChannelManager::OperationNotAllowed());
@@ -1318,7 +1606,10 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
 
   Subscriber::Subscriber(  ossie::events::EventChannel_ptr  inChannel,
                            DataArrivedCallbackFn  newListener ) :
-    consumer(NULL)
+    consumer(NULL),
+    _capacity(DEFAULT_QUEUE_CAPACITY),
+    _overflowPolicy(DROP_OLDEST),
+    _waitAbort(false)
   {
     dataArrivedCB =  boost::make_shared< StaticDataArrivedListener >( newListener );
     if ( CORBA::is_nil(inChannel) == true ) throw (CF::EventChannelManager::OperationNotAllowed());
@@ -1416,6 +1707,13 @@ int Subscriber::disconnect(const int retries,  const int retry_wait )
     RH_NL_TRACE("Subscriber", "ProxyPushSupplier disconnected." );
   }
 
+  // wake up any callers blocked in getData
+  {
+    SCOPED_LOCK(_eventsLock);
+    _waitAbort = true;
+    _eventsCond.notify_all();
+  }
+
   if ( consumer ){
     RH_NL_DEBUG("Subscriber", "Waiting for disconnect ........" );
     consumer->wait_for_disconnect(1,3);
@@ -1495,6 +1793,10 @@ int Subscriber::connect(const int retries,  const int retry_wait ) {
       // connect the the consumer object to the supplier's proxy
       proxy->connect_push_consumer( sptr.in() );
       if ( consumer ) consumer->reset();
+      {
+        SCOPED_LOCK(_eventsLock);
+        _waitAbort = false;
+      }
       retval=0;
       RH_NL_DEBUG("Subscriber", "Consumer is now attached to event channel, (connect method)" );
       break;
@@ -1536,32 +1838,24 @@ int Subscriber::connect(const int retries,  const int retry_wait ) {
 
 
 int Subscriber::getData( std::string &ret_msg ) {
-      RH_NL_DEBUG("Subscriber",  " getdata (std::string) msg :" << ret_msg);        
+  return getData( ret_msg, 0 );
+}
+
+
+int Subscriber::getData( std::string &ret_msg, int timeout ) {
       int retval=-1;
       try{
 
-        // check if callback method is enable.. it so then return
-        RH_NL_DEBUG("Subscriber",  " test for callback ");                  
-        if ( dataArrivedCB ) return retval;
-
-        // check if data is available
-        RH_NL_DEBUG("Subscriber",  " queue size "<< events.size());                  
-        if ( events.size() < 1 ) return retval;
+        CORBA::Any  rawdata;
+        if ( !_nextEvent( rawdata, timeout ) ) return retval;
 
-        RH_NL_DEBUG("Subscriber",  " getdata (std::string) front ");                  
-        CORBA::Any  rawdata =  events.front();
-        RH_NL_DEBUG("Subscriber",  " getdata (std::string) after front:");        
-          
         const char *tmsg;
-        RH_NL_DEBUG("Subscriber",  " getdata (std::string) calling CORBA extract operator >>=");        
         if (rawdata >>= tmsg) { 
           ret_msg = tmsg;
           RH_NL_DEBUG("Subscriber",  " extracted msg :" << ret_msg);
           retval=0;
         }
 
-        events.pop_front();
-
       }
       catch(...) {
         RH_NL_ERROR("Subscriber",  "(getData::string) Error grabbing data from queue");
@@ -1570,22 +1864,20 @@ int Subscriber::getData( std::string &ret_msg ) {
       return retval;
     }
 
+
 int Subscriber::getData( CORBA::Any &ret ) {
+  return getData( ret, 0 );
+}
+
+
+int Subscriber::getData( CORBA::Any &ret, int timeout ) {
         
       int retval=-1;
       try{
 
-        // check if callback method is enable.. it so then return
-        if ( dataArrivedCB ) return retval;
-
-        // check if data is available
-        if ( events.size() < 1 ) return retval;
-          
-        CORBA::Any  rawdata =  events.front();
-          
-        ret = rawdata;
-        retval=0;
-        events.pop_front();
+        if ( _nextEvent( ret, timeout ) ) {
+          retval=0;
+        }
 
       }
       catch(...) {
@@ -1596,6 +1888,97 @@ int Subscriber::getData( CORBA::Any &ret ) {
     }
 
 
+void Subscriber::_queueEvent( const CORBA::Any &data ) {
+  SCOPED_LOCK(_eventsLock);
+  _stats.received++;
+  if ( _capacity > 0 && events.size() >= _capacity ) {
+    _stats.dropped++;
+    if ( _overflowPolicy == DROP_NEWEST ) {
+      RH_NL_TRACE("Subscriber", "Event queue full, dropping newest event." );
+      return;
+    }
+    RH_NL_TRACE("Subscriber", "Event queue full, dropping oldest event." );
+    events.pop_front();
+  }
+  events.push_back(data);
+  _stats.high_water_mark = std::max( _stats.high_water_mark, events.size() );
+  _eventsCond.notify_one();
+}
+
+
+bool Subscriber::_nextEvent( CORBA::Any &data, int timeout ) {
+
+  // check if callback method is enable.. it so then return
+  if ( dataArrivedCB ) return false;
+
+  ULock lock(_eventsLock);
+  if ( events.empty() && timeout != 0 ) {
+    if ( timeout < 0 ) {
+      while ( events.empty() && !_waitAbort ) {
+        _eventsCond.wait( lock );
+      }
+    }
+    else {
+      boost::system_time const deadline=boost::get_system_time()+ boost::posix_time::milliseconds(timeout);
+      while ( events.empty() && !_waitAbort ) {
+        if ( !_eventsCond.timed_wait( lock, deadline ) ) break;
+      }
+    }
+  }
+
+  // check if data is available
+  if ( events.empty() ) return false;
+
+  data = events.front();
+  events.pop_front();
+  return true;
+}
+
+
+void Subscriber::setQueueCapacity( size_t capacity, OverflowPolicy policy ) {
+  SCOPED_LOCK(_eventsLock);
+  _capacity = capacity;
+  _overflowPolicy = policy;
+
+  // trim any excess using the new policy
+  while ( _capacity > 0 && events.size() > _capacity ) {
+    _stats.dropped++;
+    if ( _overflowPolicy == DROP_NEWEST ) {
+      events.pop_back();
+    } else {
+      events.pop_front();
+    }
+  }
+}
+
+
+size_t Subscriber::getQueueCapacity() {
+  SCOPED_LOCK(_eventsLock);
+  return _capacity;
+}
+
+
+Subscriber::OverflowPolicy Subscriber::getOverflowPolicy() {
+  SCOPED_LOCK(_eventsLock);
+  return _overflowPolicy;
+}
+
+
+Subscriber::QueueStatistics Subscriber::getQueueStatistics() {
+  SCOPED_LOCK(_eventsLock);
+  QueueStatistics stats = _stats;
+  stats.queue_depth = events.size();
+  return stats;
+}
+
+
+void Subscriber::resetQueueStatistics() {
+  SCOPED_LOCK(_eventsLock);
+  _stats = QueueStatistics();
+  _stats.high_water_mark = events.size();
+}
+
+
 
 };  // end of events namespace
 
@@ -43,6 +43,13 @@
 #endif
 
 #include <errno.h>
+#include <sched.h>
+#include <signal.h>
+#include <spawn.h>
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#include <numaif.h>
+#endif
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <sys/time.h>
@@ -55,11 +62,78 @@
 
 PREPARE_CF_LOGGING(ExecutableDevice_impl)
 
+namespace {
+
+    ExecutableDevice_impl::LaunchMode launch_mode_from_environment()
+    {
+        const char* mode = getenv("REDHAWK_EXECUTE_LAUNCHER");
+        if (mode && strcmp(mode, "spawn") == 0) {
+            return ExecutableDevice_impl::LAUNCH_SPAWN;
+        }
+        return ExecutableDevice_impl::LAUNCH_FORK;
+    }
+
+    //
+    // A spawned process starts with the cpu mask and memory policy of the
+    // thread that launched it.  ThreadPlacement records both for the calling
+    // thread and puts them back when it goes out of scope, so affinity can be
+    // applied to the launching thread for the duration of a single launch.
+    //
+    class ThreadPlacement {
+    public:
+        ThreadPlacement() :
+            have_cpus(false)
+#ifdef HAVE_LIBNUMA
+            , policy(MPOL_DEFAULT), nodes(0), have_policy(false)
+#endif
+        {
+            CPU_ZERO(&cpus);
+            have_cpus = (sched_getaffinity(0, sizeof(cpus), &cpus) == 0);
+#ifdef HAVE_LIBNUMA
+            if (numa_available() != -1) {
+                nodes = numa_allocate_nodemask();
+                have_policy = (get_mempolicy(&policy, nodes->maskp, nodes->size + 1, 0, 0) == 0);
+            }
+#endif
+        }
+
+        ~ThreadPlacement()
+        {
+            if (have_cpus) {
+                sched_setaffinity(0, sizeof(cpus), &cpus);
+            }
+#ifdef HAVE_LIBNUMA
+            if (have_policy) {
+                if (numa_bitmask_weight(nodes) == 0) {
+                    set_mempolicy(policy, 0, 0);
+                } else {
+                    set_mempolicy(policy, nodes->maskp, nodes->size + 1);
+                }
+            }
+            if (nodes) {
+                numa_bitmask_free(nodes);
+            }
+#endif
+        }
+
+    private:
+        cpu_set_t cpus;
+        bool have_cpus;
+#ifdef HAVE_LIBNUMA
+        int policy;
+        struct bitmask* nodes;
+        bool have_policy;
+#endif
+    };
+
+}
+
 /* ExecutableDevice_impl ****************************************
     - constructor 1: no capacities defined
 ****************************************************************** */
 ExecutableDevice_impl::ExecutableDevice_impl (char* devMgr_ior, char* id, char* lbl, char* sftwrPrfl):
-    LoadableDevice_impl (devMgr_ior, id, lbl, sftwrPrfl)
+    LoadableDevice_impl (devMgr_ior, id, lbl, sftwrPrfl),
+    launchMode(launch_mode_from_environment())
 {
 }
 
@@ -70,7 +144,8 @@ ExecutableDevice_impl::ExecutableDevice_impl (char* devMgr_ior, char* id, char*
 ******************************************************************** */
 ExecutableDevice_impl::ExecutableDevice_impl (char* devMgr_ior, char* id, char* lbl, char* sftwrPrfl,
                                               CF::Properties capacities):
-    LoadableDevice_impl (devMgr_ior, id, lbl, sftwrPrfl, capacities)
+    LoadableDevice_impl (devMgr_ior, id, lbl, sftwrPrfl, capacities),
+    launchMode(launch_mode_from_environment())
 {
 }
 
@@ -79,7 +154,8 @@ ExecutableDevice_impl::ExecutableDevice_impl (char* devMgr_ior, char* id, char*
 ****************************************************************** */
 ExecutableDevice_impl::ExecutableDevice_impl (char* devMgr_ior, char* id, char* lbl, char* sftwrPrfl, 
                                               char* composite_ior):
-    LoadableDevice_impl (devMgr_ior, id, lbl, sftwrPrfl, composite_ior)
+    LoadableDevice_impl (devMgr_ior, id, lbl, sftwrPrfl, composite_ior),
+    launchMode(launch_mode_from_environment())
 {
 }
 
@@ -89,7 +165,8 @@ ExecutableDevice_impl::ExecutableDevice_impl (char* devMgr_ior, char* id, char*
 ******************************************************************** */
 ExecutableDevice_impl::ExecutableDevice_impl (char* devMgr_ior, char* id, char* lbl, char* sftwrPrfl,
                                               CF::Properties capacities, char* composite_ior):
-    LoadableDevice_impl (devMgr_ior, id, lbl, sftwrPrfl, capacities, composite_ior)
+    LoadableDevice_impl (devMgr_ior, id, lbl, sftwrPrfl, capacities, composite_ior),
+    launchMode(launch_mode_from_environment())
 {
 }
 
@@ -211,6 +288,94 @@ void ExecutableDevice_impl::set_resource_affinity( const CF::Properties& options
 
 }
 
+void ExecutableDevice_impl::setLaunchMode( LaunchMode mode ) {
+    launchMode = mode;
+}
+
+ExecutableDevice_impl::LaunchMode ExecutableDevice_impl::getLaunchMode() const {
+    return launchMode;
+}
+
+void ExecutableDevice_impl::spawned_resource( const CF::Properties&, const pid_t, const char* ) {
+}
+
+/* spawn_process ***********************************************************
+    - launches a process with posix_spawn instead of fork/execv
+************************************************************************* */
+pid_t ExecutableDevice_impl::spawn_process( const char* name, const CF::Properties& options, const std::string& path, std::vector<char*>& argv )
+{
+    // the child inherits this thread's placement, so apply the affinity
+    // request here (pid 0 is the calling thread) and restore it on return
+    ThreadPlacement placement;
+    try {
+        LOG_DEBUG(ExecutableDevice_impl, " Calling set resource affinity....spawn:" << name << " options=" << options.length());
+        set_resource_affinity( options, 0, name );
+    }
+    catch( redhawk::affinity::AffinityFailed &ex ) {
+        LOG_WARN(ExecutableDevice_impl, "Unable to satisfy affinity request for: " << name << " Reason: " << ex.what() );
+        errno = EPERM;
+        return -1;
+    }
+    catch( ... ) {
+        LOG_WARN(ExecutableDevice_impl,  "Unhandled exception during affinity processing for resource: " << name  );
+        errno = EPERM;
+        return -1;
+    }
+
+    // make the component a process group leader, and do not pass on the
+    // device's blocked SIGCHLD (it is consumed through a signalfd)
+    sigset_t no_signals;
+    sigemptyset(&no_signals);
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setpgroup(&attr, 0);
+    posix_spawnattr_setsigmask(&attr, &no_signals);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_USEVFORK);
+
+    pid_t pid = -1;
+    int num_retries = 5;
+    int returnval = 0;
+    while (true) {
+        if (strcmp(argv[0], "valgrind") == 0) {
+            // Find valgrind in the path
+            returnval = posix_spawnp(&pid, argv[0], 0, &attr, &argv[0], environ);
+        } else {
+            returnval = posix_spawn(&pid, argv[0], 0, &attr, &argv[0], environ);
+        }
+
+        num_retries--;
+        if (num_retries <= 0 || returnval != ETXTBSY)
+            break;
+
+        // Only retry on "text file busy" error
+        LOG_WARN(ExecutableDevice_impl, "posix_spawn() failed, retrying... (cmd=" << path << " msg=\"" << strerror(returnval) << "\" retries=" << num_retries << ")");
+        usleep(100000);
+    }
+    posix_spawnattr_destroy(&attr);
+
+    if (returnval) {
+        LOG_ERROR(ExecutableDevice_impl, "Error when calling posix_spawn() (cmd=" << path << " errno=" << returnval << " msg=\"" << strerror(returnval) << "\")");
+        errno = returnval;
+        return -1;
+    }
+
+    try {
+        spawned_resource( options, pid, name );
+    }
+    catch( ... ) {
+        LOG_WARN(ExecutableDevice_impl, "Unable to complete launch of resource: " << name << ", stopping pid " << pid );
+        killpg(pid, SIGKILL);
+        // the caller never learns this pid, so reap it here rather than
+        // leave a zombie for a SIGCHLD handler the device may not have; if
+        // the GPP's handler gets there first, waitpid fails with ECHILD
+        while (waitpid(pid, 0, 0) == -1 && errno == EINTR) {
+        }
+        errno = EPERM;
+        return -1;
+    }
+    return pid;
+}
+
 /* execute *****************************************************************
     - executes a process on the device
 ************************************************************************* */
@@ -310,7 +475,7 @@ CF::ExecutableDevice::ProcessID_Type ExecutableDevice_impl::do_execute (const ch
         args.push_back(ossie::any_to_string(parameters[i].value));
     }
 
-    LOG_DEBUG(ExecutableDevice_impl, "Forking process " << path);
+    LOG_DEBUG(ExecutableDevice_impl, "Launching process " << path);
 
     std::vector<char*> argv(args.size() + 1, NULL);
     for (std::size_t i = 0; i < args.size(); ++i) {
@@ -321,8 +486,13 @@ CF::ExecutableDevice::ProcessID_Type ExecutableDevice_impl::do_execute (const ch
 
     rh_logger::LevelPtr  lvl = ExecutableDevice_impl::__logger->getLevel();
 
-    // fork child process
-    int pid = fork();
+    int pid;
+    if (launchMode == LAUNCH_SPAWN) {
+        pid = spawn_process(name, options, path, argv);
+    } else {
+        // fork child process
+        pid = fork();
+    }
 
     if (pid == 0) {
 
@@ -391,7 +561,7 @@ CF::ExecutableDevice::ProcessID_Type ExecutableDevice_impl::do_execute (const ch
         exit(returnval);
     }
     else if (pid < 0 ){
-        LOG_ERROR(ExecutableDevice_impl, "Error forking child process (errno: " << errno << " msg=\"" << strerror(errno) << "\")" );
+        LOG_ERROR(ExecutableDevice_impl, "Error launching child process (errno: " << errno << " msg=\"" << strerror(errno) << "\")" );
         switch (errno) {
             case E2BIG:
                 throw CF::ExecutableDevice::ExecuteFail(CF::CF_E2BIG,
@@ -27,19 +27,52 @@ PortSet_impl::PortSet_impl ()
 {
 }
 
+// Fills in the description of a port; takes ownership of the reference
+static void fillPortInfo (CF::PortSet::PortInfoType& info, const std::string& name, PortBase* servant, CORBA::Object_ptr ref)
+{
+    info.obj_ptr = ref;
+    info.name = name.c_str();
+    info.repid = servant->getRepid().c_str();
+    info.description = servant->getDescription().c_str();
+    info.direction = servant->getDirection().c_str();
+}
+
 CF::PortSet::PortInfoSequence* PortSet_impl::getPortSet ()
 {
     CF::PortSet::PortInfoSequence_var retval = new CF::PortSet::PortInfoSequence();
+    retval->length(_portServants.size());
+
+    // Go through getPort, which subclasses may override to return a
+    // different reference than the one for the registered servant
+    CORBA::ULong index = 0;
+    for (PortServantMap::iterator port=_portServants.begin(); port!=_portServants.end(); ++port, ++index) {
+        fillPortInfo(retval[index], port->first, port->second, getPort(port->first.c_str()));
+    }
 
-    for (PortServantMap::iterator port=_portServants.begin(); port!=_portServants.end(); ++port) {
-        CF::PortSet::PortInfoType info;
-        info.obj_ptr = getPort(port->first.c_str());
-        info.name = port->first.c_str();
-        info.repid = port->second->getRepid().c_str();;
-        info.description = port->second->getDescription().c_str();
-        info.direction = port->second->getDirection().c_str();
+    return retval._retn();
+}
+
+CF::PortSet::PortInfoSequence* PortSet_impl::getPorts (const CF::StringSequence& names)
+    throw (CF::PortSupplier::UnknownPort, CORBA::SystemException)
+{
+    CF::PortSet::PortInfoSequence_var retval = new CF::PortSet::PortInfoSequence();
+    retval->length(names.length());
 
-        ossie::corba::push_back(retval, info);
+    for (CORBA::ULong index = 0; index < names.length(); ++index) {
+        const std::string name(names[index]);
+        // Throws UnknownPort if the name is not recognized
+        CORBA::Object_ptr ref = getPort(name.c_str());
+        PortServantMap::iterator port = _portServants.find(name);
+        if (port != _portServants.end()) {
+            fillPortInfo(retval[index], port->first, port->second, ref);
+        } else {
+            // Served by an overridden getPort with no registered servant,
+            // so only the reference is known
+            LOG_TRACE(PortSet_impl, "Port '" << name << "' has no registered servant");
+            retval[index].obj_ptr = ref;
+            retval[index].name = name.c_str();
+            retval[index].repid = "IDL:CORBA/Object:1.0";
+        }
     }
 
     return retval._retn();
@@ -30,13 +30,24 @@ CORBA::Object* PortSupplier_impl::getPort (const char* name) throw (CORBA::Syste
 {
     PortServantMap::iterator port = _portServants.find(name);
     if (port != _portServants.end()) {
-        PortBase* servant = port->second;
-        PortableServer::POA_var poa = servant->_default_POA();
-        return poa->servant_to_reference(port->second);
+        return getPortReference(port->first, port->second);
     }
     throw CF::PortSupplier::UnknownPort();
 }
 
+CORBA::Object_ptr PortSupplier_impl::getPortReference (const std::string& name, PortBase* servant)
+{
+    boost::mutex::scoped_lock lock(_portObjectsLock);
+    std::pair<PortBase*, CORBA::Object_var>& object = _portObjects[name];
+    if ((object.first != servant) || CORBA::is_nil(object.second)) {
+        LOG_TRACE(PortSupplier_impl, "Caching object reference for port '" << name << "'");
+        PortableServer::POA_var poa = servant->_default_POA();
+        object.first = servant;
+        object.second = poa->servant_to_reference(servant);
+    }
+    return CORBA::Object::_duplicate(object.second);
+}
+
 void PortSupplier_impl::addPort (const std::string& name, PortBase* servant)
 {
     LOG_TRACE(PortSupplier_impl, "Adding port '" << name << "'");
@@ -46,6 +57,12 @@ void PortSupplier_impl::addPort (const std::string& name, PortBase* servant)
     LOG_TRACE(PortSupplier_impl, "Activating port '" << name << "'");
     PortableServer::POA_var poa = servant->_default_POA();
     PortableServer::ObjectId_var oid = poa->activate_object(servant);
+
+    // Create the object reference now, so that getPort does not need the POA
+    boost::mutex::scoped_lock lock(_portObjectsLock);
+    std::pair<PortBase*, CORBA::Object_var>& object = _portObjects[name];
+    object.first = servant;
+    object.second = poa->id_to_reference(oid);
 }
 
 void PortSupplier_impl::addPort (const std::string& name, const std::string& description, PortBase* servant)
@@ -87,6 +104,16 @@ void PortSupplier_impl::releasePorts ()
 void PortSupplier_impl::deactivatePort (PortBase* servant)
 {
     LOG_TRACE(PortSupplier_impl, "Deactivating port '" << servant->getName() << "'");
+    {
+        boost::mutex::scoped_lock lock(_portObjectsLock);
+        for (PortObjectMap::iterator object = _portObjects.begin(); object != _portObjects.end(); ) {
+            if (object->second.first == servant) {
+                _portObjects.erase(object++);
+            } else {
+                ++object;
+            }
+        }
+    }
     PortableServer::POA_var poa = servant->_default_POA();
     PortableServer::ObjectId_var oid = poa->servant_to_id(servant);
     poa->deactivate_object(oid);
@@ -206,40 +206,7 @@ throw (CORBA::SystemException, CF::PropertySet::InvalidConfiguration,
         if (property && property->isConfigurable()) {
             LOG_TRACE(PropertySet_impl, "Configure property: " << property->id);
             try {
-                std::vector<std::string>::iterator kind = property->kinds.begin();
-                bool sendEvent = false;
-                bool eventType = false;
-                if (propertyChangePort != NULL) {
-                    // searching for event type
-                    while (kind != property->kinds.end()) {
-                        if (!kind->compare("event")) {
-                            // it is of event type
-                            eventType = true;
-                            break;
-                        }
-                        kind++;
-                    }
-                    if (eventType) {
-                        // comparing values
-                        if (property->compare(configProperties[ii].value)) {
-                            // the incoming value is different from the current value
-                            sendEvent = true;
-                        }
-                    }
-                }
-                CORBA::Any before_value, after_value;
-                property->getValue(before_value);
-                property->setValue(configProperties[ii].value);
-                property->getValue(after_value);
-                std::string comparator("eq");
-                if (ossie::compare_anys(before_value, after_value, comparator)) {
-                    LOG_TRACE(PropertySet_impl, "Value has not changed on configure for property " << property->id << ". Not triggering callback");
-                }
-                executePropertyCallback(property->id);
-                if (sendEvent) {
-                    // sending the event
-                    propertyChangePort->sendPropertyEvent(property->id);
-                }
+                configureProperty(property, configProperties[ii].value);
                 ++validProperties;
             } catch (std::exception& e) {
                 LOG_ERROR(PropertySet_impl, "Setting property " << property->id << ", " << property->name << " failed.  Cause: " << e.what());
@@ -566,6 +533,44 @@ void PropertySet_impl::setPropertyChangeListener (const std::string& id, Propert
     setPropertyCallback(id, cb);
 }
 
+void PropertySet_impl::configureProperty (PropertyInterface* property, const CORBA::Any& value)
+{
+    std::vector<std::string>::iterator kind = property->kinds.begin();
+    bool sendEvent = false;
+    bool eventType = false;
+    if (propertyChangePort != NULL) {
+        // searching for event type
+        while (kind != property->kinds.end()) {
+            if (!kind->compare("event")) {
+                // it is of event type
+                eventType = true;
+                break;
+            }
+            kind++;
+        }
+        if (eventType) {
+            // comparing values
+            if (property->compare(value)) {
+                // the incoming value is different from the current value
+                sendEvent = true;
+            }
+        }
+    }
+    CORBA::Any before_value, after_value;
+    property->getValue(before_value);
+    property->setValue(value);
+    property->getValue(after_value);
+    std::string comparator("eq");
+    if (ossie::compare_anys(before_value, after_value, comparator)) {
+        LOG_TRACE(PropertySet_impl, "Value has not changed on configure for property " << property->id << ". Not triggering callback");
+    }
+    executePropertyCallback(property->id);
+    if (sendEvent) {
+        // sending the event
+        propertyChangePort->sendPropertyEvent(property->id);
+    }
+}
+
 void PropertySet_impl::executePropertyCallback (const std::string& id)
 {
     PropertyCallbackMap::iterator func = propCallbacks.find(id);
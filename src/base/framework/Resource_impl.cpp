@@ -21,6 +21,7 @@
 #include <signal.h>
 
 #include "ossie/Resource_impl.h"
+#include "ossie/ThreadedComponent.h"
 #include "ossie/Events.h"
 
 PREPARE_CF_LOGGING(Resource_impl)
@@ -31,7 +32,10 @@ Resource_impl::Resource_impl (const char* _uuid) :
     component_running_mutex(),
     component_running(&component_running_mutex),
     _domMgr(NULL),
-    _initialized(false)
+    _initialized(false),
+    _statisticsThread(0),
+    _threadStatistics(0),
+    _threadStatisticsReset(false)
 {
 }
 
@@ -43,13 +47,17 @@ Resource_impl::Resource_impl (const char* _uuid, const char *label) :
     component_running_mutex(),
     component_running(&component_running_mutex),
     _domMgr(NULL),
-    _initialized(false)
+    _initialized(false),
+    _statisticsThread(0),
+    _threadStatistics(0),
+    _threadStatisticsReset(false)
 {
 }
 
 Resource_impl::~Resource_impl () {
   if (this->_domMgr != NULL)
     delete this->_domMgr;
+  delete _threadStatistics;
 
 
 };
@@ -178,6 +186,43 @@ std::string& Resource_impl::getCurrentWorkingDirectory() {
     return this->currentWorkingDirectory;
 }
 
+void Resource_impl::addThreadStatisticsProperties(ThreadedComponent* threaded) {
+    if (_threadStatistics) {
+        return;
+    }
+    _statisticsThread = threaded;
+    _threadStatistics = new ossie::ThreadStatisticsStruct();
+
+    addProperty(*_threadStatistics,
+                "THREAD_STATISTICS",
+                "thread_statistics",
+                "readonly",
+                "",
+                "external",
+                "property");
+    setPropertyQueryImpl(*_threadStatistics, this, &Resource_impl::_queryThreadStatistics);
+
+    addProperty(_threadStatisticsReset,
+                false,
+                "THREAD_STATISTICS_RESET",
+                "thread_statistics_reset",
+                "writeonly",
+                "",
+                "external",
+                "property");
+    setPropertyConfigureImpl(_threadStatisticsReset, this, &Resource_impl::_configureThreadStatisticsReset);
+}
+
+ossie::ThreadStatisticsStruct Resource_impl::_queryThreadStatistics() {
+    return ossie::ThreadStatisticsStruct(_statisticsThread->getThreadStatistics());
+}
+
+void Resource_impl::_configureThreadStatisticsReset(const bool& reset) {
+    if (reset) {
+        _statisticsThread->resetThreadStatistics();
+    }
+}
+
 static Resource_impl* main_component = 0;
 static void sigint_handler(int signum)
 {
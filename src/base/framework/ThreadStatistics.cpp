@@ -0,0 +1,235 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <ossie/ThreadStatistics.h>
+#include <ossie/ThreadedComponent.h>
+
+namespace ossie {
+
+namespace {
+    uint64_t load(const uint64_t& value)
+    {
+        return __sync_fetch_and_add(const_cast<uint64_t*>(&value), 0);
+    }
+}
+
+LatencyHistogram::LatencyHistogram()
+{
+    clear();
+}
+
+void LatencyHistogram::clear()
+{
+    std::fill(_counts, _counts + BUCKETS, 0);
+}
+
+LatencyHistogram LatencyHistogram::snapshot() const
+{
+    LatencyHistogram result;
+    for (unsigned bucket = 0; bucket < BUCKETS; ++bucket) {
+        result._counts[bucket] = load(_counts[bucket]);
+    }
+    return result;
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    uint64_t total = 0;
+    for (unsigned bucket = 0; bucket < BUCKETS; ++bucket) {
+        total += _counts[bucket];
+    }
+    return total;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const
+{
+    const uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    percent = std::min(std::max(percent, 0.0), 100.0);
+    const uint64_t target = std::max((uint64_t)std::ceil(total * percent / 100.0), (uint64_t)1);
+    uint64_t seen = 0;
+    for (unsigned bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += _counts[bucket];
+        if (seen >= target) {
+            return highestEquivalent(bucket);
+        }
+    }
+    return max();
+}
+
+uint64_t LatencyHistogram::max() const
+{
+    for (unsigned bucket = BUCKETS; bucket > 0; --bucket) {
+        if (_counts[bucket-1]) {
+            return highestEquivalent(bucket-1);
+        }
+    }
+    return 0;
+}
+
+void LatencyHistogram::subtract(const LatencyHistogram& earlier)
+{
+    for (unsigned bucket = 0; bucket < BUCKETS; ++bucket) {
+        // Counts are read one at a time, so a later one can lag the
+        // baseline taken after it; never let it wrap
+        _counts[bucket] -= std::min(_counts[bucket], earlier._counts[bucket]);
+    }
+}
+
+uint64_t LatencyHistogram::highestEquivalent(unsigned bucket)
+{
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    const unsigned shift = (bucket / SUB_BUCKETS) - 1;
+    const uint64_t lowest = (uint64_t)(SUB_BUCKETS + (bucket % SUB_BUCKETS)) << shift;
+    return lowest + ((1ULL << shift) - 1);
+}
+
+
+ThreadStatistics::Snapshot::Snapshot() :
+    calls(0),
+    normal(0),
+    noop(0),
+    finish(0),
+    timed(0),
+    timedNanoseconds(0),
+    sleepNanoseconds(0),
+    elapsedNanoseconds(0)
+{
+}
+
+double ThreadStatistics::Snapshot::busyNanoseconds() const
+{
+    if (timed == 0) {
+        return 0.0;
+    }
+    return (double)timedNanoseconds * calls / timed;
+}
+
+double ThreadStatistics::Snapshot::dutyCycle() const
+{
+    if (elapsedNanoseconds == 0) {
+        return 0.0;
+    }
+    return std::min(busyNanoseconds() / elapsedNanoseconds, 1.0);
+}
+
+ThreadStatistics::ThreadStatistics(unsigned samplePeriod) :
+    _samplePeriod(std::max(samplePeriod, 1U)),
+    _countdown(1),
+    _timing(false),
+    _lastEnd(0),
+    _lastState(NORMAL),
+    _baselineTime(now())
+{
+}
+
+void ThreadStatistics::finishCall(uint64_t start, int state)
+{
+    // Count the outcome before the call, so that a snapshot, which reads
+    // them the other way round, does not see more outcomes than calls
+    if (state == NOOP) {
+        __sync_fetch_and_add(&_current.noop, 1);
+    } else if (state == FINISH) {
+        __sync_fetch_and_add(&_current.finish, 1);
+    }
+    __sync_fetch_and_add(&_current.calls, 1);
+
+    if (start) {
+        // The start time was read either to time this call, or to measure
+        // the gap since the previous one ended
+        if (_lastEnd) {
+            const uint64_t gap = start - _lastEnd;
+            _current.gap.record(gap);
+            if (_lastState == NOOP) {
+                __sync_fetch_and_add(&_current.sleepNanoseconds, gap);
+            }
+        }
+        _lastEnd = 0;
+        if (_timing) {
+            _timing = false;
+            _lastEnd = now();
+            const uint64_t duration = _lastEnd - start;
+            __sync_fetch_and_add(&_current.timedNanoseconds, duration);
+            __sync_fetch_and_add(&_current.timed, 1);
+            _current.service.record(duration);
+        }
+    }
+
+    // Reading the clock ahead of a sleep costs nothing worth counting
+    if ((state == NOOP) && !_lastEnd) {
+        _lastEnd = now();
+    }
+    _lastState = state;
+}
+
+void ThreadStatistics::setSamplePeriod(unsigned samplePeriod)
+{
+    __sync_lock_test_and_set(&_samplePeriod, std::max(samplePeriod, 1U));
+}
+
+ThreadStatistics::Snapshot ThreadStatistics::_load() const
+{
+    // The writer counts outcomes before calls; read them after, so that
+    // calls covers every outcome seen
+    Snapshot result;
+    result.noop = load(_current.noop);
+    result.finish = load(_current.finish);
+    result.timed = load(_current.timed);
+    result.calls = load(_current.calls);
+    result.normal = result.calls - std::min(result.calls, result.noop + result.finish);
+    result.timedNanoseconds = load(_current.timedNanoseconds);
+    result.sleepNanoseconds = load(_current.sleepNanoseconds);
+    result.service = _current.service.snapshot();
+    result.gap = _current.gap.snapshot();
+    return result;
+}
+
+ThreadStatistics::Snapshot ThreadStatistics::snapshot() const
+{
+    boost::mutex::scoped_lock lock(_baselineLock);
+    Snapshot result = _load();
+    result.calls -= std::min(result.calls, _baseline.calls);
+    result.normal -= std::min(result.normal, _baseline.normal);
+    result.noop -= std::min(result.noop, _baseline.noop);
+    result.finish -= std::min(result.finish, _baseline.finish);
+    result.timed -= std::min(result.timed, _baseline.timed);
+    result.timedNanoseconds -= std::min(result.timedNanoseconds, _baseline.timedNanoseconds);
+    result.sleepNanoseconds -= std::min(result.sleepNanoseconds, _baseline.sleepNanoseconds);
+    result.elapsedNanoseconds = now() - _baselineTime;
+    result.service.subtract(_baseline.service);
+    result.gap.subtract(_baseline.gap);
+    return result;
+}
+
+void ThreadStatistics::reset()
+{
+    boost::mutex::scoped_lock lock(_baselineLock);
+    _baseline = _load();
+    _baselineTime = now();
+}
+
+};  // end of ossie namespace
@@ -26,6 +26,7 @@ ProcessThread::ProcessThread(ThreadedComponent *target, float delay) :
     _thread(0),
     _running(false),
     _target(target),
+    _statistics(new ThreadStatistics()),
     _mythread(_thread)
 {
     updateDelay(delay);
@@ -41,8 +42,11 @@ void ProcessThread::start()
 
 void ProcessThread::run()
 {
+    ThreadStatistics& statistics = *_statistics;
     while (_running) {
+        const uint64_t start = statistics.beginCall();
         int state = _target->serviceFunction();
+        statistics.endCall(start, state);
         if (state == FINISH) {
             return;
         } else if (state == NOOP) {
@@ -97,6 +101,126 @@ bool ProcessThread::threadRunning()
     return _running;
 }
 
+ThreadStatisticsPtr ProcessThread::statistics() const
+{
+    return _statistics;
+}
+
+namespace {
+    double seconds(double nanoseconds)
+    {
+        return nanoseconds * 1e-9;
+    }
+}
+
+ThreadStatisticsStruct::ThreadStatisticsStruct(const ThreadStatistics::Snapshot& snapshot) :
+    calls(snapshot.calls),
+    normal(snapshot.normal),
+    noop(snapshot.noop),
+    finish(snapshot.finish),
+    elapsed(seconds(snapshot.elapsedNanoseconds)),
+    busy(seconds(snapshot.busyNanoseconds())),
+    sleep(seconds(snapshot.sleepNanoseconds)),
+    duty_cycle(snapshot.dutyCycle()),
+    service_p50(seconds(snapshot.service.percentile(50.0))),
+    service_p99(seconds(snapshot.service.percentile(99.0))),
+    service_p999(seconds(snapshot.service.percentile(99.9))),
+    service_max(seconds(snapshot.service.max())),
+    gap_p50(seconds(snapshot.gap.percentile(50.0))),
+    gap_p99(seconds(snapshot.gap.percentile(99.0))),
+    gap_max(seconds(snapshot.gap.max()))
+{
+}
+
+bool operator>>= (const CORBA::Any& a, ThreadStatisticsStruct& s)
+{
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("THREAD_STATISTICS::calls")) {
+        if (!(props["THREAD_STATISTICS::calls"] >>= s.calls)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::normal")) {
+        if (!(props["THREAD_STATISTICS::normal"] >>= s.normal)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::noop")) {
+        if (!(props["THREAD_STATISTICS::noop"] >>= s.noop)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::finish")) {
+        if (!(props["THREAD_STATISTICS::finish"] >>= s.finish)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::elapsed")) {
+        if (!(props["THREAD_STATISTICS::elapsed"] >>= s.elapsed)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::busy")) {
+        if (!(props["THREAD_STATISTICS::busy"] >>= s.busy)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::sleep")) {
+        if (!(props["THREAD_STATISTICS::sleep"] >>= s.sleep)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::duty_cycle")) {
+        if (!(props["THREAD_STATISTICS::duty_cycle"] >>= s.duty_cycle)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::service_p50")) {
+        if (!(props["THREAD_STATISTICS::service_p50"] >>= s.service_p50)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::service_p99")) {
+        if (!(props["THREAD_STATISTICS::service_p99"] >>= s.service_p99)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::service_p999")) {
+        if (!(props["THREAD_STATISTICS::service_p999"] >>= s.service_p999)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::service_max")) {
+        if (!(props["THREAD_STATISTICS::service_max"] >>= s.service_max)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::gap_p50")) {
+        if (!(props["THREAD_STATISTICS::gap_p50"] >>= s.gap_p50)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::gap_p99")) {
+        if (!(props["THREAD_STATISTICS::gap_p99"] >>= s.gap_p99)) return false;
+    }
+    if (props.contains("THREAD_STATISTICS::gap_max")) {
+        if (!(props["THREAD_STATISTICS::gap_max"] >>= s.gap_max)) return false;
+    }
+    return true;
+}
+
+void operator<<= (CORBA::Any& a, const ThreadStatisticsStruct& s)
+{
+    redhawk::PropertyMap props;
+    props["THREAD_STATISTICS::calls"] = s.calls;
+    props["THREAD_STATISTICS::normal"] = s.normal;
+    props["THREAD_STATISTICS::noop"] = s.noop;
+    props["THREAD_STATISTICS::finish"] = s.finish;
+    props["THREAD_STATISTICS::elapsed"] = s.elapsed;
+    props["THREAD_STATISTICS::busy"] = s.busy;
+    props["THREAD_STATISTICS::sleep"] = s.sleep;
+    props["THREAD_STATISTICS::duty_cycle"] = s.duty_cycle;
+    props["THREAD_STATISTICS::service_p50"] = s.service_p50;
+    props["THREAD_STATISTICS::service_p99"] = s.service_p99;
+    props["THREAD_STATISTICS::service_p999"] = s.service_p999;
+    props["THREAD_STATISTICS::service_max"] = s.service_max;
+    props["THREAD_STATISTICS::gap_p50"] = s.gap_p50;
+    props["THREAD_STATISTICS::gap_p99"] = s.gap_p99;
+    props["THREAD_STATISTICS::gap_max"] = s.gap_max;
+    a <<= props;
+}
+
+bool operator== (const ThreadStatisticsStruct& s1, const ThreadStatisticsStruct& s2)
+{
+    return (s1.calls == s2.calls) && (s1.normal == s2.normal) && (s1.noop == s2.noop) &&
+        (s1.finish == s2.finish) && (s1.elapsed == s2.elapsed) && (s1.busy == s2.busy) &&
+        (s1.sleep == s2.sleep) && (s1.duty_cycle == s2.duty_cycle) &&
+        (s1.service_p50 == s2.service_p50) && (s1.service_p99 == s2.service_p99) &&
+        (s1.service_p999 == s2.service_p999) && (s1.service_max == s2.service_max) &&
+        (s1.gap_p50 == s2.gap_p50) && (s1.gap_p99 == s2.gap_p99) && (s1.gap_max == s2.gap_max);
+}
+
+bool operator!= (const ThreadStatisticsStruct& s1, const ThreadStatisticsStruct& s2)
+{
+    return !(s1 == s2);
+}
+
 };   //end of ossie namespace
 
 ThreadedComponent::ThreadedComponent() :
@@ -115,6 +239,10 @@ void ThreadedComponent::startThread ()
     boost::mutex::scoped_lock lock(serviceThreadLock);
     if (!serviceThread) {
       serviceThread = new ossie::ProcessThread(this, _defaultDelay);
+      {
+          boost::mutex::scoped_lock statisticsLock(_threadStatisticsLock);
+          _serviceStatistics = serviceThread->statistics();
+      }
       serviceThread->start();
     }
 }
@@ -145,3 +273,30 @@ void ThreadedComponent::setThreadDelay (float delay)
         serviceThread->updateDelay(delay);
     }
 }
+
+ossie::ThreadStatistics::Snapshot ThreadedComponent::getThreadStatistics ()
+{
+    // Does not take serviceThreadLock, which is held while stopThread waits
+    // on a service function that may itself be waiting on a property lock
+    ossie::ThreadStatisticsPtr statistics;
+    {
+        boost::mutex::scoped_lock lock(_threadStatisticsLock);
+        statistics = _serviceStatistics;
+    }
+    if (statistics) {
+        return statistics->snapshot();
+    }
+    return ossie::ThreadStatistics::Snapshot();
+}
+
+void ThreadedComponent::resetThreadStatistics ()
+{
+    ossie::ThreadStatisticsPtr statistics;
+    {
+        boost::mutex::scoped_lock lock(_threadStatisticsLock);
+        statistics = _serviceStatistics;
+    }
+    if (statistics) {
+        statistics->reset();
+    }
+}
@@ -3,8 +3,14 @@
 #include <sstream>
 #include <list>
 #include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctype.h>
+#include <dirent.h>
 #include <sched.h>
 #include <boost/algorithm/string.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #ifdef HAVE_LIBNUMA
 #include <numa.h>
 #endif
@@ -149,46 +155,62 @@ namespace  redhawk {
     }
 
 
-    /*
-       identify_cpus 
+    const double Topology::DEFAULT_REFRESH_INTERVAL = 60.0;
 
-       From a specified network interface determine the list of CPUs that service interrupts
-       for that interface.
+    Topology::Topology( const std::string &root, const double refresh_interval ) :
+      _root(root),
+      _refresh_interval(refresh_interval),
+      _loaded(false)
+    {
+    }
 
-     */
-    CpuList identify_cpus( const std::string &iface ) {
+    Topology &Topology::Instance() {
+      static Topology _topology;
+      return _topology;
+    }
 
-      CpuList  cpus;
-      std::string pintr("/proc/interrupts");
-      std::ifstream in(pintr.c_str(), std::ifstream::in );
-      if ( in.fail() ) {
-        RH_ERROR(_affinity_logger, "Unable to access /proc/interrupts");
-        return cpus;
-      }
+    void Topology::refresh() {
+      boost::mutex::scoped_lock lock(_lock);
+      _load();
+    }
 
-      std::string line;
-      while( std::getline( in, line ) ) {
-        // check if the device is our interface
-        RH_TRACE(_affinity_logger, "Processing /proc/interrupts.... line:" << line);
-        if ( line.rfind(iface) != std::string::npos ) {
-          std::istringstream iss(line);
-          int parts=0;
-          do {
-            std::string tok;
-            iss>>tok;
-	    // skip interrupt number and iface
-	    if ( parts > 0 and tok != iface ) {
-              std::istringstream iss(tok);
-              int icnt;
-              iss >> icnt;
-              if ( icnt > 0 ) {
-                RH_TRACE(_affinity_logger, "identify cpus: Adding CPU : " << parts-1);
-                cpus.push_back(parts-1);
-              }
-	    }
-	    parts++;
-          }while(iss);
+    void Topology::set_refresh_interval( const double seconds ) {
+      boost::mutex::scoped_lock lock(_lock);
+      _refresh_interval = seconds;
+    }
+
+    double Topology::get_refresh_interval() {
+      boost::mutex::scoped_lock lock(_lock);
+      return _refresh_interval;
+    }
+
+    void Topology::set_root( const std::string &root ) {
+      boost::mutex::scoped_lock lock(_lock);
+      _root = root;
+      _loaded = false;
+    }
+
+    std::string Topology::get_root() {
+      boost::mutex::scoped_lock lock(_lock);
+      return _root;
+    }
 
+    CpuList Topology::get_interface_cpus( const std::string &iface ) {
+      boost::mutex::scoped_lock lock(_lock);
+      _check_refresh();
+
+      InterfaceMap::iterator found = _interfaces.find(iface);
+      if ( found != _interfaces.end() ) {
+        return found->second;
+      }
+
+      // match anywhere in the device names, so that per queue vectors
+      // (e.g. eth0-TxRx-0) are included with the interface
+      CpuList cpus;
+      InterruptList::const_iterator intr = _interrupts.begin();
+      for ( ; intr != _interrupts.end(); intr++ ) {
+        if ( intr->description.find(iface) != std::string::npos ) {
+          cpus.insert( cpus.end(), intr->cpus.begin(), intr->cpus.end() );
         }
       }
 
@@ -196,10 +218,152 @@ namespace  redhawk {
       for (; citer != cpus.end(); citer++) {
         RH_DEBUG(_affinity_logger, "identified CPUS iface/cpu ...:" << iface << "/" << *citer);
       }
-    
+
+      _interfaces[iface] = cpus;
       return cpus;
     }
 
+    int Topology::get_node_of_cpu( const int cpu ) {
+      boost::mutex::scoped_lock lock(_lock);
+      _check_refresh();
+      NodeMap::const_iterator found = _cpu_nodes.find(cpu);
+      if ( found != _cpu_nodes.end() ) {
+        return found->second;
+      }
+      // without numa support in the kernel every cpu belongs to node 0
+      if ( _node_cpus.empty() && std::count( _cpus.begin(), _cpus.end(), cpu ) != 0 ) {
+        return 0;
+      }
+      return -1;
+    }
+
+    CpuList Topology::get_node_cpus( const int node ) {
+      boost::mutex::scoped_lock lock(_lock);
+      _check_refresh();
+      NodeCpuMap::const_iterator found = _node_cpus.find(node);
+      if ( found != _node_cpus.end() ) {
+        return found->second;
+      }
+      if ( _node_cpus.empty() && node == 0 ) {
+        return _cpus;
+      }
+      return CpuList();
+    }
+
+    void Topology::_check_refresh() {
+      if ( !_loaded ) {
+        _load();
+        return;
+      }
+      if ( _refresh_interval > 0.0 ) {
+        boost::posix_time::time_duration age = boost::posix_time::microsec_clock::universal_time() - _load_time;
+        if ( age.total_milliseconds() >= _refresh_interval * 1000.0 ) {
+          _load();
+        }
+      }
+    }
+
+    void Topology::_load() {
+      _cpus.clear();
+      _interrupts.clear();
+      _interfaces.clear();
+      _cpu_nodes.clear();
+      _node_cpus.clear();
+      _load_interrupts();
+      _load_nodes();
+      _loaded = true;
+      _load_time = boost::posix_time::microsec_clock::universal_time();
+    }
+
+    void Topology::_load_interrupts() {
+      std::string pintr = _root + "/proc/interrupts";
+      std::ifstream in(pintr.c_str(), std::ifstream::in );
+      if ( in.fail() ) {
+        RH_ERROR(_affinity_logger, "Unable to access " << pintr);
+        return;
+      }
+
+      // the header names the cpu for each count column, offline cpus are skipped
+      std::string line;
+      if ( !std::getline( in, line ) ) return;
+      std::istringstream header(line);
+      std::string tok;
+      while ( header >> tok ) {
+        if ( tok.compare(0, 3, "CPU") == 0 ) {
+          _cpus.push_back( atoi( tok.c_str()+3 ) );
+        }
+      }
+
+      while( std::getline( in, line ) ) {
+        RH_TRACE(_affinity_logger, "Processing " << pintr << ".... line:" << line);
+        const char *pos = line.c_str();
+        const char *colon = strchr(pos, ':');
+        if ( !colon ) continue;
+        pos = colon + 1;
+
+        Interrupt intr;
+        for ( size_t col=0; col < _cpus.size(); col++ ) {
+          char *end;
+          unsigned long count = strtoul(pos, &end, 10);
+          if ( end == pos ) break;
+          if ( count > 0 ) intr.cpus.push_back( _cpus[col] );
+          pos = end;
+        }
+        intr.description = pos;
+        if ( !intr.cpus.empty() ) {
+          _interrupts.push_back( intr );
+        }
+      }
+    }
+
+    void Topology::_load_nodes() {
+      std::string node_root = _root + "/sys/devices/system/node";
+      DIR *dir = opendir( node_root.c_str() );
+      if ( !dir ) {
+        RH_DEBUG(_affinity_logger, "No numa nodes under " << node_root);
+        return;
+      }
+
+      struct dirent *ent;
+      while ( (ent = readdir(dir)) != NULL ) {
+        if ( strncmp( ent->d_name, "node", 4 ) != 0 || !isdigit( ent->d_name[4] ) ) continue;
+        int node = atoi( ent->d_name+4 );
+        std::string cpulist = node_root + "/" + ent->d_name + "/cpulist";
+        std::ifstream in(cpulist.c_str(), std::ifstream::in );
+        std::string ranges;
+        if ( in.fail() || !std::getline( in, ranges ) ) continue;
+
+        // cpulist format, e.g. 0-7,16-23
+        CpuList &cpus = _node_cpus[node];
+        std::vector<std::string> parts;
+        boost::split( parts, ranges, boost::is_any_of(","), boost::algorithm::token_compress_on );
+        for ( size_t i=0; i < parts.size(); i++ ) {
+          if ( parts[i].empty() ) continue;
+          int first = atoi( parts[i].c_str() );
+          int last = first;
+          size_t dash = parts[i].find('-');
+          if ( dash != std::string::npos ) last = atoi( parts[i].c_str()+dash+1 );
+          for ( int cpu=first; cpu <= last; cpu++ ) {
+            cpus.push_back(cpu);
+            _cpu_nodes[cpu] = node;
+          }
+        }
+      }
+      closedir(dir);
+    }
+
+
+    /*
+       identify_cpus 
+
+       From a specified network interface determine the list of CPUs that service interrupts
+       for that interface.
+
+     */
+    CpuList identify_cpus( const std::string &iface ) {
+      return Topology::Instance().get_interface_cpus(iface);
+    }
+
     int   find_socket_for_interface ( const std::string &iface , const bool findFirst, const CpuList &bl ){
 
       int retval=-1;
@@ -211,10 +375,14 @@ namespace  redhawk {
 #if HAVE_LIBNUMA
         int soc=-1;
         for( int i=0; i < (int)cpulist.size();i++ ) {
-          RH_DEBUG(_affinity_logger, "Finding (processor socket) for NIC:" << iface << " socket :" << numa_node_of_cpu(cpulist[i]) );
+          RH_DEBUG(_affinity_logger, "Finding (processor socket) for NIC:" << iface << " socket :" << Topology::Instance().get_node_of_cpu(cpulist[i]) );
           if ( std::count( bl.begin(), bl.end(), cpulist[i] ) != 0 ) continue;
 
-          soc = numa_node_of_cpu(cpulist[i]);
+          soc = Topology::Instance().get_node_of_cpu(cpulist[i]);
+          if ( soc < 0 ) {
+            RH_WARN(_affinity_logger, "Unable to determine socket of cpu:" << cpulist[i] << " servicing NIC:" << iface);
+            continue;
+          }
           if ( soc != psoc && psoc != -1 && !findFirst ) {
             RH_WARN(_affinity_logger, "More than 1 socket servicing NIC:" << iface);
             psoc=-1;
@@ -252,26 +420,15 @@ namespace  redhawk {
             throw AffinityFailed("Processor Socket affinity failed, unable to parse:  " + nodestr);
           }
 
-          bitmask *cpu_mask = numa_allocate_cpumask(); 
-          if ( !cpu_mask ) {
-            throw AffinityFailed("Unable to allocate cpu mask");
-          } 
-
           // for each bit set in the mask then get cpu list
           int nbytes = numa_bitmask_nbytes(node_mask);
           for (int i=0; i < nbytes*8; i++ ){
             if ( numa_bitmask_isbitset( node_mask, i ) ) {
-              numa_node_to_cpus( i, cpu_mask );
-              
-              // foreach cpu identified add to list
-              int nb = numa_bitmask_nbytes(cpu_mask);
-              for (int j=0; j < nb*8; j++ ){
-                if ( numa_bitmask_isbitset( cpu_mask, j ) ) {
-                  cpu_list.push_back( j );
-                }
-              }
+              CpuList node_cpus = Topology::Instance().get_node_cpus( i );
+              cpu_list.insert( cpu_list.end(), node_cpus.begin(), node_cpus.end() );
             }
           }
+          numa_bitmask_free(node_mask);
 
       }
 
@@ -494,9 +651,23 @@ namespace  redhawk {
                 throw AffinityFailed("Unable to allocate node mask");
               }
 
+              int nodes=0;
               for( int i=0; i < (int)cpulist.size();i++ ) {
-                RH_DEBUG(_affinity_logger, "Setting NIC (processor socket select) available socket :" << numa_node_of_cpu(cpulist[i]) );
-                numa_bitmask_setbit(node_mask, numa_node_of_cpu(cpulist[i]) );
+                int node = Topology::Instance().get_node_of_cpu(cpulist[i]);
+                if ( node < 0 ) {
+                  RH_WARN(_affinity_logger, "Setting NIC (processor socket select), unable to determine socket of cpu:" << cpulist[i] );
+                  continue;
+                }
+                RH_DEBUG(_affinity_logger, "Setting NIC (processor socket select) available socket :" << node );
+                numa_bitmask_setbit(node_mask, node );
+                nodes++;
+              }
+
+              if ( nodes == 0 ) {
+                numa_bitmask_free(node_mask);
+                std::ostringstream e;
+                e << "Binding to NIC, unable to determine processor socket for any cpu servicing interface:" << iface;
+                throw AffinityFailed(e.str());
               }
 
               RH_DEBUG(_affinity_logger, "Setting NIC (processor socket select) affinity constraint: :" << iface );
@@ -531,15 +702,19 @@ namespace  redhawk {
               //
               if ( (cpulist.size() == 1 && get_nic_promotion()) || ( cpus == 0 && get_nic_promotion() ) ) {
                 int cpuid = cpulist[0];
-                std::ostringstream os;
-                os << numa_node_of_cpu( cpuid );
-                CpuList tlist = get_cpu_list( "socket", os.str() );
-                RH_INFO(_affinity_logger, "Promoting NIC affinity to PID:" << pid << " SOCKET:" << os.str() );
-
-                cpulist.clear();
-                for( int i=0; i < (int)tlist.size();i++ ) {
-                  if ( tlist[i] == cpuid ) continue;
-                  cpulist.push_back( tlist[i] );
+                int node = Topology::Instance().get_node_of_cpu( cpuid );
+                if ( node < 0 ) {
+                  RH_WARN(_affinity_logger, "Unable to promote NIC affinity, no socket for cpu:" << cpuid );
+                }
+                else {
+                  CpuList tlist = Topology::Instance().get_node_cpus( node );
+                  RH_INFO(_affinity_logger, "Promoting NIC affinity to PID:" << pid << " SOCKET:" << node );
+
+                  cpulist.clear();
+                  for( int i=0; i < (int)tlist.size();i++ ) {
+                    if ( tlist[i] == cpuid ) continue;
+                    cpulist.push_back( tlist[i] );
+                  }
                 }
               }
               
@@ -607,11 +782,14 @@ namespace  redhawk {
               throw AffinityFailed("Unable to allocate cpu mask");
             } 
 
-            // check if node is active, if so then get a cpu id
+            // add the cpus of every node in the constraint
             int nbytes = numa_bitmask_nbytes(node_mask);
             for (int i=0; i < nbytes*8; i++ ){
               if ( numa_bitmask_isbitset( node_mask, i ) ) {
-                numa_node_to_cpus( i, cpu_mask );
+                CpuList node_cpus = Topology::Instance().get_node_cpus( i );
+                for ( CpuList::const_iterator citer = node_cpus.begin(); citer != node_cpus.end(); citer++ ) {
+                  numa_bitmask_setbit(cpu_mask, *citer);
+                }
               }
             }
 
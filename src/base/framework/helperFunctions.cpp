@@ -20,6 +20,8 @@
 
 
 #include <string>
+#include <sstream>
+#include <iomanip>
 #include <uuid/uuid.h>
 #include <ossie/ossieSupport.h>
 
@@ -84,6 +86,23 @@ namespace ossie {
       return retval;
     };
 
+    std::string jsonString( const std::string &value ) {
+      std::ostringstream out;
+      out << '"';
+      for ( std::string::const_iterator ch = value.begin(); ch != value.end(); ++ch ) {
+        if ( *ch == '"' || *ch == '\\' ) {
+          out << '\\' << *ch;
+        } else if ( static_cast<unsigned char>(*ch) < 0x20 ) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(*ch)
+              << std::dec << std::setfill(' ');
+        } else {
+          out << *ch;
+        }
+      }
+      out << '"';
+      return out.str();
+    };
+
   };
 
 };
@@ -549,6 +549,38 @@ public abstract class Resource extends Logging implements ResourceOperations, Ru
         return ports.toArray(new PortInfoType[0]);
     }
 
+    /**
+     * {@inheritDoc}
+     */
+    public PortInfoType[] getPorts (final String[] names) throws UnknownPort {
+        final PortInfoType[] ports = new PortInfoType[names.length];
+        for (int index = 0; index < names.length; ++index) {
+            final String name = names[index];
+            PortInfoType info = new PortInfoType();
+            info.obj_ptr = getPort(name);
+            info.name = name;
+            Object port = this.nativePorts.get(name);
+            if (port == null) {
+                port = this.portServants.get(name);
+            }
+            if (port instanceof PortBase) {
+                PortBase cast = (PortBase)port;
+                info.repid = cast.getRepid();
+                info.direction = cast.getDirection();
+            } else {
+                info.repid = "IDL:CORBA/Object:1.0";
+                info.direction = "direction";
+            }
+            if (this.portDescriptions.containsKey(name)) {
+                info.description = this.portDescriptions.get(name);
+            } else {
+                info.description = "";
+            }
+            ports[index] = info;
+        }
+        return ports;
+    }
+
     /**
      * {@inheritDoc}
      */
@@ -10,6 +10,8 @@ import org.omg.CosEventComm.*;
 import org.omg.CosEventChannelAdmin.*;
 import CF.EventChannelManagerPackage.*;
 import org.ossie.properties.AnyUtils;
+import ExtendedEvent.EventBatchType;
+import ExtendedEvent.EventBatchTypeHelper;
 import java.lang.InterruptedException;
 import java.util.concurrent.locks.*;
 import java.util.concurrent.TimeUnit;
@@ -96,6 +98,15 @@ public class  Subscriber  {
 
     
 	public  void push( final org.omg.CORBA.Any data ) {
+	    // events from a batching publisher arrive as a sequence; deliver
+	    // each one individually, in order
+	    if ( data.type().equivalent(EventBatchTypeHelper.type()) ) {
+		EventBatchType batch = EventBatchTypeHelper.extract(data);
+		for ( org.omg.CORBA.Any event : batch.events ) {
+		    push(event);
+		}
+		return;
+	    }
 	    if ( parent != null ) {
 		// if parent defines a callback
 		if ( parent.dataArrivedCB != null ) {
@@ -20,6 +20,7 @@
 #ifdef   HAVE_LOG4CXX
 #include <iostream>
 #include <ossie/CF/LogInterfaces.h>
+#include <ossie/CF/ExtendedEvent.h>
 #include "RH_LogEventAppender.h"
 #include <ossie/CorbaUtils.h>
 #include <log4cxx/helpers/loglog.h>
@@ -103,6 +104,72 @@ namespace log4cxx {
 IMPLEMENT_LOG4CXX_OBJECT_WITH_CUSTOM_CLASS(RH_LogEventAppender, ClassRH_LogEventAppender)
 
 
+//
+// EventRing
+//
+// Single-producer, single-consumer ring of log events. log4cxx serializes
+// calls to append under the appender's mutex, so there is only ever one
+// producer; the flush thread, or stopAsync_ once it has joined that thread,
+// is the only consumer. Slots are filled and
+// drained in place, and the indices are published with full memory
+// barriers, so neither side ever takes a lock.
+//
+class RH_LogEventAppender::EventRing {
+
+public:
+
+  EventRing( size_t capacity ) :
+    _head(0),
+    _tail(0)
+  {
+    _capacity = 1;
+    while ( _capacity < capacity ) _capacity <<= 1;
+    _mask = _capacity - 1;
+    _slots = new CF::LogEvent[_capacity];
+  }
+
+  ~EventRing() {
+    delete [] _slots;
+  }
+
+  // producer: next free slot, or NULL if the ring is full
+  CF::LogEvent* reserve() {
+    const unsigned long head = _head;
+    if ( head - _tail >= _capacity ) return NULL;
+    __sync_synchronize();
+    return &_slots[head & _mask];
+  }
+
+  // producer: publish the slot returned by reserve
+  void commit() {
+    __sync_synchronize();
+    _head = _head + 1;
+  }
+
+  // consumer: oldest filled slot, or NULL if the ring is empty
+  CF::LogEvent* front() {
+    const unsigned long tail = _tail;
+    if ( _head == tail ) return NULL;
+    __sync_synchronize();
+    return &_slots[tail & _mask];
+  }
+
+  // consumer: return the slot returned by front to the producer
+  void release() {
+    __sync_synchronize();
+    _tail = _tail + 1;
+  }
+
+private:
+
+  CF::LogEvent                    *_slots;
+  unsigned long                    _capacity;
+  unsigned long                    _mask;
+  volatile unsigned long           _head;
+  volatile unsigned long           _tail;
+};
+
+
 RH_LogEventAppender::RH_LogEventAppender():
 channelName("LOG_CHANNEL"),
 	nameContext(""),
@@ -113,7 +180,21 @@ channelName("LOG_CHANNEL"),
 	_nameContext(""),
 	_reconnect_retries(10),
 	_reconnect_delay(10),
-	_cleanup_event_channel(0)
+	_cleanup_event_channel(0),
+	_async(false),
+	_queue_size(1024),
+	_batch_size(64),
+	_batch_events(false),
+	_flush_interval(10),
+	_drop_policy(DROP_NEWEST),
+	_block_timeout(1000),
+	_ring(NULL),
+	_flush_thread(NULL),
+	_flush_running(false),
+	_queued(0),
+	_dropped(0),
+	_sent(0),
+	_failed(0)
 {
 
 }
@@ -121,6 +202,8 @@ channelName("LOG_CHANNEL"),
 
 RH_LogEventAppender::~RH_LogEventAppender() {
 
+  stopAsync_();
+
   if ( _event_channel &&  _cleanup_event_channel ) {
       _event_channel.reset();
       ossie::events::DeleteEventChannel( _channelName, _nameContext );
@@ -184,6 +267,59 @@ void RH_LogEventAppender::setOption(const LogString& option, const LogString& va
 	_reconnect_delay = newDelay;
       }
     }
+    else if(StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("ASYNC"), LOG4CXX_STR("async"))) {
+      synchronized sync(mutex);
+      _async = OptionConverter::toBoolean(value, false);
+      _LL_DEBUG("RH_LogEventAppender::setOption async: " << value );
+    }
+    else if(StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("QUEUE_SIZE"), LOG4CXX_STR("queue_size"))) {
+      synchronized sync(mutex);
+      int newSize = StringHelper::toInt(value);
+      _LL_DEBUG("RH_LogEventAppender::setOption queue_size: " << value );
+      if ( newSize > 0 ) {
+	_queue_size = newSize;
+      }
+    }
+    else if(StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BATCH_SIZE"), LOG4CXX_STR("batch_size"))) {
+      synchronized sync(mutex);
+      int newSize = StringHelper::toInt(value);
+      _LL_DEBUG("RH_LogEventAppender::setOption batch_size: " << value );
+      if ( newSize > 0 ) {
+	_batch_size = newSize;
+      }
+    }
+    else if(StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BATCH_EVENTS"), LOG4CXX_STR("batch_events"))) {
+      synchronized sync(mutex);
+      _batch_events = OptionConverter::toBoolean(value, false);
+      _LL_DEBUG("RH_LogEventAppender::setOption batch_events: " << value );
+    }
+    else if(StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("FLUSH_INTERVAL"), LOG4CXX_STR("flush_interval"))) {
+      synchronized sync(mutex);
+      int newInterval = StringHelper::toInt(value);
+      _LL_DEBUG("RH_LogEventAppender::setOption flush_interval: " << value );
+      if ( newInterval > 0 ) {
+	_flush_interval = newInterval;
+      }
+    }
+    else if(StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("DROP_POLICY"), LOG4CXX_STR("drop_policy"))) {
+      synchronized sync(mutex);
+      _LL_DEBUG("RH_LogEventAppender::setOption drop_policy: " << value );
+      if (StringHelper::equalsIgnoreCase(value, LOG4CXX_STR("BLOCK"), LOG4CXX_STR("block"))) {
+	_drop_policy = BLOCK;
+      } else if (StringHelper::equalsIgnoreCase(value, LOG4CXX_STR("DROP_NEWEST"), LOG4CXX_STR("drop_newest"))) {
+	_drop_policy = DROP_NEWEST;
+      } else {
+	LogLog::warn(LOG4CXX_STR("RH_LogEventAppender: unknown drop_policy, expected DROP_NEWEST or BLOCK"));
+      }
+    }
+    else if(StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BLOCK_TIMEOUT"), LOG4CXX_STR("block_timeout"))) {
+      synchronized sync(mutex);
+      int newTimeout = StringHelper::toInt(value);
+      _LL_DEBUG("RH_LogEventAppender::setOption block_timeout: " << value );
+      if ( newTimeout >= 0 ) {
+	_block_timeout = newTimeout;
+      }
+    }
     else {
       _LL_DEBUG("RH_LogEventAppender::setOption non-appender option: value : " << value );
       AppenderSkeleton::setOption(option, value);
@@ -193,19 +329,32 @@ void RH_LogEventAppender::setOption(const LogString& option, const LogString& va
 
 void RH_LogEventAppender::activateOptions(Pool& p) {
 
-  synchronized sync(mutex);
-  std::ostringstream os;
-  _LLS_DEBUG( os, "RH_LogEventAppender: CH:" << channelName ); 
-  _LLS_DEBUG( os, "RH_LogEventAppender: NameContext:" << nameContext );
-  _LLS_DEBUG( os, "RH_LogEventAppender: Retries:" << _reconnect_retries);
-  _LLS_DEBUG( os, "RH_LogEventAppender: RetryDelay:" << _reconnect_delay);
-
-  if ( _channelName != channelName && channelName != "" ) {
-    LOG4CXX_ENCODE_CHAR(t, channelName );
-    _channelName = t;
-    LOG4CXX_ENCODE_CHAR(t2, nameContext );
-    _nameContext = t2;
-    connect_();
+  bool async;
+  {
+    synchronized sync(mutex);
+    std::ostringstream os;
+    _LLS_DEBUG( os, "RH_LogEventAppender: CH:" << channelName ); 
+    _LLS_DEBUG( os, "RH_LogEventAppender: NameContext:" << nameContext );
+    _LLS_DEBUG( os, "RH_LogEventAppender: Retries:" << _reconnect_retries);
+    _LLS_DEBUG( os, "RH_LogEventAppender: RetryDelay:" << _reconnect_delay);
+    _LLS_DEBUG( os, "RH_LogEventAppender: Async:" << _async);
+    _LLS_DEBUG( os, "RH_LogEventAppender: BatchEvents:" << _batch_events);
+
+    if ( _channelName != channelName && channelName != "" ) {
+      LOG4CXX_ENCODE_CHAR(t, channelName );
+      _channelName = t;
+      LOG4CXX_ENCODE_CHAR(t2, nameContext );
+      _nameContext = t2;
+      connect_();
+    }
+    async = _async;
+  }
+
+  // restart the flush thread so that changes to the ring take effect; this
+  // joins the thread, so it must not hold the appender lock
+  stopAsync_();
+  if ( async ) {
+    startAsync_();
   }
 
   AppenderSkeleton::activateOptions(p);
@@ -224,15 +373,47 @@ void RH_LogEventAppender::append(const spi::LoggingEventPtr& event, Pool& p){
     errorHandler->error(msgL);
     return;
   }
-	 
+
+  // append is called with the appender lock held, and stopAsync_ detaches
+  // the ring under that lock, so the ring cannot go away from under us
+  if ( _ring ) {
+    // format directly into the next free slot; the flush thread pushes it
+    CF::LogEvent *slot = _ring->reserve();
+    if ( !slot && _drop_policy == BLOCK ) {
+      slot = waitForSlot_();
+    }
+    if ( !slot ) {
+      __sync_fetch_and_add(&_dropped, 1);
+      return;
+    }
+    format_( *slot, event, p );
+    _ring->commit();
+    __sync_fetch_and_add(&_queued, 1);
+    return;
+  }
+
+  // This is the message structure for a Redhawk logging event
+  CF::LogEvent rh_event;
+  format_( rh_event, event, p );
+  
+  // push log message to the event channel
+  if ( _event_channel ) {
+    if ( _event_channel->push(rh_event) != 0 ) {
+      _LL_DEBUG( "RH_LogEventAppender::append EVENT CHANNEL, PUSH OPERATION FAILED.");
+    }
+ }
+  
+}
+
+
+void RH_LogEventAppender::format_( CF::LogEvent &rh_event, const spi::LoggingEventPtr& event, Pool& p ) {
+
   log4cxx::LogString fMsg;
 	 
   this->layout->format(fMsg, event, p);
 	 
   LOG4CXX_ENCODE_CHAR(fMsgStr, fMsg);
 
-  // This is the message structure for a Redhawk logging event
-  CF::LogEvent rh_event;
   LOG4CXX_ENCODE_CHAR(t1,prodId);
   rh_event.producerId = CORBA::string_dup(t1.c_str());
   LOG4CXX_ENCODE_CHAR(t2,prodName);
@@ -259,21 +440,152 @@ void RH_LogEventAppender::append(const spi::LoggingEventPtr& event, Pool& p){
   //need to convert to seconds for rh_event
   rh_event.timeStamp = event->getTimeStamp()/1000000;
   rh_event.msg = CORBA::string_dup(fMsg.c_str());
-  
-  // push log message to the event channel
-  if ( _event_channel ) {
-    if ( _event_channel->push(rh_event) != 0 ) {
-      _LL_DEBUG( "RH_LogEventAppender::append EVENT CHANNEL, PUSH OPERATION FAILED.");
+}
+
+
+CF::LogEvent* RH_LogEventAppender::waitForSlot_() {
+  // the flush thread signals after it frees slots; give up after the block
+  // timeout, so a stalled channel cannot hold the appender lock for ever
+  boost::mutex::scoped_lock lock(_space_lock);
+  const boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds(_block_timeout);
+  CF::LogEvent *slot;
+  while ( !(slot = _ring->reserve()) && _flush_running ) {
+    if ( !_space_cond.timed_wait( lock, deadline ) ) {
+      return _ring->reserve();
     }
- }
-  
+  }
+  return slot;
+}
+
+
+void RH_LogEventAppender::startAsync_() {
+  boost::mutex::scoped_lock async_lock(_async_lock);
+  synchronized sync(mutex);
+  if ( _flush_thread ) return;
+
+  _LL_DEBUG( "RH_LogEventAppender::startAsync_ queue size:" << _queue_size << " batch size:" << _batch_size );
+  _ring = new EventRing(_queue_size);
+  _flush_running = true;
+  _flush_thread = new boost::thread( &RH_LogEventAppender::flushLoop_, this, _ring );
+}
+
+
+void RH_LogEventAppender::stopAsync_() {
+  boost::mutex::scoped_lock async_lock(_async_lock);
+  if ( !_flush_thread ) return;
+
+  _LL_DEBUG( "RH_LogEventAppender::stopAsync_ START");
+
+  // wake any append waiting for room first, so that it gives up the
+  // appender lock
+  {
+    boost::mutex::scoped_lock lock(_space_lock);
+    _flush_running = false;
+    _space_cond.notify_all();
+  }
+
+  // detach the ring under the appender lock; appends that follow are sent
+  // synchronously
+  EventRing *ring;
+  boost::thread *thread;
+  {
+    synchronized sync(mutex);
+    ring = _ring;
+    _ring = NULL;
+    thread = _flush_thread;
+    _flush_thread = NULL;
+  }
+
+  thread->join();
+  delete thread;
+
+  // deliver whatever is left, then return to synchronous mode
+  while ( flushBatch_(ring) > 0 );
+  delete ring;
+  _LL_DEBUG( "RH_LogEventAppender::stopAsync_ END queued:" << _queued << " sent:" << _sent << " failed:" << _failed << " dropped:" << _dropped );
 }
+
+
+void RH_LogEventAppender::flushLoop_( EventRing *ring ) {
+  unsigned long reported = 0;
+  while ( _flush_running ) {
+    if ( flushBatch_(ring) == 0 ) {
+      boost::this_thread::sleep( boost::posix_time::milliseconds( _flush_interval ) );
+    }
+
+    // report overflows as they happen, rather than for every dropped event
+    const unsigned long dropped = _dropped;
+    if ( dropped != reported ) {
+      std::ostringstream os;
+      os << "RH_LogEventAppender: event queue full, " << (dropped - reported) << " log events dropped (" << dropped << " total)";
+      LOG4CXX_DECODE_CHAR(msgL, os.str());
+      LogLog::warn(msgL);
+      reported = dropped;
+    }
+  }
+}
+
+
+size_t RH_LogEventAppender::flushBatch_( EventRing *ring ) {
+  PushEventSupplierPtr channel;
+  {
+    boost::mutex::scoped_lock lock(_channel_lock);
+    channel = _event_channel;
+  }
+
+  const size_t batch_size = _batch_size;
+  size_t count = 0;
+  CF::LogEvent *slot;
+  if ( _batch_events ) {
+    // copy the events out of the ring, so that their slots are free while
+    // the batch is sent, then deliver them with a single push
+    ExtendedEvent::EventBatchType batch;
+    batch.events.length(batch_size);
+    while ( count < batch_size && (slot = ring->front()) != NULL ) {
+      batch.events[count] <<= *slot;
+      ring->release();
+      count++;
+    }
+    if ( count > 0 ) {
+      batch.events.length(count);
+      CORBA::Any data;
+      data <<= batch;
+      if ( channel && channel->push(data) == 0 ) {
+        __sync_fetch_and_add(&_sent, count);
+      } else {
+        __sync_fetch_and_add(&_failed, count);
+      }
+    }
+  }
+  else {
+    while ( count < batch_size && (slot = ring->front()) != NULL ) {
+      if ( channel && channel->push(*slot) == 0 ) {
+        __sync_fetch_and_add(&_sent, 1);
+      } else {
+        __sync_fetch_and_add(&_failed, 1);
+      }
+      ring->release();
+      count++;
+    }
+  }
+
+  if ( count > 0 && _drop_policy == BLOCK ) {
+    boost::mutex::scoped_lock lock(_space_lock);
+    _space_cond.notify_all();
+  }
+  return count;
+}
+
 	 
 void RH_LogEventAppender::close()
 {
   _LL_DEBUG( "RH_LogEventAppender::close START");
   if ( closed ) return;
-  _event_channel.reset();
+  stopAsync_();
+  {
+    boost::mutex::scoped_lock lock(_channel_lock);
+    _event_channel.reset();
+  }
   closed=true;
   _LL_DEBUG( "RH_LogEventAppender::close END");
 }
@@ -283,6 +595,7 @@ int RH_LogEventAppender::connect_() {
 
   int retval = 0;
 
+  boost::mutex::scoped_lock lock(_channel_lock);
   _event_channel.reset();
   std::ostringstream os;
   _LLS_DEBUG( os, "RH_LogEventAppender::connect Create PushEventSupplier" << _channelName );
@@ -23,11 +23,15 @@
 #define RH_LogEvent_APPENDER_H
 #include <string>
 #include <ossie/EventChannelSupport.h>
+#include <ossie/CF/LogInterfaces.h>
 #include <log4cxx/appenderskeleton.h>
 #include <log4cxx/logstring.h>
 #include <log4cxx/spi/loggingevent.h>
 #include <log4cxx/helpers/pool.h>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
  
 namespace log4cxx
 {
@@ -63,16 +67,61 @@ class RH_LogEventAppender : public AppenderSkeleton
 	 
   bool requiresLayout() const { return true; }
 
+  //
+  // Asynchronous mode statistics
+  //
+  unsigned long getQueuedCount() const { return _queued; }
+  unsigned long getDroppedCount() const { return _dropped; }
+  unsigned long getSentCount() const { return _sent; }
+  unsigned long getFailedCount() const { return _failed; }
+
  private:
 
   typedef boost::shared_ptr< ossie::events::PushEventSupplier >     PushEventSupplierPtr;
 
+  //
+  // Fixed-size ring of pre-allocated log events, filled by append and
+  // drained by the flush thread
+  //
+  class EventRing;
+
+  //
+  // policy when the ring is full in asynchronous mode
+  //
+  enum DropPolicy {
+    DROP_NEWEST,         // discard the event being appended
+    BLOCK                // wait, up to the block timeout, for the flush thread to make room
+  };
+
   std::vector< std::string >                                ArgList;
 
   //
   // perform connect operation to establish a corba context 
   //
   int                                      connect_();
+
+  //
+  // fill in a log event from the log4cxx event
+  //
+  void                                     format_( CF::LogEvent &rh_event, const spi::LoggingEventPtr& event, log4cxx::helpers::Pool& p );
+
+  //
+  // wait for a free slot under the BLOCK policy, NULL on timeout or shutdown
+  //
+  CF::LogEvent*                            waitForSlot_();
+
+  //
+  // start/stop the flush thread for asynchronous mode; neither may be called
+  // with the appender lock held
+  //
+  void                                     startAsync_();
+  void                                     stopAsync_();
+
+  //
+  // flush thread, drains the ring to the event channel in batches
+  //
+  void                                     flushLoop_( EventRing *ring );
+  size_t                                   flushBatch_( EventRing *ring );
   
   //
   // Command line arguments used to configure corba util methods
@@ -128,6 +177,51 @@ class RH_LogEventAppender : public AppenderSkeleton
   // clean up event channel when appender is removed
   int                                       _cleanup_event_channel;
 
+  // deliver events from a background thread instead of from append
+  bool                                      _async;
+
+  // capacity of the ring in asynchronous mode (rounded up to a power of 2)
+  int                                       _queue_size;
+
+  // maximum number of events delivered per flush
+  int                                       _batch_size;
+
+  // deliver each flush as one ExtendedEvent::EventBatchType push instead of
+  // one push per event; off by default, because only the events::Subscriber
+  // classes unpack batches and other log consumers would receive the batch
+  bool                                      _batch_events;
+
+  // number of milliseconds the flush thread sleeps when the ring is empty
+  int                                       _flush_interval;
+
+  // what to do when the ring is full
+  DropPolicy                                _drop_policy;
+
+  // maximum number of milliseconds append waits for room under BLOCK
+  int                                       _block_timeout;
+
+  // ring and thread for asynchronous mode; both change only under the
+  // appender lock
+  EventRing                                *_ring;
+  boost::thread                            *_flush_thread;
+  volatile bool                             _flush_running;
+
+  // serializes starting and stopping the flush thread
+  boost::mutex                              _async_lock;
+
+  // signalled by the flush thread when it frees slots
+  boost::mutex                              _space_lock;
+  boost::condition_variable                 _space_cond;
+
+  // protects _event_channel against reconnects while the flush thread pushes
+  boost::mutex                              _channel_lock;
+
+  // asynchronous mode statistics
+  volatile unsigned long                    _queued;
+  volatile unsigned long                    _dropped;
+  volatile unsigned long                    _sent;
+  volatile unsigned long                    _failed;
+
   //  prevent copy and assignment statements
   RH_LogEventAppender(const RH_LogEventAppender&);
   RH_LogEventAppender& operator=(const RH_LogEventAppender&);
@@ -663,6 +663,7 @@ namespace ossie {
         logger->setLevel( newLevel );
 	STDOUT_DEBUG( " Get name/level <" << logger->getName() << ">/" << logger->getLevel()->toString() );
       }   
+      rh_logger::Logger::invalidateCachedLoggers();
       STDOUT_DEBUG( " Setting Logger: END  log:" << logid << " NEW Level:" << newLevel->toString() );
     }
 
@@ -683,6 +684,7 @@ namespace ossie {
         logger->setLevel( level );
 	STDOUT_DEBUG( " GET log4 name/level <" << logger->getName() << ">/" << logger->getLevel()->toString() );
       }   
+      rh_logger::Logger::invalidateCachedLoggers();
       STDOUT_DEBUG( " Setting Logger: END  log:" << logid << " NEW Level:" << newLevel );
     }
 
@@ -994,6 +996,7 @@ namespace ossie {
         log4cxx::helpers::InputStreamPtr is( new log4cxx::helpers::StringInputStream( fileContents ) );
         props.load(is);
         log4cxx::PropertyConfigurator::configure(props);
+        rh_logger::Logger::invalidateCachedLoggers();
     }
 
     //
@@ -1005,12 +1008,14 @@ namespace ossie {
       if (logcfgUri) {
         if (strncmp("file://", logcfgUri, 7) == 0) {
           log4cxx::PropertyConfigurator::configure(logcfgUri + 7);
+          rh_logger::Logger::invalidateCachedLoggers();
           return;
         } else if (strncmp("sca:", logcfgUri, 4) == 0) {
           // SCA URI; "?fs=" must have been given, or the file will not be located.
           std::string localFile = CacheSCAFile(std::string(logcfgUri));
           if (!localFile.empty()) {
             log4cxx::PropertyConfigurator::configure(localFile.c_str() );
+            rh_logger::Logger::invalidateCachedLoggers();
             return;
           }
         }
@@ -1130,12 +1135,14 @@ namespace ossie {
       catch(...){
         std::cout << "ERROR: ossie::logging::Configure - configure via stream contents, failed: " << std::endl;
       }
+      rh_logger::Logger::invalidateCachedLoggers();
 
     }
 
     void Terminate() {
       log4cxx::LogManager::shutdown();
       _logcfg_resolver.reset();
+      rh_logger::Logger::invalidateCachedLoggers();
    }
 
 
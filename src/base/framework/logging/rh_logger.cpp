@@ -20,6 +20,7 @@
 #include <sys/time.h>
 #include <algorithm>
 #include <sstream>
+#include <cstring>
 
 // logging macros used by redhawk resources
 #include <ossie/debug.h>
@@ -400,6 +401,112 @@ namespace rh_logger {
     return getLogger(n);
   }
 
+  //
+  // Generation count for the logging configuration, see LoggerHandle
+  //
+  static volatile unsigned int _config_generation = 0;
+
+  unsigned int Logger::getConfigGeneration() {
+    return __sync_add_and_fetch(&_config_generation, 0);
+  }
+
+  void Logger::invalidateCachedLoggers() {
+    STDOUT_DEBUG( "RH_LOGGER invalidateCachedLoggers ");
+    __sync_add_and_fetch(&_config_generation, 1);
+  }
+
+
+  //
+  // Immutable result of one lookup, published to readers of a LoggerHandle
+  //
+  struct LoggerHandle::Entry {
+    Entry( const std::string &n, const char *k, const LoggerPtr &l, unsigned int g ) :
+      name(n), key(k), logger(l), generation(g)
+    {}
+
+    std::string    name;
+    const char    *key;
+    LoggerPtr      logger;
+    unsigned int   generation;
+  };
+
+  LoggerHandle::LoggerHandle() :
+    _current(NULL),
+    _readers(0)
+  {
+  }
+
+  LoggerHandle::~LoggerHandle() {
+    delete _current;
+    _reclaim();
+  }
+
+  LoggerPtr LoggerHandle::get( const char *name ) {
+    // Fast path: the macros pass the same string literal on every call, so
+    // the cached entry is current if the pointer and generation match
+    __sync_fetch_and_add(&_readers, 1);
+    const Entry *entry = _current;
+    if ( entry && (entry->key == name) && (entry->generation == _config_generation) ) {
+      LoggerPtr logger = entry->logger;
+      __sync_fetch_and_sub(&_readers, 1);
+      return logger;
+    }
+    __sync_fetch_and_sub(&_readers, 1);
+
+    boost::mutex::scoped_lock lock(_lock);
+    return _resolve(name, name, strlen(name));
+  }
+
+  LoggerPtr LoggerHandle::get( const std::string &name ) {
+    __sync_fetch_and_add(&_readers, 1);
+    const Entry *entry = _current;
+    if ( entry && (entry->generation == _config_generation) && (entry->name == name) ) {
+      LoggerPtr logger = entry->logger;
+      __sync_fetch_and_sub(&_readers, 1);
+      return logger;
+    }
+    __sync_fetch_and_sub(&_readers, 1);
+
+    boost::mutex::scoped_lock lock(_lock);
+    return _resolve(NULL, name.c_str(), name.size());
+  }
+
+  LoggerPtr LoggerHandle::_resolve( const char *key, const char *name, size_t length ) {
+    // The name may match under a different pointer, or another thread may
+    // have resolved it while this one waited; either way the entry is good
+    Entry *current = _current;
+    const unsigned int generation = Logger::getConfigGeneration();
+    if ( current && (current->generation == generation) &&
+         (current->name.size() == length) && (current->name.compare(0, length, name) == 0) ) {
+      return current->logger;
+    }
+
+    // Read the generation before resolving, so that a reconfiguration that
+    // happens during getLogger forces another lookup on the next call
+    const std::string resolved(name, length);
+    Entry *entry = new Entry(resolved, key, Logger::getLogger(resolved), generation);
+    __sync_synchronize();
+    _current = entry;
+
+    // Readers that loaded the old entry may still be copying its logger; it
+    // can only be freed once none are left, and any reader arriving after
+    // the count is read sees the new entry
+    if ( current ) {
+      _retired.push_back(current);
+    }
+    if ( __sync_add_and_fetch(&_readers, 0) == 0 ) {
+      _reclaim();
+    }
+    return entry->logger;
+  }
+
+  void LoggerHandle::_reclaim() {
+    for ( std::vector< Entry* >::iterator iter = _retired.begin(); iter != _retired.end(); ++iter ) {
+      delete *iter;
+    }
+    _retired.clear();
+  }
+
   void Logger::setLevel ( const LevelPtr &newLevel ) {
     STDOUT_DEBUG( " RH LOGGER  setLevel - logger: " << name );    
     if ( newLevel ) {
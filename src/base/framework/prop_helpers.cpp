@@ -36,7 +36,30 @@ using namespace ossie;
 
 CREATE_LOGGER(prop_helpers)
 
+ossie::Action ossie::parseAction(const std::string& action)
+{
+    if (action == "eq") {
+        return ACTION_EQ;
+    } else if (action == "ne") {
+        return ACTION_NE;
+    } else if (action == "gt") {
+        return ACTION_GT;
+    } else if (action == "lt") {
+        return ACTION_LT;
+    } else if (action == "ge") {
+        return ACTION_GE;
+    } else if (action == "le") {
+        return ACTION_LE;
+    } else {
+        return ACTION_NONE;
+    }
+}
+
 bool ossie::compare_anys(const CORBA::Any& a, const CORBA::Any& b, std::string& action) {
+    return compare_anys(a, b, parseAction(action));
+}
+
+bool ossie::compare_anys(const CORBA::Any& a, const CORBA::Any& b, Action action) {
     CORBA::TypeCode_var typeA = a.type();
     CORBA::TypeCode_var typeB = b.type();
 
@@ -160,6 +183,139 @@ bool ossie::compare_anys(const CORBA::Any& a, const CORBA::Any& b, std::string&
     return result;
 }
 
+namespace {
+
+    // Extraction of the simple types that compare_anys supports; the
+    // single-byte types need their own helpers because CORBA::Boolean,
+    // CORBA::Char and CORBA::Octet are not distinct C++ types.
+    template <typename T>
+    bool extractNumber(const CORBA::Any& any, T& value)
+    {
+        return (any >>= value);
+    }
+
+    bool extractBoolean(const CORBA::Any& any, CORBA::Boolean& value)
+    {
+        return (any >>= CORBA::Any::to_boolean(value));
+    }
+
+    bool extractChar(const CORBA::Any& any, CORBA::Char& value)
+    {
+        return (any >>= CORBA::Any::to_char(value));
+    }
+
+    bool extractOctet(const CORBA::Any& any, CORBA::Octet& value)
+    {
+        return (any >>= CORBA::Any::to_octet(value));
+    }
+
+    bool extractString(const CORBA::Any& any, std::string& value)
+    {
+        const char* str;
+        if (any >>= str) {
+            value = str;
+            return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    class TypedPropertyMatcher : public ossie::PropertyMatcher {
+    public:
+        typedef bool (*Extractor)(const CORBA::Any&, T&);
+
+        TypedPropertyMatcher(CORBA::TCKind kind, Extractor extract, const T& value, ossie::Action action) :
+            kind_(kind),
+            extract_(extract),
+            value_(value),
+            action_(action)
+        {
+        }
+
+        bool match(const CORBA::Any& dependency, Conversions* conversions) const
+        {
+            T other;
+            if (!extract_(dependency, other)) {
+                // Not the property's type (typically a string from the
+                // ApplicationFactory); convert and try again
+                if (conversions) {
+                    if (!extract_(conversions->convert(dependency, kind_), other)) {
+                        return false;
+                    }
+                } else {
+                    CORBA::Any converted = ossie::stringToSimpleAny(ossie::any_to_string(dependency), kind_);
+                    if (!extract_(converted, other)) {
+                        return false;
+                    }
+                }
+            }
+            return ossie::perform_action(value_, other, action_);
+        }
+
+    private:
+        const CORBA::TCKind kind_;
+        const Extractor extract_;
+        const T value_;
+        const ossie::Action action_;
+    };
+
+    template <typename T>
+    ossie::PropertyMatcher* compileMatcher(const CORBA::Any& any, CORBA::TCKind kind, bool (*extract)(const CORBA::Any&, T&), ossie::Action action)
+    {
+        T value;
+        if (!extract(any, value)) {
+            return 0;
+        }
+        return new TypedPropertyMatcher<T>(kind, extract, value, action);
+    }
+
+}
+
+const CORBA::Any& ossie::PropertyMatcher::Conversions::convert(const CORBA::Any& dependency, CORBA::TCKind kind)
+{
+    const ConversionMap::key_type key(&dependency, kind);
+    ConversionMap::iterator found = conversions_.find(key);
+    if (found == conversions_.end()) {
+        found = conversions_.insert(std::make_pair(key, ossie::stringToSimpleAny(ossie::any_to_string(dependency), kind))).first;
+    }
+    return found->second;
+}
+
+ossie::PropertyMatcher* ossie::PropertyMatcher::Compile(const CORBA::Any& value, const std::string& action)
+{
+    const Action op = parseAction(action);
+    CORBA::TypeCode_var type = value.type();
+    const CORBA::TCKind kind = type->kind();
+    switch (kind) {
+    case CORBA::tk_boolean:
+        return compileMatcher(value, kind, &extractBoolean, op);
+    case CORBA::tk_char:
+        return compileMatcher(value, kind, &extractChar, op);
+    case CORBA::tk_octet:
+        return compileMatcher(value, kind, &extractOctet, op);
+    case CORBA::tk_ushort:
+        return compileMatcher(value, kind, &extractNumber<CORBA::UShort>, op);
+    case CORBA::tk_short:
+        return compileMatcher(value, kind, &extractNumber<CORBA::Short>, op);
+    case CORBA::tk_float:
+        return compileMatcher(value, kind, &extractNumber<CORBA::Float>, op);
+    case CORBA::tk_double:
+        return compileMatcher(value, kind, &extractNumber<CORBA::Double>, op);
+    case CORBA::tk_ulong:
+        return compileMatcher(value, kind, &extractNumber<CORBA::ULong>, op);
+    case CORBA::tk_long:
+        return compileMatcher(value, kind, &extractNumber<CORBA::Long>, op);
+    case CORBA::tk_longlong:
+        return compileMatcher(value, kind, &extractNumber<CORBA::LongLong>, op);
+    case CORBA::tk_ulonglong:
+        return compileMatcher(value, kind, &extractNumber<CORBA::ULongLong>, op);
+    case CORBA::tk_string:
+        return compileMatcher(value, kind, &extractString, op);
+    default:
+        return 0;
+    }
+}
+
 /*
  * Convert a string in the format A+jB to a CORBA::Any.
  *
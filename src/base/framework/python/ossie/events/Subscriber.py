@@ -27,7 +27,7 @@ import logging
 import traceback
 
 from omniORB import any, URI, CORBA
-from ossie.cf import CF, CF__POA
+from ossie.cf import CF, CF__POA, ExtendedEvent
 import CosEventComm__POA
 import CosEventChannelAdmin, CosEventChannelAdmin__POA
 
@@ -86,6 +86,12 @@ class DefaultConsumer(Receiver):
         Receiver.__init__(self)
 
     def push(self, data):
+        # Events from a batching publisher arrive as a sequence; deliver each
+        # one individually, in order
+        if data.typecode().equivalent(ExtendedEvent._tc_EventBatchType):
+            for event in data.value().events:
+                self.push(event)
+            return
         if self.parent.dataArrivedCB != None:
             self.parent.logger.trace('Received (callback) DATA: ' + str(data))
             self.parent.dataArrivedCB( data )
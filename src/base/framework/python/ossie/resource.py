@@ -459,23 +459,36 @@ class Resource(object):
     def getPortSet(self):
        """Return list of ports for this Resource"""
        self._log.trace("getPortSet()")
-       portList = []
-       for name, portdef in self.__ports.iteritems():
-           obj_ptr = self.getPort(name)
-           repid = portdef.repid
-           description = portdef.__doc__
-           direction = ''
-           if isinstance(portdef, usesport):
-               direction = 'Uses'
-           elif isinstance(portdef, providesport):
-               if repid == 'IDL:ExtendedEvent/MessageEvent:1.0':
-                   direction = 'Bidir'
-               else:
-                   direction = 'Provides'
-           info = CF.PortSet.PortInfoType(obj_ptr, name, repid, description, direction)
-           portList.append(info)
-
-       return portList
+       return [self.__getPortInfo(name, portdef) for name, portdef in self.__ports.iteritems()]
+
+    def getPorts(self, names):
+        """Return the information for the named ports, in the order given"""
+        self._log.trace("getPorts(%s)", names)
+        portList = []
+        for name in names:
+            try:
+                portdef = self.__ports[name]
+            except KeyError:
+                # A subclass may override getPort() to serve ports that are
+                # not declared; it raises UnknownPort if the name is invalid
+                portList.append(CF.PortSet.PortInfoType(self.getPort(name), name, 'IDL:CORBA/Object:1.0', '', ''))
+            else:
+                portList.append(self.__getPortInfo(name, portdef))
+        return portList
+
+    def __getPortInfo(self, name, portdef):
+        obj_ptr = self.getPort(name)
+        repid = portdef.repid
+        description = portdef.__doc__
+        direction = ''
+        if isinstance(portdef, usesport):
+            direction = 'Uses'
+        elif isinstance(portdef, providesport):
+            if repid == 'IDL:ExtendedEvent/MessageEvent:1.0':
+                direction = 'Bidir'
+            else:
+                direction = 'Provides'
+        return CF.PortSet.PortInfoType(obj_ptr, name, repid, description, direction)
 
     def __loadPorts(self):
         self.__ports = {}
@@ -1151,6 +1151,16 @@ class EventChannelManager(CorbaObject):
                 raise
         return retval
 
+    def registerResources( self, channelNames ):
+        retval=None
+        if self.ref:
+            try:
+                regs = [ _CF.EventChannelManager.EventRegistration( name, "" ) for name in channelNames ]
+                retval = self.ref.registerResources( regs )
+            except:
+                raise
+        return retval
+
     def unregister( self, channelName, reg_id ):
         if self.ref:
             try:
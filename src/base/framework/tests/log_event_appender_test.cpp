@@ -0,0 +1,139 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Exercises the asynchronous mode of RH_LogEventAppender with several
+ * threads logging through a small ring. No event channel is configured, so
+ * every event the flush thread drains counts as failed. Checks that the
+ * BLOCK policy waits for room instead of dropping, and that reconfiguring
+ * and closing the appender while other threads append, with and without
+ * batched delivery, neither crashes nor loses track of a queued event.
+ *
+ * usage: log_event_appender_test
+ */
+#include <iostream>
+#include <string>
+
+#include <ossie/testing/check.h>
+
+using namespace ossie::testing;
+
+#ifdef HAVE_LOG4CXX
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <log4cxx/logger.h>
+#include <log4cxx/patternlayout.h>
+#include <log4cxx/helpers/loglog.h>
+#include <log4cxx/helpers/pool.h>
+
+#include "logging/RH_LogEventAppender.h"
+
+using namespace log4cxx;
+
+typedef helpers::ObjectPtrT<RH_LogEventAppender> RH_LogEventAppenderPtr;
+
+static volatile bool logging = false;
+
+static void logLoop( LoggerPtr logger )
+{
+    while (logging) {
+        LOG4CXX_INFO(logger, "test event");
+    }
+}
+
+static void startLogging( LoggerPtr logger, boost::thread_group &threads )
+{
+    logging = true;
+    for (int count = 0; count < 4; ++count) {
+        threads.create_thread(boost::bind(&logLoop, logger));
+    }
+}
+
+static void stopLogging( boost::thread_group &threads )
+{
+    logging = false;
+    threads.join_all();
+}
+
+int main(int argc, char* argv[])
+{
+    // appending to the closed appender is reported, expectedly, by LogLog
+    helpers::LogLog::setQuietMode(true);
+
+    RH_LogEventAppenderPtr appender(new RH_LogEventAppender());
+    appender->setLayout(new PatternLayout(LOG4CXX_STR("%m")));
+    appender->setOption(LOG4CXX_STR("EVENT_CHANNEL"), LOG4CXX_STR(""));
+    appender->setOption(LOG4CXX_STR("ASYNC"), LOG4CXX_STR("true"));
+    appender->setOption(LOG4CXX_STR("QUEUE_SIZE"), LOG4CXX_STR("8"));
+    appender->setOption(LOG4CXX_STR("BATCH_SIZE"), LOG4CXX_STR("4"));
+    appender->setOption(LOG4CXX_STR("FLUSH_INTERVAL"), LOG4CXX_STR("1"));
+    appender->setOption(LOG4CXX_STR("DROP_POLICY"), LOG4CXX_STR("BLOCK"));
+    appender->setOption(LOG4CXX_STR("BLOCK_TIMEOUT"), LOG4CXX_STR("10000"));
+    helpers::Pool pool;
+    appender->activateOptions(pool);
+
+    LoggerPtr logger = Logger::getLogger("log_event_appender_test");
+    logger->setAdditivity(false);
+    logger->setLevel(Level::getAll());
+    logger->addAppender(appender);
+
+    // BLOCK waits for the flush thread rather than dropping
+    boost::thread_group threads;
+    startLogging(logger, threads);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+    stopLogging(threads);
+    check(appender->getQueuedCount() > 0, "events queued");
+    check(appender->getDroppedCount() == 0, "no events dropped under BLOCK");
+
+    // Reconfiguring restarts the flush thread and replaces the ring while
+    // other threads append to it, switching between per-event and batched
+    // delivery
+    startLogging(logger, threads);
+    for (int count = 0; count < 50; ++count) {
+        appender->setOption(LOG4CXX_STR("BATCH_EVENTS"), (count % 2) ? LOG4CXX_STR("true") : LOG4CXX_STR("false"));
+        appender->activateOptions(pool);
+        boost::this_thread::sleep(boost::posix_time::milliseconds(2));
+    }
+
+    // Closing stops the flush thread for good, with appends still arriving
+    appender->close();
+    stopLogging(threads);
+    check(appender->isClosed(), "appender closed");
+
+    // Every queued event was drained exactly once, whichever ring it was in
+    const unsigned long queued = appender->getQueuedCount();
+    const unsigned long drained = appender->getSentCount() + appender->getFailedCount();
+    std::cout << "queued " << queued << ", drained " << drained << ", dropped " << appender->getDroppedCount() << std::endl;
+    check(queued == drained, "queued events all drained");
+
+    logger->removeAppender(appender);
+
+    return result();
+}
+
+#else
+
+int main(int, char*[])
+{
+    std::cout << "SKIP: built without log4cxx" << std::endl;
+    return SKIPPED;
+}
+
+#endif
@@ -0,0 +1,328 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Exercises Publisher batching against a local event channel that records
+ * every push. Checks that unbatched events are sent at once, that queued
+ * events are sent when a batch fills, when the flush interval expires and
+ * when the publisher is destroyed, that sequence batches preserve order and
+ * size, and that pushing does not wait on a flush blocked in the channel.
+ *
+ * usage: publisher_batching_test
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/thread/thread.hpp>
+#include <COS/CosEventChannelAdmin.hh>
+
+#include <ossie/CorbaUtils.h>
+#include <ossie/Events.h>
+#include <ossie/testing/check.h>
+
+using namespace ossie::testing;
+
+REDHAWK_CPP_NAMESPACE_USE
+
+class TestProxyConsumer : public virtual POA_CosEventChannelAdmin::ProxyPushConsumer
+{
+public:
+    TestProxyConsumer() : blocked_(false), inPush_(false) { }
+
+    void push(const CORBA::Any& data)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        inPush_ = true;
+        cond_.notify_all();
+        while (blocked_) {
+            cond_.wait(lock);
+        }
+        inPush_ = false;
+        pushes_.push_back(data);
+        cond_.notify_all();
+    }
+
+    void connect_push_supplier(CosEventComm::PushSupplier_ptr)
+    {
+    }
+
+    void disconnect_push_consumer()
+    {
+    }
+
+    // Holds every push in the channel until unblocked
+    void block(bool blocked)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        blocked_ = blocked;
+        cond_.notify_all();
+    }
+
+    // Waits for a push to reach the channel, or for at least count pushes
+    // to complete
+    bool waitForPush(int timeout)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds(timeout);
+        while (!inPush_) {
+            if (!cond_.timed_wait(lock, deadline)) return false;
+        }
+        return true;
+    }
+
+    bool waitForPushes(size_t count, int timeout)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds(timeout);
+        while (pushes_.size() < count) {
+            if (!cond_.timed_wait(lock, deadline)) return false;
+        }
+        return true;
+    }
+
+    std::vector<CORBA::Any> takePushes()
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        std::vector<CORBA::Any> result;
+        result.swap(pushes_);
+        return result;
+    }
+
+private:
+    boost::mutex lock_;
+    boost::condition_variable cond_;
+    std::vector<CORBA::Any> pushes_;
+    bool blocked_;
+    bool inPush_;
+};
+
+class TestSupplierAdmin : public virtual POA_CosEventChannelAdmin::SupplierAdmin
+{
+public:
+    TestSupplierAdmin(CosEventChannelAdmin::ProxyPushConsumer_ptr consumer) :
+        consumer_(CosEventChannelAdmin::ProxyPushConsumer::_duplicate(consumer))
+    {
+    }
+
+    CosEventChannelAdmin::ProxyPushConsumer_ptr obtain_push_consumer()
+    {
+        return CosEventChannelAdmin::ProxyPushConsumer::_duplicate(consumer_);
+    }
+
+    CosEventChannelAdmin::ProxyPullConsumer_ptr obtain_pull_consumer()
+    {
+        return CosEventChannelAdmin::ProxyPullConsumer::_nil();
+    }
+
+private:
+    CosEventChannelAdmin::ProxyPushConsumer_var consumer_;
+};
+
+class TestChannel : public virtual POA_CosEventChannelAdmin::EventChannel
+{
+public:
+    TestChannel(CosEventChannelAdmin::SupplierAdmin_ptr admin) :
+        admin_(CosEventChannelAdmin::SupplierAdmin::_duplicate(admin))
+    {
+    }
+
+    CosEventChannelAdmin::ConsumerAdmin_ptr for_consumers()
+    {
+        return CosEventChannelAdmin::ConsumerAdmin::_nil();
+    }
+
+    CosEventChannelAdmin::SupplierAdmin_ptr for_suppliers()
+    {
+        return CosEventChannelAdmin::SupplierAdmin::_duplicate(admin_);
+    }
+
+    void destroy()
+    {
+    }
+
+private:
+    CosEventChannelAdmin::SupplierAdmin_var admin_;
+};
+
+static CORBA::ULong valueOf( const CORBA::Any &data )
+{
+    CORBA::ULong value = 0;
+    data >>= value;
+    return value;
+}
+
+static void pushValues( events::Publisher &publisher, CORBA::ULong first, CORBA::ULong count )
+{
+    for (CORBA::ULong value = first; value < first + count; ++value) {
+        CORBA::Any data;
+        data <<= value;
+        publisher.push(data);
+    }
+}
+
+static events::Publisher::BatchSettings batching( events::Publisher::BatchMode mode, size_t maxBatch, int interval )
+{
+    events::Publisher::BatchSettings settings;
+    settings.mode = mode;
+    settings.max_batch = maxBatch;
+    settings.flush_interval = interval;
+    return settings;
+}
+
+static void flushPublisher( events::Publisher *publisher, int *result )
+{
+    *result = publisher->flush();
+}
+
+int main(int argc, char* argv[])
+{
+    ossie::corba::CorbaInit(argc, argv);
+
+    TestProxyConsumer* consumer = new TestProxyConsumer();
+    PortableServer::ObjectId_var consumerId = ossie::corba::RootPOA()->activate_object(consumer);
+    CosEventChannelAdmin::ProxyPushConsumer_var consumerRef = consumer->_this();
+    TestSupplierAdmin* admin = new TestSupplierAdmin(consumerRef);
+    PortableServer::ObjectId_var adminId = ossie::corba::RootPOA()->activate_object(admin);
+    CosEventChannelAdmin::SupplierAdmin_var adminRef = admin->_this();
+    TestChannel* channel = new TestChannel(adminRef);
+    PortableServer::ObjectId_var channelId = ossie::corba::RootPOA()->activate_object(channel);
+    CosEventChannelAdmin::EventChannel_var channelRef = channel->_this();
+
+    // An interval long enough that only a full batch, flush() or destruction
+    // can send anything while a check runs
+    const int never = 60000;
+
+    {
+        // Unbatched events are sent from the pushing thread
+        events::Publisher publisher(channelRef);
+        pushValues(publisher, 0, 3);
+        check(consumer->takePushes().size() == 3, "unbatched events sent immediately");
+        check(publisher.getBatchStatistics().queued == 0, "unbatched events not queued");
+    }
+
+    {
+        // A full batch is sent without waiting for the interval
+        events::Publisher publisher(channelRef);
+        publisher.setBatching(batching(events::Publisher::BATCH_INDIVIDUAL, 10, never));
+        pushValues(publisher, 0, 9);
+        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+        check(consumer->takePushes().empty(), "partial batch held");
+        pushValues(publisher, 9, 1);
+        check(consumer->waitForPushes(10, 5000), "full batch flushed");
+        std::vector<CORBA::Any> pushes = consumer->takePushes();
+        bool ordered = (pushes.size() == 10);
+        for (size_t index = 0; ordered && index < pushes.size(); ++index) {
+            ordered = (valueOf(pushes[index]) == index);
+        }
+        check(ordered, "individual events sent in order");
+        events::Publisher::BatchStatistics stats = publisher.getBatchStatistics();
+        check(stats.queued == 10 && stats.sent == 10 && stats.queue_depth == 0, "full batch statistics");
+    }
+
+    {
+        // A partial batch is sent when the interval expires
+        events::Publisher publisher(channelRef);
+        publisher.setBatching(batching(events::Publisher::BATCH_INDIVIDUAL, 1000, 50));
+        pushValues(publisher, 0, 3);
+        check(consumer->waitForPushes(3, 5000), "partial batch flushed on interval");
+        consumer->takePushes();
+    }
+
+    {
+        // Sequence batches are bounded by max_batch and keep their order
+        events::Publisher publisher(channelRef);
+        publisher.setBatching(batching(events::Publisher::BATCH_SEQUENCE, 10, never));
+        publisher.flush();
+        consumer->block(true);
+        pushValues(publisher, 0, 10);
+        check(consumer->waitForPush(5000), "full sequence batch reached channel");
+        pushValues(publisher, 10, 15);
+        consumer->block(false);
+        check(consumer->waitForPushes(1, 5000), "blocked sequence batch delivered");
+        check(publisher.flush() == 0, "explicit flush");
+        std::vector<CORBA::Any> pushes = consumer->takePushes();
+        std::vector<size_t> sizes;
+        CORBA::ULong expected = 0;
+        bool ordered = true;
+        for (size_t index = 0; index < pushes.size(); ++index) {
+            const ExtendedEvent::EventBatchType* batch;
+            if (!(pushes[index] >>= batch)) {
+                ordered = false;
+                continue;
+            }
+            sizes.push_back(batch->events.length());
+            for (CORBA::ULong event = 0; event < batch->events.length(); ++event) {
+                ordered = ordered && (valueOf(batch->events[event]) == expected++);
+            }
+        }
+        check(ordered && expected == 25, "sequence batches carry every event in order");
+        bool bounded = !sizes.empty();
+        for (size_t index = 0; index < sizes.size(); ++index) {
+            bounded = bounded && (sizes[index] <= 10);
+        }
+        check(bounded, "sequence batches bounded by max_batch");
+    }
+
+    {
+        // Queued events are sent when the publisher is destroyed
+        events::Publisher* publisher = new events::Publisher(channelRef);
+        publisher->setBatching(batching(events::Publisher::BATCH_INDIVIDUAL, 1000, never));
+        pushValues(*publisher, 0, 5);
+        check(consumer->takePushes().empty(), "events queued before destruction");
+        delete publisher;
+        check(consumer->takePushes().size() == 5, "queue flushed on destruction");
+    }
+
+    {
+        // Disabling batching delivers the queue
+        events::Publisher publisher(channelRef);
+        publisher.setBatching(batching(events::Publisher::BATCH_INDIVIDUAL, 1000, never));
+        pushValues(publisher, 0, 4);
+        publisher.setBatching(events::Publisher::BatchSettings());
+        check(consumer->takePushes().size() == 4, "queue flushed when batching disabled");
+        pushValues(publisher, 4, 1);
+        check(consumer->takePushes().size() == 1, "direct send after batching disabled");
+    }
+
+    {
+        // A flush blocked in the channel does not hold up new events, or
+        // anyone asking for statistics
+        events::Publisher publisher(channelRef);
+        publisher.setBatching(batching(events::Publisher::BATCH_INDIVIDUAL, 1000, never));
+        pushValues(publisher, 0, 2);
+        consumer->block(true);
+        int result = -1;
+        boost::thread flusher(&flushPublisher, &publisher, &result);
+        check(consumer->waitForPush(5000), "flush reached channel");
+        pushValues(publisher, 2, 3);
+        events::Publisher::BatchStatistics stats = publisher.getBatchStatistics();
+        check(stats.queued == 5 && stats.queue_depth == 3, "push and statistics during blocked flush");
+        consumer->block(false);
+        flusher.join();
+        check(result == 0, "blocked flush completed");
+        check(publisher.flush() == 0, "second flush");
+        check(consumer->takePushes().size() == 5, "every event delivered once");
+    }
+
+    ossie::corba::OrbShutdown(true);
+
+    return result();
+}
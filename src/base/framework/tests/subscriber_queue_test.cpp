@@ -0,0 +1,285 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Exercises the Subscriber event queue against a local event channel that
+ * hands its events straight to the subscriber's consumer. Checks that the
+ * queue is unbounded by default, that a capacity is enforced with either
+ * overflow policy, that lowering the capacity trims the queue, and that
+ * getData waits up to its timeout, returns as soon as an event arrives and
+ * is woken by a disconnect.
+ *
+ * usage: subscriber_queue_test
+ */
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <COS/CosEventChannelAdmin.hh>
+
+#include <ossie/CorbaUtils.h>
+#include <ossie/Events.h>
+#include <ossie/testing/check.h>
+
+using namespace ossie::testing;
+
+REDHAWK_CPP_NAMESPACE_USE
+
+class TestProxySupplier : public virtual POA_CosEventChannelAdmin::ProxyPushSupplier
+{
+public:
+    void connect_push_consumer(CosEventComm::PushConsumer_ptr consumer)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        consumer_ = CosEventComm::PushConsumer::_duplicate(consumer);
+    }
+
+    void disconnect_push_supplier()
+    {
+        CosEventComm::PushConsumer_var consumer;
+        {
+            boost::mutex::scoped_lock lock(lock_);
+            consumer = consumer_._retn();
+        }
+        if (!CORBA::is_nil(consumer)) {
+            consumer->disconnect_push_consumer();
+        }
+    }
+
+    // Delivers an event to the connected consumer, as the channel would
+    void push(const CORBA::Any& data)
+    {
+        CosEventComm::PushConsumer_var consumer;
+        {
+            boost::mutex::scoped_lock lock(lock_);
+            consumer = CosEventComm::PushConsumer::_duplicate(consumer_);
+        }
+        if (!CORBA::is_nil(consumer)) {
+            consumer->push(data);
+        }
+    }
+
+private:
+    boost::mutex lock_;
+    CosEventComm::PushConsumer_var consumer_;
+};
+
+class TestConsumerAdmin : public virtual POA_CosEventChannelAdmin::ConsumerAdmin
+{
+public:
+    TestConsumerAdmin(CosEventChannelAdmin::ProxyPushSupplier_ptr supplier) :
+        supplier_(CosEventChannelAdmin::ProxyPushSupplier::_duplicate(supplier))
+    {
+    }
+
+    CosEventChannelAdmin::ProxyPushSupplier_ptr obtain_push_supplier()
+    {
+        return CosEventChannelAdmin::ProxyPushSupplier::_duplicate(supplier_);
+    }
+
+    CosEventChannelAdmin::ProxyPullSupplier_ptr obtain_pull_supplier()
+    {
+        return CosEventChannelAdmin::ProxyPullSupplier::_nil();
+    }
+
+private:
+    CosEventChannelAdmin::ProxyPushSupplier_var supplier_;
+};
+
+class TestChannel : public virtual POA_CosEventChannelAdmin::EventChannel
+{
+public:
+    TestChannel(CosEventChannelAdmin::ConsumerAdmin_ptr admin) :
+        admin_(CosEventChannelAdmin::ConsumerAdmin::_duplicate(admin))
+    {
+    }
+
+    CosEventChannelAdmin::ConsumerAdmin_ptr for_consumers()
+    {
+        return CosEventChannelAdmin::ConsumerAdmin::_duplicate(admin_);
+    }
+
+    CosEventChannelAdmin::SupplierAdmin_ptr for_suppliers()
+    {
+        return CosEventChannelAdmin::SupplierAdmin::_nil();
+    }
+
+    void destroy()
+    {
+    }
+
+private:
+    CosEventChannelAdmin::ConsumerAdmin_var admin_;
+};
+
+// Subscribers are normally created by the events::Manager
+class TestSubscriber : public events::Subscriber
+{
+public:
+    TestSubscriber(ossie::events::EventChannel_ptr channel) :
+        events::Subscriber(channel)
+    {
+    }
+};
+
+static void pushValues( TestProxySupplier *supplier, CORBA::ULong first, CORBA::ULong count )
+{
+    for (CORBA::ULong value = first; value < first + count; ++value) {
+        CORBA::Any data;
+        data <<= value;
+        supplier->push(data);
+    }
+}
+
+static void pushAfter( TestProxySupplier *supplier, CORBA::ULong value, int delay )
+{
+    boost::this_thread::sleep(boost::posix_time::milliseconds(delay));
+    pushValues(supplier, value, 1);
+}
+
+// Takes every queued event, returning their values in order
+static std::vector<CORBA::ULong> drain( events::Subscriber &subscriber )
+{
+    std::vector<CORBA::ULong> values;
+    CORBA::ULong value;
+    while (subscriber.getData(value) == 0) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+static bool isRange( const std::vector<CORBA::ULong> &values, CORBA::ULong first, CORBA::ULong count )
+{
+    if (values.size() != count) return false;
+    for (size_t index = 0; index < values.size(); ++index) {
+        if (values[index] != first + index) return false;
+    }
+    return true;
+}
+
+static long elapsedMillis( const boost::system_time &start )
+{
+    return (boost::get_system_time() - start).total_milliseconds();
+}
+
+int main(int argc, char* argv[])
+{
+    ossie::corba::CorbaInit(argc, argv);
+
+    TestProxySupplier* supplier = new TestProxySupplier();
+    PortableServer::ObjectId_var supplierId = ossie::corba::RootPOA()->activate_object(supplier);
+    CosEventChannelAdmin::ProxyPushSupplier_var supplierRef = supplier->_this();
+    TestConsumerAdmin* admin = new TestConsumerAdmin(supplierRef);
+    PortableServer::ObjectId_var adminId = ossie::corba::RootPOA()->activate_object(admin);
+    CosEventChannelAdmin::ConsumerAdmin_var adminRef = admin->_this();
+    TestChannel* channel = new TestChannel(adminRef);
+    PortableServer::ObjectId_var channelId = ossie::corba::RootPOA()->activate_object(channel);
+    CosEventChannelAdmin::EventChannel_var channelRef = channel->_this();
+
+    {
+        // The queue is unbounded unless a capacity is set
+        TestSubscriber subscriber(channelRef);
+        checkEqual("default capacity", subscriber.getQueueCapacity(), (size_t) 0);
+        pushValues(supplier, 0, 20000);
+        events::Subscriber::QueueStatistics stats = subscriber.getQueueStatistics();
+        checkEqual("unbounded queue depth", stats.queue_depth, (size_t) 20000);
+        checkEqual("unbounded queue dropped", stats.dropped, 0ULL);
+        check(isRange(drain(subscriber), 0, 20000), "unbounded queue keeps every event in order");
+    }
+
+    {
+        // DROP_OLDEST keeps the most recent events
+        TestSubscriber subscriber(channelRef);
+        subscriber.setQueueCapacity(5, events::Subscriber::DROP_OLDEST);
+        pushValues(supplier, 0, 12);
+        events::Subscriber::QueueStatistics stats = subscriber.getQueueStatistics();
+        checkEqual("DROP_OLDEST received", stats.received, 12ULL);
+        checkEqual("DROP_OLDEST dropped", stats.dropped, 7ULL);
+        checkEqual("DROP_OLDEST queue depth", stats.queue_depth, (size_t) 5);
+        checkEqual("DROP_OLDEST high water mark", stats.high_water_mark, (size_t) 5);
+        check(isRange(drain(subscriber), 7, 5), "DROP_OLDEST keeps the newest events");
+    }
+
+    {
+        // DROP_NEWEST keeps the earliest events
+        TestSubscriber subscriber(channelRef);
+        subscriber.setQueueCapacity(5, events::Subscriber::DROP_NEWEST);
+        check(subscriber.getOverflowPolicy() == events::Subscriber::DROP_NEWEST, "overflow policy set");
+        pushValues(supplier, 0, 12);
+        events::Subscriber::QueueStatistics stats = subscriber.getQueueStatistics();
+        checkEqual("DROP_NEWEST dropped", stats.dropped, 7ULL);
+        check(isRange(drain(subscriber), 0, 5), "DROP_NEWEST keeps the oldest events");
+
+        // Room made by reading is filled again
+        pushValues(supplier, 12, 1);
+        check(isRange(drain(subscriber), 12, 1), "event accepted after draining");
+    }
+
+    {
+        // Lowering the capacity trims the queue with the new policy
+        TestSubscriber subscriber(channelRef);
+        pushValues(supplier, 0, 10);
+        subscriber.setQueueCapacity(4, events::Subscriber::DROP_OLDEST);
+        checkEqual("trimmed dropped", subscriber.getQueueStatistics().dropped, 6ULL);
+        check(isRange(drain(subscriber), 6, 4), "trim keeps the newest events");
+
+        pushValues(supplier, 0, 10);
+        subscriber.setQueueCapacity(0);
+        subscriber.resetQueueStatistics();
+        events::Subscriber::QueueStatistics stats = subscriber.getQueueStatistics();
+        checkEqual("reset dropped", stats.dropped, 0ULL);
+        checkEqual("reset high water mark", stats.high_water_mark, (size_t) 4);
+        drain(subscriber);
+    }
+
+    {
+        TestSubscriber subscriber(channelRef);
+        CORBA::ULong value = 0;
+
+        // A zero timeout returns at once
+        boost::system_time start = boost::get_system_time();
+        checkEqual("empty getData", subscriber.getData(value, 0), -1);
+        check(elapsedMillis(start) < 50, "empty getData does not wait");
+
+        // A positive timeout waits that long for an event
+        start = boost::get_system_time();
+        checkEqual("timed out getData", subscriber.getData(value, 100), -1);
+        check(elapsedMillis(start) >= 100, "getData waits for its timeout");
+
+        // An event arriving during the wait ends it
+        boost::thread pusher(&pushAfter, supplier, 42, 50);
+        start = boost::get_system_time();
+        checkEqual("getData with arriving event", subscriber.getData(value, 5000), 0);
+        check(elapsedMillis(start) < 2500, "getData returns when an event arrives");
+        checkEqual("arrived event", value, (CORBA::ULong) 42);
+        pusher.join();
+
+        // Waiting forever ends when the subscriber is disconnected
+        boost::thread disconnector(boost::bind(&events::Subscriber::disconnect, &subscriber, 1, 0));
+        checkEqual("getData after disconnect", subscriber.getData(value, -1), -1);
+        disconnector.join();
+    }
+
+    ossie::corba::OrbShutdown(true);
+
+    return result();
+}
@@ -0,0 +1,200 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Exercises the service loop statistics. Checks that LatencyHistogram puts
+ * every value in a bucket that reports it to within 1/16, and computes
+ * percentiles from the buckets; that ThreadStatistics counts calls by
+ * return value, times one call per sample period, measures sleeps after
+ * NOOP and restarts on reset; and that snapshots taken while the service
+ * thread is counting are consistent and end with the exact totals.
+ *
+ * usage: thread_statistics_test
+ */
+#include <iostream>
+#include <string>
+
+#include <boost/thread/thread.hpp>
+
+#include <ossie/ThreadStatistics.h>
+#include <ossie/ThreadedComponent.h>
+#include <ossie/testing/check.h>
+
+using ossie::LatencyHistogram;
+using ossie::ThreadStatistics;
+using namespace ossie::testing;
+
+// Calls the service function would make, as ProcessThread::run does
+static void serviceCall( ThreadStatistics &statistics, int state )
+{
+    const uint64_t start = statistics.beginCall();
+    statistics.endCall(start, state);
+}
+
+static int stateFor( uint64_t call )
+{
+    switch (call % 4) {
+    case 0:
+        return NOOP;
+    case 1:
+        return FINISH;
+    default:
+        return NORMAL;
+    }
+}
+
+static volatile int serviceRunning = 0;
+
+static void serviceLoop( ThreadStatistics *statistics, uint64_t calls )
+{
+    for (uint64_t call = 0; call < calls; ++call) {
+        serviceCall(*statistics, stateFor(call));
+    }
+    __sync_lock_test_and_set(&serviceRunning, 0);
+}
+
+int main(int argc, char* argv[])
+{
+    {
+        // Small values get a bucket each; larger ones share buckets that
+        // report them to within 1/16, over the full range
+        bool exact = true;
+        for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; ++value) {
+            exact = exact && (LatencyHistogram::highestEquivalent(LatencyHistogram::bucketFor(value)) == value);
+        }
+        check(exact, "values below 16 recorded exactly");
+
+        bool bounded = true;
+        bool ordered = true;
+        unsigned previous = 0;
+        for (unsigned bit = 4; bit < 64; ++bit) {
+            const uint64_t power = 1ULL << bit;
+            const uint64_t values[] = { power - 1, power, power + 1, power + (power >> 4), power + (power >> 1) };
+            for (size_t index = 0; index < sizeof(values) / sizeof(values[0]); ++index) {
+                const uint64_t value = values[index];
+                const unsigned bucket = LatencyHistogram::bucketFor(value);
+                const uint64_t highest = LatencyHistogram::highestEquivalent(bucket);
+                bounded = bounded && (bucket < LatencyHistogram::BUCKETS) && (highest >= value) && ((highest - value) <= (value >> 4));
+                ordered = ordered && (bucket >= previous);
+                previous = bucket;
+            }
+        }
+        check(bounded, "values reported to within 1/16");
+        check(ordered, "buckets increase with value");
+        check(LatencyHistogram::bucketFor(~0ULL) == LatencyHistogram::BUCKETS - 1, "largest value in last bucket");
+        check(LatencyHistogram::highestEquivalent(LatencyHistogram::BUCKETS - 1) == ~0ULL, "last bucket reaches the largest value");
+        check(LatencyHistogram::bucketFor(16) == 16 && LatencyHistogram::bucketFor(31) == 31 &&
+              LatencyHistogram::bucketFor(32) == 32 && LatencyHistogram::bucketFor(33) == 32,
+              "bucket width doubles at each power of two");
+    }
+
+    {
+        // Percentiles are taken from the bucket counts
+        LatencyHistogram histogram;
+        check(histogram.count() == 0 && histogram.percentile(50.0) == 0 && histogram.max() == 0, "empty histogram");
+        for (uint64_t value = 1; value <= 100; ++value) {
+            histogram.record(value * 1000);
+        }
+        check(histogram.count() == 100, "histogram count");
+        const uint64_t p50 = histogram.percentile(50.0);
+        check(p50 >= 50000 && p50 <= 50000 + (50000 >> 4), "p50 within a bucket of 50000");
+        const uint64_t p99 = histogram.percentile(99.0);
+        check(p99 >= 99000 && p99 <= 99000 + (99000 >> 4), "p99 within a bucket of 99000");
+        check(histogram.percentile(100.0) == histogram.max(), "p100 is max");
+        check(histogram.max() >= 100000 && histogram.max() <= 100000 + (100000 >> 4), "max within a bucket of 100000");
+        check(histogram.percentile(0.0) == LatencyHistogram::highestEquivalent(LatencyHistogram::bucketFor(1000)), "p0 is the smallest bucket");
+
+        LatencyHistogram earlier = histogram.snapshot();
+        check(earlier.count() == 100 && earlier.percentile(50.0) == p50, "snapshot copies the counts");
+        histogram.record(1000000);
+        histogram.subtract(earlier);
+        check(histogram.count() == 1 && histogram.max() >= 1000000, "subtract leaves later values");
+        histogram.clear();
+        check(histogram.count() == 0, "cleared histogram");
+    }
+
+    {
+        // Every call is counted by return value, and one in each sample
+        // period is timed, starting with the first
+        ThreadStatistics statistics(4);
+        for (uint64_t call = 0; call < 100; ++call) {
+            serviceCall(statistics, (call < 90) ? NORMAL : ((call < 99) ? NOOP : FINISH));
+        }
+        ThreadStatistics::Snapshot snapshot = statistics.snapshot();
+        check(snapshot.calls == 100, "calls counted");
+        check(snapshot.normal == 90 && snapshot.noop == 9 && snapshot.finish == 1, "calls counted by return value");
+        check(snapshot.timed == 25 && snapshot.service.count() == 25, "one call in each sample period timed");
+        check(snapshot.elapsedNanoseconds > 0, "elapsed time measured");
+
+        // Resetting starts the counts over
+        statistics.reset();
+        snapshot = statistics.snapshot();
+        check(snapshot.calls == 0 && snapshot.normal == 0 && snapshot.noop == 0 && snapshot.finish == 0 &&
+              snapshot.timed == 0 && snapshot.service.count() == 0 && snapshot.gap.count() == 0,
+              "reset clears the counts");
+
+        // The time from each NOOP to the next call is a sleep, and is always
+        // measured whatever the sample period
+        statistics.setSamplePeriod(1000);
+        check(statistics.getSamplePeriod() == 1000, "sample period changed");
+        for (int call = 0; call < 10; ++call) {
+            serviceCall(statistics, NOOP);
+            boost::this_thread::sleep(boost::posix_time::milliseconds(2));
+        }
+        serviceCall(statistics, NORMAL);
+        snapshot = statistics.snapshot();
+        check(snapshot.calls == 11 && snapshot.noop == 10 && snapshot.normal == 1, "calls counted after reset");
+        check(snapshot.gap.count() >= 10, "gap after every NOOP recorded");
+        check(snapshot.sleepNanoseconds >= 10 * 2000000ULL, "sleep after NOOP measured");
+        check(snapshot.gap.percentile(50.0) >= 2000000ULL, "gap covers the sleep");
+    }
+
+    {
+        // Snapshots taken while the service thread counts are consistent,
+        // and the final one has the exact totals
+        const uint64_t calls = 2000000;
+        ThreadStatistics statistics(ThreadStatistics::DEFAULT_SAMPLE_PERIOD);
+        serviceRunning = 1;
+        boost::thread service(&serviceLoop, &statistics, calls);
+        uint64_t previous = 0;
+        bool consistent = true;
+        bool monotonic = true;
+        size_t snapshots = 0;
+        while (__sync_fetch_and_add(&serviceRunning, 0)) {
+            ThreadStatistics::Snapshot snapshot = statistics.snapshot();
+            consistent = consistent && (snapshot.normal + snapshot.noop + snapshot.finish == snapshot.calls);
+            monotonic = monotonic && (snapshot.calls >= previous);
+            previous = snapshot.calls;
+            statistics.setSamplePeriod((snapshots++ % 2) ? 16 : ThreadStatistics::DEFAULT_SAMPLE_PERIOD);
+        }
+        service.join();
+        check(consistent, "concurrent snapshots consistent");
+        check(monotonic, "concurrent snapshots never go backwards");
+
+        ThreadStatistics::Snapshot snapshot = statistics.snapshot();
+        check(snapshot.calls == calls, "every concurrent call counted");
+        check(snapshot.noop == calls / 4 && snapshot.finish == calls / 4 && snapshot.normal == calls / 2,
+              "concurrent calls counted by return value");
+        check(snapshot.timed == snapshot.service.count() && snapshot.timed > 0, "concurrent timed calls recorded");
+        std::cout << snapshots << " snapshots during " << calls << " calls" << std::endl;
+    }
+
+    return result();
+}
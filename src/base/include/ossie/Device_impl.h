@@ -244,6 +244,7 @@ private:
             device = new T(devMgrIOR, identifier, label, profile);
             PortableServer::ObjectId_var oid = ossie::corba::RootPOA()->activate_object(device);
         }
+        addThreadStatistics(device, boost::is_base_of<ThreadedComponent,T>());
         return device;
     }
     // Generic implementation of start_device, taking a function pointer to
@@ -260,6 +261,13 @@ private:
     // Legacy capacity management
     bool allocateCapacityLegacy (const CF::Properties& capacities);
     void deallocateCapacityLegacy (const CF::Properties& capacities);
+    // Working values of the properties touched by a legacy (de)allocation;
+    // the helpers must be called with propertySetAccess held
+    typedef std::vector<std::pair<PropertyInterface*, CORBA::Any> > LegacyCapacities;
+    CORBA::Any* getLegacyCapacity (LegacyCapacities& capacities, const std::string& id);
+    bool getLegacyValue (LegacyCapacities& capacities, const std::string& id, CORBA::Any& value);
+    bool hasRemainingCapacity (LegacyCapacities& capacities);
+    void commitLegacyCapacities (LegacyCapacities& capacities, const CF::Properties& request);
     // container to the Device Manager
     redhawk::DeviceManagerContainer *_devMgr;
 
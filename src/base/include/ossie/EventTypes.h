@@ -50,6 +50,9 @@ namespace ossie {
     typedef  CF::EventChannelManager::EventChannelReg          EventChannelReg;
     typedef  CF::EventChannelManager::EventChannelReg_var      EventChannelReg_var;
     typedef  CF::EventChannelManager::EventChannelReg*         EventChannelReg_ptr;
+    typedef  CF::EventChannelManager::EventRegistrationList    EventRegistrationList;
+    typedef  CF::EventChannelManager::EventChannelRegList      EventChannelRegList;
+    typedef  CF::EventChannelManager::EventChannelRegList_var  EventChannelRegList_var;
 
   };  // end of event namespace
 
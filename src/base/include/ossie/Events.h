@@ -24,6 +24,7 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/ref.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <deque>
 #include <ossie/RedhawkDefs.h>
 #include <ossie/EventTypes.h>
@@ -61,7 +62,8 @@ typedef   CORBA::Object_ptr             RH_Object;
         message events using 2 methods of acquistion:
           
            Non Callback Queues- Subscribers can use the queueing method to received data from the message queue at their convenience.  The 
-                                getData method returns the oldest message on the event queue.
+                                getData method returns the oldest message on the event queue.  The queue is unbounded unless a
+                                capacity is set with setQueueCapacity.
 
            Callback notification: - Subscribers can use a callback method to imediately receive event messages upon arrival to the underlying
                                     Event Channel.
@@ -423,9 +425,13 @@ namespace events {
     // interface that handle disconnects from channel
     class Receiver;
 
+    // queue and thread that deliver batched events
+    class Batcher;
+
   private:
     friend class Manager;
     friend class Receiver;
+    friend class Batcher;
 
 
   public:    
@@ -433,6 +439,53 @@ namespace events {
     static const int DEFAULT_RETRIES=10;
     static const int DEFAULT_WAIT=10;
 
+    //
+    // Delivery modes for published events. Batching is off unless a
+    // publisher calls setBatching. The events::Subscriber classes in C++,
+    // Python and Java unpack a BATCH_SEQUENCE batch into its events, but
+    // other consumers on the channel, or subscribers from earlier releases,
+    // receive the batch itself.
+    //
+    enum BatchMode {
+      BATCH_NONE,          // each push is sent synchronously (default)
+      BATCH_INDIVIDUAL,    // queued events are sent from a background thread, one push per event
+      BATCH_SEQUENCE       // queued events are sent from a background thread as an ExtendedEvent::EventBatchType
+    };
+
+    //
+    // Batching configuration
+    //
+    // @param mode           delivery mode
+    // @param max_batch      number of queued events that triggers a flush
+    // @param max_queue      maximum number of queued events, 0 is unbounded
+    // @param flush_interval number of millisecs between flushes of a partial batch
+    // @param drop_oldest    when the queue is full, discard the oldest event instead of the new one
+    //
+    struct BatchSettings {
+      BatchSettings();
+
+      BatchMode     mode;
+      size_t        max_batch;
+      size_t        max_queue;
+      int           flush_interval;
+      bool          drop_oldest;
+    };
+
+    //
+    // Batching statistics, accumulated since batching was enabled
+    //
+    struct BatchStatistics {
+      BatchStatistics();
+
+      size_t                queue_depth;
+      size_t                high_water_mark;
+      unsigned long long    queued;
+      unsigned long long    sent;
+      unsigned long long    dropped;
+      unsigned long long    failed;
+      unsigned long long    flushes;
+    };
+
 
     //
     //  Publisher for an Event Channel
@@ -451,47 +504,25 @@ namespace events {
     //
     // Publish a CORBA Any object or a specific object subscribers.... 
     //
+    // When batching is enabled, the event is queued and a return value of 0
+    // only indicates that it was accepted; -1 is returned if it was dropped.
+    //
     template< typename T > 
       int     push( T &msg ) {
-      int retval=0;
-      try {
-        CORBA::Any data;
-        RH_NL_TRACE("Publisher", "Creating event message object for proxy.");
-        data <<= msg;
-        if (!CORBA::is_nil(proxy)) {
-          proxy->push(data);
-          RH_NL_TRACE("Publisher", "Message sent downstream......");
-        }
-        else{
-          retval=-1;
-        }
-      }
-      catch( CORBA::Exception& ex) {
-        retval=-1;
-      }
-
+      RH_NL_TRACE("Publisher", "Creating event message object for proxy.");
+      CORBA::Any data;
+      data <<= msg;
+      int retval = _push(data);
       RH_NL_TRACE("Publisher", "push(msg) retval" << retval );
       return retval;
     }
 
     template< typename T > 
       int     push( T *msg ) {
-      int retval=0;
-      try {
-        CORBA::Any data;
-        RH_NL_TRACE("Publisher", "Creating event message object for proxy.");
-        data <<= msg;
-        if (!CORBA::is_nil(proxy)) {
-          proxy->push(data);
-          RH_NL_TRACE("Publisher", "Message sent downstream......");
-        }
-        else{
-          retval=-1;
-        }
-      }
-      catch( CORBA::Exception& ex) {
-        retval=-1;
-      }
+      RH_NL_TRACE("Publisher", "Creating event message object for proxy.");
+      CORBA::Any data;
+      data <<= msg;
+      int retval = _push(data);
       RH_NL_TRACE("Publisher", "push(*msg) retval" << retval );
       return retval;
     }
@@ -500,6 +531,26 @@ namespace events {
     int     push( const std::string &msg );
     int     push( CORBA::Any &data );
 
+    //
+    // Enable, reconfigure or (with BATCH_NONE) disable batching. Any events
+    // already queued are flushed before the new settings take effect; when
+    // batching is disabled, events pushed from other threads during that
+    // flush are sent directly and may arrive ahead of it.
+    //
+    void    setBatching( const BatchSettings &settings );
+
+    BatchSettings    getBatching();
+
+    //
+    // Send all queued events now, from the calling thread
+    //
+    // @returns  0  all events were sent, or there was nothing to send
+    // @returns  -1 one or more events could not be sent
+    //
+    int     flush();
+
+    BatchStatistics  getBatchStatistics();
+
     //
     // disconnect from the event channnel
     //
@@ -528,9 +579,35 @@ namespace events {
 
   private:
 
+    // send or queue a single event
+    int     _push( const CORBA::Any &data );
+
+    // send a single event to the channel
+    int     _send( const CORBA::Any &data );
+
+    typedef boost::shared_ptr< Batcher >     BatcherPtr;
+
+    // install a new batcher (or none), returning the old one
+    BatcherPtr  _swapBatcher( BatcherPtr batcher );
+
+    // stop a detached batcher and deliver its queue
+    void    _stopBatcher( BatcherPtr batcher );
+
     // handle to object that responds to disconnect messages
     Receiver                                 *_disconnectReceiver;
 
+    // queue for batched events, empty when batching is disabled; held only
+    // to enqueue or to take a reference, never across a push to the channel
+    BatcherPtr                                _batcher;
+
+    Mutex                                     _batchLock;
+
+    // non-zero when _batcher is set, so unbatched pushes skip _batchLock
+    volatile int                              _batching;
+
+    // serializes setBatching and destruction
+    Mutex                                     _settingsLock;
+
   };
 
 
@@ -550,6 +627,28 @@ namespace events {
 
     static const int DEFAULT_RETRIES=10;
     static const int DEFAULT_WAIT=10;
+    // The event queue is unbounded unless a capacity is set
+    static const size_t DEFAULT_QUEUE_CAPACITY=0;
+
+    //
+    // Behavior when an event arrives and the event queue is at capacity
+    //
+    enum OverflowPolicy {
+      DROP_OLDEST,         // discard the oldest queued event to make room (default)
+      DROP_NEWEST          // discard the arriving event
+    };
+
+    //
+    // Event queue statistics
+    //
+    struct QueueStatistics {
+      QueueStatistics();
+
+      size_t                queue_depth;
+      size_t                high_water_mark;
+      unsigned long long    received;
+      unsigned long long    dropped;
+    };
 
     //
     // Interface to handle received messages and disconnects
@@ -627,19 +726,25 @@ namespace events {
     void   setDataArrivedListener( DataArrivedCallbackFn  newListener );
 
 
+    //
+    // Return the oldest message on the event queue. Not available when a
+    // callback has been registered.
+    //
+    // @param timeout number of millisecs to wait for a message to arrive if
+    //                the queue is empty (0 does not wait, -1 waits until a
+    //                message arrives or the subscriber is disconnected)
+    //
+    // @returns  0  a message was returned
+    // @returns  -1 no message was available, or it was not of the requested type
+    //
     template< typename MSG_TYPE>
-      int getData( MSG_TYPE &ret_msg ) {
+      int getData( MSG_TYPE &ret_msg, int timeout=0 ) {
         
       int retval=-1;
       try{
 
-        // check if callback method is enable.. it so then return
-        if ( dataArrivedCB ) return retval;
-
-        // check if data is available
-        if ( events.size() < 1 ) return retval;
-          
-        CORBA::Any  rawdata =  events.front();
+        CORBA::Any  rawdata;
+        if ( !_nextEvent( rawdata, timeout ) ) return retval;
           
         MSG_TYPE tmsg;
         if (rawdata >>= tmsg) { 
@@ -647,8 +752,6 @@ namespace events {
           retval=0;
         }
 
-        events.pop_front();
-
       }
       catch(...) {
       }
@@ -658,8 +761,29 @@ namespace events {
 
     virtual int getData( std::string &ret_msg );
 
+    virtual int getData( std::string &ret_msg, int timeout );
+
     virtual int getData( CORBA::Any &ret );
 
+    virtual int getData( CORBA::Any &ret, int timeout );
+
+    //
+    // Limit the number of messages held on the event queue, which is
+    // unbounded by default
+    //
+    // @param capacity maximum number of queued messages, 0 is unbounded
+    // @param policy   which message to discard when the queue is full
+    //
+    void   setQueueCapacity( size_t capacity, OverflowPolicy policy=DROP_OLDEST );
+
+    size_t getQueueCapacity();
+
+    OverflowPolicy getOverflowPolicy();
+
+    QueueStatistics getQueueStatistics();
+
+    void   resetQueueStatistics();
+
     //
     // disconnect from the event channnel
     //
@@ -739,12 +863,30 @@ namespace events {
     //
     std::deque< CORBA::Any >               events;
 
+    //
+    // Guards the event queue and its statistics; signalled when a message
+    // is queued or the subscriber disconnects
+    //
+    Mutex                                  _eventsLock;
+    boost::condition_variable              _eventsCond;
+
 
   private:
 
 
     void   _init(  ossie::events::EventChannel_ptr     inChannel );
 
+    // add a message to the event queue, applying the overflow policy
+    void   _queueEvent( const CORBA::Any &data );
+
+    // remove the oldest message from the event queue, waiting up to timeout millisecs
+    bool   _nextEvent( CORBA::Any &data, int timeout );
+
+    size_t                                 _capacity;
+    OverflowPolicy                         _overflowPolicy;
+    QueueStatistics                        _stats;
+    bool                                   _waitAbort;
+
 
   }; // end of Subscriber
 
@@ -39,6 +39,12 @@ class ExecutableDevice_impl:
 
 public:
 
+    // How do_execute starts a component process
+    enum LaunchMode {
+        LAUNCH_FORK,    // fork the device, then apply affinity and exec in the child
+        LAUNCH_SPAWN    // posix_spawn, without copying the device's address space
+    };
+
     ExecutableDevice_impl (char*, char*, char*, char*);
     ExecutableDevice_impl (char*, char*, char*, char*, CF::Properties capacities);
     ExecutableDevice_impl (char*, char*, char*, char*, char*);
@@ -88,9 +94,25 @@ protected:
                                           const pid_t rsc_pid,
                                           const char *rsc_name,
                                           const std::vector<int> &bl = std::vector<int>(0) );
+
+    // select the launcher used by do_execute; the initial mode comes from
+    // the REDHAWK_EXECUTE_LAUNCHER environment variable ("fork" or "spawn")
+    void       setLaunchMode( LaunchMode mode );
+    LaunchMode getLaunchMode() const;
+
+    // called in the device after a LAUNCH_SPAWN launch with the new process
+    // id, for setup that cannot be inherited from the launching thread
+    virtual void   spawned_resource( const CF::Properties& options,
+                                     const pid_t rsc_pid,
+                                     const char *rsc_name );
         
 private:
+    // LAUNCH_SPAWN path of do_execute, returns the pid or -1 with errno set
+    pid_t spawn_process( const char* name, const CF::Properties& options,
+                         const std::string& path, std::vector<char*>& argv );
+
     CF::ExecutableDevice::ProcessID_Type PID;
+    LaunchMode launchMode;
 };
 
 #endif
@@ -43,6 +43,10 @@ public:
     // Return the set of ports owned by this instance
     CF::PortSet::PortInfoSequence* getPortSet ();
 
+    // Return the named ports, in order; throws UnknownPort if any is missing
+    CF::PortSet::PortInfoSequence* getPorts (const CF::StringSequence& names)
+        throw (CF::PortSupplier::UnknownPort, CORBA::SystemException);
+
 protected:
     PortSet_impl ();
 };
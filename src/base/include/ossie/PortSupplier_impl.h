@@ -25,6 +25,8 @@
 #include <map>
 #include <string>
 
+#include <boost/thread/mutex.hpp>
+
 #include "CF/cf.h"
 #include "Port_impl.h"
 #include "debug.h"
@@ -74,9 +76,18 @@ protected:
     void deactivateOutPorts();
     void deactivateInPorts();
 
+    // Returns the cached object reference for a port servant
+    CORBA::Object_ptr getPortReference (const std::string& name, PortBase* servant);
+
 private:
     void insertPort (const std::string& name, PortBase* servant);
     void deactivatePort (PortBase* servant);
+
+    // Object references for the port servants, created when the port is
+    // activated (or on first use for ports activated by the subclass)
+    typedef std::map<std::string, std::pair<PortBase*, CORBA::Object_var> > PortObjectMap;
+    PortObjectMap _portObjects;
+    boost::mutex _portObjectsLock;
 };
 
 #endif
@@ -24,6 +24,8 @@
 #include <time.h>
 #include <boost/thread.hpp>
 
+#include "ossie/ThreadStatistics.h"
+
 class ThreadedComponent;
 
 namespace ossie {
@@ -50,11 +52,17 @@ public:
 
     bool threadRunning();
 
+    // Counters and latency histograms for the calls to the target's service
+    // function since the thread was created or the statistics were reset;
+    // they remain valid after the thread is deleted
+    ThreadStatisticsPtr statistics () const;
+
 private:
     boost::thread* _thread;
     volatile bool _running;
     ThreadedComponent* _target;
     struct timespec _delay;
+    ThreadStatisticsPtr _statistics;
 
 public: 
     boost::thread*& _mythread;
@@ -308,6 +308,13 @@ protected:
      * Call the property change callback for the given identifier.
      */
     void executePropertyCallback (const std::string& id);
+
+    /*
+     * Set the value of a single property the way configure() does, including
+     * its change callback and property event. The caller must hold
+     * propertySetAccess; exceptions from setting the value propagate.
+     */
+    void configureProperty (PropertyInterface* property, const CORBA::Any& value);
     
     // This mutex is used to deal with configure/query concurrency
     boost::mutex propertySetAccess;
@@ -24,6 +24,7 @@
 
 #include <string>
 #include <map>
+#include <boost/type_traits/is_base_of.hpp>
 #include "Logging_impl.h"
 #include "Port_impl.h"
 #include "LifeCycle_impl.h"
@@ -37,6 +38,12 @@
 #include "ossie/PropertyMap.h"
 #include "ossie/Autocomplete.h"
 
+class ThreadedComponent;
+
+namespace ossie {
+    struct ThreadStatisticsStruct;
+}
+
 class Resource_impl: 
 #ifdef BEGIN_AUTOCOMPLETE_IGNORE
     public virtual POA_CF::Resource, 
@@ -117,6 +124,30 @@ protected:
     omni_mutex component_running_mutex;
     omni_condition component_running;
 
+    /*
+     * Adds the read-only THREAD_STATISTICS property, which reports on the
+     * service thread of a threaded resource since it was last started, and
+     * the write-only THREAD_STATISTICS_RESET property. Resources that
+     * derive from ThreadedComponent get them when they are created by
+     * start_component() or start_device(); calling it again has no effect.
+     */
+    void addThreadStatisticsProperties (ThreadedComponent* threaded);
+
+    // Adds the thread statistics properties to a newly created resource if
+    // it is a ThreadedComponent (selected by boost::is_base_of)
+    template <class T>
+    static void addThreadStatistics (T* resource, boost::true_type)
+    {
+        // Generated base classes inherit ThreadedComponent as protected; the
+        // C-style cast is the only conversion that ignores access
+        static_cast<Resource_impl*>(resource)->addThreadStatisticsProperties((ThreadedComponent*)resource);
+    }
+
+    template <class T>
+    static void addThreadStatistics (T*, boost::false_type)
+    {
+    }
+
 private:
     Resource_impl(); // No default constructor
     Resource_impl(Resource_impl&);  // No copying
@@ -127,6 +158,7 @@ private:
     static Resource_impl* make_component(T*& component, const std::string& identifier, const std::string& name)
     {
         component = new T(identifier.c_str(), name.c_str());
+        addThreadStatistics(component, boost::is_base_of<ThreadedComponent,T>());
         return component;
     }
 
@@ -137,5 +169,12 @@ private:
     std::string currentWorkingDirectory;
     redhawk::DomainManagerContainer *_domMgr;
     bool _initialized;
+
+    ossie::ThreadStatisticsStruct _queryThreadStatistics ();
+    void _configureThreadStatisticsReset (const bool& reset);
+
+    ThreadedComponent* _statisticsThread;
+    ossie::ThreadStatisticsStruct* _threadStatistics;
+    bool _threadStatisticsReset;
 };
 #endif
@@ -0,0 +1,209 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef OSSIE_THREADSTATISTICS_H
+#define OSSIE_THREADSTATISTICS_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace ossie {
+
+//
+// Histogram of durations in nanoseconds with 16 linear buckets per power of
+// two, in the manner of an HDR histogram: every value is reported to within
+// 1/16 of what was recorded, over the full 64-bit range, in fixed storage.
+//
+class LatencyHistogram
+{
+public:
+    static const unsigned SUB_BUCKET_BITS = 4;
+    static const unsigned SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const unsigned BUCKETS = SUB_BUCKETS * (65 - SUB_BUCKET_BITS);
+
+    LatencyHistogram ();
+
+    // Safe to call while other threads take snapshots
+    void record (uint64_t value)
+    {
+        __sync_fetch_and_add(&_counts[bucketFor(value)], 1);
+    }
+
+    void clear ();
+
+    // Copy of the counts, each read atomically, while another thread may
+    // be recording
+    LatencyHistogram snapshot () const;
+
+    uint64_t count () const;
+
+    // Largest value that is equivalent to the one at the given percentile
+    // (0 to 100); 0 if nothing has been recorded
+    uint64_t percentile (double percent) const;
+
+    uint64_t max () const;
+
+    // Removes the counts of an earlier copy of this histogram
+    void subtract (const LatencyHistogram& earlier);
+
+    static unsigned bucketFor (uint64_t value)
+    {
+        if (value < SUB_BUCKETS) {
+            return value;
+        }
+        const unsigned shift = (63 - __builtin_clzll(value)) - SUB_BUCKET_BITS;
+        return SUB_BUCKETS * (shift + 1) + ((value >> shift) & (SUB_BUCKETS - 1));
+    }
+
+    static uint64_t highestEquivalent (unsigned bucket);
+
+private:
+    uint64_t _counts[BUCKETS];
+};
+
+//
+// Counters and latency histograms for a ProcessThread's service loop.
+//
+// Every call is counted, but only one call in each sample period is timed:
+// an empty service function costs little more than the yield that follows
+// it, and reading the clock around every call would add far more than that.
+// The end of a call that returns NOOP is always read, so every sleep is
+// measured exactly. A sample period of 1 times every call.
+//
+// The service thread is the only writer. It updates the shared counters and
+// histogram buckets with atomic adds, and readers load each one atomically,
+// so no field of a snapshot is torn, though it may be one call behind. An
+// untimed call that returns NORMAL costs one atomic add; the count of NORMAL
+// calls is derived from the others when a snapshot is taken. Resetting
+// stores a baseline that later snapshots subtract, which leaves the writer's
+// fields alone and works whether or not the thread is running.
+//
+class ThreadStatistics
+{
+public:
+    static const unsigned DEFAULT_SAMPLE_PERIOD = 64;
+
+    struct Snapshot {
+        Snapshot ();
+
+        // Time spent in serviceFunction, extrapolated from the timed calls
+        double busyNanoseconds () const;
+
+        // Fraction of the elapsed time spent in serviceFunction
+        double dutyCycle () const;
+
+        // Calls to serviceFunction, by return value, and how many were timed
+        uint64_t calls;
+        uint64_t normal;
+        uint64_t noop;
+        uint64_t finish;
+        uint64_t timed;
+
+        // Time spent in the timed calls, time spent sleeping after NOOP, and
+        // time since the statistics were created or last reset
+        uint64_t timedNanoseconds;
+        uint64_t sleepNanoseconds;
+        uint64_t elapsedNanoseconds;
+
+        // Duration of the timed calls, and time from the end of a timed or
+        // NOOP call to the start of the next one
+        LatencyHistogram service;
+        LatencyHistogram gap;
+    };
+
+    explicit ThreadStatistics (unsigned samplePeriod=DEFAULT_SAMPLE_PERIOD);
+
+    static uint64_t now ()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    }
+
+    // Called by the service thread before each call to serviceFunction;
+    // returns the start time if the clock was read, otherwise 0
+    uint64_t beginCall ()
+    {
+        if (--_countdown == 0) {
+            _countdown = getSamplePeriod();
+            _timing = true;
+            return now();
+        } else if (_lastEnd) {
+            return now();
+        }
+        return 0;
+    }
+
+    // Called by the service thread after each call to serviceFunction, with
+    // the value returned by beginCall
+    void endCall (uint64_t start, int state)
+    {
+        // NOOP is 0 and FINISH is -1, so an untimed call returning a positive
+        // value needs nothing more than counting
+        if (!start && (state > 0)) {
+            __sync_fetch_and_add(&_current.calls, 1);
+            return;
+        }
+        finishCall(start, state);
+    }
+
+    unsigned getSamplePeriod () const
+    {
+        return __sync_fetch_and_add(const_cast<volatile unsigned*>(&_samplePeriod), 0);
+    }
+
+    // Takes effect after the current sample period
+    void setSamplePeriod (unsigned samplePeriod);
+
+    Snapshot snapshot () const;
+
+    void reset ();
+
+private:
+    ThreadStatistics (const ThreadStatistics&);
+    ThreadStatistics& operator= (const ThreadStatistics&);
+
+    // Counts the calls not handled inline, and records their timing
+    void finishCall (uint64_t start, int state);
+
+    // Copy of the live fields, each read atomically
+    Snapshot _load () const;
+
+    // Shared with readers; normal is not kept, only derived
+    Snapshot _current;
+    volatile unsigned _samplePeriod;
+    unsigned _countdown;
+    bool _timing;
+    uint64_t _lastEnd;
+    int _lastState;
+
+    mutable boost::mutex _baselineLock;
+    Snapshot _baseline;
+    uint64_t _baselineTime;
+};
+
+typedef boost::shared_ptr<ThreadStatistics> ThreadStatisticsPtr;
+
+};  // end of ossie namespace
+
+#endif // OSSIE_THREADSTATISTICS_H
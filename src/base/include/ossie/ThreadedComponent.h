@@ -21,6 +21,7 @@
 #ifndef OSSIE_THREADEDCOMPONENT_H
 #define OSSIE_THREADEDCOMPONENT_H
 #include "ossie/ProcessThread.h"
+#include "ossie/PropertyMap.h"
 #include "ossie/Autocomplete.h"
 
 enum {
@@ -29,6 +30,61 @@ enum {
     NORMAL = 1
 };
 
+namespace ossie {
+
+//
+// Value of the THREAD_STATISTICS property; durations are in seconds
+//
+struct ThreadStatisticsStruct {
+    ThreadStatisticsStruct () :
+        calls(0),
+        normal(0),
+        noop(0),
+        finish(0),
+        elapsed(0.0),
+        busy(0.0),
+        sleep(0.0),
+        duty_cycle(0.0),
+        service_p50(0.0),
+        service_p99(0.0),
+        service_p999(0.0),
+        service_max(0.0),
+        gap_p50(0.0),
+        gap_p99(0.0),
+        gap_max(0.0)
+    {
+    }
+
+    explicit ThreadStatisticsStruct (const ThreadStatistics::Snapshot& snapshot);
+
+    static std::string getId() {
+        return std::string("THREAD_STATISTICS");
+    }
+
+    CORBA::ULongLong calls;
+    CORBA::ULongLong normal;
+    CORBA::ULongLong noop;
+    CORBA::ULongLong finish;
+    double elapsed;
+    double busy;
+    double sleep;
+    double duty_cycle;
+    double service_p50;
+    double service_p99;
+    double service_p999;
+    double service_max;
+    double gap_p50;
+    double gap_p99;
+    double gap_max;
+};
+
+bool operator>>= (const CORBA::Any& a, ThreadStatisticsStruct& s);
+void operator<<= (CORBA::Any& a, const ThreadStatisticsStruct& s);
+bool operator== (const ThreadStatisticsStruct& s1, const ThreadStatisticsStruct& s2);
+bool operator!= (const ThreadStatisticsStruct& s1, const ThreadStatisticsStruct& s2);
+
+};  // end of ossie namespace
+
 //
 // Mix-in class for threaded components and devices
 //
@@ -39,6 +95,13 @@ public:
     // Main work function (to be implemented by subclass)
     virtual int serviceFunction () = 0;
 
+    // Returns the statistics of the most recently started service thread;
+    // all zero if it has never been started
+    ossie::ThreadStatistics::Snapshot getThreadStatistics ();
+
+    // Restarts the service thread's statistics
+    void resetThreadStatistics ();
+
 protected:
     ThreadedComponent ();
 
@@ -59,6 +122,8 @@ protected:
 
 private:
     float _defaultDelay;
+    ossie::ThreadStatisticsPtr _serviceStatistics;
+    boost::mutex _threadStatisticsLock;
 };
 
 #endif // OSSIE_THREADEDCOMPONENT_H
@@ -23,6 +23,9 @@
 #include <string>
 #include <vector>
 #include <stdexcept>
+#include <map>
+#include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include "ossie/PropertyMap.h"
 #include "ossie/logging/rh_logger.h"
 
@@ -192,6 +195,94 @@ namespace redhawk
       int set_affinity( const AffinityDirectives &spec, const pid_t pid, const CpuList &blacklist = CpuList(0))
         throw (AffinityFailed);
 
+      /*
+         Topology
+
+         Map of network interface -> interrupt -> cpu -> numa node, built from /proc/interrupts and
+         /sys/devices/system/node.  The map is read once and then reused for every affinity lookup,
+         it is rebuilt when refresh is called or, on the next lookup, after the refresh interval
+         has elapsed.
+
+         The root directory can be changed to read a copy of the proc and sys trees.
+      */
+      class Topology {
+
+      public:
+
+        Topology( const std::string &root="/", const double refresh_interval=DEFAULT_REFRESH_INTERVAL );
+
+        /*
+           Process wide topology used by the affinity methods
+        */
+        static Topology &Instance();
+
+        /*
+           Default refresh interval in seconds
+        */
+        static const double DEFAULT_REFRESH_INTERVAL;
+
+        /*
+           Rebuild the map from the proc and sys trees
+        */
+        void refresh();
+
+        /*
+           Seconds between automatic refreshes, 0 or less disables them
+        */
+        void set_refresh_interval( const double seconds );
+        double get_refresh_interval();
+
+        /*
+           Change the root directory for the proc and sys trees, forces a refresh
+        */
+        void set_root( const std::string &root );
+        std::string get_root();
+
+        /*
+           List of cpus that have serviced interrupts for a network interface, one entry per
+           interrupt and servicing cpu
+        */
+        CpuList get_interface_cpus( const std::string &iface );
+
+        /*
+           Numa node for a cpu, -1 if the cpu is unknown
+        */
+        int get_node_of_cpu( const int cpu );
+
+        /*
+           List of cpus on a numa node
+        */
+        CpuList get_node_cpus( const int node );
+
+      private:
+
+        struct Interrupt {
+          std::string  description;      // controller, type and device names
+          CpuList      cpus;             // cpus with a non-zero count
+        };
+
+        typedef std::vector< Interrupt >          InterruptList;
+        typedef std::map< std::string, CpuList >  InterfaceMap;
+        typedef std::map< int, int >              NodeMap;
+        typedef std::map< int, CpuList >          NodeCpuMap;
+
+        void _check_refresh();
+        void _load();
+        void _load_interrupts();
+        void _load_nodes();
+
+        boost::mutex                _lock;
+        std::string                 _root;
+        double                      _refresh_interval;
+        bool                        _loaded;
+        boost::posix_time::ptime    _load_time;
+        CpuList                     _cpus;           // cpu ids from the /proc/interrupts header
+        InterruptList               _interrupts;
+        InterfaceMap                _interfaces;     // lookup results, cleared on refresh
+        NodeMap                     _cpu_nodes;
+        NodeCpuMap                  _node_cpus;
+      };
+
     };  // affinity namespace
     
 }  // redhawk  Namespace
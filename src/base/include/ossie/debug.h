@@ -70,8 +70,37 @@
     }; \
     rh_logger::LoggerPtr classname::__logger(rh_logger::Logger::getLogger(#classname));
 
+//
+//  Compile time logging floor.  Log statements below RH_LOG_LEVEL_FLOOR are
+//  reduced to a constant false condition, so the compiler removes them
+//  (including their message formatting) entirely.  Release builds, as
+//  indicated by RH_LOG_RELEASE, discard TRACE and DEBUG statements.
+//
+#define RH_LOG_LEVEL_ALL    0
+#define RH_LOG_LEVEL_TRACE  1
+#define RH_LOG_LEVEL_DEBUG  2
+#define RH_LOG_LEVEL_INFO   3
+#define RH_LOG_LEVEL_WARN   4
+#define RH_LOG_LEVEL_ERROR  5
+#define RH_LOG_LEVEL_FATAL  6
+
+#ifndef RH_LOG_LEVEL_FLOOR
+#ifdef RH_LOG_RELEASE
+#define RH_LOG_LEVEL_FLOOR  RH_LOG_LEVEL_INFO
+#else
+#define RH_LOG_LEVEL_FLOOR  RH_LOG_LEVEL_ALL
+#endif
+#endif
+
+#define _RH_LOG_ENABLED_Trace  (RH_LOG_LEVEL_FLOOR <= RH_LOG_LEVEL_TRACE)
+#define _RH_LOG_ENABLED_Debug  (RH_LOG_LEVEL_FLOOR <= RH_LOG_LEVEL_DEBUG)
+#define _RH_LOG_ENABLED_Info   (RH_LOG_LEVEL_FLOOR <= RH_LOG_LEVEL_INFO)
+#define _RH_LOG_ENABLED_Warn   (RH_LOG_LEVEL_FLOOR <= RH_LOG_LEVEL_WARN)
+#define _RH_LOG_ENABLED_Error  (RH_LOG_LEVEL_FLOOR <= RH_LOG_LEVEL_ERROR)
+#define _RH_LOG_ENABLED_Fatal  (RH_LOG_LEVEL_FLOOR <= RH_LOG_LEVEL_FATAL)
+
 #define _RH_LOG( level, logger, msg)	\
-  if ( logger && logger->is##level##Enabled() ) {			\
+  if ( _RH_LOG_ENABLED_##level && logger && logger->is##level##Enabled() ) {	\
     std::ostringstream _msg;						\
     _msg <<  msg;				          		\
     logger->handleLogEvent( rh_logger::Level::get##level(), _msg.str(), rh_logger::spi::LocationInfo(__FILE__,__PRETTY_FUNCTION__,__LINE__) ); \
@@ -100,14 +129,22 @@
 
 
 //
-//  Gen 3 Macros, use named logger to lookup logger instance to use
+//  Gen 3 Macros, use named logger to lookup logger instance to use.  The
+//  logger is cached for each call site, see rh_logger::LoggerHandle
 //
-#define RH_NL_TRACE( loggerName, expression )  _RH_LOG( Trace,  rh_logger::Logger::getLogger(loggerName), expression)
-#define RH_NL_DEBUG( loggerName, expression )  _RH_LOG( Debug,  rh_logger::Logger::getLogger(loggerName), expression)
-#define RH_NL_INFO( loggerName, expression )   _RH_LOG( Info,   rh_logger::Logger::getLogger(loggerName), expression)
-#define RH_NL_WARN( loggerName, expression )   _RH_LOG( Warn,   rh_logger::Logger::getLogger(loggerName), expression)
-#define RH_NL_ERROR( loggerName, expression )  _RH_LOG( Error,  rh_logger::Logger::getLogger(loggerName), expression)
-#define RH_NL_FATAL( loggerName, expression )  _RH_LOG( Fatal,  rh_logger::Logger::getLogger(loggerName), expression)
+#define _RH_NL_LOG( level, loggerName, msg )				\
+  if ( _RH_LOG_ENABLED_##level ) {					\
+    static rh_logger::LoggerHandle _rh_nl_handle;			\
+    rh_logger::LoggerPtr _rh_nl_logger = _rh_nl_handle.get(loggerName);	\
+    _RH_LOG( level, _rh_nl_logger, msg );				\
+  }
+
+#define RH_NL_TRACE( loggerName, expression )  _RH_NL_LOG( Trace,  loggerName, expression)
+#define RH_NL_DEBUG( loggerName, expression )  _RH_NL_LOG( Debug,  loggerName, expression)
+#define RH_NL_INFO( loggerName, expression )   _RH_NL_LOG( Info,   loggerName, expression)
+#define RH_NL_WARN( loggerName, expression )   _RH_NL_LOG( Warn,   loggerName, expression)
+#define RH_NL_ERROR( loggerName, expression )  _RH_NL_LOG( Error,  loggerName, expression)
+#define RH_NL_FATAL( loggerName, expression )  _RH_NL_LOG( Fatal,  loggerName, expression)
 
 
 
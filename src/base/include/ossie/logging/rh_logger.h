@@ -23,6 +23,7 @@
 #include <values.h>
 #include <iostream>
 #include <fstream>
+#include <vector>
 #include <cstdio>
 #include <boost/thread/mutex.hpp>
 #include <boost/shared_ptr.hpp>
@@ -258,6 +259,15 @@ namespace rh_logger {
     static LoggerPtr getResourceLogger( const std::string &name );
     static const std::string &getResourceLoggerName();
 
+    //
+    // Configuration generation, incremented each time the logging
+    // configuration or a logger's level is changed.  Cached logger
+    // references (see LoggerHandle) compare against this value to decide
+    // when they must be resolved again.
+    //
+    static unsigned int getConfigGeneration();
+    static void         invalidateCachedLoggers();
+
     //
     // Set the logging level for this logger
     //
@@ -344,6 +354,49 @@ namespace rh_logger {
   };
 
 
+  /*
+   * LoggerHandle
+   *
+   * Caches the result of Logger::getLogger for a single call site so that
+   * the RH_NL_XXX macros do not resolve the logger name on every log
+   * statement.  The cached logger is resolved again if the name differs
+   * from the previous call, or if the logging configuration has changed
+   * since it was resolved.
+   *
+   * While the name and configuration are unchanged, get() takes no lock:
+   * each lookup is published as an immutable entry, and replaced entries
+   * are freed only once no reader can still hold them.
+   */
+  class LoggerHandle {
+
+  public:
+    LoggerHandle();
+    ~LoggerHandle();
+
+    LoggerPtr get( const char *name );
+    LoggerPtr get( const std::string &name );
+
+  private:
+    struct Entry;
+
+    // Non-copyable
+    LoggerHandle( const LoggerHandle& );
+    LoggerHandle& operator=( const LoggerHandle& );
+
+    // Called with _lock held; key is the caller's pointer for the const
+    // char* overload, otherwise NULL
+    LoggerPtr _resolve( const char *key, const char *name, size_t length );
+
+    // Frees the retired entries, called with _lock held and no readers
+    void _reclaim();
+
+    Mutex                  _lock;
+    Entry * volatile       _current;
+    volatile int           _readers;
+    std::vector< Entry* >  _retired;
+  };
+
+
 };  // end of rh_logger namespace
 
 //
@@ -57,6 +57,17 @@ namespace ossie
 
       int is_jarfile( const std::string &jarPath );
 
+      /*
+         jsonString
+
+         Quotes a string for use in a JSON document, escaping quotes,
+         backslashes and control characters
+
+         @return the quoted string
+      */
+
+      std::string jsonString( const std::string &value );
+
     };
 }  // Close ossieSupport Namespace
 #endif
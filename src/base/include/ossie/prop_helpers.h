@@ -24,6 +24,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 
 #if HAVE_OMNIORB4
 #include <omniORB4/CORBA.h>
@@ -33,26 +34,47 @@
 
 namespace ossie
 {
+    // Comparison from a PRF <action> element; ACTION_NONE covers "external"
+    // and anything unrecognized, and never matches
+    enum Action {
+        ACTION_NONE,
+        ACTION_EQ,
+        ACTION_NE,
+        ACTION_GT,
+        ACTION_LT,
+        ACTION_GE,
+        ACTION_LE
+    };
+
+    Action parseAction(const std::string& action);
+
     template<class T>
-    bool perform_action(T val1, T val2, std::string& action)
+    bool perform_action(const T& val1, const T& val2, Action action)
     {
-        if (action == "eq") {
+        switch (action) {
+        case ACTION_EQ:
             return (val1 == val2);
-        } else if (action == "ne") {
+        case ACTION_NE:
             return (val1 != val2);
-        } else if (action == "gt") {
+        case ACTION_GT:
             return (val1 > val2);
-        } else if (action == "lt") {
+        case ACTION_LT:
             return (val1 < val2);
-        } else if (action == "ge") {
+        case ACTION_GE:
             return (val1 >= val2);
-        } else if (action == "le") {
+        case ACTION_LE:
             return (val1 <= val2);
-        } else {
+        default:
             return false;
         }
     }
 
+    template<class T>
+    bool perform_action(T val1, T val2, std::string& action)
+    {
+        return perform_action(val1, val2, parseAction(action));
+    }
+
     template<class T>
     double perform_math(double operand, T propval, std::string& math)
     {
@@ -72,6 +94,45 @@ namespace ossie
     }
 
     bool compare_anys(const CORBA::Any& a, const CORBA::Any& b, std::string& action);
+    bool compare_anys(const CORBA::Any& a, const CORBA::Any& b, Action action);
+
+    /*
+     * A matching allocation property, compiled once from its value and
+     * action. The value is held in its native type, so evaluating a
+     * dependency only has to extract the dependency's value.
+     */
+    class PropertyMatcher {
+    public:
+        /*
+         * Dependency values converted to the types of the matchers they were
+         * checked against. One instance lives for a single allocation
+         * request, so that a dependency checked against many devices is
+         * converted once per type rather than once per device. Values are
+         * keyed by address, and must outlive the cache.
+         */
+        class Conversions {
+        public:
+            const CORBA::Any& convert(const CORBA::Any& dependency, CORBA::TCKind kind);
+
+        private:
+            typedef std::map<std::pair<const CORBA::Any*, CORBA::TCKind>, CORBA::Any> ConversionMap;
+            ConversionMap conversions_;
+        };
+
+        virtual ~PropertyMatcher() { }
+
+        // Returns true if the compiled value (on the left-hand side) satisfies
+        // the action against the dependency value. A dependency of another
+        // type is converted via its string form first, the same way that
+        // convertAnyToPropertyType does; the conversion is reused from, or
+        // kept in, conversions if one is given.
+        virtual bool match(const CORBA::Any& dependency, Conversions* conversions=0) const = 0;
+
+        // Returns a new matcher, or 0 if the value is not a simple type that
+        // compare_anys supports (e.g., nil or complex).
+        static PropertyMatcher* Compile(const CORBA::Any& value, const std::string& action);
+    };
+
     CORBA::Any calculateDynamicProp(double operand, CORBA::Any& prop, std::string& math, CORBA::TCKind resultKind);
     CORBA::Any string_to_any(std::string value, CORBA::TypeCode_ptr type);
     CORBA::Any stringToSimpleAny(std::string value, CORBA::TCKind kind);
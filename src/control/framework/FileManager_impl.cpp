@@ -28,10 +28,49 @@
 #include "ossie/debug.h"
 #include "ossie/CorbaUtils.h"
 #include "ossie/ossieSupport.h"
+#include "ossie/CorbaIterator.h"
 
+typedef ossie::corba::Iterator<CF::FileSystem::FileInformationType,
+                               CF::FileSystem::FileInformationType_out,
+                               CF::FileSystem::FileInformationSequence,
+                               CF::FileSystem::FileInformationSequence_out,
+                               CF::FileInformationIterator,
+                               POA_CF::FileInformationIterator> FileInformationListIter;
 
 namespace {
 
+    // Number of files to fetch per call when paging through a remote listing
+    const CORBA::ULong LIST_PAGE_SIZE = 1000;
+
+    // Lists a remote file system one page at a time, so that no single reply
+    // has to carry the entire directory; file systems that do not support
+    // listFiles fall back to a single call to list.
+    static CF::FileSystem::FileInformationSequence* listRemote (CF::FileSystem_ptr fileSystem, const char* pattern)
+    {
+        CF::FileSystem::FileInformationSequence_var result;
+        CF::FileInformationIterator_var iter;
+        try {
+            fileSystem->listFiles(pattern, true, LIST_PAGE_SIZE, result, iter);
+        } catch (const CORBA::BAD_OPERATION&) {
+            return fileSystem->list(pattern);
+        } catch (const CORBA::NO_IMPLEMENT&) {
+            return fileSystem->list(pattern);
+        }
+
+        if (!CORBA::is_nil(iter)) {
+            CF::FileSystem::FileInformationSequence_var page;
+            while (iter->next_n(LIST_PAGE_SIZE, page)) {
+                ossie::corba::extend(result, page);
+            }
+            try {
+                iter->destroy();
+            } catch (...) {
+                // The iterator will be reclaimed by the remote side eventually
+            }
+        }
+        return result._retn();
+    }
+
     static std::string normalizeMountPath (const std::string& path)
     {
         // Remove any trailing / in the mount point.
@@ -460,21 +499,9 @@ CF::FileSystem::FileInformationSequence* FileManager_impl::list (const char* pat
         result = FileSystem_impl::list(pattern);
 
         // Check for any mount points that match the pattern.
-        std::string searchPattern = pattern;
-        if (!searchPattern.empty() && (searchPattern[searchPattern.size()-1] == '/')) {
-            searchPattern += "*";
-        }
-
-        for (MountList::iterator ii = mountedFileSystems.begin(); ii != mountedFileSystems.end(); ++ii) {
-            if (fnmatch(searchPattern.c_str(), ii->path.c_str(), 0) == 0) {
-                CORBA::ULong index = result->length();
-                result->length(index+1);
-                result[index].name = CORBA::string_dup(ii->path.substr(1).c_str());
-                result[index].kind = CF::FileSystem::FILE_SYSTEM;
-                result[index].size = 0;
-                result[index].fileProperties.length(0);
-            }
-        }
+        CF::FileSystem::FileInformationSequence mounts;
+        getMatchingMounts(pattern, mounts);
+        ossie::corba::extend(result, mounts);
     } else {
         const std::string searchPath = mount->getRelativePath(pattern);
         if (searchPath.empty()) {
@@ -489,7 +516,7 @@ CF::FileSystem::FileInformationSequence* FileManager_impl::list (const char* pat
         } else {
             // List contents of mount point
             LOG_TRACE(FileManager_impl, "Listing " << searchPath << " on remote file system mounted at " << mount->path);
-            result = mount->fs->list(searchPath.c_str());
+            result = listRemote(mount->fs, searchPath.c_str());
         }
     }
 
@@ -497,6 +524,74 @@ CF::FileSystem::FileInformationSequence* FileManager_impl::list (const char* pat
     return result._retn();
 }
 
+void FileManager_impl::listFiles (const char* pattern, CORBA::Boolean details, CORBA::ULong how_many,
+                                  CF::FileSystem::FileInformationSequence_out files, CF::FileInformationIterator_out iter)
+    throw (CORBA::SystemException, CF::FileException, CF::InvalidFileName)
+{
+    TRACE_ENTER(FileManager_impl);
+
+    LOG_TRACE(FileManager_impl, "List up to " << how_many << " files with pattern " << pattern);
+
+    // Lock the mount table shared to allow others to access the file system,
+    // but prevent changes to the mount table itself.
+    boost::shared_lock<boost::shared_mutex> lock(mountsLock);
+
+    MountList::iterator mount = getMountForPath(pattern);
+    if (mount == mountedFileSystems.end()) {
+        // Any matching mount points are returned after the local files.
+        LOG_TRACE(FileManager_impl, "Listing local file system");
+        CF::FileSystem::FileInformationSequence mounts;
+        getMatchingMounts(pattern, mounts);
+        iter = FileSystem_impl::_listFiles(pattern, details, how_many, files, mounts);
+    } else {
+        const std::string searchPath = mount->getRelativePath(pattern);
+        if (searchPath.empty()) {
+            // Exact match for mount point
+            LOG_TRACE(FileManager_impl, "List mount point " << mount->path);
+            CF::FileSystem::FileInformationSequence_var result = new CF::FileSystem::FileInformationSequence();
+            result->length(1);
+            result[0].name = CORBA::string_dup(mount->path.substr(1).c_str());
+            result[0].kind = CF::FileSystem::FILE_SYSTEM;
+            result[0].size = 0;
+            result[0].fileProperties.length(0);
+            files = result._retn();
+            iter = CF::FileInformationIterator::_nil();
+        } else {
+            // The remote file system's iterator is returned directly to the
+            // caller; if it does not support listFiles, page its full list.
+            LOG_TRACE(FileManager_impl, "Listing " << searchPath << " on remote file system mounted at " << mount->path);
+            try {
+                mount->fs->listFiles(searchPath.c_str(), details, how_many, files, iter);
+            } catch (const CORBA::BAD_OPERATION&) {
+                iter = FileInformationListIter::list(how_many, files, mount->fs->list(searchPath.c_str()));
+            } catch (const CORBA::NO_IMPLEMENT&) {
+                iter = FileInformationListIter::list(how_many, files, mount->fs->list(searchPath.c_str()));
+            }
+        }
+    }
+
+    TRACE_EXIT(FileManager_impl);
+}
+
+void FileManager_impl::getMatchingMounts (const std::string& pattern, CF::FileSystem::FileInformationSequence& mounts)
+{
+    std::string searchPattern = pattern;
+    if (!searchPattern.empty() && (searchPattern[searchPattern.size()-1] == '/')) {
+        searchPattern += "*";
+    }
+
+    for (MountList::iterator ii = mountedFileSystems.begin(); ii != mountedFileSystems.end(); ++ii) {
+        if (fnmatch(searchPattern.c_str(), ii->path.c_str(), 0) == 0) {
+            CORBA::ULong index = mounts.length();
+            mounts.length(index+1);
+            mounts[index].name = CORBA::string_dup(ii->path.substr(1).c_str());
+            mounts[index].kind = CF::FileSystem::FILE_SYSTEM;
+            mounts[index].size = 0;
+            mounts[index].fileProperties.length(0);
+        }
+    }
+}
+
 
 CF::File_ptr FileManager_impl::create (const char* fileName)
     throw (CORBA::SystemException, CF::InvalidFileName, CF::FileException)
@@ -24,13 +24,19 @@
 #include <iostream>
 #include <string>
 
+#include <algorithm>
+#include <vector>
+
 #include <fnmatch.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <boost/filesystem.hpp>
 
 #include "ossie/FileSystem_impl.h"
 #include "ossie/File_impl.h"
 #include "ossie/CorbaUtils.h"
+#include "ossie/CorbaGC.h"
 #include "ossie/ossieSupport.h"
 #include "ossie/prop_helpers.h"
 #include <ossie/PropertyMap.h>
@@ -134,6 +140,19 @@ namespace {
         int retry_delay;
     };
 
+    // Upper bound on the initial allocation for a page of listing results
+    const CORBA::ULong MAX_INITIAL_PAGE = 1024;
+
+    // Matches a file name against a list pattern; hidden files are only
+    // included when they are named explicitly.
+    bool matches_list_pattern (const std::string& searchPattern, const std::string& filename)
+    {
+        if (fnmatch(searchPattern.c_str(), filename.c_str(), 0) != 0) {
+            return false;
+        }
+        return filename.empty() || (filename[0] != '.') || (filename == searchPattern);
+    }
+
 #undef RETRY_START
 #undef RETRY_END
 
@@ -143,6 +162,151 @@ namespace {
 PREPARE_LOGGING(FileSystem_impl)
 
 
+/*
+ * Iterator over a directory listing; entries are read and evaluated only as
+ * they are requested, so that very large directories can be paged through
+ * without building the entire listing up front.
+ */
+class FileInformationIter : public virtual POA_CF::FileInformationIterator
+{
+public:
+    FileInformationIter (FileSystem_impl* fileSystem, const fs::path& dirPath, const std::string& searchPattern,
+                         bool rootEntry, bool details, const CF::FileSystem::FileInformationSequence& trailing) :
+        fileSystem_(fileSystem),
+        searchPattern_(searchPattern),
+        rootEntry_(rootEntry),
+        details_(details),
+        trailing_(trailing),
+        trailingOffset_(0)
+    {
+        // Keep the file system servant alive for as long as the iterator may
+        // still read from it, even if it is deactivated in the meantime
+        fileSystem_->_add_ref();
+        try {
+            current_ = fsops_.begin(dirPath);
+            skipToMatch();
+        } catch (...) {
+            fileSystem_->_remove_ref();
+            throw;
+        }
+    }
+
+    ~FileInformationIter ()
+    {
+        release();
+    }
+
+    CORBA::Boolean next_one (CF::FileSystem::FileInformationType_out file)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        CF::FileSystem::FileInformationSequence files;
+        fetch(1, files);
+        if (files.length() == 0) {
+            file = new CF::FileSystem::FileInformationType();
+            return false;
+        }
+        file = new CF::FileSystem::FileInformationType(files[0]);
+        return true;
+    }
+
+    CORBA::Boolean next_n (CORBA::ULong how_many, CF::FileSystem::FileInformationSequence_out files)
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        CF::FileSystem::FileInformationSequence_var result = new CF::FileSystem::FileInformationSequence;
+        fetch(how_many, result.inout());
+        const bool more = (result->length() > 0);
+        files = result._retn();
+        return more;
+    }
+
+    void destroy ()
+    {
+        // The object stays active until it is garbage collected, but there
+        // is no reason to hold the directory open until then
+        boost::mutex::scoped_lock lock(mutex_);
+        trailingOffset_ = trailing_.length();
+        release();
+    }
+
+    void fetch (CORBA::ULong count, CF::FileSystem::FileInformationSequence& files)
+    {
+        // Size the page up front, growing geometrically if the caller asked
+        // for more than the initial estimate, and trim it at the end
+        CORBA::ULong index = 0;
+        files.length(std::min(count, MAX_INITIAL_PAGE));
+        const fs::directory_iterator end;
+        while ((index < count) && (current_ != end)) {
+            const fs::path path = current_->path();
+            fsops_.increment(current_);
+            skipToMatch();
+
+            if (index == files.length()) {
+                files.length(std::min(count, index * 2));
+            }
+            const std::string name = rootEntry_ ? "/" : BOOST_PATH_STRING(path.filename());
+            if (fileSystem_->_getFileInformation(path, name, details_, files[index])) {
+                ++index;
+            }
+        }
+
+        // Once the directory is exhausted, return any trailing entries
+        while ((index < count) && (trailingOffset_ < trailing_.length())) {
+            if (index == files.length()) {
+                files.length(std::min(count, index * 2));
+            }
+            files[index++] = trailing_[trailingOffset_++];
+        }
+        files.length(index);
+
+        if (current_ == end) {
+            release();
+        }
+    }
+
+    bool exhausted () const
+    {
+        return (current_ == fs::directory_iterator()) && (trailingOffset_ >= trailing_.length());
+    }
+
+private:
+    // Closes the directory and drops the reference to the file system once
+    // no further entries will be read from them
+    void release ()
+    {
+        current_ = fs::directory_iterator();
+        if (fileSystem_) {
+            fileSystem_->_remove_ref();
+            fileSystem_ = 0;
+        }
+    }
+
+    // Advances the directory iterator to the next matching entry, so that
+    // exhaustion is known as soon as the last match has been returned
+    void skipToMatch ()
+    {
+        const fs::directory_iterator end;
+        while (current_ != end) {
+            const std::string filename = BOOST_PATH_STRING(current_->path().filename());
+            if (matches_list_pattern(searchPattern_, filename)) {
+                return;
+            }
+            fsops_.increment(current_);
+        }
+    }
+
+    FileSystem_impl* fileSystem_;
+    UnreliableFS fsops_;
+    fs::directory_iterator current_;
+    const std::string searchPattern_;
+    const bool rootEntry_;
+    const bool details_;
+    const CF::FileSystem::FileInformationSequence trailing_;
+    CORBA::ULong trailingOffset_;
+    boost::mutex mutex_;
+};
+
+
+
 FileSystem_impl::FileSystem_impl (const char* _root):
     root(_root)
 {
@@ -294,12 +458,10 @@ bool FileSystem_impl::_local_exists (const char* fileName)
     return fsops.exists(fname);
 }
 
-CF::FileSystem::FileInformationSequence* FileSystem_impl::list (const char* pattern) throw (CORBA::SystemException, CF::FileException, CF::InvalidFileName)
+void FileSystem_impl::_resolveListPattern (const char* pattern, fs::path& dirPath, std::string& searchPattern)
 {
-    TRACE_ENTER(FileSystem_impl);
-
     fs::path filePath(root / pattern);
-    fs::path dirPath(filePath.parent_path());
+    dirPath = filePath.parent_path();
     UnreliableFS fsops;
 
     // Validate the input pattern and its path.
@@ -311,66 +473,135 @@ CF::FileSystem::FileInformationSequence* FileSystem_impl::list (const char* patt
         throw CF::FileException(CF::CF_ENOTDIR, "Path is not a directory");
     }
 
-    std::string searchPattern = BOOST_PATH_STRING(filePath.filename());
+    searchPattern = BOOST_PATH_STRING(filePath.filename());
     if ((searchPattern == ".") && (fsops.is_directory(filePath))) {
         searchPattern = "*";
     }
     LOG_TRACE(FileSystem_impl, "List using search pattern " << searchPattern << " in " << dirPath);
+}
 
-    CF::FileSystem::FileInformationSequence_var result = new CF::FileSystem::FileInformationSequence;
+bool FileSystem_impl::_getFileInformation (const fs::path& path, const std::string& name, bool details,
+                                           CF::FileSystem::FileInformationType& info)
+{
+    // A single stat() provides the kind, size, permissions and modification
+    // time. It follows symbolic links, so a bad link fails here.
+    const std::string localFilename = path.string();
+    struct stat status;
+    if ((::stat(localFilename.c_str(), &status) != 0) || !(S_ISDIR(status.st_mode) || S_ISREG(status.st_mode))) {
+        LOG_WARN(FileSystem_impl, "File cannot be evaluated, excluding from list: " << BOOST_PATH_STRING(path.filename()));
+        return false;
+    }
+
+    info.name = name.c_str();
+    if (S_ISDIR(status.st_mode)) {
+        info.kind = CF::FileSystem::DIRECTORY;
+        info.size = 0;
+    } else {
+        info.kind = CF::FileSystem::PLAIN;
+        info.size = status.st_size;
+    }
 
+    if (!details) {
+        info.fileProperties.length(0);
+        return true;
+    }
+
+    const CORBA::ULongLong modtime = status.st_mtime;
+    redhawk::PropertyMap& props = redhawk::PropertyMap::cast(info.fileProperties);
+    props[CF::FileSystem::CREATED_TIME_ID] = modtime;
+    props[CF::FileSystem::MODIFIED_TIME_ID] = modtime;
+    props[CF::FileSystem::LAST_ACCESS_TIME_ID] = modtime;
+    // access(2) accounts for read-only mounts and ACLs, which the mode bits
+    // from stat() do not
+    props["READ_ONLY"] = (access(localFilename.c_str(), W_OK) != 0);
+    props["EXECUTABLE"] = (access(localFilename.c_str(), X_OK) == 0);
+    props["IOR_AVAILABLE"] = getFileIOR(localFilename);
+    return true;
+}
+
+CF::FileSystem::FileInformationSequence* FileSystem_impl::list (const char* pattern) throw (CORBA::SystemException, CF::FileException, CF::InvalidFileName)
+{
+    TRACE_ENTER(FileSystem_impl);
+
+    fs::path dirPath;
+    std::string searchPattern;
+    _resolveListPattern(pattern, dirPath, searchPattern);
+    UnreliableFS fsops;
+
+    // Collect the matching entries before evaluating any of them, so that the
+    // result sequence is sized once instead of growing one file at a time
+    std::vector<fs::path> matches;
     const fs::directory_iterator end_itr; // an end iterator (by boost definition)
     for (fs::directory_iterator itr = fsops.begin(dirPath); itr != end_itr; fsops.increment(itr)) {
         const std::string filename = BOOST_PATH_STRING(itr->path().filename());
-        if (fnmatch(searchPattern.c_str(), filename.c_str(), 0) == 0) {
-            if ((filename.length() > 0) && (filename[0] == '.') && (filename != searchPattern)) {
-                LOG_TRACE(FileSystem_impl, "Ignoring hidden match " << filename);
-                continue;
-            }
+        if (matches_list_pattern(searchPattern, filename)) {
             LOG_TRACE(FileSystem_impl, "Match in list with " << filename);
-            CORBA::ULong index = result->length();
-            result->length(index + 1);
-                
-            // We need to specially handle the empty '' pattern
-            if (strlen(pattern) == 0) {
-                result[index].name = CORBA::string_dup("/");
-            } else {
-                result[index].name = CORBA::string_dup(filename.c_str());
-            }
-            if (fsops.is_directory(*itr)) {
-                result[index].kind = CF::FileSystem::DIRECTORY;
-                result[index].size = 0;
-            } else {
-                try {
-                    result[index].kind = CF::FileSystem::PLAIN;
-                    result[index].size = fs::file_size(*itr);
-                } catch ( ... ) {
-                    // this file is not good (i.e.: bad link)
-                    result->length(index);
-                    LOG_WARN(FileSystem_impl, "File cannot be evaluated, excluding from list: " << filename);
-                    continue;
-                }
-            }
+            matches.push_back(itr->path());
+        }
+    }
+
+    // We need to specially handle the empty '' pattern
+    const bool rootEntry = (strlen(pattern) == 0);
 
-            const std::string localFilename = itr->path().string();
-            bool readonly = access(localFilename.c_str(), W_OK);
-            bool executable = !access(localFilename.c_str(), X_OK);
-            CORBA::ULongLong modtime = fs::last_write_time(*itr);
-
-            redhawk::PropertyMap& props = redhawk::PropertyMap::cast(result[index].fileProperties);
-            props[CF::FileSystem::CREATED_TIME_ID] = modtime;
-            props[CF::FileSystem::MODIFIED_TIME_ID] = modtime;
-            props[CF::FileSystem::LAST_ACCESS_TIME_ID] = modtime;
-            props["READ_ONLY"] = readonly;
-            props["EXECUTABLE"] = executable;
-            props["IOR_AVAILABLE"] = getFileIOR(localFilename);
+    CF::FileSystem::FileInformationSequence_var result = new CF::FileSystem::FileInformationSequence;
+    result->length(matches.size());
+    CORBA::ULong index = 0;
+    for (std::vector<fs::path>::const_iterator match = matches.begin(); match != matches.end(); ++match) {
+        const std::string name = rootEntry ? "/" : BOOST_PATH_STRING(match->filename());
+        if (_getFileInformation(*match, name, true, result[index])) {
+            ++index;
         }
     }
+    result->length(index);
 
     TRACE_EXIT(FileSystem_impl);
     return result._retn();
 }
 
+void FileSystem_impl::listFiles (const char* pattern, CORBA::Boolean details, CORBA::ULong how_many,
+                                 CF::FileSystem::FileInformationSequence_out files, CF::FileInformationIterator_out iter)
+    throw (CORBA::SystemException, CF::FileException, CF::InvalidFileName)
+{
+    iter = _listFiles(pattern, details, how_many, files, CF::FileSystem::FileInformationSequence());
+}
+
+CF::FileInformationIterator_ptr FileSystem_impl::_listFiles (const char* pattern, bool details, CORBA::ULong how_many,
+                                                             CF::FileSystem::FileInformationSequence_out files,
+                                                             const CF::FileSystem::FileInformationSequence& trailing)
+{
+    TRACE_ENTER(FileSystem_impl);
+
+    fs::path dirPath;
+    std::string searchPattern;
+    _resolveListPattern(pattern, dirPath, searchPattern);
+
+    FileInformationIter* iter = new FileInformationIter(this, dirPath, searchPattern, (strlen(pattern) == 0), details, trailing);
+
+    // Let the iterator handle fetching the first page
+    CF::FileSystem::FileInformationSequence_var result = new CF::FileSystem::FileInformationSequence;
+    try {
+        iter->fetch(how_many, result.inout());
+    } catch (...) {
+        iter->_remove_ref();
+        throw;
+    }
+    files = result._retn();
+
+    if (iter->exhausted()) {
+        iter->_remove_ref();
+        TRACE_EXIT(FileSystem_impl);
+        return CF::FileInformationIterator::_nil();
+    }
+
+    // Activate the iterator into the garbage-collected POA
+    PortableServer::POA_var poa = ossie::corba::RootPOA()->find_POA("Iterators", 1);
+    CORBA::Object_var obj = ossie::corba::activateGCObject(poa, iter);
+    iter->_remove_ref();
+
+    TRACE_EXIT(FileSystem_impl);
+    return CF::FileInformationIterator::_narrow(obj);
+}
+
 
 CF::File_ptr FileSystem_impl::create (const char* fileName) throw (CORBA::SystemException, CF::InvalidFileName, CF::FileException)
 {
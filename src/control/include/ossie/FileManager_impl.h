@@ -76,6 +76,10 @@ public:
     CF::FileSystem::FileInformationSequence* list (const char* pattern)
         throw (CF::InvalidFileName, CF::FileException, CORBA::SystemException);
 
+    void listFiles (const char* pattern, CORBA::Boolean details, CORBA::ULong how_many,
+                    CF::FileSystem::FileInformationSequence_out files, CF::FileInformationIterator_out iter)
+        throw (CF::InvalidFileName, CF::FileException, CORBA::SystemException);
+
     CF::FileManager::MountSequence* getMounts () throw (CORBA::SystemException);
 
 private:
@@ -98,6 +102,7 @@ private:
     boost::shared_mutex mountsLock;
 
     MountList::iterator getMountForPath (const std::string& path);
+    void getMatchingMounts (const std::string& pattern, CF::FileSystem::FileInformationSequence& mounts);
 
     CORBA::ULongLong getCombinedProperty (const char* propId);
 
@@ -71,6 +71,10 @@ public:
     CF::FileSystem::FileInformationSequence* list (const char* pattern)
         throw (CF::InvalidFileName, CF::FileException, CORBA::SystemException);
 
+    void listFiles (const char* pattern, CORBA::Boolean details, CORBA::ULong how_many,
+                    CF::FileSystem::FileInformationSequence_out files, CF::FileInformationIterator_out iter)
+        throw (CF::InvalidFileName, CF::FileException, CORBA::SystemException);
+
     std::string getLocalPath(const char* fileName);
     
     void closeAllFiles();
@@ -79,17 +83,28 @@ protected:
     CORBA::ULongLong getSize () const;
     CORBA::ULongLong getAvailableSpace () const;
 
+    // Lists the local files matching pattern, followed by the (already
+    // filtered) trailing entries; used by FileManager to add mount points.
+    CF::FileInformationIterator_ptr _listFiles (const char* pattern, bool details, CORBA::ULong how_many,
+                                                CF::FileSystem::FileInformationSequence_out files,
+                                                const CF::FileSystem::FileInformationSequence& trailing);
+
 private:
     FileSystem_impl (const FileSystem_impl& _fsi);
     FileSystem_impl operator= (FileSystem_impl _fsi);
 
     friend class File_impl;
+    friend class FileInformationIter;
 
     typedef std::vector<std::string> IORList;
     typedef std::map<std::string, IORList> IORTable;
 
     bool _local_exists (const char* fileName);
 
+    void _resolveListPattern (const char* pattern, boost::filesystem::path& dirPath, std::string& searchPattern);
+    bool _getFileInformation (const boost::filesystem::path& path, const std::string& name, bool details,
+                              CF::FileSystem::FileInformationType& info);
+
     void removeDirectory(const boost::filesystem::path& dirPath, bool doRemove);
 
     void incrementFileIORCount(std::string &fileName, std::string &fileIOR);
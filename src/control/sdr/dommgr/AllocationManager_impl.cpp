@@ -228,10 +228,13 @@ CF::AllocationManager::AllocationResponseSequence* AllocationManager_impl::alloc
 
 std::pair<ossie::AllocationType*,ossie::DeviceList::iterator> AllocationManager_impl::allocateRequest(const std::string& requestID, const CF::Properties& dependencyProperties, ossie::DeviceList& devices, const std::string& sourceID,  const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps, const std::string& domainName)
 {
+    // Dependencies that need converting to a device property's type are
+    // converted once for the whole request, not once per device
+    ossie::PropertyMatcher::Conversions conversions;
     for (ossie::DeviceList::iterator iter = devices.begin(); iter != devices.end(); ++iter) {
         boost::shared_ptr<ossie::DeviceNode> node = *iter;
         CF::Properties allocatedProperties;
-        if (allocateDevice(dependencyProperties, *node, allocatedProperties, processorDeps, osDeps)) {
+        if (allocateDevice(dependencyProperties, *node, allocatedProperties, processorDeps, osDeps, conversions)) {
             ossie::AllocationType* allocation = new ossie::AllocationType();
             allocation->allocationID = ossie::generateUUID();
             allocation->sourceID = sourceID;
@@ -277,7 +280,7 @@ bool AllocationManager_impl::hasListenerAllocation(const CF::Properties& request
     return false;
 }
 
-bool AllocationManager_impl::allocateDevice(const CF::Properties& requestedProperties, ossie::DeviceNode& node, CF::Properties& allocatedProperties, const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps)
+bool AllocationManager_impl::allocateDevice(const CF::Properties& requestedProperties, ossie::DeviceNode& node, CF::Properties& allocatedProperties, const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps, ossie::PropertyMatcher::Conversions& conversions)
 {
     if (!ossie::corba::objectExists(node.device)) {
         LOG_WARN(AllocationManager_impl, "Not using device for uses_device allocation " << node.identifier << " because it no longer exists");
@@ -297,7 +300,7 @@ bool AllocationManager_impl::allocateDevice(const CF::Properties& requestedPrope
 
     // Determine whether or not the device in question has the required matching properties
     CF::Properties allocProps;
-    if (!checkDeviceMatching(node.prf, allocProps, requestedProperties, processorDeps, osDeps)) {
+    if (!checkDeviceMatching(node.prf, node.matchers, allocProps, requestedProperties, processorDeps, osDeps, conversions)) {
         LOG_TRACE(AllocationManager_impl, "Matching failed");
         return false;
     }
@@ -385,8 +388,17 @@ bool AllocationManager_impl::completeAllocations(CF::Device_ptr device, const st
     return true;
 }
 
-bool AllocationManager_impl::checkMatchingProperty(const ossie::Property* property, const CF::DataType& dependency)
+bool AllocationManager_impl::checkMatchingProperty(const ossie::Property* property, const ossie::PropertyMatcherMap& matchers, const CF::DataType& dependency, ossie::PropertyMatcher::Conversions& conversions)
 {
+    // Use the matcher compiled when the device's profile was parsed; this
+    // covers every matching simple property with a supported value type
+    ossie::PropertyMatcherMap::const_iterator matcher = matchers.find(property->getID());
+    if (matcher != matchers.end()) {
+        LOG_TRACE(AllocationManager_impl, "Matching " << property->getID() << " " << property->getAction()
+                  << " '" << ossie::any_to_string(dependency.value) << "'");
+        return matcher->second->match(dependency.value, &conversions);
+    }
+
     // Only attempt matching for simple properties
     const ossie::SimpleProperty* simpleProp = dynamic_cast<const ossie::SimpleProperty*>(property);
     if (!simpleProp) {
@@ -410,7 +422,7 @@ bool AllocationManager_impl::checkMatchingProperty(const ossie::Property* proper
     return ossie::compare_anys(allocProp.value, depValue, action);
 }
 
-bool AllocationManager_impl::checkDeviceMatching(ossie::Properties& prf, CF::Properties& externalProperties, const CF::Properties& dependencyProperties, const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps)
+bool AllocationManager_impl::checkDeviceMatching(ossie::Properties& prf, const ossie::PropertyMatcherMap& matchers, CF::Properties& externalProperties, const CF::Properties& dependencyProperties, const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps, ossie::PropertyMatcher::Conversions& conversions)
 {
     // Check for a matching processor, which only happens in deployment
     if (!processorDeps.empty()) {
@@ -449,7 +461,7 @@ bool AllocationManager_impl::checkDeviceMatching(ossie::Properties& prf, CF::Pro
             ossie::corba::push_back(externalProperties, ossie::convertDataTypeToPropertyType(dependency, property));
         } else {
             // Evaluate matching properties right now
-            if (!checkMatchingProperty(property, dependency)) {
+            if (!checkMatchingProperty(property, matchers, dependency, conversions)) {
                 return false;
             } else {
                 ++matches;
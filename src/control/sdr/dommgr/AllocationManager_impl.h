@@ -112,11 +112,11 @@ class AllocationManager_impl: public virtual POA_CF::AllocationManager
 
         std::pair<ossie::AllocationType*,ossie::DeviceList::iterator> allocateRequest(const std::string& requestID, const CF::Properties& allocationProperties, ossie::DeviceList& devices, const std::string& sourceID, const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps, const std::string& domainName);
 
-        bool checkDeviceMatching(ossie::Properties& _prf, CF::Properties& externalProps, const CF::Properties& dependencyPropertiesFromComponent, const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps);
+        bool checkDeviceMatching(ossie::Properties& _prf, const ossie::PropertyMatcherMap& matchers, CF::Properties& externalProps, const CF::Properties& dependencyPropertiesFromComponent, const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps, ossie::PropertyMatcher::Conversions& conversions);
 
-        bool checkMatchingProperty(const ossie::Property* property, const CF::DataType& dependency);
+        bool checkMatchingProperty(const ossie::Property* property, const ossie::PropertyMatcherMap& matchers, const CF::DataType& dependency, ossie::PropertyMatcher::Conversions& conversions);
 
-        bool allocateDevice(const CF::Properties& requestedProperties, ossie::DeviceNode& device, CF::Properties& allocatedProperties, const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps);
+        bool allocateDevice(const CF::Properties& requestedProperties, ossie::DeviceNode& device, CF::Properties& allocatedProperties, const std::vector<std::string>& processorDeps, const std::vector<ossie::SPD::NameVersionPair>& osDeps, ossie::PropertyMatcher::Conversions& conversions);
         void partitionProperties(const CF::Properties& properties, std::vector<CF::Properties>& outProps);
 
         bool completeAllocations(CF::Device_ptr device, const std::vector<CF::Properties>& duplicates);
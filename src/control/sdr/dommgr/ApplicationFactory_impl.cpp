@@ -85,6 +85,21 @@ void ScopedAllocations::deallocate()
 }
 
 
+/* Upper bound on the threads making connectPort calls for one application;
+ * connections on the same uses port are always made in order.
+ */
+static const size_t MAX_CONCURRENT_CONNECTS = 8;
+
+/* Records a span for each connectPort call made so far, including any that
+ * failed
+ */
+static void recordConnectCalls(ossie::DeploymentTrace* trace, const ossie::AppConnectionManager::Timing& timing)
+{
+    typedef std::vector<ossie::AppConnectionManager::ConnectCall> CallList;
+    for (CallList::const_iterator call = timing.calls.begin(); call != timing.calls.end(); ++call) {
+        trace->record("connect", call->identifier, call->start, call->seconds, call->failed);
+    }
+}
 
 /* Rotates a device list to put the device with the given identifier first
  */
@@ -649,6 +664,7 @@ void createHelper::_configureComponents()
 
 void createHelper::assignRemainingComponentsToDevices(const std::string &appIdentifier)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "assignRemainingComponentsToDevices");
     PlacementList::iterator componentIter;
     for (componentIter  = _requiredComponents.begin(); 
          componentIter != _requiredComponents.end(); 
@@ -662,6 +678,7 @@ void createHelper::assignRemainingComponentsToDevices(const std::string &appIden
 
 void createHelper::_assignComponentsUsingDAS(const DeviceAssignmentMap& deviceAssignments, const std::string &appIdentifier)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "assignComponentsUsingDAS");
     LOG_TRACE(ApplicationFactory_impl, "Assigning " << deviceAssignments.size() 
               << " component(s) based on DeviceAssignmentSequence");
 
@@ -844,6 +861,7 @@ void createHelper::_consolidateAllocations(const ossie::ImplementationInfo::List
 
 void createHelper::_handleHostCollocation(const std::string &appIdentifier)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "handleHostCollocation");
     const std::vector<SoftwareAssembly::HostCollocation>& hostCollocations =
         _appFact._sadParser.getHostCollocations();
     LOG_TRACE(ApplicationFactory_impl,
@@ -857,6 +875,7 @@ void createHelper::_handleHostCollocation(const std::string &appIdentifier)
 
 void createHelper::_placeHostCollocation(const SoftwareAssembly::HostCollocation& collocation, const std::string &appIdentifier)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "placeHostCollocation", collocation.getID());
     LOG_TRACE(ApplicationFactory_impl,
               "-- Begin placment for Collocation " <<
               collocation.getName() << " " <<
@@ -934,6 +953,12 @@ void createHelper::_placeHostCollocation(const SoftwareAssembly::HostCollocation
                 }
                 (*comp)->setAssignedDevice(node);
                 collocAssignedDevs[i].deviceAssignment.componentId = CORBA::string_dup((*comp)->getIdentifier());
+
+                // Record each component's own share of the consolidated
+                // request, as for a single component deployment
+                CF::Properties componentAllocation;
+                this->_consolidateAllocations(ossie::ImplementationInfo::List(1, *impl), componentAllocation);
+                (*comp)->setAllocationOptions(componentAllocation);
             }
             
             // Move the device to the front of the list
@@ -996,6 +1021,7 @@ void createHelper::_getComponentsToPlace(
 
 void createHelper::_handleUsesDevices(const std::string& appName)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "handleUsesDevices");
     // Gets all uses device info from the SAD file
     const UsesDeviceInfo::List& usesDevices = _appInfo.getUsesDevices();
     LOG_TRACE(ApplicationFactory_impl, "Application has " << usesDevices.size() << " usesdevice dependencies");
@@ -1029,18 +1055,26 @@ void createHelper::_handleUsesDevices(const std::string& appName)
 
 void createHelper::setUpExternalPorts(Application_impl* application)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "setUpExternalPorts");
     const std::vector<SoftwareAssembly::Port>& ports =
         _appInfo.getExternalPorts();
     LOG_TRACE(ApplicationFactory_impl,
               "Mapping " << ports.size() << " external port(s)");
     std::vector<SoftwareAssembly::Port>::const_iterator port;
 
+    // Uses and provides ports are looked up with one getPorts call per
+    // component, after all of the components have been checked
+    std::vector<CORBA::Object_var> objects(ports.size());
+    std::vector<CF::PortSet_var> suppliers(ports.size());
+    std::map<std::string, std::vector<size_t> > portsByComponent;
+
     for (port = ports.begin(); port != ports.end(); ++port) {
         LOG_TRACE(ApplicationFactory_impl,
                   "Port component: " << port->componentrefid
                         << " Port identifier: " << port->identifier);
 
         // Get the component from the instantiation identifier.
+        const size_t index = port - ports.begin();
         CORBA::Object_var obj =
             lookupComponentByInstantiationId(port->componentrefid);
         if (CORBA::is_nil(obj)) {
@@ -1063,37 +1097,54 @@ void createHelper::setUpExternalPorts(Application_impl* application)
                     CF::CF_NOTSET,
                     "Component does not support requested interface"));
             }
+            objects[index] = obj._retn();
         } else {
             // Must be either "usesidentifier" or "providesidentifier",
             // which are equivalent unless you want to be extra
             // pedantic and check how the port is described in the
             // component's SCD.
+            suppliers[index] = CF::PortSet::_unchecked_narrow(obj);
+            portsByComponent[port->componentrefid].push_back(index);
+        }
+    }
 
-            CF::PortSupplier_var portSupplier =
-                ossie::corba::_narrowSafe<CF::PortSupplier> (obj);
-
-            // Try to look up the port.
-            try {
-                obj = portSupplier->getPort(port->identifier.c_str());
-            } CATCH_THROW_LOG_ERROR(
-                ApplicationFactory_impl,
-                "Invalid port id",
-                CF::ApplicationFactory::CreateApplicationError(
-                    CF::CF_NOTSET,
-                    "Invalid port identifier"))
+    // Try to look up the ports.
+    for (std::map<std::string, std::vector<size_t> >::iterator component = portsByComponent.begin();
+         component != portsByComponent.end(); ++component) {
+        const std::vector<size_t>& indices = component->second;
+        CF::StringSequence names;
+        names.length(indices.size());
+        for (size_t ii = 0; ii < indices.size(); ++ii) {
+            names[ii] = ports[indices[ii]].identifier.c_str();
         }
+        try {
+            CF::PortSet::PortInfoSequence_var info = ossie::queryPorts(suppliers[indices.front()], names);
+            for (size_t ii = 0; ii < indices.size(); ++ii) {
+                objects[indices[ii]] = CORBA::Object::_duplicate(info[ii].obj_ptr);
+            }
+        } CATCH_THROW_LOG_ERROR(
+            ApplicationFactory_impl,
+            "Invalid port id",
+            CF::ApplicationFactory::CreateApplicationError(
+                CF::CF_NOTSET,
+                "Invalid port identifier"))
+    }
 
+    for (port = ports.begin(); port != ports.end(); ++port) {
         // Add it to the list of external ports on the application object.
-        if (port->externalname == ""){
-            application->addExternalPort(port->identifier, obj);
+        const size_t index = port - ports.begin();
+        const std::string& name = (port->externalname == "") ? port->identifier : port->externalname;
+        if (CORBA::is_nil(suppliers[index])) {
+            application->addExternalPort(name, objects[index]);
         } else {
-            application->addExternalPort(port->externalname, obj);
+            application->addExternalPort(name, objects[index], port->componentrefid, suppliers[index], port->identifier);
         }
     }
 }
 
 void createHelper::setUpExternalProperties(Application_impl* application)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "setUpExternalProperties");
     const std::vector<SoftwareAssembly::Property>& props = _appInfo.getExternalProperties();
     LOG_TRACE(ApplicationFactory_impl, "Mapping " << props.size() << " external property(ies)");
     for (std::vector<SoftwareAssembly::Property>::const_iterator prop = props.begin(); prop != props.end(); ++prop) {
@@ -1234,6 +1285,7 @@ throw (CORBA::SystemException,
        CF::ApplicationFactory::InvalidInitConfiguration)
 {
     TRACE_ENTER(ApplicationFactory_impl);
+    ossie::DeploymentTrace::Scope span(_trace.get(), "create");
     
     bool aware_application = true;
     
@@ -1386,6 +1438,8 @@ throw (CORBA::SystemException,
                                             aware_application,
                                             _domainContext);
 
+        _application->setDeploymentTrace(_trace);
+
         // Activate the new Application servant
         PortableServer::ObjectId_var oid = Application_impl::Activate(_application);
 
@@ -1589,6 +1643,7 @@ void createHelper::allocateComponent(ossie::ComponentInfo*  component,
                                      DeviceAssignmentList &appAssignedDevs,
                                      const std::string& appIdentifier)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "allocateComponent", component->getIdentifier());
     // get the implementations from the component
     ossie::ImplementationInfo::List  implementations;
     component->getImplementations(implementations);
@@ -1950,6 +2005,9 @@ ossie::AllocationResult createHelper::allocateComponentToDevice( ossie::Componen
     }
     
     ossie::AllocationResult response = this->_allocationMgr->allocateDeployment(requestid, allocationProperties, devices, appIdentifier, implementation->getProcessorDeps(), implementation->getOsDeps());
+    if (!response.first.empty()) {
+        component->setAllocationOptions(allocationProperties);
+    }
     if (allocationProperties.contains("nic_allocation")) {
         if (!response.first.empty()) {
             redhawk::PropertyMap query_props;
@@ -2064,6 +2122,7 @@ void createHelper::getRequiredComponents()
  throw (CF::ApplicationFactory::CreateApplicationError)
 {
     TRACE_ENTER(ApplicationFactory_impl);
+    ossie::DeploymentTrace::Scope span(_trace.get(), "getRequiredComponents");
 
     std::vector<ComponentPlacement> componentsFromSAD = _appFact._sadParser.getAllComponents();
 
@@ -2314,6 +2373,7 @@ void createHelper::loadDependencies(ossie::ComponentInfo& component,
         const std::string fileName = codeLocalFile.string();
         LOG_DEBUG(ApplicationFactory_impl, "Loading dependency local file " << fileName);
         try {
+             ossie::DeploymentTrace::Scope span(_trace.get(), "load", component.getIdentifier());
              device->load(_appFact._fileMgr, fileName.c_str(), codeType);
         } catch (...) {
             LOG_ERROR(ApplicationFactory_impl, "Failure loading file " << fileName);
@@ -2329,6 +2389,7 @@ void createHelper::loadDependencies(ossie::ComponentInfo& component,
  */
 void createHelper::loadAndExecuteComponents(CF::ApplicationRegistrar_ptr _appReg)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "loadAndExecuteComponents");
     LOG_TRACE(ApplicationFactory_impl, "Loading and Executing " << _requiredComponents.size() << " components");
     // apply application affinity options to required components
     applyApplicationAffinityOptions();
@@ -2397,6 +2458,7 @@ void createHelper::loadAndExecuteComponents(CF::ApplicationRegistrar_ptr _appReg
         try {
             try {
                 LOG_TRACE(ApplicationFactory_impl, "loading " << codeLocalFile << " on device " << ossie::corba::returnString(loadabledev->label()));
+                ossie::DeploymentTrace::Scope span(_trace.get(), "load", component->getIdentifier());
                 loadabledev->load(_appFact._fileMgr, codeLocalFile.string().c_str(), implementation->getCodeType());
             } catch( ... ) {
                 load_eout << "'load' failed for component: '";
@@ -2609,6 +2671,7 @@ void createHelper::attemptComponentExecution (
             LOG_TRACE(ApplicationFactory_impl, " RESOURCE OPTION: " << cop[i].id << " " << ossie::any_to_string(cop[i].value))
         }
 
+        ossie::DeploymentTrace::Scope span(_trace.get(), "execute", component->getIdentifier());
         tempPid = execdev->executeLinked(executeName.string().c_str(), cop, component->getPopulatedExecParameters(), dep_seq);
     } catch( CF::InvalidFileName& _ex ) {
         ostringstream eout;
@@ -2730,6 +2793,7 @@ void createHelper::applyApplicationAffinityOptions() {
 
 void createHelper::waitForComponentRegistration()
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "waitForComponentRegistration");
     // Wait for all components to be registered before continuing
     int componentBindingTimeout = _appFact._domainManager->getComponentBindingTimeout();
     LOG_TRACE(ApplicationFactory_impl, "Waiting " << componentBindingTimeout << "s for all components register");
@@ -2770,6 +2834,7 @@ void createHelper::waitForComponentRegistration()
  */
 void createHelper::initializeComponents()
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "initializeComponents");
     // Install the different components in the system
     LOG_TRACE(ApplicationFactory_impl, "initializing " << _requiredComponents.size() << " waveform components")
 
@@ -2838,6 +2903,7 @@ void createHelper::initializeComponents()
           }
           try {
             // Try to set the initial values for the component's properties
+            ossie::DeploymentTrace::Scope span(_trace.get(), "initializeProperties", componentId);
             resource->initializeProperties(component->getNonNilNonExecConstructProperties());
           } catch(CF::PropertySet::InvalidConfiguration& e) {
             ostringstream eout;
@@ -2880,6 +2946,7 @@ void createHelper::initializeComponents()
 
         LOG_TRACE(ApplicationFactory_impl, "Initializing component " << componentId);
         try {
+            ossie::DeploymentTrace::Scope span(_trace.get(), "initialize", componentId);
             resource->initialize();
         } catch (const CF::LifeCycle::InitializeError& error) {
             // Dump the detailed initialization failure to the log
@@ -2923,6 +2990,7 @@ void createHelper::initializeComponents()
 
 void createHelper::configureComponents()
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "configureComponents");
     for (unsigned int rc_idx = 0; rc_idx < _requiredComponents.size (); rc_idx++) {
         ossie::ComponentInfo* component = _requiredComponents[rc_idx];
         
@@ -2969,6 +3037,7 @@ void createHelper::configureComponents()
                 }
                 try {
                     // try to configure the component
+                    ossie::DeploymentTrace::Scope span(_trace.get(), "configure", component->getIdentifier());
                     _rsc->configure (component->getNonNilConfigureProperties());
                 } catch(CF::PropertySet::InvalidConfiguration& e) {
                     ostringstream eout;
@@ -3067,6 +3136,7 @@ void createHelper::configureComponents()
                 }
                 try {
                     // try to configure the component
+                    ossie::DeploymentTrace::Scope span(_trace.get(), "configure", component->getIdentifier());
                     _rsc->configure (component->getNonNilConfigureProperties());
                 } catch(CF::PropertySet::InvalidConfiguration& e) {
                     ostringstream eout;
@@ -3125,6 +3195,7 @@ void createHelper::configureComponents()
  */
 void createHelper::connectComponents(std::vector<ConnectionNode>& connections, string base_naming_context)
 {
+    ossie::DeploymentTrace::Scope span(_trace.get(), "connectComponents");
     const std::vector<Connection>& _connection = _appFact._sadParser.getConnections ();
 
     // Create an AppConnectionManager to resolve and track all connections in the application.
@@ -3133,24 +3204,45 @@ void createHelper::connectComponents(std::vector<ConnectionNode>& connections, s
     using ossie::AppConnectionManager;
     std::auto_ptr<AppConnectionManager> connectionManager(new AppConnectionManager(_appFact._domainManager, this, this, base_naming_context));
 
-    // Create all resource connections
+    // Create all resource connections, in reverse SAD order; if any
+    // connection fails, application creation fails.
     LOG_TRACE(ApplicationFactory_impl, "Establishing " << _connection.size() << " waveform connections")
+    std::vector<const Connection*> ordered;
     for (int c_idx = _connection.size () - 1; c_idx >= 0; c_idx--) {
-        const Connection& connection = _connection[c_idx];
-
-        LOG_TRACE(ApplicationFactory_impl, "Processing connection " << connection.getID());
-
-        // Attempt to resolve the connection; if any connection fails, application creation fails.
-        if (!connectionManager->resolveConnection(connection)) {
-            LOG_ERROR(ApplicationFactory_impl, "Unable to make connection " << connection.getID());
-            ostringstream eout;
-            eout << "Unable to make connection " << connection.getID();
-            eout << " in waveform '"<< _waveformContextName<<"';";
-            eout << " error occurred near line:" <<__LINE__ << " in file:" <<  __FILE__ << ";";
-            throw CF::ApplicationFactory::CreateApplicationError(CF::CF_EIO, eout.str().c_str());
+        ordered.push_back(&_connection[c_idx]);
+    }
+    const AppConnectionManager::Timing& timing = connectionManager->getTiming();
+    std::string failed;
+    std::string reason;
+    try {
+        failed = connectionManager->resolveConnections(ordered, MAX_CONCURRENT_CONNECTS);
+    } catch (const ossie::InvalidConnection& ex) {
+        // A connectPort call failed; report the first one that did
+        for (std::vector<AppConnectionManager::ConnectCall>::const_iterator call = timing.calls.begin(); call != timing.calls.end(); ++call) {
+            if (call->failed) {
+                failed = call->identifier;
+                break;
+            }
         }
+        reason = ex.what();
+    }
+    recordConnectCalls(_trace.get(), timing);
+    if (!failed.empty() || !reason.empty()) {
+        LOG_ERROR(ApplicationFactory_impl, "Unable to make connection " << failed << " " << reason);
+        ostringstream eout;
+        eout << "Unable to make connection " << failed;
+        if (!reason.empty()) {
+            eout << " (" << reason << ")";
+        }
+        eout << " in waveform '"<< _waveformContextName<<"';";
+        eout << " error occurred near line:" <<__LINE__ << " in file:" <<  __FILE__ << ";";
+        throw CF::ApplicationFactory::CreateApplicationError(CF::CF_EIO, eout.str().c_str());
     }
 
+    LOG_DEBUG(ApplicationFactory_impl, "Established " << _connection.size() << " waveform connections: "
+              << timing.resolve * 1e3 << " ms resolving (" << timing.portLookups << " getPort calls, "
+              << timing.portCacheHits << " cached), " << timing.connect * 1e3 << " ms connecting");
+
     // Copy all established connections into the connection array
     const std::vector<ConnectionNode>& establishedConnections = connectionManager->getConnections();
     std::copy(establishedConnections.begin(), establishedConnections.end(), std::back_inserter(connections));
@@ -3167,7 +3259,8 @@ createHelper::createHelper (
     _allocationMgr(_appFact._domainManager->_allocationMgr),
     _allocations(*_allocationMgr),
     _isComplete(false),
-    _application(0)
+    _application(0),
+    _trace(new ossie::DeploymentTrace())
 {
     this->_waveformContextName = waveformContextName;
     this->_baseNamingContext   = baseNamingContext;
@@ -3191,6 +3284,10 @@ createHelper::~createHelper()
 
 void createHelper::_cleanupFailedCreate()
 {
+    // The trace is only reachable through the application, which is about
+    // to go away; log it so that a failed deployment can still be profiled
+    LOG_DEBUG(ApplicationFactory_impl, "Deployment trace for failed create of " << _waveformContextName << ": " << _trace->toJSON());
+
     if (_application) {
         _application->releaseComponents();
         _application->terminateComponents();
@@ -35,6 +35,7 @@
 #include "PersistenceStore.h"
 #include "applicationSupport.h"
 #include "connectionSupport.h"
+#include "DeploymentTrace.h"
 
 class DomainManager_impl;
 class Application_impl;
@@ -207,6 +208,9 @@ private:
 
     ossie::ApplicationInfo _appInfo;
 
+    // Timing of each phase and component call, handed to the application
+    ossie::DeploymentTracePtr _trace;
+
     // createHelper helper methods
     ossie::ComponentInfo* getAssemblyController();
     void overrideExternalProperties(const CF::Properties& initConfiguration);
@@ -18,6 +18,7 @@
  * along with this program.  If not, see http://www.gnu.org/licenses/.
  */
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <sstream>
@@ -25,6 +26,7 @@
 #include <ossie/debug.h>
 #include <ossie/CorbaUtils.h>
 #include <ossie/EventChannelSupport.h>
+#include <ossie/CF/WellKnownProperties.h>
 
 #include "Application_impl.h"
 #include "DomainManager_impl.h"
@@ -111,6 +113,11 @@ namespace {
     {
         convert_sequence_if(out, in.begin(), in.end(), func, pred);
     }
+
+    bool is_deployment_trace(const std::string& propId)
+    {
+        return (propId == ExtendedCF::WKP::DEPLOYMENT_TRACE) || (propId == ExtendedCF::WKP::DEPLOYMENT_TRACE_JSON);
+    }
 }
 
 Application_impl::Application_impl (const std::string& id, const std::string& name, const std::string& profile,
@@ -523,7 +530,10 @@ throw (CF::UnknownProperties, CORBA::SystemException)
             // Gets external ID for property mapping
             const std::string extId(configProperties[i].id);
 
-            if (_properties.count(extId)) {
+            if (is_deployment_trace(extId)) {
+                // Kept by the application itself rather than a component
+                _queryDeploymentTrace(configProperties[i]);
+            } else if (_properties.count(extId)) {
                 // Gets the component and its property id
                 const std::string propId = _properties[extId].first;
                 CF::Resource_ptr comp = _properties[extId].second;
@@ -577,6 +587,12 @@ throw (CF::UnknownProperties, CORBA::SystemException)
         // -Catch any errors
         for (std::map<std::string, std::pair<CF::Resource_ptr, CF::Properties> >::iterator comp = batch.begin();
                 comp != batch.end(); ++comp) {
+            if (comp->second.second.length() == 0) {
+                // Nothing was requested from this component (the assembly
+                // controller is always in the batch); an empty query would
+                // fetch all of its properties only to discard them
+                continue;
+            }
             try {
                 comp->second.first->query(comp->second.second);
             } catch (CF::UnknownProperties e) {
@@ -597,7 +613,9 @@ throw (CF::UnknownProperties, CORBA::SystemException)
             std::string compId;
 
             // Checks if property ID is external or AC property
-            if (_properties.count(extId)) {
+            if (is_deployment_trace(extId)) {
+                continue;
+            } else if (_properties.count(extId)) {
                 propId = _properties[extId].first;
                 compId = ossie::corba::returnString(_properties[extId].second->identifier());
             } else {
@@ -751,7 +769,73 @@ throw (CORBA::SystemException, CF::PortSupplier::UnknownPort)
 
 CF::PortSet::PortInfoSequence* Application_impl::getPortSet ()
 {
+    std::vector<std::string> identifiers;
+    for (std::map<std::string, CORBA::Object_var>::iterator _port_val=_ports.begin(); _port_val!=_ports.end(); _port_val++) {
+        identifiers.push_back(_port_val->first);
+    }
+    CF::PortSet::PortInfoSequence_var retval = new CF::PortSet::PortInfoSequence();
+    describePorts(identifiers, retval.inout());
+    return retval._retn();
+}
+
+CF::PortSet::PortInfoSequence* Application_impl::getPorts (const CF::StringSequence& names)
+throw (CF::PortSupplier::UnknownPort, CORBA::SystemException)
+{
+    std::vector<std::string> identifiers;
+    for (CORBA::ULong index = 0; index < names.length(); ++index) {
+        const std::string identifier(names[index]);
+        if (!_ports.count(identifier)) {
+            LOG_ERROR(Application_impl, "Get ports failed with unknown port " << identifier)
+            throw CF::PortSupplier::UnknownPort();
+        }
+        identifiers.push_back(identifier);
+    }
     CF::PortSet::PortInfoSequence_var retval = new CF::PortSet::PortInfoSequence();
+    describePorts(identifiers, retval.inout());
+    return retval._retn();
+}
+
+void Application_impl::describePorts (const std::vector<std::string>& identifiers, CF::PortSet::PortInfoSequence& info)
+{
+    info.length(identifiers.size());
+    std::vector<bool> found(identifiers.size(), false);
+
+    // Ask each component for all of its external ports at once
+    std::map<std::string, std::vector<size_t> > portsByComponent;
+    for (size_t index = 0; index < identifiers.size(); ++index) {
+        std::map<std::string, PortSource>::const_iterator source = _portSources.find(identifiers[index]);
+        if (source != _portSources.end()) {
+            portsByComponent[source->second.componentId].push_back(index);
+        }
+    }
+    for (std::map<std::string, std::vector<size_t> >::iterator component = portsByComponent.begin();
+         component != portsByComponent.end(); ++component) {
+        const std::vector<size_t>& indices = component->second;
+        CF::StringSequence names;
+        names.length(indices.size());
+        for (size_t ii = 0; ii < indices.size(); ++ii) {
+            names[ii] = _portSources[identifiers[indices[ii]]].portName.c_str();
+        }
+        try {
+            CF::PortSet_ptr supplier = _portSources[identifiers[indices.front()]].supplier;
+            CF::PortSet::PortInfoSequence_var ports = ossie::queryPorts(supplier, names);
+            for (size_t ii = 0; ii < indices.size(); ++ii) {
+                info[indices[ii]] = ports[ii];
+                found[indices[ii]] = true;
+            }
+        } catch ( ... ) {
+            // the component is unreachable; fall through to the search below
+            LOG_TRACE(Application_impl, "Unable to query ports from component " << component->first);
+        }
+    }
+
+    if (std::find(found.begin(), found.end(), false) == found.end()) {
+        return;
+    }
+
+    // Any ports that could not be queried directly (e.g., restored from a
+    // persisted application) are found by searching every component's port
+    // set for an equivalent reference
     std::vector<CF::PortSet::PortInfoSequence_var> comp_portsets;
     for (ossie::ComponentList::iterator _component_iter=this->_components.begin(); _component_iter!=this->_components.end(); _component_iter++) {
         try {
@@ -761,48 +845,33 @@ CF::PortSet::PortInfoSequence* Application_impl::getPortSet ()
             // failed to get the port set from the component
         }
     }
-    for (std::map<std::string, CORBA::Object_var>::iterator _port_val=_ports.begin(); _port_val!=_ports.end(); _port_val++) {
-        for (std::vector<CF::PortSet::PortInfoSequence_var>::iterator comp_portset=comp_portsets.begin(); comp_portset!=comp_portsets.end(); comp_portset++) {
+    for (size_t index = 0; index < identifiers.size(); ++index) {
+        if (found[index]) {
+            continue;
+        }
+        CORBA::Object_ptr port = _ports[identifiers[index]];
+        for (std::vector<CF::PortSet::PortInfoSequence_var>::iterator comp_portset=comp_portsets.begin(); !found[index] && comp_portset!=comp_portsets.end(); comp_portset++) {
             for (unsigned int i=0; i<(*comp_portset)->length(); i++) {
                 try {
-                    if (_port_val->second->_is_equivalent((*comp_portset)[i].obj_ptr)) {
-                        CF::PortSet::PortInfoType info;
-                        info.obj_ptr = (*comp_portset)[i].obj_ptr;
-                        info.name = (*comp_portset)[i].name;
-                        info.repid =(*comp_portset)[i].repid;
-                        info.description = (*comp_portset)[i].description;
-                        info.direction = (*comp_portset)[i].direction;
-                        ossie::corba::push_back(retval, info);
+                    if (port->_is_equivalent((*comp_portset)[i].obj_ptr)) {
+                        info[index] = (*comp_portset)[i];
+                        found[index] = true;
+                        break;
                     }
                 } catch ( ... ) {
                     // unable to add port reference
                 }
             }
         }
-    }
-    if (_ports.size() != retval->length()) {
-        // some of the components are unreachable and the list is incomplete
-        for (std::map<std::string, CORBA::Object_var>::iterator _port_val=_ports.begin(); _port_val!=_ports.end(); _port_val++) {
-            bool foundPort = false;
-            for (unsigned int i=0; i<retval->length(); i++) {
-                std::string retvalPortName(retval[i].name);
-                if (retvalPortName == _port_val->first) {
-                    foundPort = true;
-                    break;
-                }
-            }
-            if (not foundPort) {
-                CF::PortSet::PortInfoType info;
-                info.obj_ptr = CORBA::Object::_nil();
-                info.name = _port_val->first.c_str();
-                info.repid = "";
-                info.description = "";
-                info.direction = "";
-                ossie::corba::push_back(retval, info);
-            }
+        if (!found[index]) {
+            // the component is unreachable and the description is incomplete
+            info[index].obj_ptr = CORBA::Object::_nil();
+            info[index].name = identifiers[index].c_str();
+            info[index].repid = "";
+            info[index].description = "";
+            info[index].direction = "";
         }
     }
-	return retval._retn();
 }
 
 
@@ -1162,6 +1231,16 @@ void Application_impl::addExternalPort (const std::string& identifier, CORBA::Ob
     _ports[identifier] = CORBA::Object::_duplicate(port);
 }
 
+void Application_impl::addExternalPort (const std::string& identifier, CORBA::Object_ptr port, const std::string& componentId, CF::PortSet_ptr supplier, const std::string& portName)
+{
+    addExternalPort(identifier, port);
+
+    PortSource& source = _portSources[identifier];
+    source.componentId = componentId;
+    source.supplier = CF::PortSet::_duplicate(supplier);
+    source.portName = portName;
+}
+
 void Application_impl::addExternalProperty (const std::string& propId, const std::string& externalId, CF::Resource_ptr comp)
 {
     if (_properties.count(externalId)) {
@@ -1208,6 +1287,23 @@ bool Application_impl::waitForComponents (std::set<std::string>& identifiers, in
     return identifiers.empty();
 }
 
+void Application_impl::setDeploymentTrace(const ossie::DeploymentTracePtr& trace)
+{
+    _deploymentTrace = trace;
+}
+
+void Application_impl::_queryDeploymentTrace(CF::DataType& property)
+{
+    // Applications restored from the persistence store have no trace
+    ossie::DeploymentTrace empty(1);
+    const ossie::DeploymentTrace& trace = _deploymentTrace ? *_deploymentTrace : empty;
+    if (std::string(property.id) == ExtendedCF::WKP::DEPLOYMENT_TRACE_JSON) {
+        property.value <<= trace.toJSON().c_str();
+    } else {
+        property.value = trace.toAny();
+    }
+}
+
 CF::Application_ptr Application_impl::getComponentApplication ()
 {
     if (_isAware) {
@@ -34,6 +34,7 @@
 
 #include "applicationSupport.h"
 #include "connectionSupport.h"
+#include "DeploymentTrace.h"
 
 
 class DomainManager_impl;
@@ -102,6 +103,9 @@ public:
         throw (CORBA::SystemException, CF::PortSupplier::UnknownPort);
 
     CF::PortSet::PortInfoSequence* getPortSet ();
+
+    CF::PortSet::PortInfoSequence* getPorts (const CF::StringSequence&)
+        throw (CF::PortSupplier::UnknownPort, CORBA::SystemException);
         
     void runTest (CORBA::ULong, CF::Properties&)
         throw (CORBA::SystemException, CF::UnknownProperties, CF::TestableObject::UnknownTest);
@@ -131,6 +135,7 @@ public:
     CF::ApplicationRegistrar_ptr appReg (void);
 
     void addExternalPort (const std::string&, CORBA::Object_ptr);
+    void addExternalPort (const std::string&, CORBA::Object_ptr, const std::string&, CF::PortSet_ptr, const std::string&);
     void addExternalProperty (const std::string&, const std::string&, CF::Resource_ptr);
 
     // Returns true if any connections in this application depend on the given object, false otherwise
@@ -152,6 +157,10 @@ public:
 
     bool waitForComponents(std::set<std::string>& identifiers, int timeout);
 
+    // Timing of the create() call that built this application, reported
+    // through the DEPLOYMENT_TRACE query properties
+    void setDeploymentTrace(const ossie::DeploymentTracePtr& trace);
+
     CF::Application_ptr getComponentApplication();
     CF::DomainManager_ptr getComponentDomainManager();
     
@@ -199,6 +208,15 @@ private:
     boost::condition_variable _registrationCondition;
 
     std::map<std::string, CORBA::Object_var> _ports;
+
+    // Where each external port came from, so that its description can be
+    // fetched from the owning component with one getPorts call
+    struct PortSource {
+        std::string componentId;
+        CF::PortSet_var supplier;
+        std::string portName;
+    };
+    std::map<std::string, PortSource> _portSources;
     std::map<std::string, std::pair<std::string, CF::Resource_var> > _properties;
 
     bool _releaseAlreadyCalled;
@@ -206,8 +224,15 @@ private:
 
     PropertyChangeRegistry   _propertyChangeRegistrations;
 
+    ossie::DeploymentTracePtr _deploymentTrace;
+
     ossie::ApplicationComponent* findComponent(const std::string& identifier);
 
+    void describePorts(const std::vector<std::string>& identifiers, CF::PortSet::PortInfoSequence& info);
+
+    // Fills in the value of a DEPLOYMENT_TRACE or DEPLOYMENT_TRACE_JSON query
+    void _queryDeploymentTrace(CF::DataType& property);
+
     // Returns externalpropid if one exists based off of compId and
     // internal propId, returns empty string if no external prop exists
     std::string getExternalPropertyId(std::string compId, std::string propId);
@@ -18,35 +18,86 @@
 * along with this program.  If not, see http://www.gnu.org/licenses/.
 */
 
-#include <ossie/CorbaIterator.h>
+#include <algorithm>
+
+#include <ossie/CorbaGC.h>
 
 #include "ConnectionManager.h"
 #include "DomainManager_impl.h"
 #include "Endpoints.h"
 
-typedef ossie::corba::Iterator<CF::ConnectionManager::ConnectionStatusType,
-                               CF::ConnectionManager::ConnectionStatusType_out,
-                               CF::ConnectionManager::ConnectionStatusSequence,
-                               CF::ConnectionManager::ConnectionStatusSequence_out,
-                               CF::ConnectionStatusIterator,
-                               POA_CF::ConnectionStatusIterator> ConnectionStatusIter;
+namespace {
 
-static CF::ConnectionManager::ConnectionStatusSequence* connectionListToSequence(const ossie::ConnectionList& connections)
-{
-    CF::ConnectionManager::ConnectionStatusSequence_var result = new CF::ConnectionManager::ConnectionStatusSequence();
+    typedef ossie::DomainConnectionManager::SnapshotPtr SnapshotPtr;
+    typedef ossie::DomainConnectionManager::ConstConnectionPtr ConstConnectionPtr;
 
-    for (ossie::ConnectionList::const_iterator ii = connections.begin(); ii != connections.end(); ++ii) {
+    CF::ConnectionManager::ConnectionStatusType toConnectionStatus(const ossie::ConnectionNode& connection)
+    {
         CF::ConnectionManager::ConnectionStatusType status;
-        status.usesEndpoint = ii->uses->toEndpointStatusType();
-        status.providesEndpoint = ii->provides->toEndpointStatusType();
-        status.connectionId = CORBA::string_dup(ii->identifier.c_str());
-        status.requesterId = CORBA::string_dup(ii->requesterId.c_str());
-        status.connectionRecordId = CORBA::string_dup(ii->connectionRecordId.c_str());
-        status.connected = ii->connected;
-        ossie::corba::push_back(result, status);
+        status.usesEndpoint = connection.uses->toEndpointStatusType();
+        status.providesEndpoint = connection.provides->toEndpointStatusType();
+        status.connectionId = CORBA::string_dup(connection.identifier.c_str());
+        status.requesterId = CORBA::string_dup(connection.requesterId.c_str());
+        status.connectionRecordId = CORBA::string_dup(connection.connectionRecordId.c_str());
+        status.connected = connection.connected;
+        return status;
+    }
+
+    CF::ConnectionManager::ConnectionStatusSequence* toConnectionStatusSequence(std::vector<ConstConnectionPtr>::const_iterator begin,
+                                                                                std::vector<ConstConnectionPtr>::const_iterator end)
+    {
+        CF::ConnectionManager::ConnectionStatusSequence_var result = new CF::ConnectionManager::ConnectionStatusSequence();
+        result->length(end - begin);
+        for (CORBA::ULong index = 0; begin != end; ++begin, ++index) {
+            result[index] = toConnectionStatus(**begin);
+        }
+        return result._retn();
     }
 
-    return result._retn();
+    // Pages through a snapshot of the connection table, converting each
+    // connection only when it is fetched
+    class ConnectionStatusIter : public virtual POA_CF::ConnectionStatusIterator
+    {
+    public:
+        ConnectionStatusIter(const SnapshotPtr& snapshot, size_t offset) :
+            snapshot_(snapshot),
+            offset_(offset)
+        {
+        }
+
+        CORBA::Boolean next_one(CF::ConnectionManager::ConnectionStatusType_out connection)
+        {
+            if (offset_ >= snapshot_->connections.size()) {
+                connection = new CF::ConnectionManager::ConnectionStatusType();
+                return false;
+            }
+            connection = new CF::ConnectionManager::ConnectionStatusType(toConnectionStatus(*snapshot_->connections[offset_++]));
+            return true;
+        }
+
+        CORBA::Boolean next_n(CORBA::ULong how_many, CF::ConnectionManager::ConnectionStatusSequence_out connections)
+        {
+            const size_t remaining = snapshot_->connections.size() - std::min(offset_, snapshot_->connections.size());
+            if (remaining == 0) {
+                connections = new CF::ConnectionManager::ConnectionStatusSequence();
+                return false;
+            }
+            const size_t count = std::min(static_cast<size_t>(how_many), remaining);
+            std::vector<ConstConnectionPtr>::const_iterator begin = snapshot_->connections.begin() + offset_;
+            connections = toConnectionStatusSequence(begin, begin + count);
+            offset_ += count;
+            return true;
+        }
+
+        void destroy()
+        {
+        }
+
+    private:
+        const SnapshotPtr snapshot_;
+        size_t offset_;
+    };
+
 }
 
 ConnectionManager_impl::ConnectionManager_impl(DomainManager_impl* domainManager) :
@@ -137,18 +188,38 @@ void ConnectionManager_impl::disconnect(const char* connectionRecordId)
 
 CF::ConnectionManager::ConnectionStatusSequence* ConnectionManager_impl::connections()
 {
-    CF::ConnectionManager::ConnectionStatusSequence_var result = new CF::ConnectionManager::ConnectionStatusSequence();
+    // The snapshot is converted without holding the connection table lock
+    const SnapshotPtr snapshot = _domainManager->_connectionManager.getSnapshot();
+    return toConnectionStatusSequence(snapshot->connections.begin(), snapshot->connections.end());
+}
 
-    const ossie::ConnectionTable connection_table = _domainManager->_connectionManager.getConnections();
-    for (ossie::ConnectionTable::const_iterator ii = connection_table.begin(); ii != connection_table.end(); ++ii) {
-        CF::ConnectionManager::ConnectionStatusSequence_var items = connectionListToSequence(ii->second);
-        ossie::corba::extend(result, items);
+void ConnectionManager_impl::listConnections(CORBA::ULong count, CF::ConnectionManager::ConnectionStatusSequence_out conns, CF::ConnectionStatusIterator_out iter)
+{
+    const SnapshotPtr snapshot = _domainManager->_connectionManager.getSnapshot();
+    const size_t first = std::min(static_cast<size_t>(count), snapshot->connections.size());
+    conns = toConnectionStatusSequence(snapshot->connections.begin(), snapshot->connections.begin() + first);
+    if (first == snapshot->connections.size()) {
+        iter = CF::ConnectionStatusIterator::_nil();
+        return;
     }
-    
-    return result._retn();
+
+    // The remainder is converted as the caller pages through it
+    ConnectionStatusIter* servant = new ConnectionStatusIter(snapshot, first);
+    PortableServer::POA_var poa = ossie::corba::RootPOA()->find_POA("Iterators", 1);
+    CORBA::Object_var obj = ossie::corba::activateGCObject(poa, servant, boost::posix_time::seconds(60));
+    servant->_remove_ref();
+    iter = CF::ConnectionStatusIterator::_narrow(obj);
 }
 
-void ConnectionManager_impl::listConnections(CORBA::ULong count, CF::ConnectionManager::ConnectionStatusSequence_out conns, CF::ConnectionStatusIterator_out iter)
+CORBA::Boolean ConnectionManager_impl::connectionChanges(CORBA::ULongLong since, CORBA::ULongLong_out version, CF::ConnectionManager::ConnectionStatusSequence_out added, CF::StringSequence_out removed)
 {
-    iter = ConnectionStatusIter::list(count, conns, connections());
+    const ossie::DomainConnectionManager::Changes changes = _domainManager->_connectionManager.getChanges(since);
+    version = changes.version;
+    added = toConnectionStatusSequence(changes.added.begin(), changes.added.end());
+    removed = new CF::StringSequence();
+    removed->length(changes.removed.size());
+    for (CORBA::ULong index = 0; index < changes.removed.size(); ++index) {
+        (*removed)[index] = changes.removed[index].c_str();
+    }
+    return changes.incremental;
 }
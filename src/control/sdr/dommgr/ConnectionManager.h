@@ -39,6 +39,8 @@ public:
 
     virtual void listConnections(CORBA::ULong count, CF::ConnectionManager::ConnectionStatusSequence_out connections, CF::ConnectionStatusIterator_out iter);
 
+    virtual CORBA::Boolean connectionChanges(CORBA::ULongLong since, CORBA::ULongLong_out version, CF::ConnectionManager::ConnectionStatusSequence_out added, CF::StringSequence_out removed);
+
 private:
     ossie::Endpoint* requestToEndpoint(const CF::ConnectionManager::EndpointRequest& request);
 
@@ -0,0 +1,154 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <algorithm>
+#include <exception>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <ossie/CorbaUtils.h>
+#include <ossie/ossieSupport.h>
+
+#include "DeploymentTrace.h"
+
+using namespace ossie;
+
+namespace {
+
+    boost::posix_time::ptime currentTime()
+    {
+        return boost::posix_time::microsec_clock::universal_time();
+    }
+
+    template <typename T>
+    void addField(CF::Properties& fields, const char* id, T value)
+    {
+        CF::DataType field;
+        field.id = id;
+        field.value <<= value;
+        ossie::corba::push_back(fields, field);
+    }
+
+}
+
+DeploymentTrace::DeploymentTrace(size_t capacity) :
+    _capacity(std::max(capacity, static_cast<size_t>(1))),
+    _next(0),
+    _dropped(0)
+{
+}
+
+void DeploymentTrace::record(const TraceSpan& span)
+{
+    boost::mutex::scoped_lock lock(_lock);
+    if (_spans.size() < _capacity) {
+        _spans.push_back(span);
+    } else {
+        _spans[_next] = span;
+        _next = (_next + 1) % _capacity;
+        ++_dropped;
+    }
+}
+
+void DeploymentTrace::record(const std::string& phase, const std::string& component,
+                             const boost::posix_time::ptime& start, double seconds, bool failed)
+{
+    TraceSpan span;
+    span.phase = phase;
+    span.component = component;
+    span.start = start;
+    span.seconds = seconds;
+    span.failed = failed;
+    record(span);
+}
+
+std::vector<TraceSpan> DeploymentTrace::spans() const
+{
+    boost::mutex::scoped_lock lock(_lock);
+    std::vector<TraceSpan> result(_spans.begin() + _next, _spans.end());
+    result.insert(result.end(), _spans.begin(), _spans.begin() + _next);
+    return result;
+}
+
+size_t DeploymentTrace::dropped() const
+{
+    boost::mutex::scoped_lock lock(_lock);
+    return _dropped;
+}
+
+CORBA::Any DeploymentTrace::toAny() const
+{
+    const std::vector<TraceSpan> current = spans();
+    CORBA::AnySeq structs;
+    structs.length(current.size());
+    for (size_t index = 0; index < current.size(); ++index) {
+        const TraceSpan& span = current[index];
+        CF::Properties fields;
+        addField(fields, "DEPLOYMENT_TRACE::phase", span.phase.c_str());
+        addField(fields, "DEPLOYMENT_TRACE::component", span.component.c_str());
+        addField(fields, "DEPLOYMENT_TRACE::start", boost::posix_time::to_iso_extended_string(span.start).c_str());
+        addField(fields, "DEPLOYMENT_TRACE::seconds", static_cast<CORBA::Double>(span.seconds));
+        addField(fields, "DEPLOYMENT_TRACE::failed", CORBA::Any::from_boolean(span.failed));
+        structs[index] <<= fields;
+    }
+    CORBA::Any value;
+    value <<= structs;
+    return value;
+}
+
+std::string DeploymentTrace::toJSON() const
+{
+    const std::vector<TraceSpan> current = spans();
+    std::ostringstream out;
+    out << "{\"dropped\":" << dropped() << ",\"spans\":[";
+    for (size_t index = 0; index < current.size(); ++index) {
+        const TraceSpan& span = current[index];
+        if (index) {
+            out << ",";
+        }
+        out << "{\"phase\":" << helpers::jsonString(span.phase)
+            << ",\"component\":" << helpers::jsonString(span.component)
+            << ",\"start\":" << helpers::jsonString(boost::posix_time::to_iso_extended_string(span.start))
+            << ",\"seconds\":" << std::fixed << std::setprecision(6) << span.seconds
+            << ",\"failed\":" << (span.failed ? "true" : "false") << "}";
+    }
+    out << "]}";
+    return out.str();
+}
+
+DeploymentTrace::Scope::Scope(DeploymentTrace* trace, const std::string& phase, const std::string& component) :
+    _trace(trace),
+    _phase(phase),
+    _component(component)
+{
+    if (_trace) {
+        _start = currentTime();
+    }
+}
+
+DeploymentTrace::Scope::~Scope()
+{
+    if (_trace) {
+        const double seconds = (currentTime() - _start).total_microseconds() * 1e-6;
+        _trace->record(_phase, _component, _start, seconds, std::uncaught_exception());
+    }
+}
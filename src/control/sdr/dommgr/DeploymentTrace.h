@@ -0,0 +1,98 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef DEPLOYMENTTRACE_H
+#define DEPLOYMENTTRACE_H
+
+#include <string>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <ossie/CF/cf.h>
+
+namespace ossie {
+
+    // Timing of one phase of application creation (component is empty), or
+    // of one remote call made on a component or connection during it
+    struct TraceSpan {
+        std::string phase;
+        std::string component;
+        boost::posix_time::ptime start;
+        double seconds;
+        bool failed;
+    };
+
+    // Spans recorded while creating one application, kept in a bounded ring;
+    // once full, each new span replaces the oldest one.
+    class DeploymentTrace {
+    public:
+        static const size_t DEFAULT_CAPACITY = 4096;
+
+        explicit DeploymentTrace(size_t capacity=DEFAULT_CAPACITY);
+
+        void record(const TraceSpan& span);
+        void record(const std::string& phase, const std::string& component,
+                    const boost::posix_time::ptime& start, double seconds, bool failed);
+
+        // Recorded spans, oldest first
+        std::vector<TraceSpan> spans() const;
+
+        // Number of spans overwritten because the ring was full
+        size_t dropped() const;
+
+        // The spans as a struct sequence property value (a sequence of
+        // CF::Properties, one per span)
+        CORBA::Any toAny() const;
+
+        std::string toJSON() const;
+
+        // Records a span covering its own lifetime. A span that ends because
+        // of an exception is marked as failed. A null trace records nothing.
+        class Scope {
+        public:
+            Scope(DeploymentTrace* trace, const std::string& phase, const std::string& component=std::string());
+            ~Scope();
+
+        private:
+            Scope(const Scope&);
+            Scope& operator=(const Scope&);
+
+            DeploymentTrace* _trace;
+            std::string _phase;
+            std::string _component;
+            boost::posix_time::ptime _start;
+        };
+
+    private:
+        mutable boost::mutex _lock;
+        std::vector<TraceSpan> _spans;
+        size_t _capacity;
+        size_t _next;
+        size_t _dropped;
+    };
+
+    typedef boost::shared_ptr<DeploymentTrace> DeploymentTracePtr;
+
+}
+
+#endif // DEPLOYMENTTRACE_H
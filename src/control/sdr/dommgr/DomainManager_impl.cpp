@@ -2489,4 +2489,21 @@ void DomainManager_impl::parseDeviceProfile (ossie::DeviceNode& node)
     } else {
         LOG_WARN(DomainManager_impl, "Unable to find device " << node.identifier << " in DCD");
     }
+
+    // Compile the matching allocation properties with their final values, so
+    // that allocation does not have to convert them on every request
+    node.matchers.clear();
+    const std::vector<const Property*>& allocProps = node.prf.getAllocationProperties();
+    for (std::vector<const Property*>::const_iterator prop = allocProps.begin(); prop != allocProps.end(); ++prop) {
+        const ossie::SimpleProperty* simple = dynamic_cast<const ossie::SimpleProperty*>(*prop);
+        if (!simple || simple->isExternal()) {
+            continue;
+        }
+        const CF::DataType value = ossie::convertPropertyToDataType(simple);
+        ossie::PropertyMatcher* matcher = ossie::PropertyMatcher::Compile(value.value, simple->getAction());
+        if (matcher) {
+            node.matchers[simple->getID()].reset(matcher);
+        }
+    }
+    LOG_TRACE(DomainManager_impl, "Compiled " << node.matchers.size() << " matching properties for device " << node.identifier);
 }
@@ -50,6 +50,13 @@ namespace ossie {
             return ((type == APPLICATION) && (identifier == identifier_));
         }
 
+        virtual bool getDependency(DependencyType& type, std::string& identifier) const
+        {
+            type = APPLICATION;
+            identifier = identifier_;
+            return true;
+        }
+
         virtual ApplicationEndpoint* clone() const
         {
             return new ApplicationEndpoint(*this);
@@ -96,6 +103,13 @@ namespace ossie {
             return ((type == COMPONENT) && (identifier == identifier_));
         }
 
+        virtual bool getDependency(DependencyType& type, std::string& identifier) const
+        {
+            type = COMPONENT;
+            identifier = identifier_;
+            return true;
+        }
+
         virtual ComponentEndpoint* clone() const
         {
             return new ComponentEndpoint(*this);
@@ -347,6 +361,13 @@ namespace ossie {
             return ((type == Endpoint::SERVICENAME) && (identifier == name_));
         }
 
+        virtual bool getDependency(DependencyType& type, std::string& identifier) const
+        {
+            type = Endpoint::SERVICENAME;
+            identifier = name_;
+            return true;
+        }
+
         virtual FindByDomainFinderEndpoint* clone() const
         {
             return new FindByDomainFinderEndpoint(*this);
@@ -405,6 +426,13 @@ namespace ossie {
             return ((type == Endpoint::SERVICENAME) && (identifier == name_));
         }
 
+        virtual bool getDependency(DependencyType& type, std::string& identifier) const
+        {
+            type = Endpoint::SERVICENAME;
+            identifier = name_;
+            return true;
+        }
+
         virtual ServiceEndpoint* clone() const
         {
             return new ServiceEndpoint(*this);
@@ -583,6 +611,11 @@ namespace ossie {
             return supplier_->checkDependency(type, identifier);
         }
 
+        virtual bool getDependency(DependencyType& type, std::string& identifier) const
+        {
+            return supplier_->getDependency(type, identifier);
+        }
+
         virtual PortEndpoint* clone() const
         {
             return new PortEndpoint(*this);
@@ -595,7 +628,7 @@ namespace ossie {
             CF::PortSupplier_var portSupplier = ossie::corba::_narrowSafe<CF::PortSupplier>(supplierObject);
             if (!CORBA::is_nil(portSupplier)) {
                 try {
-                    return portSupplier->getPort(name_.c_str());
+                    return manager.resolvePort(portSupplier, name_);
                 } catch (const CF::PortSupplier::UnknownPort&) {
                     LOG_ERROR(PortEndpoint, "Port supplier reports no port with name " << name_);
                 } CATCH_LOG_ERROR(PortEndpoint, "Failure in getPort");
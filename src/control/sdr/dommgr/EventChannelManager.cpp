@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <cstddef>
 #include <sstream>
@@ -44,6 +45,12 @@ typedef  ossie::corba::Iterator< CF::EventChannelManager::EventRegistrant,
                                              const bool allow_es ) :
     EventChannelManagerBase(),
     _event_channel_factory(),
+    _factoryThread(0),
+    _factoryThreadRunning(false),
+    _factoryRequested(false),
+    _factoryLookupActive(false),
+    _factoryShutdown(false),
+    _factoryLookups(0),
     _use_naming_service( enableNS ),
     _use_fqn(use_fqn),
     _allow_es_resolve(allow_es),
@@ -68,6 +75,12 @@ typedef  ossie::corba::Iterator< CF::EventChannelManager::EventRegistrant,
     EventChannelManagerBase(),
     _domainManager(domainManager),
     _event_channel_factory(),
+    _factoryThread(0),
+    _factoryThreadRunning(false),
+    _factoryRequested(false),
+    _factoryLookupActive(false),
+    _factoryShutdown(false),
+    _factoryLookups(0),
     _use_naming_service( enableNS ),
     _use_fqn(use_fqn),
     _allow_es_resolve(allow_es),
@@ -93,10 +106,32 @@ EventChannelManager::~EventChannelManager () {
   ECM_TRACE("DTOR", "DTOR ENTER");
   // call terminate to clean up resources
   terminate();
+
+  // stop trying to reconnect to the factory
+  boost::thread* reconnect = 0;
+  {
+    redhawk::ScopedLock lock(_factoryLock);
+    _factoryShutdown = true;
+    _factoryCond.notify_all();
+    reconnect = _factoryThread;
+    _factoryThread = 0;
+  }
+  if ( reconnect ) {
+    reconnect->join();
+    delete reconnect;
+  }
   ECM_TRACE("DTOR", "DTOR EXIT");
 }
 
 
+const std::string& EventChannelManager::ChannelRegistration::ior() {
+  if ( _ior.empty() && !CORBA::is_nil(channel) ) {
+    _ior = ossie::corba::objectToString( channel );
+  }
+  return _ior;
+}
+
+
 void EventChannelManager::_initialize () {
 
 }
@@ -108,31 +143,45 @@ void EventChannelManager::_initialize () {
 void EventChannelManager::terminate ( const bool destroyChannels ) {
 
   ECM_DEBUG("terminate", " Terminate START" );
-  SCOPED_LOCK(_mgrlock);
 
-  ECM_DEBUG("terminate", "Event Channel Registry Size:" << _channels.size() );
-  ChannelRegistrationTable::iterator  iter = _channels.begin();
-  for ( ; iter != _channels.end(); iter++ ) {
-    try {
+  // take the whole table, then destroy the channels without the manager
+  // lock; a channel that is still being created holds its own lock until
+  // its first registrant is added
+  ChannelRegistrationTable channels;
+  {
+    SCOPED_LOCK(_mgrlock);
+    channels.swap(_channels);
+  }
+
+  ECM_DEBUG("terminate", "Event Channel Registry Size:" << channels.size() );
+  ChannelRegistrationTable::iterator  iter = channels.begin();
+  for ( ; iter != channels.end(); iter++ ) {
+    ChannelRegistration& creg = *(iter->second);
+    ossie::events::EventChannel_var channel;
+    {
+      redhawk::ScopedLock channel_lock(creg.lock);
+      creg.removed = true;
       ECM_DEBUG("terminate", "Removing Channel: " << iter->first );
-      ECM_DEBUG("terminate", "    ChannelRecord: name:" << iter->second.channel_name );
-      ECM_DEBUG("terminate", "    ChannelRecord: fqn:" << iter->second.fqn );
-      ECM_DEBUG("terminate", "    ChannelRecord: autoRelease:" << iter->second.autoRelease );
-      ECM_DEBUG("terminate", "    ChannelRecord: release:" << iter->second.release );
-      ECM_DEBUG("terminate", "    ChannelRecord: registrants:" << iter->second.registrants.size());
-      ECM_DEBUG("terminate", "    ChannelRecord: channel:" << iter->second.channel);
-      //if ( CORBA::is_nil(iter->second.channel) == true ) {
-      if ( ossie::corba::objectExists(iter->second.channel) == false ) {
+      ECM_DEBUG("terminate", "    ChannelRecord: name:" << creg.channel_name );
+      ECM_DEBUG("terminate", "    ChannelRecord: fqn:" << creg.fqn );
+      ECM_DEBUG("terminate", "    ChannelRecord: autoRelease:" << creg.autoRelease );
+      ECM_DEBUG("terminate", "    ChannelRecord: release:" << creg.release );
+      ECM_DEBUG("terminate", "    ChannelRecord: registrants:" << creg.registrants.size());
+      ECM_DEBUG("terminate", "    ChannelRecord: channel:" << creg.channel);
+      channel = creg.channel._retn();
+    }
+    try {
+      //if ( CORBA::is_nil(channel) == true ) {
+      if ( ossie::corba::objectExists(channel) == false ) {
 	ECM_DEBUG("terminate", " Channel is NIL : " << iter->first );
       }
       else {
 	ECM_DEBUG("terminate", " Destroy EventChannel PRE: " << iter->first );
         if ( destroyChannels ) {
-          iter->second.channel->destroy();
+          channel->destroy();
         }
 	ECM_DEBUG("terminate", " Destroy EventChannel POST: " << iter->first );
       }
-      iter->second.channel = ossie::events::EventChannel::_nil();
     }
     catch(CORBA::OBJECT_NOT_EXIST){
       ECM_ERROR("Terminate", "Remove Channel FAILED, CHANNEL:" << iter->first << " REASON: Object does not exists");
@@ -142,14 +191,12 @@ void EventChannelManager::terminate ( const bool destroyChannels ) {
     }
   }
 
-  _channels.clear();
   ECM_DEBUG("terminate", " Terminate COMPLETED " );
 
 }
 
 const ossie::events::EventChannel_ptr EventChannelManager::findChannel( const std::string &channel_name )
   {
-    SCOPED_LOCK(_mgrlock);
     ossie::events::EventChannel_ptr ret = ossie::events::EventChannel::_nil();
     
     // get the event channel factory... throws ServiceUnavailable
@@ -158,8 +205,13 @@ const ossie::events::EventChannel_ptr EventChannelManager::findChannel( const st
     //
     // check if a registration record exists for this channel .. 
     //
-    ChannelRegistrationPtr creg = _getChannelRegistration( channel_name );
+    ChannelRegistrationPtr creg;
+    {
+      SCOPED_LOCK(_mgrlock);
+      creg = _getChannelRegistration( channel_name );
+    }
     if ( creg ) {
+      redhawk::ScopedLock channel_lock(creg->lock);
       ret = creg->channel;
     }
 
@@ -189,18 +241,27 @@ const ossie::events::EventChannel_ptr EventChannelManager::findChannel( const st
 	    CF::EventChannelManager::OperationNotAllowed,
 	    CF::EventChannelManager::ServiceUnavailable )
   {
-     SCOPED_LOCK(_mgrlock);
     // get the event channel factory... throws ServiceUnavailable if factory is not resolved
     _getEventChannelFactory();
 
     std::string cname(channel_name);
-    ChannelRegistrationPtr reg = _getChannelRegistration( cname );
+    ChannelRegistrationPtr reg;
+    {
+      SCOPED_LOCK(_mgrlock);
+      reg = _getChannelRegistration( cname );
+    }
 
     // channel registration entry does not exists 
-    if ( reg == NULL ) {
+    if ( !reg ) {
       throw (CF::EventChannelManager::ChannelDoesNotExist());
     }
 
+    // the channel may still be being created; wait for it without holding
+    // up the rest of the manager
+    redhawk::ScopedLock channel_lock(reg->lock);
+    if ( reg->removed ) {
+      throw (CF::EventChannelManager::ChannelDoesNotExist());
+    }
     reg->autoRelease = true;
     ECM_DEBUG( "markForRegistrationr",  " EventChannel: " << cname << " marked for autoRelease" );
   }
@@ -212,7 +273,6 @@ const ossie::events::EventChannel_ptr EventChannelManager::findChannel( const st
 	    CF::EventChannelManager::OperationFailed, 
 	    CF::EventChannelManager::OperationNotAllowed,
 	    CF::EventChannelManager::ServiceUnavailable ) {
-     SCOPED_LOCK(_mgrlock);
     _release(channel_name.c_str() );
   }
 
@@ -223,7 +283,6 @@ const ossie::events::EventChannel_ptr EventChannelManager::findChannel( const st
 	    CF::EventChannelManager::OperationFailed, 
 	    CF::EventChannelManager::OperationNotAllowed,
 	    CF::EventChannelManager::ServiceUnavailable ) {
-    SCOPED_LOCK(_mgrlock);
     _release(channel_name);
   }
 
@@ -243,20 +302,40 @@ const ossie::events::EventChannel_ptr EventChannelManager::findChannel( const st
     std::string cname(channel_name);
 
     ECM_DEBUG( "release", " Check registration for event channel: " << channel_name );    
-    ChannelRegistrationPtr reg = _getChannelRegistration( cname );
+    ChannelRegistrationPtr reg;
+    {
+      SCOPED_LOCK(_mgrlock);
+      reg = _getChannelRegistration( cname );
+    }
 
     // channel registration entry does not exists 
-    if ( reg == NULL ) {
+    if ( !reg ) {
       ECM_DEBUG( "release", " Registration DOES NOT EXISTS event channel: " << channel_name );    
       throw (CF::EventChannelManager::ChannelDoesNotExist());
     }
 
-    // check if anyone is still registered
-    if ( reg->nregistrants() > 0 ) {
+    // check if anyone is still registered; the manager lock is not held, so
+    // a channel that is still being created does not hold up other channels
+    {
+      redhawk::ScopedLock channel_lock(reg->lock);
+      if ( reg->removed ) {
+        ECM_DEBUG( "release", " Registration DOES NOT EXISTS event channel: " << channel_name );    
+        throw (CF::EventChannelManager::ChannelDoesNotExist());
+      }
+      if ( reg->nregistrants() > 0 ) {
+        ECM_DEBUG( "release", " Registrations still exists: " << channel_name );    
+        // mark channel for deletion when registrations are emptied
+        reg->autoRelease = true;
+        reg->release = true;
+        throw (CF::EventChannelManager::RegistrationsExists());
+      }
+    }
+
+    // remove the registration, unless a registrant arrived since the check
+    // above (registerResource does not hold the manager lock)
+    ossie::events::EventChannel_var channel;
+    if ( !_removeChannelRegistration( reg, channel, true ) ) {
       ECM_DEBUG( "release", " Registrations still exists: " << channel_name );    
-      // mark channel for deletion when registrations are emptied
-      reg->autoRelease = true;
-      reg->release = true;
       throw (CF::EventChannelManager::RegistrationsExists());
     }
 
@@ -267,11 +346,10 @@ const ossie::events::EventChannel_ptr EventChannelManager::findChannel( const st
       ECM_DEBUG( "release", " Remove channel from NamingService: " << channel_name );    
       ossie::corba::Unbind( cname, _domain_context );        }
 
-    // destroy the event channel and delete the registration
+    // destroy the event channel
     try {
       ECM_DEBUG( "release", " Delete the registration: " << channel_name );    
-      // delete the registration
-      _deleteChannelRegistration( cname );
+      _destroyChannel( reg->channel_name, reg->fqn, channel );
     } 
     catch(CORBA::SystemException& ex) {
       // this will happen if channel is destroyed but 
@@ -350,12 +428,33 @@ ossie::events::EventChannel_ptr EventChannelManager::create( const std::string &
       throw (CF::EventChannelManager::ChannelAlreadyExists());
     }
 
+    std::string   cname(channel_name);
+    std::string   fqn = _getFQN(cname);
+    ossie::events::EventChannel_var event_channel = _obtainChannel( cname, fqn );
+
+    ECM_TRACE("create", 
+            "ADD Channel Registration, Event Channel: "<< channel_name << " fqn:" << fqn );
+    ChannelRegistrationPtr reg  __attribute__((unused)) = _addChannelRegistration( channel_name, fqn, event_channel, autoRelease ); 
+
+    //
+    // return pointer the channel... we maintain a separate copy
+    //
+    ECM_TRACE("create", "Completed create Event Channel: "<< channel_name );
+    return event_channel._retn();
+  }
+
+
+  ossie::events::EventChannel_ptr EventChannelManager::_obtainChannel( const std::string &channel_name, const std::string &fqn ) 
+    throw ( CF::EventChannelManager::ChannelAlreadyExists, 
+	    CF::EventChannelManager::OperationFailed, 
+	    CF::EventChannelManager::OperationNotAllowed,
+	    CF::EventChannelManager::ServiceUnavailable )
+  {
     //
     // check if channel name is already exists in the event service
     //
     ossie::events::EventChannel_var event_channel = ossie::events::EventChannel::_nil();
-    std::string   cname(channel_name);
-    std::string   fqn = _getFQN(cname);
+    const std::string& cname = channel_name;
     bool          require_ns = false;           // if channel exists and use_nameing_service is enabled
     event_channel = _resolve_es( cname, fqn );
 
@@ -405,14 +504,6 @@ ossie::events::EventChannel_ptr EventChannelManager::create( const std::string &
       throw (CF::EventChannelManager::OperationFailed());      
     }
 
-    ECM_TRACE("create", 
-            "ADD Channel Registration, Event Channel: "<< channel_name << " fqn:" << fqn );
-    ChannelRegistrationPtr reg  __attribute__((unused)) = _addChannelRegistration( channel_name, fqn, event_channel, autoRelease ); 
-
-    //
-    // return pointer the channel... we maintain a separate copy
-    //
-    ECM_TRACE("create", "Completed create Event Channel: "<< channel_name );
     return event_channel._retn();
   }
 
@@ -510,25 +601,12 @@ void EventChannelManager::restore( ossie::events::EventChannel_ptr savedChannel,
   {
 
     ECM_DEBUG("registerResource", "REQUEST REGISTRATION , REG-ID:" << request.reg_id << " CHANNEL:" << request.channel_name );
-    SCOPED_LOCK(_mgrlock);
 
     // get the event channel factory... throws ServiceUnavailable
     _getEventChannelFactory();
 
-    //
-    // check if registration exists
-    //
     std::string regid(request.reg_id.in());
     std::string channel_name(request.channel_name.in());
-    if (regid.empty()) {
-      regid = _generateRegId();
-      while (_regIdExists( channel_name, regid ) == true) {
-        regid = _generateRegId();
-      }
-    }
-    if (  _regIdExists( channel_name, regid ) == true ) {
-      throw ( CF::EventChannelManager::RegistrationAlreadyExists());
-    }
 
     //
     // validate channel name...
@@ -536,37 +614,23 @@ void EventChannelManager::restore( ossie::events::EventChannel_ptr savedChannel,
     if ( _validateChannelName( channel_name ) == false ) {
       throw ( CF::EventChannelManager::InvalidChannelName());
     }
+
     //
-    // check if a registration record exists for this channel .. 
+    // get the registration record for this channel, creating the channel if
+    // needed; only this channel's lock is held from here on
     //
-    ChannelRegistrationPtr creg = _getChannelRegistration( channel_name );
-    if ( creg ) {
-      // channel is marked for deletion..... 
-      if (creg->release ) throw ( CF::EventChannelManager::OperationNotAllowed());    
-    }
-    else {
+    ChannelRegistrationPtr creg = _lockChannelForRegistration( channel_name );
+    redhawk::ScopedLock channel_lock(creg->lock, boost::adopt_lock);
 
-      // need to create a channel....
-      try {
-        ossie::events::EventChannel_var ch  __attribute__((unused)) = _create(channel_name);         // adds to list of channel registrations automatically
-      }
-      catch( CF::EventChannelManager::ChannelAlreadyExists ){
-        ECM_ERROR("registerResource", "REGISTRATION ERROR, REG-ID:" << regid << " CHANNEL:" << channel_name  << " Channel exists in EventService" );
-        throw (CF::EventChannelManager::OperationFailed());    
-      }
-      creg = _getChannelRegistration( channel_name );
-      if ( creg == NULL ) throw ( CF::EventChannelManager::OperationFailed());    
-    }
+    // throws RegistrationAlreadyExists or OperationNotAllowed
+    _addRegistrant( *creg, regid );
 
     ossie::events::EventChannelReg_ptr reg = new ossie::events::EventChannelReg();
     reg->reg.channel_name = CORBA::string_dup(channel_name.c_str());
     reg->reg.reg_id = CORBA::string_dup(regid.c_str());
     reg->channel = ossie::events::EventChannel::_duplicate(creg->channel);
 
-    std::string ior = ossie::corba::objectToString( reg->channel );
-    ECM_DEBUG("register", "NEW REGISTRATION FOR:" << ior );
-    creg->registrants.insert( RegRecord( regid, ior ) );
-
+    ECM_DEBUG("register", "NEW REGISTRATION FOR:" << creg->ior() );
     ECM_DEBUG("registerResource", "NEW REGISTRATION REG-ID:" << regid << " CHANNEL:" << channel_name );
 
     //
@@ -576,6 +640,82 @@ void EventChannelManager::restore( ossie::events::EventChannel_ptr savedChannel,
   }
 
 
+  ossie::events::EventChannelRegList* EventChannelManager::registerResources( const ossie::events::EventRegistrationList &requests )
+    throw ( CF::EventChannelManager::InvalidChannelName, 
+	    CF::EventChannelManager::RegistrationAlreadyExists,
+	    CF::EventChannelManager::OperationFailed, 
+	    CF::EventChannelManager::OperationNotAllowed,
+	    CF::EventChannelManager::ServiceUnavailable )
+  {
+    ECM_DEBUG("registerResources", "REQUEST REGISTRATIONS, COUNT:" << requests.length() );
+
+    // get the event channel factory... throws ServiceUnavailable
+    _getEventChannelFactory();
+
+    //
+    // validate all of the channel names before registering anything, and
+    // group the requests by channel
+    //
+    typedef std::map< std::string, std::vector<CORBA::ULong> > RequestMap;
+    RequestMap channel_requests;
+    for ( CORBA::ULong index = 0; index < requests.length(); ++index ) {
+      std::string channel_name(requests[index].channel_name.in());
+      if ( _validateChannelName( channel_name ) == false ) {
+        throw ( CF::EventChannelManager::InvalidChannelName());
+      }
+      channel_requests[channel_name].push_back(index);
+    }
+
+    ossie::events::EventChannelRegList_var regs = new ossie::events::EventChannelRegList();
+    regs->length(requests.length());
+
+    RequestMap::iterator iter = channel_requests.begin();
+    try {
+      for ( ; iter != channel_requests.end(); ++iter ) {
+        ChannelRegistrationPtr creg = _lockChannelForRegistration( iter->first );
+        redhawk::ScopedLock channel_lock(creg->lock, boost::adopt_lock);
+
+        std::vector<CORBA::ULong>::iterator index = iter->second.begin();
+        try {
+          for ( ; index != iter->second.end(); ++index ) {
+            std::string regid(requests[*index].reg_id.in());
+            _addRegistrant( *creg, regid );
+            regs[*index].reg.channel_name = CORBA::string_dup(iter->first.c_str());
+            regs[*index].reg.reg_id = CORBA::string_dup(regid.c_str());
+            regs[*index].channel = ossie::events::EventChannel::_duplicate(creg->channel);
+          }
+        }
+        catch ( ... ) {
+          // back out this channel's registrations while its lock is held
+          while ( index != iter->second.begin() ) {
+            --index;
+            creg->registrants.erase( std::string(regs[*index].reg.reg_id) );
+          }
+          throw;
+        }
+        ECM_DEBUG("registerResources", "NEW REGISTRATIONS FOR CHANNEL:" << iter->first << " COUNT:" << iter->second.size() );
+      }
+    }
+    catch ( ... ) {
+      // back out the channels that were completed
+      while ( iter != channel_requests.begin() ) {
+        --iter;
+        for ( std::vector<CORBA::ULong>::iterator index = iter->second.begin(); index != iter->second.end(); ++index ) {
+          try {
+            _unregister( regs[*index].reg );
+          }
+          catch ( ... ) {
+            ECM_WARN("registerResources", "Unable to back out registration REG-ID:" << regs[*index].reg.reg_id << " CHANNEL:" << iter->first );
+          }
+        }
+      }
+      throw;
+    }
+
+    return regs._retn();
+  }
+
+
 
 
   /*
@@ -586,8 +726,6 @@ void EventChannelManager::restore( ossie::events::EventChannel_ptr savedChannel,
 	    CF::EventChannelManager::RegistrationDoesNotExist,
 	    CF::EventChannelManager::ServiceUnavailable ) 
   {
-    SCOPED_LOCK(_mgrlock);
-
     ECM_DEBUG("unregister", "REQUEST TO UNREGISTER, REG-ID:" << reg.reg_id  << " CHANNEL:" << reg.channel_name);
     // get the event channel factory... throw ServiceUnavailable
     _getEventChannelFactory();
@@ -612,24 +750,45 @@ void EventChannelManager::restore( ossie::events::EventChannel_ptr savedChannel,
     //
     std::string regid(reg.reg_id);
     std::string cname(reg.channel_name);
-
-    ECM_DEBUG("unregister", "CHECK REGISTRATION,  ID:" << regid<< " CHANNEL:" << cname);
-    _regExists( cname, regid );
+    if ( regid.empty() ) {
+      throw ( CF::EventChannelManager::RegistrationDoesNotExist());
+    }
 
     // get the registration record for this channel 
     ECM_DEBUG("unregister", "GET REGISTRATION RECORD, ID:" << reg.reg_id );
-    ChannelRegistrationPtr creg = _getChannelRegistration( cname );
-    if (creg) {
+    ChannelRegistrationPtr creg;
+    {
+      SCOPED_LOCK(_mgrlock);
+      creg = _getChannelRegistration( cname );
+    }
+    if ( !creg ) {
+      throw ( CF::EventChannelManager::ChannelDoesNotExist());
+    }
+
+    bool release = false;
+    {
+      redhawk::ScopedLock channel_lock(creg->lock);
+      if ( creg->removed ) {
+        throw ( CF::EventChannelManager::ChannelDoesNotExist());
+      }
+
       //  search for registration entry and remove registration from the list,
       RegIdList::iterator itr = creg->registrants.find(regid);
-      if ( itr != creg->registrants.end() )  {
-        ECM_DEBUG("unregister", "ERASE REGISTRATION RECORD, REG-ID:" << reg.reg_id );        
-        creg->registrants.erase(itr);
+      if ( itr == creg->registrants.end() )  {
+        throw ( CF::EventChannelManager::RegistrationDoesNotExist());
       }
+      ECM_DEBUG("unregister", "ERASE REGISTRATION RECORD, REG-ID:" << reg.reg_id );        
+      creg->registrants.erase(itr);
+      release = ( creg->registrants.size()==0 and creg->autoRelease );
+    }
 
-      if ( creg->registrants.size()==0 and creg->autoRelease ) {
+    if ( release ) {
+      ossie::events::EventChannel_var channel;
+      const bool removed = _removeChannelRegistration( creg, channel, true );
+      // destroy the channel without holding any locks
+      if ( removed ) {
         ECM_DEBUG("EventChannelManager", "NO MORE REGISTRATIONS, (AUTO-RELEASE IS ON), DELETING CHANNEL:" << cname  );        
-        _deleteChannelRegistration(cname);
+        _destroyChannel( creg->channel_name, creg->fqn, channel );
       }
     }
 
@@ -643,21 +802,28 @@ void EventChannelManager::restore( ossie::events::EventChannel_ptr savedChannel,
                                           CF::EventChannelInfoIterator_out eiter) {
 
 
-    SCOPED_LOCK(_mgrlock);
-    uint64_t size = _channels.size();
+    // copy the table, so that channels still being created do not hold up
+    // the manager lock
+    ChannelRegistrationTable channels;
+    {
+      SCOPED_LOCK(_mgrlock);
+      channels = _channels;
+    }
+    uint64_t size = channels.size();
     ECM_TRACE( "listChannels", " listChannel context " << this << ", how_many " << how_many << ", size " << size );
 
     // create copy of entire table...
     ossie::events::EventChannelInfoList* all = new ossie::events::EventChannelInfoList(size);
     all->length(size);
 
-    ChannelRegistrationTable::iterator iter =  _channels.begin();
-    for ( int i=0; iter != _channels.end() ; iter++,i++ ){
+    ChannelRegistrationTable::iterator iter =  channels.begin();
+    for ( int i=0; iter != channels.end() ; iter++,i++ ){
       std::string cname(iter->first.c_str());
+      redhawk::ScopedLock channel_lock(iter->second->lock);
       (*all)[i].channel_name = CORBA::string_dup(cname.c_str());
-      (*all)[i].reg_count = iter->second.registrants.size();
+      (*all)[i].reg_count = iter->second->registrants.size();
       ECM_DEBUG("listChannels", " list channel context: (" << i << ") channel_name: " <<  iter->first <<
-              " N registrants: " << iter->second.registrants.size() );
+              " N registrants: " << iter->second->registrants.size() );
     }
 
     eiter = EventChannelInfoIter::list( how_many, elist, all );
@@ -669,15 +835,19 @@ void EventChannelManager::restore( ossie::events::EventChannel_ptr savedChannel,
                                              CF::EventChannelManager::EventRegistrantList_out rlist, 
                                              CF::EventRegistrantIterator_out riter) {
 
-    SCOPED_LOCK(_mgrlock);
-    ChannelRegistrationPtr reg = _getChannelRegistration( channel_name );
-    if ( reg == 0 ) {
+    ChannelRegistrationPtr reg;
+    {
+      SCOPED_LOCK(_mgrlock);
+      reg = _getChannelRegistration( channel_name );
+    }
+    if ( !reg ) {
       // no results
       // result of this call
       riter = CF::EventRegistrantIterator::_nil();
       rlist->length(0);
       return;
     }      
+    redhawk::ScopedLock channel_lock(reg->lock);
 
     // get number of registrants to 
     uint64_t size = reg->nregistrants();
@@ -691,8 +861,8 @@ void EventChannelManager::restore( ossie::events::EventChannel_ptr savedChannel,
     for ( int i=0; iter != reg->registrants.end() ; iter++,i++ ){
       std::string cname(channel_name);
       (*all)[i].channel_name = CORBA::string_dup(cname.c_str());
-      (*all)[i].reg_id = CORBA::string_dup( iter->first.c_str() );
-      ECM_DEBUG("listRegistrants", " Registrant : (" << i << ") regid: " <<  iter->first );
+      (*all)[i].reg_id = CORBA::string_dup( iter->c_str() );
+      ECM_DEBUG("listRegistrants", " Registrant : (" << i << ") regid: " <<  *iter );
     }
 
     riter = EventRegistrantIter::list( how_many, rlist, all );
@@ -748,30 +918,28 @@ void EventChannelManager::_getEventChannelFactory ()
       throw (CF::EventChannelManager::ServiceUnavailable() );
     }
 
-    if ( CORBA::is_nil(_event_channel_factory )  ) {
+    redhawk::ULock lock(_factoryLock);
+    if ( !CORBA::is_nil(_event_channel_factory) ) {
+      return;
+    }
 
-      // Attempt to locate the OmniEvents event channel factory to create the event channels.
-      // First, check for an initial reference in the omniORB configuration; if it cannot be
-      // resolved in this manner, look it up via the naming service.
-      CORBA::Object_var factoryObj;
-      ECM_TRACE("_getEventChannelFactory", " ... Get EventChannelFactory...");
-      try {
-	  factoryObj = _orbCtx.namingServiceCtx->resolve_str("EventChannelFactory");
-      } catch (const CosNaming::NamingContext::NotFound&) {
-	ECM_DEBUG("_getEventChannelFactory",  "No naming service entry for 'EventChannelFactory'");
-      } catch (const CORBA::Exception& e) {
-	ECM_WARN( "_getEventChannel", "CORBA " << e._name() << " exception looking up EventChannelFactory in name service");
+    if ( !_factoryShutdown ) {
+      // Ask the reconnect thread to look the factory up now, and wait for a
+      // lookup that started after this request; concurrent callers all share
+      // the same lookup rather than each contacting the NamingService
+      const uint64_t target = _factoryLookups + (_factoryLookupActive ? 2 : 1);
+      _factoryRequested = true;
+      if ( !_factoryThreadRunning ) {
+        if ( _factoryThread ) {
+          _factoryThread->join();
+          delete _factoryThread;
+        }
+        _factoryThreadRunning = true;
+        _factoryThread = new boost::thread(&EventChannelManager::_reconnectFactory, this);
       }
-
-      if (!CORBA::is_nil(factoryObj)) {
-	try {
-	  if (!factoryObj->_non_existent()) {
-	    _event_channel_factory = CosLifeCycle::GenericFactory::_narrow(factoryObj);
-            ECM_TRACE("_getEventChannelFactory", "Resolved EventChannelFactory in NameService");
-	  }
-	} catch (const CORBA::TRANSIENT&) {
-	  ECM_WARN( "_getEventChannelEvent", "Could not contact EventChannelFactory");
-	} 
+      _factoryCond.notify_all();
+      while ( CORBA::is_nil(_event_channel_factory) && _factoryLookups < target && !_factoryShutdown ) {
+        _factoryCond.wait(lock);
       }
     }
 
@@ -783,6 +951,103 @@ void EventChannelManager::_getEventChannelFactory ()
   }
 
 
+ossie::events::EventChannelFactory_ptr EventChannelManager::_channelFactory ()
+    throw  ( CF::EventChannelManager::ServiceUnavailable )
+  {
+    _getEventChannelFactory();
+    redhawk::ScopedLock lock(_factoryLock);
+    if ( CORBA::is_nil(_event_channel_factory) ) {
+      // invalidated since the check above
+      throw (CF::EventChannelManager::ServiceUnavailable() );
+    }
+    return ossie::events::EventChannelFactory::_duplicate(_event_channel_factory);
+  }
+
+
+void EventChannelManager::_invalidateFactory ( ossie::events::EventChannelFactory_ptr factory )
+  {
+    redhawk::ScopedLock lock(_factoryLock);
+    // another caller may have already dropped or replaced it
+    if ( !CORBA::is_nil(_event_channel_factory) && _event_channel_factory.in() == factory ) {
+      ECM_WARN( "_invalidateFactory", "Lost contact with EventChannelFactory, reconnecting");
+      _event_channel_factory = ossie::events::EventChannelFactory::_nil();
+      if ( !_factoryThreadRunning && !_factoryShutdown ) {
+        if ( _factoryThread ) {
+          _factoryThread->join();
+          delete _factoryThread;
+        }
+        _factoryThreadRunning = true;
+        _factoryThread = new boost::thread(&EventChannelManager::_reconnectFactory, this);
+      }
+    }
+  }
+
+
+void EventChannelManager::_reconnectFactory ()
+  {
+    // time between lookups when no caller is waiting, doubling after each
+    // failure so that a factory that stays down is not polled every second;
+    // a caller that needs the factory still gets a lookup at once
+    const boost::posix_time::time_duration max_retry_period = boost::posix_time::seconds(60);
+    boost::posix_time::time_duration retry_period = boost::posix_time::seconds(1);
+
+    redhawk::ULock lock(_factoryLock);
+    while ( !_factoryShutdown && CORBA::is_nil(_event_channel_factory) ) {
+      _factoryRequested = false;
+      _factoryLookupActive = true;
+      lock.unlock();
+      ossie::events::EventChannelFactory_var factory = _resolveEventChannelFactory();
+      lock.lock();
+      _factoryLookupActive = false;
+      _factoryLookups++;
+      if ( CORBA::is_nil(_event_channel_factory) ) {
+        _event_channel_factory = factory._retn();
+      }
+      _factoryCond.notify_all();
+
+      if ( CORBA::is_nil(_event_channel_factory) && !_factoryRequested && !_factoryShutdown ) {
+        _factoryCond.timed_wait(lock, retry_period);
+        retry_period = std::min(retry_period * 2, max_retry_period);
+      }
+    }
+    _factoryThreadRunning = false;
+  }
+
+
+ossie::events::EventChannelFactory_ptr EventChannelManager::_resolveEventChannelFactory ()
+  {
+    ossie::events::EventChannelFactory_var factory;
+
+    // Attempt to locate the OmniEvents event channel factory to create the event channels.
+    // First, check for an initial reference in the omniORB configuration; if it cannot be
+    // resolved in this manner, look it up via the naming service.
+    CORBA::Object_var factoryObj;
+    ECM_TRACE("_getEventChannelFactory", " ... Get EventChannelFactory...");
+    try {
+      factoryObj = _orbCtx.namingServiceCtx->resolve_str("EventChannelFactory");
+    } catch (const CosNaming::NamingContext::NotFound&) {
+      ECM_DEBUG("_getEventChannelFactory",  "No naming service entry for 'EventChannelFactory'");
+    } catch (const CORBA::Exception& e) {
+      ECM_WARN( "_getEventChannel", "CORBA " << e._name() << " exception looking up EventChannelFactory in name service");
+    }
+
+    if (!CORBA::is_nil(factoryObj)) {
+      try {
+        if (!factoryObj->_non_existent()) {
+          factory = CosLifeCycle::GenericFactory::_narrow(factoryObj);
+          ECM_TRACE("_getEventChannelFactory", "Resolved EventChannelFactory in NameService");
+        }
+      } catch (const CORBA::TRANSIENT&) {
+        ECM_WARN( "_getEventChannelEvent", "Could not contact EventChannelFactory");
+      } catch (const CORBA::SystemException& e) {
+        ECM_WARN( "_getEventChannelEvent", "CORBA " << e._name() << " exception contacting EventChannelFactory");
+      }
+    }
+
+    return factory._retn();
+  }
+
+
 
   ossie::events::EventChannel_ptr EventChannelManager::_createChannel( const std::string &cname, 
                                                                       const std::string &fqn, 
@@ -794,7 +1059,7 @@ void EventChannelManager::_getEventChannelFactory ()
 	    CF::EventChannelManager::ServiceUnavailable )
   {
     // resolve factory.... this throws.... ServiceUnavailable
-    _getEventChannelFactory();
+    ossie::events::EventChannelFactory_var factory = _channelFactory();
 
     //
     // if we are at this point then prior methods are responsible for checking if channel already exits
@@ -807,7 +1072,16 @@ void EventChannelManager::_getEventChannelFactory ()
     key[0].kind = "object interface";
 
     ECM_TRACE( "_createChannel", " Check EventChannelFactory API" );
-    if(!_event_channel_factory->supports(key)) {
+    bool supported = false;
+    try {
+      supported = factory->supports(key);
+    }
+    catch( CORBA::SystemException &ex ) {
+      ECM_ERROR( "Create Event Channel", " Create failed, CHANNEL:" << cname << " REASON: EventChannelFactory unreachable (" << ex._name() << ")" );
+      _invalidateFactory(factory);
+      throw (CF::EventChannelManager::ServiceUnavailable());
+    }
+    if(!supported) {
       ECM_WARN( "Create Event Channel", " EventChannelFactory does not support Event Channel Interface!" );
       throw (CF::EventChannelManager::OperationNotAllowed());
     }
@@ -828,7 +1102,7 @@ void EventChannelManager::_getEventChannelFactory ()
 
     CORBA::Object_var obj;
     try {
-      obj =_event_channel_factory->create_object(key, criteria);
+      obj =factory->create_object(key, criteria);
     }
     catch (CosLifeCycle::CannotMeetCriteria& ex) /* create_object() */ {
       ECM_ERROR( "Create Event Channel", "Create failed, CHANNEL: " << cname << " REASON: CannotMeetCriteria " );
@@ -1027,59 +1301,6 @@ ossie::events::EventChannel_ptr  EventChannelManager::_resolve_es ( const std::s
 }
 
 
-  /*
-     Check the registration database exists for the specified channel
-     
-     @returns false - channel or registration was not found
-     @returns true - registration id was found for specified channel
-  */
-bool EventChannelManager::_regIdExists( const std::string &cname, const std::string &regid ) {
-
-  bool retval = false;
-  if ( regid.size() > 0  ) {
-    ChannelRegistrationPtr reg = _getChannelRegistration( cname );
-    if ( reg ) {
-      if ( reg->registrants.find(regid) != reg->registrants.end() ) retval = true;
-    }
-  }
-  return retval;
-}
-
-
-  /*
-     Check the registration database if a specified publisher is registered
-     
-     @returns false - channel or registration was not found
-     @returns true -  publisher registration id was found for the specified channel
-  */
-  bool EventChannelManager::_regExists( const std::string &cname, const std::string &regid ) 
-    throw ( CF::EventChannelManager::ChannelDoesNotExist,
-            CF::EventChannelManager::RegistrationDoesNotExist )
-  {
-
-    bool retval = false;
-    if ( regid.size() > 0  ) {
-      ChannelRegistrationPtr reg = _getChannelRegistration( cname );
-      if ( reg ) {
-	if ( reg->registrants.find(regid) != reg->registrants.end() ) {
-          retval = true;
-        }
-        else {
-          throw ( CF::EventChannelManager::RegistrationDoesNotExist());
-        }
-      }
-      else {
-        throw ( CF::EventChannelManager::ChannelDoesNotExist());
-      }
-    }
-    else {
-      throw ( CF::EventChannelManager::RegistrationDoesNotExist());
-    }
-
-    return retval;
-  }
-
-
   /*
      check if channel name is registered
   */
@@ -1092,7 +1313,7 @@ bool EventChannelManager::_regIdExists( const std::string &cname, const std::str
       // search for fully qualified name in registration list
       ChannelRegistrationTable::iterator   itr = _channels.begin();
       for(; itr != _channels.end() ; itr++ ) {
-        if ( itr->second.fqn.compare(cname) == 0 ) {
+        if ( itr->second->fqn.compare(cname) == 0 ) {
           count++;
           break;
         }
@@ -1139,23 +1360,23 @@ bool EventChannelManager::_regIdExists( const std::string &cname, const std::str
   EventChannelManager::ChannelRegistrationPtr  EventChannelManager::_getChannelRegistration( const std::string &cname ) {
 
     std::string::size_type pos = cname.find(".");
-    ChannelRegistrationPtr ret=NULL;
+    ChannelRegistrationPtr ret;
 
     if ( pos != std::string::npos ) {
       // search registration base on fully qualified name
       ChannelRegistrationTable::iterator   itr = _channels.begin();
       for( ; itr != _channels.end(); itr++ ) {
-        if ( itr->second.fqn.compare(cname) == 0 ) {
-          ret = &(itr->second);
+        if ( itr->second->fqn.compare(cname) == 0 ) {
+          ret = itr->second;
           break;
         }
       }
     }
 
-    if ( ret == NULL ) {
+    if ( !ret ) {
       ChannelRegistrationTable::iterator   itr = _channels.find( cname );
       if ( itr != _channels.end() ){
-        ret = &(itr->second);
+        ret = itr->second;
       }
     }
 
@@ -1173,23 +1394,24 @@ EventChannelManager::ChannelRegistrationPtr EventChannelManager::_addChannelRegi
   ECM_TRACE("_addChannelRegistration", "Created ChannelRegistrationRecord, Event Channel : "<< channel << "/" << autoRelease );
 
   ChannelRegistrationTable::iterator   itr = _channels.find( cname );
-  ChannelRegistrationPtr ret=NULL;
+  ChannelRegistrationPtr ret;
   if ( itr == _channels.end() ){
     // Insert a new registration
-    _channels[cname] = ChannelRegistration();
-    _channels[cname].channel_name = cname;           // name known to the domain
-    _channels[cname].fqn = fqn;                      // internal name registered with EventService
-    _channels[cname].channel = ossie::events::EventChannel::_duplicate(channel);
-    _channels[cname].release = false;
-    _channels[cname].autoRelease = autoRelease;
-    ret = &(_channels[cname]);
+    ret.reset(new ChannelRegistration());
+    ret->channel_name = cname;           // name known to the domain
+    ret->fqn = fqn;                      // internal name registered with EventService
+    ret->channel = ossie::events::EventChannel::_duplicate(channel);
+    ret->release = false;
+    ret->autoRelease = autoRelease;
+    ret->removed = false;
+    _channels[cname] = ret;
     ECM_TRACE("_addChannelRegistration", "Created ChannelRegistrationRecord, Event Channel/FQN : "<< cname << "/" << fqn );
-    ECM_TRACE("addChannelRegistration", "    ChannelRecord: name:" << _channels[cname].channel_name );
-    ECM_TRACE("addChannelRegistration", "    ChannelRecord: fqn:" << _channels[cname].fqn );
-    ECM_TRACE("addChannelRegistration", "    ChannelRecord: autoRelease:" << _channels[cname].autoRelease );
-    ECM_TRACE("addChannelRegistration", "    ChannelRecord: release:" << _channels[cname].release );
-    ECM_TRACE("addChannelRegistration", "    ChannelRecord: registrants:" << _channels[cname].registrants.size());
-    ECM_TRACE("addChannelRegistration", "    ChannelRecord: channel:" << _channels[cname].channel);
+    ECM_TRACE("addChannelRegistration", "    ChannelRecord: name:" << ret->channel_name );
+    ECM_TRACE("addChannelRegistration", "    ChannelRecord: fqn:" << ret->fqn );
+    ECM_TRACE("addChannelRegistration", "    ChannelRecord: autoRelease:" << ret->autoRelease );
+    ECM_TRACE("addChannelRegistration", "    ChannelRecord: release:" << ret->release );
+    ECM_TRACE("addChannelRegistration", "    ChannelRecord: registrants:" << ret->registrants.size());
+    ECM_TRACE("addChannelRegistration", "    ChannelRecord: channel:" << ret->channel);
     ECM_TRACE("_addChannelRegistration", "Registration Table Size: "<< _channels.size() );
   }
   return ret;
@@ -1198,32 +1420,122 @@ EventChannelManager::ChannelRegistrationPtr EventChannelManager::_addChannelRegi
 
 
 
-  /*
-   
-   */
-  void EventChannelManager::_deleteChannelRegistration( const std::string &cname ) {
-    ChannelRegistrationTable::iterator   itr = _channels.find( cname );
-    if ( itr != _channels.end() ){
-      ChannelRegistrationPtr reg = &(itr->second);
-      if ( reg ) {
-        if ( CORBA::is_nil( reg->channel) == false ){
-          ECM_DEBUG("_deleteChannelRegistration", "Calling Destroy, Channel/EventChannel: "<< cname << "/" << reg->fqn);
-          try {
-            reg->channel->destroy();
-          }
-          catch(...){
-            ECM_DEBUG("_deleteChannelRegistration", "Exception during destroy  EventService.. channel/EventChannel: "<< cname << "/" << reg->fqn);
-          }
-          reg->channel = ossie::events::EventChannel::_nil();
-          ECM_DEBUG("_deleteChannelRegistration", "Destory Completed, Channel/EventChannel: "<< cname << "/" << reg->fqn);
-        }
+  bool EventChannelManager::_removeChannelRegistration( const ChannelRegistrationPtr &reg, 
+                                                        ossie::events::EventChannel_var &channel,
+                                                        bool unused ) {
+    {
+      redhawk::ScopedLock channel_lock(reg->lock);
+      if ( reg->removed ) {
+        // already removed by another thread
+        return false;
       }
+      if ( unused && reg->nregistrants() > 0 ) {
+        return false;
+      }
+      reg->removed = true;
+      channel = reg->channel._retn();
+    }
 
-      // remove the channel registration entry
-      ECM_DEBUG("_deleteChannelRegistration", "Deleting Registration for EventChannel: "<< cname );
+    // remove the channel registration entry; registrants that find it before
+    // then see that it was removed and look again
+    ECM_DEBUG("_removeChannelRegistration", "Deleting Registration for EventChannel: "<< reg->channel_name );
+    SCOPED_LOCK(_mgrlock);
+    ChannelRegistrationTable::iterator   itr = _channels.find( reg->channel_name );
+    if ( itr != _channels.end() && itr->second == reg ) {
       _channels.erase(itr);
     }
-    ECM_DEBUG("_deleteChannelRegistration", "Completed delete registration...EventChannel: "<< cname );
-    return;
+    return true;
+  }
+
+
+  void EventChannelManager::_destroyChannel( const std::string &cname, const std::string &fqn, ossie::events::EventChannel_ptr channel ) {
+    if ( CORBA::is_nil( channel ) == false ){
+      ECM_DEBUG("_destroyChannel", "Calling Destroy, Channel/EventChannel: "<< cname << "/" << fqn);
+      try {
+        channel->destroy();
+      }
+      catch(...){
+        ECM_DEBUG("_destroyChannel", "Exception during destroy  EventService.. channel/EventChannel: "<< cname << "/" << fqn);
+      }
+      ECM_DEBUG("_destroyChannel", "Destory Completed, Channel/EventChannel: "<< cname << "/" << fqn);
+    }
   }
 
+
+  EventChannelManager::ChannelRegistrationPtr EventChannelManager::_lockChannelForRegistration( const std::string &cname )
+    throw ( CF::EventChannelManager::OperationFailed, 
+            CF::EventChannelManager::OperationNotAllowed,
+            CF::EventChannelManager::ServiceUnavailable )
+  {
+    while (true) {
+      ChannelRegistrationPtr creg;
+      bool created = false;
+      {
+        SCOPED_LOCK(_mgrlock);
+        creg = _getChannelRegistration( cname );
+        if ( !creg ) {
+          // reserve the name with an empty record, so that registrants for
+          // the same channel wait on its lock while it is created
+          creg = _addChannelRegistration( cname, _getFQN(cname), ossie::events::EventChannel::_nil(), false );
+          created = true;
+          creg->lock.lock();
+        }
+      }
+
+      if ( !created ) {
+        creg->lock.lock();
+        if ( creg->removed ) {
+          // released (or its creation failed) while waiting, look again
+          creg->lock.unlock();
+          continue;
+        }
+        return creg;
+      }
+
+      // need to create a channel....
+      try {
+        try {
+          creg->channel = _obtainChannel( cname, creg->fqn );
+        }
+        catch( CF::EventChannelManager::ChannelAlreadyExists ){
+          ECM_ERROR("registerResource", "REGISTRATION ERROR, CHANNEL:" << cname  << " Channel exists in EventService" );
+          throw (CF::EventChannelManager::OperationFailed());    
+        }
+      }
+      catch( ... ) {
+        // give up the reservation; waiting registrants will see that it was
+        // removed and try again
+        creg->removed = true;
+        creg->lock.unlock();
+        SCOPED_LOCK(_mgrlock);
+        ChannelRegistrationTable::iterator itr = _channels.find( cname );
+        if ( itr != _channels.end() && itr->second == creg ) {
+          _channels.erase(itr);
+        }
+        throw;
+      }
+      return creg;
+    }
+  }
+
+
+  void EventChannelManager::_addRegistrant( ChannelRegistration &creg, std::string &regid )
+    throw ( CF::EventChannelManager::RegistrationAlreadyExists,
+            CF::EventChannelManager::OperationNotAllowed )
+  {
+    // channel is marked for deletion..... 
+    if ( creg.release ) throw ( CF::EventChannelManager::OperationNotAllowed());
+
+    //
+    // check if registration exists
+    //
+    if ( regid.empty() ) {
+      regid = _generateRegId();
+      while ( creg.registrants.count(regid) ) {
+        regid = _generateRegId();
+      }
+    }
+    if ( !creg.registrants.insert( regid ).second ) {
+      throw ( CF::EventChannelManager::RegistrationAlreadyExists());
+    }
+  }
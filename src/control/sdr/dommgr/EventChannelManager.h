@@ -1,6 +1,9 @@
 #ifndef __RH_CF_DOMMGR_ECM__
 #define __RH_CF_DOMMGR_ECM__
 #include <set>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <COS/CosLifeCycle.hh>
 #include <ossie/RedhawkDefs.h>
 #include <ossie/EventTypes.h>
@@ -134,6 +137,19 @@ class EventChannelManager: public virtual EventChannelManagerBase {
             CF::EventChannelManager::OperationNotAllowed,
             CF::EventChannelManager::ServiceUnavailable );
 
+  /*
+     Register a batch of publishers and subscribers.  Each channel named in the
+     batch is looked up (or created) once, and all of its registrants are added
+     together.  If any request fails, the registrations already made for the
+     batch are removed before the exception is rethrown.
+  */
+  ossie::events::EventChannelRegList* registerResources( const ossie::events::EventRegistrationList &reqs )
+    throw ( CF::EventChannelManager::InvalidChannelName, 
+            CF::EventChannelManager::RegistrationAlreadyExists,
+            CF::EventChannelManager::OperationFailed, 
+            CF::EventChannelManager::OperationNotAllowed,
+            CF::EventChannelManager::ServiceUnavailable );
+
   /*
      Unregister a publisher or subcriber from an event channel and invalidates the context
   */
@@ -163,26 +179,44 @@ class EventChannelManager: public virtual EventChannelManagerBase {
 
  private:
 
-  typedef  std::pair< std::string, std::string >  RegRecord;
-  typedef  std::map< std::string, std::string >   RegIdList;
+  typedef  std::set< std::string >                RegIdList;
 
+  //
+  // Each channel is guarded by its own lock, so that registrations against
+  // different channels do not wait on each other.  The lock is also held
+  // while a channel is being created for its first registrant, so callers
+  // look a record up under _mgrlock and release it before taking the channel
+  // lock.  The only exception is a record that has just been added, whose
+  // lock nobody else can hold yet; _mgrlock is never taken with a channel
+  // lock held.
+  //
   struct ChannelRegistration {
     std::string                      channel_name;
     std::string                      fqn;
     ossie::events::EventChannel_var  channel;
     bool                             autoRelease;
     bool                             release;
+    // set when the record has been removed from the table; registrants that
+    // were waiting on the lock must look the channel up again
+    bool                             removed;
     RegIdList                        registrants;
+    redhawk::Mutex                   lock;
 
     int nregistrants( ) const { 
       return registrants.size();
     }
+
+    // stringified channel reference, only computed when needed
+    const std::string& ior();
+
+  private:
+    std::string                      _ior;
   };
 
 
-  typedef ChannelRegistration*                              ChannelRegistrationPtr;
+  typedef boost::shared_ptr< ChannelRegistration >          ChannelRegistrationPtr;
 
-  typedef std::map< std::string, ChannelRegistration >      ChannelRegistrationTable;
+  typedef std::map< std::string, ChannelRegistrationPtr >   ChannelRegistrationTable;
 
 
   void _initialize();
@@ -196,9 +230,35 @@ class EventChannelManager: public virtual EventChannelManagerBase {
 
   /*
      _getEventChannelFactory
+
+     Returns immediately if the factory has been resolved; otherwise, waits
+     for the reconnect thread to try again, sharing that lookup with any
+     other callers.
   */
   void     _getEventChannelFactory() throw  ( CF::EventChannelManager::ServiceUnavailable );
 
+  /*
+     Returns a reference to the current factory, resolving it if necessary
+  */
+  ossie::events::EventChannelFactory_ptr _channelFactory() throw  ( CF::EventChannelManager::ServiceUnavailable );
+
+  /*
+     Drops the cached factory after it has failed, and starts reconnecting
+  */
+  void     _invalidateFactory( ossie::events::EventChannelFactory_ptr factory );
+
+  /*
+     Look up the factory in the NamingService; returns nil on failure
+  */
+  ossie::events::EventChannelFactory_ptr _resolveEventChannelFactory();
+
+  /*
+     Body of the reconnect thread, which retries the factory lookup until it
+     succeeds or the manager is destroyed, backing off between unrequested
+     attempts
+  */
+  void     _reconnectFactory();
+
 
   void _release( const std::string &channel_name) 
     throw ( CF::EventChannelManager::ChannelDoesNotExist, 
@@ -214,6 +274,34 @@ class EventChannelManager: public virtual EventChannelManagerBase {
             CF::EventChannelManager::OperationNotAllowed,
             CF::EventChannelManager::ServiceUnavailable );
 
+  /*
+     Find an existing channel in the EventService or NamingService, or create
+     a new one; does not touch the registration table
+  */
+  ossie::events::EventChannel_ptr _obtainChannel( const std::string &channel_name, const std::string &fqn )
+    throw ( CF::EventChannelManager::ChannelAlreadyExists, 
+            CF::EventChannelManager::OperationFailed, 
+            CF::EventChannelManager::OperationNotAllowed,
+            CF::EventChannelManager::ServiceUnavailable );
+
+  /*
+     Returns the registration record for a channel with its lock held,
+     creating the channel if this is its first registrant.  Only the record's
+     lock is held during creation.
+  */
+  ChannelRegistrationPtr              _lockChannelForRegistration( const std::string &cname )
+    throw ( CF::EventChannelManager::OperationFailed, 
+            CF::EventChannelManager::OperationNotAllowed,
+            CF::EventChannelManager::ServiceUnavailable );
+
+  /*
+     Add a registrant to a locked channel record, generating an id if the
+     request did not include one
+  */
+  void                                _addRegistrant( ChannelRegistration &creg, std::string &regid )
+    throw ( CF::EventChannelManager::RegistrationAlreadyExists,
+            CF::EventChannelManager::OperationNotAllowed );
+
   /*
      _create
 
@@ -244,19 +332,6 @@ class EventChannelManager: public virtual EventChannelManagerBase {
                                                      const std::string &fqn,
                                                      const std::string &nc_name="" );
 
-  /*
-     check if registration id exists for the specified channel
-  */
-  bool                                _regIdExists( const std::string &cname, const std::string &regid );
-
-
-  /*
-     check if registration id exists for the specified channel as a publisher
-  */
-  bool                                _regExists( const std::string &cname, const std::string &regid ) 
-    throw ( CF::EventChannelManager::ChannelDoesNotExist,
-            CF::EventChannelManager::RegistrationDoesNotExist );
-
   /*
      check if channel name exits in the local registration database 
   */
@@ -289,9 +364,17 @@ class EventChannelManager: public virtual EventChannelManagerBase {
 
 
   /*
-       
-   */
-  void                                _deleteChannelRegistration( const std::string &cname );
+     Remove a record from the table (if it is still there) and mark it as
+     removed, handing its channel to the caller to destroy.  If unused is
+     true, the record is left alone when it has gained registrants since the
+     caller last looked, and false is returned.  Takes the channel lock and
+     then _mgrlock, one after the other; the caller must hold neither.
+  */
+  bool                                _removeChannelRegistration( const ChannelRegistrationPtr &reg,
+                                                                 ossie::events::EventChannel_var &channel,
+                                                                 bool unused=false );
+
+  void                                _destroyChannel( const std::string &cname, const std::string &fqn, ossie::events::EventChannel_ptr channel );
 
 
 
@@ -309,6 +392,18 @@ class EventChannelManager: public virtual EventChannelManagerBase {
   //  Handle to factory interface to create EventChannels
   ossie::events::EventChannelFactory_var            _event_channel_factory;
 
+  // guards the factory reference and the reconnect thread state
+  redhawk::Mutex                                   _factoryLock;
+  boost::condition_variable                        _factoryCond;
+  boost::thread*                                   _factoryThread;
+  bool                                             _factoryThreadRunning;
+  // a caller is waiting and the next lookup should not be delayed
+  bool                                             _factoryRequested;
+  bool                                             _factoryLookupActive;
+  bool                                             _factoryShutdown;
+  // number of completed lookups, so callers can wait for a fresh one
+  uint64_t                                         _factoryLookups;
+
   //
   // Channel Registration database
   //
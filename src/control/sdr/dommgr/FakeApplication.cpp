@@ -91,6 +91,14 @@ CF::PortSet::PortInfoSequence* FakeApplication::getPortSet ()
 	return new CF::PortSet::PortInfoSequence();
 }
 
+CF::PortSet::PortInfoSequence* FakeApplication::getPorts (const CF::StringSequence& names)
+{
+    if (names.length() > 0) {
+        throw CF::PortSupplier::UnknownPort();
+    }
+    return new CF::PortSet::PortInfoSequence();
+}
+
 void FakeApplication::runTest (CORBA::ULong, CF::Properties&)
 {
     throw CF::TestableObject::UnknownTest();
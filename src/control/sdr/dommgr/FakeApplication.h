@@ -55,6 +55,8 @@ public:
     CORBA::Object_ptr getPort (const char*);
 
     CF::PortSet::PortInfoSequence* getPortSet ();
+
+    CF::PortSet::PortInfoSequence* getPorts (const CF::StringSequence&);
         
     void runTest (CORBA::ULong, CF::Properties&);
     
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include <ossie/exceptions.h>
+#include <ossie/prop_helpers.h>
 #include "applicationSupport.h"
 #include "connectionSupport.h"
 
@@ -57,6 +58,8 @@ namespace ossie {
 
     typedef  ID    DeviceID;
 
+    typedef std::map<std::string, boost::shared_ptr<PropertyMatcher> > PropertyMatcherMap;
+
     struct DeviceNode {
         std::string identifier;
         std::string label;
@@ -67,6 +70,8 @@ namespace ossie {
         std::string softwareProfile;
         ossie::SoftPkg spd;
         ossie::Properties prf;
+        // Matching allocation properties, compiled from prf by ID
+        PropertyMatcherMap matchers;
         std::string implementationId;
         bool isLoadable;
         bool isExecutable;
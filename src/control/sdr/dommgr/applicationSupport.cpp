@@ -689,6 +689,10 @@ void ComponentInfo::setNicAssignment(std::string nic) {
     nicAssignment = nic;
 };
 
+void ComponentInfo::setAllocationOptions(const CF::Properties &allocation) {
+    allocationOptions = allocation;
+};
+
 
 void ComponentInfo::setAffinity( const AffinityProperties &affinity_props )
 {
@@ -1043,6 +1047,14 @@ CF::Properties ComponentInfo::getOptions()
       RH_NL_DEBUG("DomainManager", "ComponentInfo - Extending options, adding Affinity Properties ...set length: " << affinity_options.length());
     }
 
+    // pass along what was allocated for the component so the device can
+    // confine it to that capacity
+    if ( allocationOptions.length() > 0 ) {
+      options.length(options.length()+1);
+      options[options.length()-1].id = CORBA::string_dup("ALLOCATION");
+      options[options.length()-1].value <<= allocationOptions;
+    }
+
     RH_NL_TRACE("DomainManager", "ComponentInfo - getOptions.... length: " << options.length());
     for ( uint32_t i=0; i < options.length(); i++ ) {
       RH_NL_TRACE("DomainManager", "ComponentInfo - getOptions id:"  <<  options[i].id << "/" <<  ossie::any_to_string( options[i].value )) ;
@@ -1191,3 +1203,32 @@ ComponentInfo* ApplicationInfo::findComponentByInstantiationId(const std::string
     }
     return 0;
 }
+
+CF::PortSet::PortInfoSequence* ossie::queryPorts(CF::PortSet_ptr component, const CF::StringSequence& names)
+{
+    try {
+        return component->getPorts(names);
+    } catch (const CORBA::BAD_OPERATION&) {
+    } catch (const CORBA::NO_IMPLEMENT&) {
+    }
+
+    CF::PortSet::PortInfoSequence_var ports = component->getPortSet();
+    CF::PortSet::PortInfoSequence_var result = new CF::PortSet::PortInfoSequence();
+    result->length(names.length());
+    for (CORBA::ULong index = 0; index < names.length(); ++index) {
+        CORBA::ULong port = 0;
+        while ((port < ports->length()) && (strcmp(ports[port].name, names[index]) != 0)) {
+            ++port;
+        }
+        if (port == ports->length()) {
+            // Not in the port set, but an overridden getPort may still
+            // serve it; throws UnknownPort if not
+            result[index].obj_ptr = component->getPort(names[index]);
+            result[index].name = names[index];
+            result[index].repid = "IDL:CORBA/Object:1.0";
+        } else {
+            result[index] = ports[port];
+        }
+    }
+    return result._retn();
+}
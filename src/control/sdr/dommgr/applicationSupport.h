@@ -227,6 +227,7 @@ namespace ossie
         void setIsAssemblyController(bool isAssemblyController);
         void setIsScaCompliant(bool isScaCompliant);
         void setNicAssignment(std::string nic);
+        void setAllocationOptions(const CF::Properties &allocation);
         void setAffinity( const AffinityProperties &affinity );
         void mergeAffinityOptions( const CF::Properties &new_affinity );
         void setLoggingConfig( const LoggingConfig &logcfg );
@@ -305,6 +306,7 @@ namespace ossie
         CF::Properties factoryParameters;
         CF::Properties execParameters;
         CF::Properties affinityOptions;
+        CF::Properties allocationOptions;
         
         std::vector<std::string> resolved_softpkg_dependencies;
 
@@ -352,5 +354,13 @@ namespace ossie
         CF::Properties acProps;
         std::vector<ComponentInfo*> components;
     };
+
+    /*
+     * Returns the named ports of a component, in order, with a single
+     * getPorts call; components that predate getPorts are asked for their
+     * whole port set instead, and getPort is called for any name not in
+     * it. Throws UnknownPort if any port is missing.
+     */
+    CF::PortSet::PortInfoSequence* queryPorts(CF::PortSet_ptr component, const CF::StringSequence& names);
 }
 #endif
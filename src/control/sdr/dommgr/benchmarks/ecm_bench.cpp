@@ -0,0 +1,238 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Measures EventChannelManager registration under load, as seen when a large
+ * application starts and every message/event port registers at once. One
+ * thread per registrant calls registerResource concurrently, spread across a
+ * number of channels; the same registrations are then made with a single
+ * registerResources call. Channels are created by the first registrant in
+ * each run, so creation cost is included.
+ *
+ * Requires a running naming service and event service (omniEvents) with an
+ * "EventChannelFactory" entry.
+ *
+ * usage: ecm_bench [registrants] [channels]
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <time.h>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+
+#include <ossie/CorbaUtils.h>
+#include <ossie/logging/loghelpers.h>
+
+#include "EventChannelManager.h"
+
+namespace {
+
+    double now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + (ts.tv_nsec * 1e-9);
+    }
+
+    std::string channelName(size_t round, size_t index)
+    {
+        std::ostringstream name;
+        name << "ecm_bench_" << round << "_" << index;
+        return name.str();
+    }
+
+    void report(const std::string& name, size_t count, double elapsed, double worst)
+    {
+        std::cout << std::setw(22) << std::left << name
+                  << std::setw(10) << std::right << std::fixed << std::setprecision(1)
+                  << (elapsed * 1e3) << " ms total"
+                  << std::setw(10) << (count / elapsed) << " reg/s";
+        if (worst > 0.0) {
+            std::cout << std::setw(10) << std::setprecision(2) << (worst * 1e3) << " ms worst";
+        }
+        std::cout << std::endl;
+    }
+
+    class Registrant {
+    public:
+        Registrant(EventChannelManager* manager, const std::string& channel, boost::barrier& start) :
+            _manager(manager),
+            _channel(channel),
+            _start(start),
+            _latency(0.0),
+            _failed(false)
+        {
+        }
+
+        void operator() ()
+        {
+            ossie::events::EventRegistration request;
+            request.channel_name = _channel.c_str();
+            request.reg_id = "";
+            _start.wait();
+            double begin = now();
+            try {
+                ossie::events::EventChannelReg_var reg = _manager->registerResource(request);
+                _registration = reg->reg;
+            } catch (...) {
+                _failed = true;
+            }
+            _latency = now() - begin;
+        }
+
+        double latency() const
+        {
+            return _latency;
+        }
+
+        bool failed() const
+        {
+            return _failed;
+        }
+
+        const ossie::events::EventRegistration& registration() const
+        {
+            return _registration;
+        }
+
+    private:
+        EventChannelManager* _manager;
+        std::string _channel;
+        boost::barrier& _start;
+        double _latency;
+        bool _failed;
+        ossie::events::EventRegistration _registration;
+    };
+
+    void unregisterAll(EventChannelManager* manager, const ossie::events::EventRegistrationList& regs)
+    {
+        for (CORBA::ULong ii = 0; ii < regs.length(); ++ii) {
+            try {
+                manager->unregister(regs[ii]);
+            } catch (...) {
+            }
+        }
+    }
+
+    void runConcurrent(EventChannelManager* manager, size_t registrants, size_t channels)
+    {
+        // All of the threads are released at once by the barrier, so that the
+        // registrations contend with each other as they would at startup
+        boost::barrier start(registrants + 1);
+        std::vector<Registrant*> workers;
+        boost::thread_group threads;
+        for (size_t ii = 0; ii < registrants; ++ii) {
+            workers.push_back(new Registrant(manager, channelName(0, ii % channels), start));
+            threads.create_thread(boost::ref(*workers.back()));
+        }
+
+        start.wait();
+        double begin = now();
+        threads.join_all();
+        double elapsed = now() - begin;
+
+        double worst = 0.0;
+        size_t failures = 0;
+        ossie::events::EventRegistrationList regs;
+        for (size_t ii = 0; ii < workers.size(); ++ii) {
+            if (workers[ii]->failed()) {
+                ++failures;
+            } else {
+                ossie::corba::push_back(regs, workers[ii]->registration());
+            }
+            worst = std::max(worst, workers[ii]->latency());
+            delete workers[ii];
+        }
+        report("registerResource", registrants, elapsed, worst);
+        if (failures) {
+            std::cout << "  " << failures << " registration(s) failed" << std::endl;
+        }
+
+        unregisterAll(manager, regs);
+    }
+
+    void runBatched(EventChannelManager* manager, size_t registrants, size_t channels)
+    {
+        ossie::events::EventRegistrationList requests;
+        requests.length(registrants);
+        for (size_t ii = 0; ii < registrants; ++ii) {
+            requests[ii].channel_name = channelName(1, ii % channels).c_str();
+            requests[ii].reg_id = "";
+        }
+
+        double begin = now();
+        ossie::events::EventChannelRegList_var regs;
+        try {
+            regs = manager->registerResources(requests);
+        } catch (...) {
+            std::cout << "registerResources failed" << std::endl;
+            return;
+        }
+        double elapsed = now() - begin;
+        report("registerResources", registrants, elapsed, 0.0);
+
+        ossie::events::EventRegistrationList created;
+        for (CORBA::ULong ii = 0; ii < regs->length(); ++ii) {
+            ossie::corba::push_back(created, regs[ii].reg);
+        }
+        unregisterAll(manager, created);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t registrants = 500;
+    size_t channels = 10;
+    if (argc > 1) {
+        registrants = strtoul(argv[1], 0, 10);
+    }
+    if (argc > 2) {
+        channels = strtoul(argv[2], 0, 10);
+    }
+
+    ossie::corba::CorbaInit(argc, argv);
+    ossie::logging::ConfigureDefault();
+
+    EventChannelManager* manager = new EventChannelManager(true, false, false);
+    try {
+        // make sure the factory can be reached before timing anything
+        manager->findChannel("ecm_bench");
+    } catch (const CF::EventChannelManager::ServiceUnavailable&) {
+        std::cerr << "EventChannelFactory is not available" << std::endl;
+        delete manager;
+        ossie::corba::OrbShutdown(true);
+        return 1;
+    }
+
+    std::cout << "Event channel registrations, " << registrants << " registrants over "
+              << channels << " channels" << std::endl;
+    runConcurrent(manager, registrants, channels);
+    runBatched(manager, registrants, channels);
+
+    manager->terminate();
+    delete manager;
+    ossie::corba::OrbShutdown(true);
+    return 0;
+}
@@ -20,6 +20,12 @@
 
 #include <string>
 #include <vector>
+#include <algorithm>
+
+#include <boost/bind.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 
 #if HAVE_BOOST_SERIALIZATION
 #include <boost/archive/text_iarchive.hpp>
@@ -107,8 +113,85 @@ CORBA::Object_ptr ConnectionManager::resolveFindByNamingService(const std::strin
     return CORBA::Object::_nil();
 }
 
+CORBA::Object_ptr ConnectionManager::resolvePort(CF::PortSupplier_ptr supplier, const std::string& name)
+{
+    return supplier->getPort(name.c_str());
+}
+
+namespace {
+
+    // Makes the connectPort calls for groups of resolved connections, one
+    // group at a time per thread; errors[i] holds the failure of nodes[i],
+    // and calls[i] its timing.
+    class ConnectWorkers {
+    public:
+        ConnectWorkers(std::vector<ConnectionNode*>& nodes,
+                       const std::vector< std::vector<size_t> >& groups,
+                       std::vector<std::string>& errors,
+                       std::vector<AppConnectionManager::ConnectCall>& calls) :
+            nodes_(nodes),
+            groups_(groups),
+            errors_(errors),
+            calls_(calls),
+            next_(0)
+        {
+        }
+
+        void run()
+        {
+            while (true) {
+                size_t group;
+                {
+                    boost::mutex::scoped_lock lock(lock_);
+                    if (next_ >= groups_.size()) {
+                        return;
+                    }
+                    group = next_++;
+                }
+                const std::vector<size_t>& members = groups_[group];
+                for (std::vector<size_t>::const_iterator index = members.begin(); index != members.end(); ++index) {
+                    AppConnectionManager::ConnectCall& call = calls_[*index];
+                    call.identifier = nodes_[*index]->identifier;
+                    call.start = boost::posix_time::microsec_clock::universal_time();
+                    try {
+                        nodes_[*index]->establish();
+                    } catch (const InvalidConnection& ex) {
+                        errors_[*index] = ex.what();
+                    } catch ( ... ) {
+                        errors_[*index] = "Unknown error";
+                    }
+                    call.seconds = (boost::posix_time::microsec_clock::universal_time() - call.start).total_microseconds() * 1e-6;
+                    call.failed = !errors_[*index].empty();
+                }
+            }
+        }
+
+    private:
+        std::vector<ConnectionNode*>& nodes_;
+        const std::vector< std::vector<size_t> >& groups_;
+        std::vector<std::string>& errors_;
+        std::vector<AppConnectionManager::ConnectCall>& calls_;
+        boost::mutex lock_;
+        size_t next_;
+    };
+
+    double secondsSince(const boost::posix_time::ptime& start)
+    {
+        return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() * 1e-6;
+    }
+
+}
+
 PREPARE_LOGGING(AppConnectionManager);
 
+AppConnectionManager::Timing::Timing() :
+    resolve(0.0),
+    connect(0.0),
+    portLookups(0),
+    portCacheHits(0)
+{
+}
+
 AppConnectionManager::AppConnectionManager(DomainLookup* domainLookup,
                                            ComponentLookup* componentLookup,
                                            DeviceLookup* deviceLookup,
@@ -140,6 +223,99 @@ bool AppConnectionManager::resolveConnection(const Connection& connection)
     return false;
 }
 
+std::string AppConnectionManager::resolveConnections(const std::vector<const Connection*>& connections, size_t maxConcurrency)
+{
+    boost::ptr_vector<ConnectionNode> nodes;
+    std::vector<ConnectionNode*> pending;
+
+    // Resolve every endpoint first; lookups go through the application
+    // factory and the domain, so they stay on this thread
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    for (std::vector<const Connection*>::const_iterator connection = connections.begin(); connection != connections.end(); ++connection) {
+        ConnectionNode* node = ConnectionNode::ParseConnection(**connection);
+        if (!node) {
+            LOG_ERROR(AppConnectionManager, "Unable to parse connection");
+            return (*connection)->getID();
+        }
+        nodes.push_back(node);
+        LOG_TRACE(AppConnectionManager, "Attempting to resolve connection " << node->identifier);
+        if (!node->resolve(*this)) {
+            return node->identifier;
+        }
+        pending.push_back(node);
+    }
+    _timing.resolve += secondsSince(start);
+
+    // Connections that share a uses port are made in order by one thread
+    std::vector< std::vector<size_t> > groups;
+    std::vector<CORBA::Object_ptr> usesPorts;
+    for (size_t index = 0; index < pending.size(); ++index) {
+        CORBA::Object_ptr usesPort = pending[index]->uses->object();
+        size_t group = 0;
+        while (group < usesPorts.size() && !usesPorts[group]->_is_equivalent(usesPort)) {
+            ++group;
+        }
+        if (group == usesPorts.size()) {
+            usesPorts.push_back(usesPort);
+            groups.push_back(std::vector<size_t>());
+        }
+        groups[group].push_back(index);
+    }
+
+    start = boost::posix_time::microsec_clock::universal_time();
+    std::vector<std::string> errors(pending.size());
+    std::vector<ConnectCall> calls(pending.size());
+    ConnectWorkers workers(pending, groups, errors, calls);
+    size_t threads = std::min(maxConcurrency, groups.size());
+    if (threads <= 1) {
+        workers.run();
+    } else {
+        boost::thread_group pool;
+        for (size_t ii = 0; ii < threads; ++ii) {
+            pool.create_thread(boost::bind(&ConnectWorkers::run, &workers));
+        }
+        pool.join_all();
+    }
+    _timing.connect += secondsSince(start);
+    _timing.calls.insert(_timing.calls.end(), calls.begin(), calls.end());
+    LOG_DEBUG(AppConnectionManager, "Made " << pending.size() << " connections on " << groups.size()
+              << " uses ports with " << std::max(threads, (size_t)1) << " thread(s)");
+
+    for (size_t index = 0; index < pending.size(); ++index) {
+        if (!errors[index].empty()) {
+            throw InvalidConnection(errors[index]);
+        }
+    }
+    for (size_t index = 0; index < pending.size(); ++index) {
+        addConnection_(*pending[index]);
+    }
+    return "";
+}
+
+const AppConnectionManager::Timing& AppConnectionManager::getTiming() const
+{
+    return _timing;
+}
+
+CORBA::Object_ptr AppConnectionManager::resolvePort(CF::PortSupplier_ptr supplier, const std::string& name)
+{
+    // Several connections usually share a port, only ask the supplier once
+    PortList& ports = _portCache[name];
+    for (PortList::iterator entry = ports.begin(); entry != ports.end(); ++entry) {
+        if (entry->first->_is_equivalent(supplier)) {
+            ++_timing.portCacheHits;
+            return CORBA::Object::_duplicate(entry->second);
+        }
+    }
+
+    ++_timing.portLookups;
+    CORBA::Object_var port = ConnectionManager::resolvePort(supplier, name);
+    if (!CORBA::is_nil(port)) {
+        ports.push_back(std::make_pair(CF::PortSupplier::_duplicate(supplier), CORBA::Object::_duplicate(port)));
+    }
+    return port._retn();
+}
+
 CORBA::Object_ptr AppConnectionManager::resolveFindByNamingService(const std::string& name)
 {
     // Try the default lookup first.
@@ -204,11 +380,22 @@ void AppConnectionManager::addConnection_(const ConnectionNode& connection)
 
 PREPARE_LOGGING(DomainConnectionManager);
 
+DomainConnectionManager::Statistics::Statistics() :
+    notifications(0),
+    examined(0),
+    attempted(0),
+    established(0)
+{
+}
+
 DomainConnectionManager::DomainConnectionManager(DomainLookup* domainLookup,
                                                  ComponentLookup* componentLookup,
                                                  const std::string& domainName) :
     ConnectionManager(domainLookup, componentLookup, domainName),
-    _connectionsByRequester()
+    _connections(),
+    _connectionsByRequester(),
+    _connectionsByDependency(),
+    _version(0)
 {
 }
 
@@ -278,47 +465,40 @@ std::string DomainConnectionManager::restoreConnection(const std::string& device
 
 void DomainConnectionManager::breakConnection(const std::string& connectionRecordId)
 {
-    boost::mutex::scoped_lock(_connectionMutex);
-    std::map< std::string, std::pair<std::string, std::string> >::iterator _gC_it = _globalConnections.find(connectionRecordId);
-    if (_gC_it == _globalConnections.end()) {
+    ConnectionPtr connection;
+    {
+        boost::mutex::scoped_lock lock(_connectionLock);
+        connection = removeConnection_(connectionRecordId);
+    }
+    if (!connection) {
         // connection already broken
         throw (InvalidConnection("Connection already broken"));
     }
-    std::string deviceManagerId = _gC_it->second.first;
-    std::string connectionId = _gC_it->second.second;
-    _globalConnections.erase(_gC_it);
-    ConnectionTable::iterator table = _connectionsByRequester.find(deviceManagerId);
-    if (table != _connectionsByRequester.end()) {
-        ConnectionList& connections = table->second;
-        for (ConnectionList::iterator ii = connections.begin(); ii != connections.end(); ++ii) {
-            if (ii->identifier == connectionId) {
-                ii->disconnect(_domainLookup);
-                connections.erase(ii);
-                return;
-            }
-        }
-    }
+    // Snapshots may still refer to the stored node; break a copy
+    ConnectionNode copy(*connection);
+    copy.disconnect(_domainLookup);
 }
 
 void DomainConnectionManager::deviceManagerUnregistered(const std::string& deviceManagerName)
 {
     TRACE_ENTER(DomainConnectionManager);
-    boost::mutex::scoped_lock(_connectionLock);
-    ConnectionTable::iterator devMgr = _connectionsByRequester.find(deviceManagerName);
-    if (devMgr == _connectionsByRequester.end()) {
-        // DeviceManager has no connections.
-        return;
-    }
-    ConnectionList& connectionList = devMgr->second;
-    LOG_TRACE(DomainConnectionManager, "Deleting " << connectionList.size() << " connection(s) from DeviceManager " << deviceManagerName);
-    for (ConnectionList::iterator connection = connectionList.begin(); connection != connectionList.end(); ++connection) {
-        connection->disconnect(_domainLookup);
-        try {
-            _globalConnections.erase(connection->connectionRecordId);
-        } catch ( ... ) {
+    ConnectionPtrList connections;
+    {
+        boost::mutex::scoped_lock lock(_connectionLock);
+        std::map<std::string, std::vector<std::string> >::iterator devMgr = _connectionsByRequester.find(deviceManagerName);
+        if (devMgr == _connectionsByRequester.end()) {
+            // DeviceManager has no connections.
+            return;
+        }
+        // Drop the requester first so each removal skips its record list
+        const std::vector<std::string> records = devMgr->second;
+        _connectionsByRequester.erase(devMgr);
+        LOG_TRACE(DomainConnectionManager, "Deleting " << records.size() << " connection(s) from DeviceManager " << deviceManagerName);
+        for (std::vector<std::string>::const_iterator record = records.begin(); record != records.end(); ++record) {
+            connections.push_back(removeConnection_(*record));
         }
     }
-    _connectionsByRequester.erase(devMgr);
+    disconnectAll_(connections);
     TRACE_EXIT(DomainConnectionManager);
 }
 
@@ -327,10 +507,6 @@ void DomainConnectionManager::deviceRegistered(const std::string& deviceId)
     TRACE_ENTER(DomainConnectionManager);
     try {
         tryPendingConnections_(Endpoint::COMPONENT, deviceId);
-    } catch ( ossie::InvalidConnection &e ) {
-        std::ostringstream err;
-        err << "Invalid connection: "<<e.what();
-        LOG_WARN(DomainConnectionManager, err.str())
     } catch ( ... ) {
         LOG_WARN(DomainConnectionManager, "An error happened while trying to resolve the pending connections");
     }
@@ -349,10 +525,6 @@ void DomainConnectionManager::serviceRegistered(const std::string& serviceName)
     TRACE_ENTER(DomainConnectionManager);
     try {
         tryPendingConnections_(Endpoint::SERVICENAME, serviceName);
-    } catch ( ossie::InvalidConnection &e ) {
-        std::ostringstream err;
-        err << "Invalid connection: "<<e.what();
-        LOG_WARN(DomainConnectionManager, err.str())
     } catch ( ... ) {
         LOG_WARN(DomainConnectionManager, "An error happened while trying to resolve the pending connections");
     }
@@ -371,10 +543,6 @@ void DomainConnectionManager::applicationRegistered(const std::string& applicati
     TRACE_ENTER(DomainConnectionManager);
     try {
         tryPendingConnections_(Endpoint::APPLICATION, applicationId);
-    } catch ( ossie::InvalidConnection &e ) {
-        std::ostringstream err;
-        err << "Invalid connection: "<<e.what();
-        LOG_WARN(DomainConnectionManager, err.str())
     } catch ( ... ) {
         LOG_WARN(DomainConnectionManager, "An error happened while trying to resolve the pending connections");
     }
@@ -388,51 +556,213 @@ void DomainConnectionManager::applicationUnregistered(const std::string& applica
     TRACE_EXIT(DomainConnectionManager);
 }
 
-const ConnectionTable& DomainConnectionManager::getConnections() const
+ConnectionTable DomainConnectionManager::getConnections() const
 {
-    return _connectionsByRequester;
+    // Copy from a snapshot, so that the lock is not held while copying
+    const SnapshotPtr snapshot = getSnapshot();
+    ConnectionTable table;
+    for (std::vector<ConstConnectionPtr>::const_iterator connection = snapshot->connections.begin();
+         connection != snapshot->connections.end(); ++connection) {
+        table[(*connection)->requesterId].push_back(**connection);
+    }
+    return table;
 }
 
-std::string DomainConnectionManager::addConnection_(const std::string& requesterId, const ConnectionNode& connection)
+DomainConnectionManager::SnapshotPtr DomainConnectionManager::getSnapshot() const
+{
+    boost::mutex::scoped_lock lock(_connectionLock);
+    if (!_snapshot || (_snapshot->version != _version)) {
+        boost::shared_ptr<Snapshot> snapshot(new Snapshot());
+        snapshot->version = _version;
+        snapshot->connections.reserve(_connections.size());
+        std::map<std::string, std::vector<std::string> >::const_iterator requester;
+        for (requester = _connectionsByRequester.begin(); requester != _connectionsByRequester.end(); ++requester) {
+            for (std::vector<std::string>::const_iterator record = requester->second.begin(); record != requester->second.end(); ++record) {
+                std::map<std::string, ConnectionPtr>::const_iterator connection = _connections.find(*record);
+                if (connection != _connections.end()) {
+                    snapshot->connections.push_back(connection->second);
+                }
+            }
+        }
+        _snapshot = snapshot;
+    }
+    return _snapshot;
+}
+
+DomainConnectionManager::Changes DomainConnectionManager::getChanges(unsigned long long since) const
+{
+    Changes changes;
+    std::map<std::string, ConnectionPtr> latest;
+    {
+        boost::mutex::scoped_lock lock(_connectionLock);
+        changes.version = _version;
+        // Every change after since must still be in the log
+        if (since == 0) {
+            changes.incremental = false;
+        } else if (_changes.empty()) {
+            changes.incremental = (since == _version);
+        } else {
+            changes.incremental = (since <= _version) && (_changes.front().version <= (since + 1));
+        }
+        if (changes.incremental) {
+            for (std::deque<Change>::const_reverse_iterator change = _changes.rbegin();
+                 (change != _changes.rend()) && (change->version > since); ++change) {
+                // Walking backwards, the first change seen for a record wins
+                latest.insert(std::make_pair(change->connectionRecordId, change->connection));
+            }
+        }
+    }
+
+    if (!changes.incremental) {
+        const SnapshotPtr snapshot = getSnapshot();
+        changes.version = snapshot->version;
+        changes.added = snapshot->connections;
+        return changes;
+    }
+
+    for (std::map<std::string, ConnectionPtr>::const_iterator record = latest.begin(); record != latest.end(); ++record) {
+        if (record->second) {
+            changes.added.push_back(record->second);
+        } else {
+            changes.removed.push_back(record->first);
+        }
+    }
+    return changes;
+}
+
+void DomainConnectionManager::recordChange_(const std::string& connectionRecordId, const ConnectionPtr& connection)
 {
-    boost::mutex::scoped_lock(_connectionMutex);
-    if (_connectionsByRequester.find(requesterId) == _connectionsByRequester.end()) {
-        _connectionsByRequester[requesterId] = ConnectionList();
+    // Caller must hold _connectionLock
+    Change change;
+    change.version = ++_version;
+    change.connectionRecordId = connectionRecordId;
+    change.connection = connection;
+    _changes.push_back(change);
+    if (_changes.size() > MAX_CHANGES) {
+        _changes.pop_front();
     }
+}
+
+DomainConnectionManager::Statistics DomainConnectionManager::getStatistics() const
+{
+    boost::mutex::scoped_lock lock(_connectionLock);
+    return _statistics;
+}
+
+std::string DomainConnectionManager::addConnection_(const std::string& requesterId, const ConnectionNode& connection)
+{
+    ConnectionPtr tmpNode(new ConnectionNode(connection));
+    std::vector<ConnectionNode::Dependency> dependencies;
+    tmpNode->getDependencies(dependencies);
+
+    boost::mutex::scoped_lock lock(_connectionLock);
     std::string connectionRecordId = requesterId + std::string("_") + connection.identifier;
     std::string orig_connectionRecordId = connectionRecordId;
     int counter = 1;
-    while (_globalConnections.find(connectionRecordId) != _globalConnections.end()) {
+    while (_connections.find(connectionRecordId) != _connections.end()) {
         std::ostringstream candidate;
         candidate << orig_connectionRecordId<<"_"<<counter;
         counter++;
         connectionRecordId = candidate.str();
     }
-    _globalConnections[connectionRecordId] = std::make_pair(requesterId, connection.identifier);
-    ConnectionNode tmpNode = connection;
-    tmpNode.setconnectionRecordId(connectionRecordId);
-    _connectionsByRequester[requesterId].push_back(tmpNode);
+    tmpNode->setrequesterId(requesterId);
+    tmpNode->setconnectionRecordId(connectionRecordId);
+    _connections[connectionRecordId] = tmpNode;
+    _connectionsByRequester[requesterId].push_back(connectionRecordId);
+    for (std::vector<ConnectionNode::Dependency>::iterator dep = dependencies.begin(); dep != dependencies.end(); ++dep) {
+        _connectionsByDependency[*dep].insert(connectionRecordId);
+    }
+    recordChange_(connectionRecordId, tmpNode);
     return connectionRecordId;
 }
 
+DomainConnectionManager::ConnectionPtr DomainConnectionManager::removeConnection_(const std::string& connectionRecordId)
+{
+    // Caller must hold _connectionLock
+    std::map<std::string, ConnectionPtr>::iterator record = _connections.find(connectionRecordId);
+    if (record == _connections.end()) {
+        return ConnectionPtr();
+    }
+    ConnectionPtr connection = record->second;
+    _connections.erase(record);
+    recordChange_(connectionRecordId, ConnectionPtr());
+
+    std::map<std::string, std::vector<std::string> >::iterator requester = _connectionsByRequester.find(connection->requesterId);
+    if (requester != _connectionsByRequester.end()) {
+        std::vector<std::string>& records = requester->second;
+        records.erase(std::remove(records.begin(), records.end(), connectionRecordId), records.end());
+        if (records.empty()) {
+            _connectionsByRequester.erase(requester);
+        }
+    }
+
+    std::vector<ConnectionNode::Dependency> dependencies;
+    connection->getDependencies(dependencies);
+    for (std::vector<ConnectionNode::Dependency>::iterator dep = dependencies.begin(); dep != dependencies.end(); ++dep) {
+        std::map<ConnectionNode::Dependency, std::set<std::string> >::iterator waiting = _connectionsByDependency.find(*dep);
+        if (waiting != _connectionsByDependency.end()) {
+            waiting->second.erase(connectionRecordId);
+            if (waiting->second.empty()) {
+                _connectionsByDependency.erase(waiting);
+            }
+        }
+    }
+
+    // A connection attempt still in flight must not store its result
+    std::map<std::string, int>::iterator progress = _connectionsInProgress.find(connectionRecordId);
+    if (progress != _connectionsInProgress.end()) {
+        progress->second |= BROKEN;
+    }
+    return connection;
+}
+
 void DomainConnectionManager::tryPendingConnections_(Endpoint::DependencyType type, const std::string& identifier)
 {
     TRACE_ENTER(DomainConnectionManager);
 
-    boost::mutex::scoped_lock lock(_connectionLock);
-    for (ConnectionTable::iterator devMgr = _connectionsByRequester.begin(); devMgr != _connectionsByRequester.end(); ++devMgr) {
-        // Go through the list of connections for each DeviceManager to check
-        // for pending connections that have the given dependency, and attempt
-        // to complete the connection.
-        ConnectionList& connections = devMgr->second;
-        for (ConnectionList::iterator connection = connections.begin(); connection != connections.end(); ++connection) {
-            if (connection->connected || !connection->checkDependency(type, identifier)) {
+    // Pick out the pending connections that depend on the new object, and
+    // take a copy of each to connect without holding the lock
+    std::vector< std::pair<std::string, ConnectionPtr> > pending;
+    {
+        boost::mutex::scoped_lock lock(_connectionLock);
+        ++_statistics.notifications;
+        std::map<ConnectionNode::Dependency, std::set<std::string> >::iterator waiting;
+        waiting = _connectionsByDependency.find(std::make_pair(type, identifier));
+        if (waiting == _connectionsByDependency.end()) {
+            return;
+        }
+        for (std::set<std::string>::iterator record = waiting->second.begin(); record != waiting->second.end(); ++record) {
+            ++_statistics.examined;
+            ConnectionPtr connection = _connections[*record];
+            if (connection->connected) {
                 continue;
             }
-            LOG_TRACE(DomainConnectionManager, "Resolving pending connection " << connection->identifier);
-            if (!connection->connect(*this)) {
+            std::map<std::string, int>::iterator progress = _connectionsInProgress.find(*record);
+            if (progress != _connectionsInProgress.end()) {
+                // Another registration is connecting it; have it try again
+                progress->second |= RETRY;
+                continue;
+            }
+            _connectionsInProgress[*record] = 0;
+            pending.push_back(std::make_pair(*record, ConnectionPtr(new ConnectionNode(*connection))));
+        }
+    }
+
+    for (size_t index = 0; index < pending.size(); ++index) {
+        tryConnection_(pending[index].first, pending[index].second);
+    }
+    TRACE_EXIT(DomainConnectionManager);
+}
+
+void DomainConnectionManager::tryConnection_(const std::string& connectionRecordId, ConnectionPtr connection)
+{
+    while (true) {
+        LOG_TRACE(DomainConnectionManager, "Resolving pending connection " << connection->identifier);
+        bool connected = false;
+        try {
+            connected = connection->connect(*this);
+            if (!connected) {
                 if (!connection->allowDeferral()) {
-                    // This connection needs to be removed from the list
                     LOG_ERROR(DomainConnectionManager, "Connection " << connection->identifier << " cannot be resolved");
                 } else {
                     LOG_TRACE(DomainConnectionManager, "Connection " << connection->identifier << " still has pending dependencies");
@@ -440,46 +770,92 @@ void DomainConnectionManager::tryPendingConnections_(Endpoint::DependencyType ty
             } else {
                 LOG_DEBUG(DomainConnectionManager, "Connection " << connection->identifier << " resolved");
             }
+        } catch (const ossie::InvalidConnection& e) {
+            LOG_WARN(DomainConnectionManager, "Invalid connection: " << e.what());
+        } catch ( ... ) {
+            LOG_WARN(DomainConnectionManager, "An error happened while trying to resolve pending connection " << connection->identifier);
+        }
+
+        boost::mutex::scoped_lock lock(_connectionLock);
+        ++_statistics.attempted;
+        int flags = _connectionsInProgress[connectionRecordId];
+        std::map<std::string, ConnectionPtr>::iterator record = _connections.find(connectionRecordId);
+        if ((flags & BROKEN) || (record == _connections.end())) {
+            // Removed or lost a dependency while connecting; undo the attempt
+            _connectionsInProgress.erase(connectionRecordId);
+            lock.unlock();
+            connection->disconnect(_domainLookup);
+            return;
+        }
+
+        // Keep the attempt, which also carries any endpoints it resolved
+        record->second = connection;
+        recordChange_(connectionRecordId, connection);
+        if (connected) {
+            ++_statistics.established;
+        }
+        if (connected || !(flags & RETRY)) {
+            _connectionsInProgress.erase(connectionRecordId);
+            return;
         }
+        _connectionsInProgress[connectionRecordId] = 0;
+        connection.reset(new ConnectionNode(*connection));
     }
-    TRACE_EXIT(DomainConnectionManager);
 }
 
 void DomainConnectionManager::breakConnections_(Endpoint::DependencyType type, const std::string& identifier)
 {
     TRACE_ENTER(DomainConnectionManager);
 
-    boost::mutex::scoped_lock lock(_connectionLock);
-    for (ConnectionTable::iterator devMgr = _connectionsByRequester.begin(); devMgr != _connectionsByRequester.end(); ++devMgr) {
-        // Go through the list of connections for each DeviceManager to check
-        // for connections that have the given dependency
-        ConnectionList& connections = devMgr->second;
-        for (ConnectionList::iterator connection = connections.begin(); connection != connections.end(); ) {
-            bool remove = false;
-            if (connection->checkDependency(type, identifier)) {
-                // If the connection does not allow deferral of this dependency
-                // (e.g, an application is going away), remove the connection
-                if (!connection->allowDeferral(type, identifier)) {
-                    remove = true;
-                }
-                // If the connection is still connected, break it
-                if (connection->connected) {
-                    LOG_TRACE(DomainConnectionManager, "Breaking connection " << connection->identifier);
-                    connection->disconnect(_domainLookup);
-                }
+    ConnectionPtrList broken;
+    {
+        boost::mutex::scoped_lock lock(_connectionLock);
+        std::map<ConnectionNode::Dependency, std::set<std::string> >::iterator waiting;
+        waiting = _connectionsByDependency.find(std::make_pair(type, identifier));
+        if (waiting == _connectionsByDependency.end()) {
+            return;
+        }
+        // Copy the record ids, removing connections updates the index
+        const std::set<std::string> records = waiting->second;
+        for (std::set<std::string>::const_iterator record = records.begin(); record != records.end(); ++record) {
+            ConnectionPtr connection = _connections[*record];
+            std::map<std::string, int>::iterator progress = _connectionsInProgress.find(*record);
+            if (progress != _connectionsInProgress.end()) {
+                progress->second |= BROKEN;
             }
-            if (remove) {
+            // If the connection does not allow deferral of this dependency
+            // (e.g, an application is going away), remove the connection
+            if (!connection->allowDeferral(type, identifier)) {
                 LOG_TRACE(DomainConnectionManager, "Removing connection " << connection->identifier << " that does not allow deferral");
-                connection = connections.erase(connection);
-            } else {
-                ++connection;
+                broken.push_back(removeConnection_(*record));
+            } else if (connection->connected) {
+                // Keep a pending copy of the connection, and break the
+                // established one once the lock is released
+                LOG_TRACE(DomainConnectionManager, "Breaking connection " << connection->identifier);
+                broken.push_back(connection);
+                ConnectionPtr pending(new ConnectionNode(*connection));
+                pending->reset();
+                _connections[*record] = pending;
+                recordChange_(*record, pending);
             }
         }
     }
+    disconnectAll_(broken);
 
     TRACE_EXIT(DomainConnectionManager);
 }
 
+void DomainConnectionManager::disconnectAll_(ConnectionPtrList& connections)
+{
+    // The nodes may still be referenced by snapshots; disconnect copies
+    for (ConnectionPtrList::iterator connection = connections.begin(); connection != connections.end(); ++connection) {
+        if (*connection) {
+            ConnectionNode copy(**connection);
+            copy.disconnect(_domainLookup);
+        }
+    }
+}
+
 
 #if HAVE_BOOST_SERIALIZATION
 EXPORT_CLASS_SERIALIZATION(ApplicationEndpoint);
@@ -687,6 +1063,14 @@ bool ConnectionNode::connect(ConnectionManager& manager)
         return true;
     }
 
+    if (!resolve(manager)) {
+        return false;
+    }
+    return establish();
+}
+
+bool ConnectionNode::resolve(ConnectionManager& manager)
+{
     CORBA::Object_var usesObject = CORBA::Object::_nil();
     CORBA::Object_var providesPort = CORBA::Object::_nil();
     try {
@@ -713,15 +1097,19 @@ bool ConnectionNode::connect(ConnectionManager& manager)
             }
         }
     }
+    return true;
+}
 
-    CF::Port_var usesPort = ossie::corba::_narrowSafe<CF::Port>(usesObject);
+bool ConnectionNode::establish()
+{
+    CF::Port_var usesPort = ossie::corba::_narrowSafe<CF::Port>(uses->object());
     if (CORBA::is_nil(usesPort)) {
         LOG_ERROR(ConnectionNode, "Uses port is not a CF::Port");
         throw InvalidConnection("Uses port is not a CF::Port");
     }
 
     try {
-        usesPort->connectPort(providesPort, identifier.c_str());
+        usesPort->connectPort(provides->object(), identifier.c_str());
         connected = true;
         return true;
     } catch (const CF::Port::InvalidPort& ip) {
@@ -806,6 +1194,26 @@ bool ConnectionNode::checkDependency(Endpoint::DependencyType type, const std::s
     return (uses->checkDependency(type, identifier) || provides->checkDependency(type, identifier));
 }
 
+void ConnectionNode::getDependencies(std::vector<Dependency>& dependencies) const
+{
+    Dependency dependency;
+    if (uses->getDependency(dependency.first, dependency.second)) {
+        dependencies.push_back(dependency);
+    }
+    if (provides->getDependency(dependency.first, dependency.second)) {
+        if (dependencies.empty() || dependencies.front() != dependency) {
+            dependencies.push_back(dependency);
+        }
+    }
+}
+
+void ConnectionNode::reset()
+{
+    connected = false;
+    uses->release();
+    provides->release();
+}
+
 CREATE_LOGGER(connectionSupport);
 
 std::string ossie::eventChannelName(const FindBy* findby)
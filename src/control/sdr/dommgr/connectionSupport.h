@@ -23,10 +23,15 @@
 
 #include <string>
 #include <vector>
+#include <set>
+#include <map>
+#include <deque>
 #include <stdexcept>
 
 #include <boost/thread/mutex.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #if HAVE_BOOST_SERIALIZATION
 #include <boost/serialization/access.hpp>
 #endif
@@ -106,6 +111,10 @@ namespace ossie
         virtual bool allowDeferral() = 0;
         virtual bool checkDependency(DependencyType type, const std::string& identifier) const = 0;
 
+        // Reports the domain object this endpoint waits on, if any; it must
+        // agree with checkDependency, and is used to index pending connections.
+        virtual bool getDependency(DependencyType& type, std::string& identifier) const { return false; }
+
         void release();
 
         // Virtual copy contstructor
@@ -152,10 +161,24 @@ namespace ossie
         bool connect(ConnectionManager& manager);
         void disconnect(DomainLookup* domainLookup);
 
+        // The two halves of connect(): resolve() looks up both endpoints and
+        // returns false if the connection must wait; establish() makes the
+        // connectPort call for a resolved connection, and does not use the
+        // ConnectionManager.
+        bool resolve(ConnectionManager& manager);
+        bool establish();
+
         bool allowDeferral();
         bool allowDeferral(Endpoint::DependencyType type, const std::string& identifier);
         bool checkDependency(Endpoint::DependencyType type, const std::string& identifier) const;
 
+        typedef std::pair<Endpoint::DependencyType, std::string> Dependency;
+        void getDependencies(std::vector<Dependency>& dependencies) const;
+
+        // Forgets an established connection without contacting the uses port;
+        // a copy of the node made beforehand can still disconnect() it.
+        void reset();
+
         // Default ctor and assignment exist only for deserialization support.
         ConnectionNode() { }
         const ConnectionNode& operator=(const ConnectionNode& other)
@@ -210,6 +233,9 @@ namespace ossie
         // Subclasses may override or extend the NamingService lookup behavior.
         virtual CORBA::Object_ptr resolveFindByNamingService(const std::string& name);
 
+        // Subclasses may cache the ports returned by a port supplier.
+        virtual CORBA::Object_ptr resolvePort(CF::PortSupplier_ptr supplier, const std::string& name);
+
         // Subclasses must implement these device lookups as appropriate.
         virtual CF::Device_ptr resolveDeviceThatLoadedThisComponentRef(const std::string& refid) = 0;
         virtual CF::Device_ptr resolveDeviceUsedByThisComponentRef(const std::string& refid, const std::string& usesid) = 0;
@@ -237,6 +263,36 @@ namespace ossie
         bool resolveConnection(const ossie::Connection& connection);
         const ConnectionList& getConnections();
 
+        // Makes a batch of connections: the endpoints are resolved in order
+        // on the calling thread, then the connectPort calls are made from up
+        // to maxConcurrency threads, with calls on the same uses port kept in
+        // order. Returns the identifier of a connection that could not be
+        // resolved, or an empty string; a failed connectPort call throws
+        // InvalidConnection, as resolveConnection does. Connections are only
+        // recorded once the whole batch succeeds.
+        std::string resolveConnections(const std::vector<const ossie::Connection*>& connections, size_t maxConcurrency);
+
+        // One connectPort call made by resolveConnections
+        struct ConnectCall {
+            std::string identifier;
+            boost::posix_time::ptime start;
+            double seconds;
+            bool failed;
+        };
+
+        // Time spent in the phases of resolveConnections
+        struct Timing {
+            Timing();
+            double resolve;         // seconds resolving endpoints
+            double connect;         // seconds in connectPort calls
+            size_t portLookups;     // getPort calls made
+            size_t portCacheHits;   // getPort calls saved by the cache
+            std::vector<ConnectCall> calls;
+        };
+        const Timing& getTiming() const;
+
+        virtual CORBA::Object_ptr resolvePort(CF::PortSupplier_ptr supplier, const std::string& name);
+
     protected:
         virtual CORBA::Object_ptr resolveFindByNamingService(const std::string& name);
         virtual CF::Device_ptr resolveDeviceThatLoadedThisComponentRef(const std::string& refid);
@@ -248,6 +304,11 @@ namespace ossie
         ossie::DeviceLookup* _deviceLookup;
 
         ConnectionList _connections;
+
+        // Ports already returned by getPort, by port name, with their supplier
+        typedef std::vector< std::pair<CF::PortSupplier_var, CORBA::Object_var> > PortList;
+        std::map<std::string, PortList> _portCache;
+        Timing _timing;
     };
 
     class DomainConnectionManager : public ConnectionManager
@@ -276,20 +337,88 @@ namespace ossie
         void applicationRegistered(const std::string& applicationId);
         void applicationUnregistered(const std::string& applicationId);
 
-        const ConnectionTable& getConnections() const;
+        // Returns a copy of the connections, grouped by requester
+        ConnectionTable getConnections() const;
+
+        // Read-only view of the connections at one version, in requester
+        // order. Stored connections are replaced rather than modified, so a
+        // snapshot can be read without the lock while the table moves on;
+        // it is only rebuilt when a reader finds it out of date.
+        typedef boost::shared_ptr<const ConnectionNode> ConstConnectionPtr;
+        struct Snapshot {
+            unsigned long long version;
+            std::vector<ConstConnectionPtr> connections;
+        };
+        typedef boost::shared_ptr<const Snapshot> SnapshotPtr;
+        SnapshotPtr getSnapshot() const;
+
+        // Net changes since an earlier version: connections that were added
+        // or changed, and the record ids of those removed. When the changes
+        // since that version are no longer kept (or since is 0), incremental
+        // is false and added holds every connection.
+        struct Changes {
+            unsigned long long version;
+            bool incremental;
+            std::vector<ConstConnectionPtr> added;
+            std::vector<std::string> removed;
+        };
+        Changes getChanges(unsigned long long since) const;
+
+        // Work done by registrations looking for pending connections
+        struct Statistics {
+            Statistics();
+            size_t notifications;   // registrations that checked for pending connections
+            size_t examined;        // connections those registrations looked at
+            size_t attempted;       // connection attempts
+            size_t established;     // attempts that completed a connection
+        };
+        Statistics getStatistics() const;
 
     protected:
         virtual CF::Device_ptr resolveDeviceThatLoadedThisComponentRef(const std::string& refid);
         virtual CF::Device_ptr resolveDeviceUsedByThisComponentRef(const std::string& refid, const std::string& usesrefid);
         virtual CF::Device_ptr resolveDeviceUsedByApplication(const std::string& usesrefid);
 
+        typedef boost::shared_ptr<ConnectionNode> ConnectionPtr;
+        typedef std::vector<ConnectionPtr> ConnectionPtrList;
+
         std::string addConnection_(const std::string& deviceManagerId, const ConnectionNode& connection);
+        ConnectionPtr removeConnection_(const std::string& connectionRecordId);
+        void recordChange_(const std::string& connectionRecordId, const ConnectionPtr& connection);
         void tryPendingConnections_(Endpoint::DependencyType type, const std::string& identifier);
+        void tryConnection_(const std::string& connectionRecordId, ConnectionPtr connection);
         void breakConnections_(Endpoint::DependencyType type, const std::string& identifier);
-
-        boost::mutex _connectionLock;
-        ConnectionTable _connectionsByRequester;
-        std::map< std::string, std::pair<std::string, std::string> > _globalConnections;
+        void disconnectAll_(ConnectionPtrList& connections);
+
+        // Flags for a connection being connected outside of the lock
+        enum {
+            RETRY = 0x1,    // another of its dependencies registered meanwhile
+            BROKEN = 0x2    // one of its dependencies unregistered meanwhile
+        };
+
+        // Connections are keyed by connection record id, and indexed by
+        // requester (in the order they were added) and by the objects they
+        // depend on, so that a registration only visits the connections
+        // waiting on it. Remote calls are made without holding the lock.
+        mutable boost::mutex _connectionLock;
+        std::map<std::string, ConnectionPtr> _connections;
+        std::map<std::string, std::vector<std::string> > _connectionsByRequester;
+        std::map<ConnectionNode::Dependency, std::set<std::string> > _connectionsByDependency;
+        std::map<std::string, int> _connectionsInProgress;
+        Statistics _statistics;
+
+        // Bumped on every change to _connections; the last MAX_CHANGES
+        // changes are kept (with a null connection for a removal) to answer
+        // getChanges
+        struct Change {
+            unsigned long long version;
+            std::string connectionRecordId;
+            ConnectionPtr connection;
+        };
+        static const size_t MAX_CHANGES = 4096;
+        unsigned long long _version;
+        std::deque<Change> _changes;
+        mutable SnapshotPtr _snapshot;
     };
 
     // Miscellaneous helper functions
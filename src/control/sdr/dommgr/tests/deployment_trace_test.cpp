@@ -0,0 +1,260 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Exercises DeploymentTrace by opening its scopes in the order and nesting
+ * that createHelper uses for a two component create. Checks that every
+ * phase and remote call is recorded, in the order it completed, with each
+ * span inside the create span and the phases following one another; that
+ * a create that fails part way marks only the spans it unwound through;
+ * and that the property values and a full ring keep the same order.
+ *
+ * usage: deployment_trace_test
+ */
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "DeploymentTrace.h"
+#include <ossie/testing/check.h>
+
+using namespace ossie;
+using namespace ossie::testing;
+
+static const char* COMPONENTS[] = { "comp_1", "comp_2" };
+static const size_t NUM_COMPONENTS = sizeof(COMPONENTS) / sizeof(COMPONENTS[0]);
+
+// Opens the same scopes as createHelper::create, in the same order; throws
+// from inside the given phase, if any
+static void create( DeploymentTrace* trace, const std::string& failIn=std::string() )
+{
+    DeploymentTrace::Scope create(trace, "create");
+    {
+        DeploymentTrace::Scope span(trace, "getRequiredComponents");
+    }
+    {
+        DeploymentTrace::Scope span(trace, "handleUsesDevices");
+    }
+    {
+        DeploymentTrace::Scope span(trace, "assignComponentsUsingDAS");
+    }
+    {
+        DeploymentTrace::Scope span(trace, "handleHostCollocation");
+    }
+    {
+        DeploymentTrace::Scope span(trace, "assignRemainingComponentsToDevices");
+        for (size_t index = 0; index < NUM_COMPONENTS; ++index) {
+            DeploymentTrace::Scope call(trace, "allocateComponent", COMPONENTS[index]);
+        }
+    }
+    {
+        DeploymentTrace::Scope span(trace, "loadAndExecuteComponents");
+        for (size_t index = 0; index < NUM_COMPONENTS; ++index) {
+            {
+                DeploymentTrace::Scope call(trace, "load", COMPONENTS[index]);
+            }
+            DeploymentTrace::Scope call(trace, "execute", COMPONENTS[index]);
+        }
+    }
+    {
+        DeploymentTrace::Scope span(trace, "waitForComponentRegistration");
+    }
+    {
+        DeploymentTrace::Scope span(trace, "initializeComponents");
+        for (size_t index = 0; index < NUM_COMPONENTS; ++index) {
+            {
+                DeploymentTrace::Scope call(trace, "initializeProperties", COMPONENTS[index]);
+            }
+            DeploymentTrace::Scope call(trace, "initialize", COMPONENTS[index]);
+            if (failIn == "initialize") {
+                throw std::runtime_error("initialize failed");
+            }
+        }
+    }
+    {
+        // Connections are timed by the worker threads and added afterwards
+        DeploymentTrace::Scope span(trace, "connectComponents");
+        trace->record("connect", "connection_1", boost::posix_time::microsec_clock::universal_time(), 0.0, false);
+    }
+    {
+        DeploymentTrace::Scope span(trace, "configureComponents");
+        for (size_t index = 0; index < NUM_COMPONENTS; ++index) {
+            DeploymentTrace::Scope call(trace, "configure", COMPONENTS[index]);
+        }
+    }
+    {
+        DeploymentTrace::Scope span(trace, "setUpExternalPorts");
+    }
+    {
+        DeploymentTrace::Scope span(trace, "setUpExternalProperties");
+    }
+}
+
+static std::string describe( const TraceSpan& span )
+{
+    if (span.component.empty()) {
+        return span.phase;
+    }
+    return span.phase + "(" + span.component + ")";
+}
+
+static std::vector<std::string> describe( const std::vector<TraceSpan>& spans )
+{
+    std::vector<std::string> result;
+    for (size_t index = 0; index < spans.size(); ++index) {
+        result.push_back(describe(spans[index]));
+    }
+    return result;
+}
+
+// Durations are recorded in whole microseconds
+static boost::posix_time::ptime endOf( const TraceSpan& span )
+{
+    return span.start + boost::posix_time::microseconds(static_cast<long>(span.seconds * 1e6 + 0.5));
+}
+
+static bool contains( const TraceSpan& outer, const TraceSpan& inner )
+{
+    return (inner.start >= outer.start) && (endOf(inner) <= endOf(outer));
+}
+
+int main(int argc, char* argv[])
+{
+    {
+        // A successful create records every phase and call as it completes,
+        // so each phase follows the calls made inside it and create is last
+        DeploymentTrace trace;
+        create(&trace);
+
+        const char* expected[] = {
+            "getRequiredComponents",
+            "handleUsesDevices",
+            "assignComponentsUsingDAS",
+            "handleHostCollocation",
+            "allocateComponent(comp_1)", "allocateComponent(comp_2)",
+            "assignRemainingComponentsToDevices",
+            "load(comp_1)", "execute(comp_1)", "load(comp_2)", "execute(comp_2)",
+            "loadAndExecuteComponents",
+            "waitForComponentRegistration",
+            "initializeProperties(comp_1)", "initialize(comp_1)",
+            "initializeProperties(comp_2)", "initialize(comp_2)",
+            "initializeComponents",
+            "connect(connection_1)",
+            "connectComponents",
+            "configure(comp_1)", "configure(comp_2)",
+            "configureComponents",
+            "setUpExternalPorts",
+            "setUpExternalProperties",
+            "create"
+        };
+        const std::vector<std::string> phases(expected, expected + sizeof(expected) / sizeof(expected[0]));
+        const std::vector<TraceSpan> spans = trace.spans();
+        check(describe(spans) == phases, "create phases recorded in completion order");
+        check(trace.dropped() == 0, "nothing dropped from a default sized trace");
+
+        bool failed = false;
+        bool inside = !spans.empty();
+        bool sequential = true;
+        const TraceSpan* previous = 0;
+        for (size_t index = 0; index < spans.size(); ++index) {
+            failed = failed || spans[index].failed;
+            inside = inside && contains(spans.back(), spans[index]);
+            if (spans[index].component.empty() && index + 1 < spans.size()) {
+                // Each top-level phase starts once the one before it ended
+                if (previous) {
+                    sequential = sequential && (spans[index].start >= endOf(*previous));
+                }
+                previous = &spans[index];
+            }
+        }
+        check(!failed, "no span of a successful create marked failed");
+        check(inside, "every span lies within the create span");
+        check(sequential, "phases follow one another");
+
+        // The property values list the spans in the same order
+        const std::string json = trace.toJSON();
+        size_t position = 0;
+        bool ordered = true;
+        for (size_t index = 0; index < spans.size(); ++index) {
+            const std::string field = "\"phase\":\"" + spans[index].phase + "\"";
+            const size_t found = json.find(field, position);
+            ordered = ordered && (found != std::string::npos);
+            position = found;
+        }
+        check(ordered, "JSON lists spans in recorded order");
+
+        CORBA::Any value = trace.toAny();
+        const CORBA::AnySeq* structs;
+        bool matches = (value >>= structs) && (structs->length() == spans.size());
+        for (CORBA::ULong index = 0; matches && index < structs->length(); ++index) {
+            const CF::Properties* fields;
+            const char* phase;
+            matches = ((*structs)[index] >>= fields) && (fields->length() == 5)
+                && ((*fields)[0].value >>= phase) && (spans[index].phase == phase);
+        }
+        check(matches, "struct sequence lists spans in recorded order");
+    }
+
+    {
+        // A create that fails stops recording phases, and marks the spans
+        // the exception unwound through as failed
+        DeploymentTrace trace;
+        bool threw = false;
+        try {
+            create(&trace, "initialize");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        check(threw, "failed create throws");
+
+        const std::vector<TraceSpan> spans = trace.spans();
+        std::vector<std::string> failedPhases;
+        for (size_t index = 0; index < spans.size(); ++index) {
+            if (spans[index].failed) {
+                failedPhases.push_back(describe(spans[index]));
+            }
+        }
+        const char* expected[] = { "initialize(comp_1)", "initializeComponents", "create" };
+        const std::vector<std::string> phases(expected, expected + 3);
+        check(failedPhases == phases, "only the unwound spans marked failed");
+        check(!spans.empty() && describe(spans.back()) == "create", "failed create span recorded last");
+        check(!spans.empty() && describe(spans[spans.size() - 2]) == "initializeComponents", "no phase recorded after the failure");
+    }
+
+    {
+        // A full ring keeps the most recent spans, oldest first
+        DeploymentTrace trace(4);
+        create(&trace);
+        const char* expected[] = { "configureComponents", "setUpExternalPorts", "setUpExternalProperties", "create" };
+        const std::vector<std::string> phases(expected, expected + 4);
+        check(describe(trace.spans()) == phases, "full ring keeps the last spans in order");
+        check(trace.dropped() == 22, "overwritten spans counted");
+    }
+
+    {
+        // Without a trace, the scopes record nothing and do not fail
+        DeploymentTrace::Scope span(0, "create");
+    }
+
+    return result();
+}
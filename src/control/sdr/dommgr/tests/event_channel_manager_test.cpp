@@ -0,0 +1,444 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Exercises the EventChannelManager, built standalone as for ecm_bench,
+ * against a local naming context and event channel factory. Checks that the
+ * factory lookup backs off while nobody needs it but is made at once for a
+ * caller, that a channel being created only holds up its own registrants,
+ * that a failed registerResources backs out every registration it made, and
+ * that terminate destroys each channel once without holding up the rest of
+ * the manager.
+ *
+ * usage: event_channel_manager_test
+ */
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <COS/CosEventChannelAdmin.hh>
+#include <COS/CosNaming.hh>
+
+#include <ossie/CorbaUtils.h>
+
+#include "EventChannelManager.h"
+#include <ossie/testing/check.h>
+
+using namespace ossie::testing;
+
+class TestChannel : public virtual POA_CosEventChannelAdmin::EventChannel
+{
+public:
+    TestChannel(boost::mutex& lock, boost::condition_variable& cond, bool& blocked, int& destroyed) :
+        lock_(lock),
+        cond_(cond),
+        blocked_(blocked),
+        destroyed_(destroyed)
+    {
+    }
+
+    CosEventChannelAdmin::ConsumerAdmin_ptr for_consumers()
+    {
+        return CosEventChannelAdmin::ConsumerAdmin::_nil();
+    }
+
+    CosEventChannelAdmin::SupplierAdmin_ptr for_suppliers()
+    {
+        return CosEventChannelAdmin::SupplierAdmin::_nil();
+    }
+
+    // Waits while the factory holds destruction
+    void destroy()
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        while (blocked_) {
+            cond_.wait(lock);
+        }
+        ++destroyed_;
+        cond_.notify_all();
+    }
+
+private:
+    boost::mutex& lock_;
+    boost::condition_variable& cond_;
+    bool& blocked_;
+    int& destroyed_;
+};
+
+class TestFactory : public virtual POA_CosLifeCycle::GenericFactory
+{
+public:
+    TestFactory() : blockDestroy_(false), destroyed_(0) { }
+
+    CORBA::Boolean supports(const CosLifeCycle::Key&)
+    {
+        return true;
+    }
+
+    CORBA::Object_ptr create_object(const CosLifeCycle::Key&, const CosLifeCycle::Criteria& criteria)
+    {
+        // The channel is created by its fully-qualified name
+        const char* insName = "";
+        criteria[0].value >>= insName;
+        std::string name(insName);
+        name = name.substr(name.rfind('.') + 1);
+
+        boost::mutex::scoped_lock lock(lock_);
+        ++creates_[name];
+        cond_.notify_all();
+        while (blockCreate_ == name) {
+            cond_.wait(lock);
+        }
+        if (name.find("bad") != std::string::npos) {
+            throw CosLifeCycle::CannotMeetCriteria(criteria);
+        }
+        TestChannel* channel = new TestChannel(lock_, cond_, blockDestroy_, destroyed_);
+        PortableServer::ObjectId_var oid = ossie::corba::RootPOA()->activate_object(channel);
+        channel->_remove_ref();
+        return channel->_this();
+    }
+
+    // Holds the creation of the named channel (or none, if empty)
+    void blockCreate(const std::string& name)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        blockCreate_ = name;
+        cond_.notify_all();
+    }
+
+    void blockDestroy(bool blocked)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        blockDestroy_ = blocked;
+        cond_.notify_all();
+    }
+
+    int creates(const std::string& name)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        return creates_[name];
+    }
+
+    int destroyed()
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        return destroyed_;
+    }
+
+    // Waits for the named channel's creation to start
+    bool waitForCreate(const std::string& name, int timeout)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds(timeout);
+        while (creates_[name] == 0) {
+            if (!cond_.timed_wait(lock, deadline)) return false;
+        }
+        return true;
+    }
+
+private:
+    boost::mutex lock_;
+    boost::condition_variable cond_;
+    std::map<std::string,int> creates_;
+    std::string blockCreate_;
+    bool blockDestroy_;
+    int destroyed_;
+};
+
+// Naming context that only knows the EventChannelFactory, which can be
+// withdrawn to make the lookup fail
+class TestNamingContext : public virtual POA_CosNaming::NamingContextExt
+{
+public:
+    TestNamingContext(CORBA::Object_ptr factory) :
+        factory_(CORBA::Object::_duplicate(factory)),
+        available_(false)
+    {
+    }
+
+    CORBA::Object_ptr resolve_str(const char* name)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        if (std::string(name) == "EventChannelFactory") {
+            lookups_.push_back(boost::get_system_time());
+            if (available_) {
+                return CORBA::Object::_duplicate(factory_);
+            }
+        }
+        throw CosNaming::NamingContext::NotFound();
+    }
+
+    void setAvailable(bool available)
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        available_ = available;
+    }
+
+    std::vector<boost::system_time> lookups()
+    {
+        boost::mutex::scoped_lock lock(lock_);
+        return lookups_;
+    }
+
+    void bind(const CosNaming::Name&, CORBA::Object_ptr) { throw CORBA::NO_IMPLEMENT(); }
+    void rebind(const CosNaming::Name&, CORBA::Object_ptr) { throw CORBA::NO_IMPLEMENT(); }
+    void bind_context(const CosNaming::Name&, CosNaming::NamingContext_ptr) { throw CORBA::NO_IMPLEMENT(); }
+    void rebind_context(const CosNaming::Name&, CosNaming::NamingContext_ptr) { throw CORBA::NO_IMPLEMENT(); }
+    CORBA::Object_ptr resolve(const CosNaming::Name&) { throw CosNaming::NamingContext::NotFound(); }
+    void unbind(const CosNaming::Name&) { throw CORBA::NO_IMPLEMENT(); }
+    CosNaming::NamingContext_ptr new_context() { throw CORBA::NO_IMPLEMENT(); }
+    CosNaming::NamingContext_ptr bind_new_context(const CosNaming::Name&) { throw CORBA::NO_IMPLEMENT(); }
+    void destroy() { throw CORBA::NO_IMPLEMENT(); }
+    void list(CORBA::ULong, CosNaming::BindingList_out, CosNaming::BindingIterator_out) { throw CORBA::NO_IMPLEMENT(); }
+    char* to_string(const CosNaming::Name&) { throw CORBA::NO_IMPLEMENT(); }
+    CosNaming::Name* to_name(const char*) { throw CORBA::NO_IMPLEMENT(); }
+    char* to_url(const char*, const char*) { throw CORBA::NO_IMPLEMENT(); }
+
+private:
+    boost::mutex lock_;
+    CORBA::Object_var factory_;
+    bool available_;
+    std::vector<boost::system_time> lookups_;
+};
+
+// Registers one publisher from its own thread, so that a registration held
+// up by a channel being created can be watched from the test
+class Registrant {
+public:
+    Registrant(EventChannelManager* manager, const std::string& channel, const std::string& regid) :
+        manager_(manager),
+        channel_(channel),
+        regid_(regid),
+        failed_(false)
+    {
+    }
+
+    void operator() ()
+    {
+        ossie::events::EventRegistration request;
+        request.channel_name = channel_.c_str();
+        request.reg_id = regid_.c_str();
+        try {
+            ossie::events::EventChannelReg_var reg = manager_->registerResource(request);
+            channel_ref_ = ossie::events::EventChannel::_duplicate(reg->channel);
+        } catch (...) {
+            failed_ = true;
+        }
+    }
+
+    bool failed() const
+    {
+        return failed_;
+    }
+
+    ossie::events::EventChannel_ptr channel() const
+    {
+        return channel_ref_.in();
+    }
+
+private:
+    EventChannelManager* manager_;
+    std::string channel_;
+    std::string regid_;
+    bool failed_;
+    ossie::events::EventChannel_var channel_ref_;
+};
+
+static ossie::events::EventRegistration registration( const std::string& channel, const std::string& regid )
+{
+    ossie::events::EventRegistration request;
+    request.channel_name = channel.c_str();
+    request.reg_id = regid.c_str();
+    return request;
+}
+
+static size_t registrantCount( EventChannelManager* manager, const std::string& channel )
+{
+    CF::EventChannelManager::EventRegistrantList_var registrants;
+    CF::EventRegistrantIterator_var iterator;
+    manager->listRegistrants(channel.c_str(), 100, registrants, iterator);
+    return registrants->length();
+}
+
+static double seconds( const boost::posix_time::time_duration& duration )
+{
+    return duration.total_microseconds() * 1e-6;
+}
+
+static void terminateManager( EventChannelManager* manager )
+{
+    manager->terminate();
+}
+
+static void findChannel( EventChannelManager* manager, const std::string& channel, bool* found )
+{
+    *found = manager->isChannel(channel);
+}
+
+int main(int argc, char* argv[])
+{
+    ossie::corba::CorbaInit(argc, argv);
+
+    TestFactory* factory = new TestFactory();
+    PortableServer::ObjectId_var factoryId = ossie::corba::RootPOA()->activate_object(factory);
+    CosLifeCycle::GenericFactory_var factoryRef = factory->_this();
+    TestNamingContext* naming = new TestNamingContext(factoryRef);
+    PortableServer::ObjectId_var namingId = ossie::corba::RootPOA()->activate_object(naming);
+    CosNaming::NamingContextExt_var namingRef = naming->_this();
+    ossie::corba::Orb()->register_initial_reference("NameService", namingRef);
+
+    // The manager looks the factory up when it is created and fails, then
+    // keeps trying from its reconnect thread
+    EventChannelManager* manager = new EventChannelManager(true, false, false);
+
+    {
+        // Retries back off while no caller is waiting: lookups at about
+        // 0, 1 and 3 seconds, rather than every second
+        boost::this_thread::sleep(boost::posix_time::milliseconds(3500));
+        std::vector<boost::system_time> lookups = naming->lookups();
+        checkEqual("background lookups", lookups.size(), (size_t) 3);
+        if (lookups.size() >= 3) {
+            double first = seconds(lookups[1] - lookups[0]);
+            double second = seconds(lookups[2] - lookups[1]);
+            check(second > first * 1.5, "retry period grows between lookups");
+        }
+
+        // A caller gets a lookup at once, and is told when it fails
+        boost::system_time start = boost::get_system_time();
+        bool unavailable = false;
+        try {
+            ossie::events::EventChannelReg_var reg = manager->registerResource(registration("early", ""));
+        } catch (const CF::EventChannelManager::ServiceUnavailable&) {
+            unavailable = true;
+        }
+        check(unavailable, "registration without a factory is refused");
+        check(seconds(boost::get_system_time() - start) < 0.5, "caller does not wait out the backoff");
+        checkEqual("requested lookup", naming->lookups().size(), (size_t) 4);
+
+        // Once the factory is back, the next caller finds it
+        naming->setAvailable(true);
+        ossie::events::EventChannelReg_var reg = manager->registerResource(registration("first", "first-1"));
+        check(!CORBA::is_nil(reg->channel), "registration after factory returns");
+        const size_t resolved = naming->lookups().size();
+        boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+        checkEqual("no lookups once resolved", naming->lookups().size(), resolved);
+    }
+
+    {
+        // A channel being created holds up its own registrants only
+        factory->blockCreate("slow");
+        Registrant first(manager, "slow", "slow-1");
+        boost::thread firstThread(boost::ref(first));
+        check(factory->waitForCreate("slow", 5000), "slow channel creation started");
+
+        Registrant second(manager, "slow", "slow-2");
+        boost::thread secondThread(boost::ref(second));
+
+        Registrant other(manager, "fast", "fast-1");
+        boost::thread otherThread(boost::ref(other));
+        check(otherThread.timed_join(boost::posix_time::seconds(5)), "other channel registered during creation");
+        check(!other.failed(), "other channel registration succeeded");
+        check(manager->isChannel("slow"), "manager answers during creation");
+        check(!secondThread.timed_join(boost::posix_time::milliseconds(100)), "same channel registrant waits for creation");
+
+        factory->blockCreate("");
+        check(firstThread.timed_join(boost::posix_time::seconds(5)), "first slow registrant finished");
+        check(secondThread.timed_join(boost::posix_time::seconds(5)), "second slow registrant finished");
+        check(!first.failed() && !second.failed(), "slow registrations succeeded");
+        check(first.channel()->_is_equivalent(second.channel()), "slow registrants share the channel");
+        checkEqual("slow channel creations", factory->creates("slow"), 1);
+        checkEqual("slow registrants", registrantCount(manager, "slow"), (size_t) 2);
+    }
+
+    {
+        // A channel that cannot be created backs out the channels before it
+        // (requests are handled in channel name order) but not registrations
+        // made earlier
+        ossie::events::EventChannelReg_var kept = manager->registerResource(registration("a_good", "kept"));
+        ossie::events::EventRegistrationList requests;
+        requests.length(4);
+        requests[0] = registration("a_good", "a-1");
+        requests[1] = registration("b_good", "b-1");
+        requests[2] = registration("b_good", "b-2");
+        requests[3] = registration("z_bad", "bad-1");
+        bool failed = false;
+        try {
+            ossie::events::EventChannelRegList_var regs = manager->registerResources(requests);
+        } catch (const CF::EventChannelManager::OperationFailed&) {
+            failed = true;
+        }
+        check(failed, "batch with an uncreatable channel fails");
+        checkEqual("a_good registrants after back out", registrantCount(manager, "a_good"), (size_t) 1);
+        checkEqual("b_good registrants after back out", registrantCount(manager, "b_good"), (size_t) 0);
+        check(!manager->isChannel("z_bad"), "failed channel not left in the table");
+
+        // A duplicate within one channel backs out that channel's earlier
+        // registrations too
+        requests.length(3);
+        requests[0] = registration("b_good", "b-1");
+        requests[1] = registration("c_dup", "dup");
+        requests[2] = registration("c_dup", "dup");
+        failed = false;
+        try {
+            ossie::events::EventChannelRegList_var regs = manager->registerResources(requests);
+        } catch (const CF::EventChannelManager::RegistrationAlreadyExists&) {
+            failed = true;
+        }
+        check(failed, "batch with a duplicate registration fails");
+        checkEqual("b_good registrants after duplicate", registrantCount(manager, "b_good"), (size_t) 0);
+        checkEqual("c_dup registrants after duplicate", registrantCount(manager, "c_dup"), (size_t) 0);
+
+        // The same batch without the duplicate succeeds
+        requests.length(2);
+        ossie::events::EventChannelRegList_var regs = manager->registerResources(requests);
+        checkEqual("batch registrations", regs->length(), (CORBA::ULong) 2);
+        checkEqual("b_good registrants", registrantCount(manager, "b_good"), (size_t) 1);
+        checkEqual("c_dup registrants", registrantCount(manager, "c_dup"), (size_t) 1);
+    }
+
+    {
+        // terminate destroys every channel once, and the manager lock is
+        // not held while a channel is being destroyed
+        CF::EventChannelManager::EventChannelInfoList_var channels;
+        CF::EventChannelInfoIterator_var iterator;
+        manager->listChannels(100, channels, iterator);
+        const int created = channels->length();
+
+        factory->blockDestroy(true);
+        boost::thread terminator(boost::bind(&terminateManager, manager));
+        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+        bool found = true;
+        boost::thread finder(boost::bind(&findChannel, manager, "first", &found));
+        check(finder.timed_join(boost::posix_time::seconds(2)), "manager answers during terminate");
+        factory->blockDestroy(false);
+        finder.join();
+        check(!found, "terminated channels removed from the table");
+        check(terminator.timed_join(boost::posix_time::seconds(5)), "terminate finished");
+        checkEqual("channels destroyed", factory->destroyed(), created);
+    }
+
+    delete manager;
+    ossie::corba::OrbShutdown(true);
+
+    return result();
+}
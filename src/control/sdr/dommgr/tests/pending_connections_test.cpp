@@ -0,0 +1,246 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file 
+ * distributed with this source distribution.
+ * 
+ * This file is part of REDHAWK core.
+ * 
+ * REDHAWK core is free software: you can redistribute it and/or modify it 
+ * under the terms of the GNU Lesser General Public License as published by the 
+ * Free Software Foundation, either version 3 of the License, or (at your 
+ * option) any later version.
+ * 
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT 
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License 
+ * for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License 
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Exercises the DomainConnectionManager pending connection index with
+ * local CORBA objects standing in for the ports and the domain. 1000
+ * connections wait on one service and 1000 more on other services; the
+ * test checks that registering unrelated objects does no work, that the
+ * service registration visits and connects exactly its 1000 connections,
+ * and that unregistering breaks them again.
+ *
+ * usage: pending_connections_test
+ */
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <ossie/CorbaUtils.h>
+#include <ossie/CF/cf.h>
+
+#include "connectionSupport.h"
+#include "Endpoints.h"
+#include <ossie/testing/check.h>
+
+using namespace ossie;
+using namespace ossie::testing;
+
+class TestPort : public virtual POA_CF::Port
+{
+public:
+    TestPort() : connects(0), disconnects(0) { }
+
+    void connectPort(CORBA::Object_ptr, const char*)
+    {
+        ++connects;
+    }
+
+    void disconnectPort(const char*)
+    {
+        ++disconnects;
+    }
+
+    size_t connects;
+    size_t disconnects;
+};
+
+class TestSupplier : public virtual POA_CF::PortSupplier
+{
+public:
+    TestSupplier(CF::Port_ptr port) : port_(CF::Port::_duplicate(port)) { }
+
+    CORBA::Object_ptr getPort(const char*)
+    {
+        return CORBA::Object::_duplicate(port_);
+    }
+
+private:
+    CF::Port_var port_;
+};
+
+class TestDomain : public DomainLookup, public ComponentLookup
+{
+public:
+    TestDomain(CORBA::Object_ptr service) : service_(CORBA::Object::_duplicate(service)), lookups(0) { }
+
+    CORBA::Object_ptr lookupDomainObject(const std::string& type, const std::string& name)
+    {
+        ++lookups;
+        if (type == "servicename" && registered.count(name)) {
+            return CORBA::Object::_duplicate(service_);
+        }
+        return CORBA::Object::_nil();
+    }
+
+    CF::DeviceManager_ptr lookupDeviceManagerByInstantiationId(const std::string&)
+    {
+        return CF::DeviceManager::_nil();
+    }
+
+    unsigned int incrementEventChannelConnections(const std::string&) { return 0; }
+    unsigned int decrementEventChannelConnections(const std::string&) { return 0; }
+
+    CF::Resource_ptr lookupComponentByInstantiationId(const std::string&)
+    {
+        return CF::Resource::_nil();
+    }
+
+    std::set<std::string> registered;
+
+private:
+    CORBA::Object_var service_;
+
+public:
+    size_t lookups;
+};
+
+static ConnectionNode makeConnection(CORBA::Object_ptr supplier, const std::string& service, int index)
+{
+    std::ostringstream id;
+    id << "connection_" << index;
+    return ConnectionNode(new PortEndpoint(new ObjectrefEndpoint(CORBA::Object::_duplicate(supplier)), "dataOut"),
+                          new ServiceEndpoint(service), id.str(), "", "");
+}
+
+static size_t countConnected(const ConnectionTable& table)
+{
+    size_t connected = 0;
+    for (ConnectionTable::const_iterator ii = table.begin(); ii != table.end(); ++ii) {
+        for (ConnectionList::const_iterator jj = ii->second.begin(); jj != ii->second.end(); ++jj) {
+            if (jj->connected) ++connected;
+        }
+    }
+    return connected;
+}
+
+static size_t countConnections(const ConnectionTable& table)
+{
+    size_t count = 0;
+    for (ConnectionTable::const_iterator ii = table.begin(); ii != table.end(); ++ii) {
+        count += ii->second.size();
+    }
+    return count;
+}
+
+int main(int argc, char* argv[])
+{
+    const int pending = 1000;
+    ossie::corba::CorbaInit(argc, argv);
+
+    TestPort* port = new TestPort();
+    PortableServer::ObjectId_var portId = ossie::corba::RootPOA()->activate_object(port);
+    CF::Port_var portRef = port->_this();
+    TestSupplier* supplier = new TestSupplier(portRef);
+    PortableServer::ObjectId_var supplierId = ossie::corba::RootPOA()->activate_object(supplier);
+    CF::PortSupplier_var supplierRef = supplier->_this();
+
+    TestDomain domain(portRef);
+    DomainConnectionManager manager(&domain, &domain, "TEST_DOMAIN");
+
+    std::string firstRecord;
+    for (int ii = 0; ii < pending; ++ii) {
+        std::string record = manager.restoreConnection("DCD_1", makeConnection(supplierRef, "svc", ii));
+        if (firstRecord.empty()) firstRecord = record;
+        std::ostringstream other;
+        other << "other_" << ii;
+        manager.restoreConnection("DCD_2", makeConnection(supplierRef, other.str(), pending + ii));
+    }
+    check(countConnections(manager.getConnections()) == 2 * pending, "all connections stored");
+
+    // Objects no connection waits on should not touch any connection
+    for (int ii = 0; ii < 100; ++ii) {
+        std::ostringstream name;
+        name << "unrelated_" << ii;
+        manager.serviceRegistered(name.str());
+        manager.deviceRegistered(name.str());
+    }
+    DomainConnectionManager::Statistics stats = manager.getStatistics();
+    check(stats.notifications == 200, "unrelated registrations counted");
+    check(stats.examined == 0, "unrelated registrations examine no connections");
+    check(domain.lookups == 0, "unrelated registrations do no lookups");
+
+    // One registration resolves its 1000 pending connections
+    DomainConnectionManager::SnapshotPtr before = manager.getSnapshot();
+    check(manager.getSnapshot() == before, "unchanged table reuses its snapshot");
+    domain.registered.insert("svc");
+    manager.serviceRegistered("svc");
+    stats = manager.getStatistics();
+    std::cout << "registration: examined " << stats.examined << ", attempted " << stats.attempted
+              << ", established " << stats.established << ", lookups " << domain.lookups << std::endl;
+    check(stats.examined == (size_t)pending, "registration examines only its connections");
+    check(stats.attempted == (size_t)pending, "one attempt per pending connection");
+    check(stats.established == (size_t)pending, "every pending connection established");
+    check(port->connects == (size_t)pending, "connectPort called once per connection");
+    check(domain.lookups == (size_t)pending, "one service lookup per connection");
+    check(countConnected(manager.getConnections()) == (size_t)pending, "connections recorded as connected");
+
+    // Published snapshots are never modified; the change log reports what
+    // happened since one was taken
+    size_t stale = 0;
+    for (size_t ii = 0; ii < before->connections.size(); ++ii) {
+        if (before->connections[ii]->connected) ++stale;
+    }
+    check(stale == 0, "earlier snapshot is unchanged");
+    DomainConnectionManager::Changes changes = manager.getChanges(before->version);
+    check(changes.incremental, "recent changes are incremental");
+    check(changes.added.size() == (size_t)pending, "each established connection reported once");
+    check(changes.removed.empty(), "nothing reported removed");
+    check(!manager.getChanges(0).incremental, "version 0 returns the full table");
+
+    // A repeated registration finds nothing left to connect
+    manager.serviceRegistered("svc");
+    stats = manager.getStatistics();
+    check(stats.attempted == (size_t)pending, "connected connections are not retried");
+
+    // Unregistering breaks the connections and leaves them pending
+    domain.registered.erase("svc");
+    manager.serviceUnregistered("svc");
+    check(port->disconnects == (size_t)pending, "disconnectPort called once per connection");
+    check(countConnected(manager.getConnections()) == 0, "connections pending again");
+    check(countConnections(manager.getConnections()) == 2 * pending, "deferrable connections kept");
+
+    unsigned long long version = manager.getSnapshot()->version;
+    manager.breakConnection(firstRecord);
+    check(countConnections(manager.getConnections()) == 2 * pending - 1, "breakConnection removes the record");
+    changes = manager.getChanges(version);
+    check(changes.removed.size() == 1 && changes.removed[0] == firstRecord, "removed record reported");
+    bool threw = false;
+    try {
+        manager.breakConnection(firstRecord);
+    } catch (const InvalidConnection&) {
+        threw = true;
+    }
+    check(threw, "breaking a removed connection throws");
+
+    manager.deviceManagerUnregistered("DCD_1");
+    manager.deviceManagerUnregistered("DCD_2");
+    check(countConnections(manager.getConnections()) == 0, "device manager connections removed");
+
+    // The index no longer holds the removed connections
+    size_t examined = manager.getStatistics().examined;
+    domain.registered.insert("svc");
+    manager.serviceRegistered("svc");
+    check(manager.getStatistics().examined == examined, "removed connections are not indexed");
+
+    ossie::corba::OrbShutdown(true);
+
+    return result();
+}
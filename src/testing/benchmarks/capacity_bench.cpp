@@ -0,0 +1,202 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Measures legacy (non-callback) capacity allocation throughput on devices
+ * with 10, 100 and 1000 properties, comparing Device_impl's in-place
+ * implementation against the full query()/configure() snapshot it replaced.
+ * Each device also has one large sequence property, which the snapshot has
+ * to copy twice per call.
+ *
+ * usage: capacity_bench [iterations]
+ */
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <time.h>
+
+#include <ossie/CorbaUtils.h>
+#include <ossie/Device_impl.h>
+#include <ossie/logging/loghelpers.h>
+
+namespace {
+
+    double now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + (ts.tv_nsec * 1e-9);
+    }
+
+    void report(const std::string& name, size_t properties, size_t iterations, double elapsed)
+    {
+        std::cout << std::setw(10) << std::left << name
+                  << std::setw(8) << std::right << properties << " props"
+                  << std::setw(12) << std::fixed << std::setprecision(2)
+                  << (elapsed * 1e6 / iterations) << " us/cycle"
+                  << std::setw(12) << std::setprecision(0)
+                  << (iterations / elapsed) << " cycles/s" << std::endl;
+    }
+
+    char* str(const char* value)
+    {
+        return const_cast<char*>(value);
+    }
+
+    class BenchDevice : public Device_impl {
+    public:
+        BenchDevice(size_t count) :
+            Device_impl(str(""), str("capacity_bench"), str("capacity_bench"), str("")),
+            capacities(count, 1000000)
+        {
+            CF::Properties initial;
+            for (size_t ii = 0; ii < capacities.size(); ++ii) {
+                std::ostringstream id;
+                id << "capacity_" << ii;
+                addProperty(capacities[ii], capacities[ii], id.str(), "", "readwrite", "", "external", "allocation");
+                CF::DataType value;
+                value.id = id.str().c_str();
+                value.value <<= capacities[ii];
+                ossie::corba::push_back(initial, value);
+            }
+            samples.resize(65536);
+            addProperty(samples, "samples", "", "readwrite", "", "external", "configure");
+
+            // Record the original capacities, as the DeviceManager's initial
+            // configure would
+            configure(initial);
+        }
+
+        // The previous Device_impl::allocateCapacityLegacy, less logging
+        bool snapshotAllocate(const CF::Properties& request)
+        {
+            CF::Properties current;
+            query(current);
+            for (unsigned ii = 0; ii < request.length(); ++ii) {
+                for (unsigned jj = 0; jj < current.length(); ++jj) {
+                    if (strcmp(request[ii].id, current[jj].id) == 0) {
+                        if (!allocate(current[jj].value, request[ii].value)) {
+                            return false;
+                        }
+                        break;
+                    }
+                }
+            }
+            for (unsigned ii = 0; ii < current.length(); ++ii) {
+                if (compareAnyToZero(current[ii].value) == POSITIVE) {
+                    break;
+                }
+            }
+            configure(current);
+            return true;
+        }
+
+        void snapshotDeallocate(const CF::Properties& request)
+        {
+            CF::Properties current;
+            query(current);
+            for (unsigned ii = 0; ii < request.length(); ++ii) {
+                for (unsigned jj = 0; jj < current.length(); ++jj) {
+                    if (strcmp(request[ii].id, current[jj].id) == 0) {
+                        deallocate(current[jj].value, request[ii].value);
+                        break;
+                    }
+                }
+            }
+            for (unsigned ii = 0; ii < current.length(); ++ii) {
+                for (unsigned jj = 0; jj < originalCap.length(); ++jj) {
+                    if (strcmp(current[ii].id, originalCap[jj].id) == 0) {
+                        compareAnys(current[ii].value, originalCap[jj].value);
+                    }
+                }
+            }
+            configure(current);
+        }
+
+    private:
+        std::vector<CORBA::ULong> capacities;
+        std::vector<float> samples;
+    };
+
+    CF::Properties makeRequest(size_t index)
+    {
+        std::ostringstream id;
+        id << "capacity_" << index;
+        CF::Properties request;
+        request.length(1);
+        request[0].id = id.str().c_str();
+        request[0].value <<= static_cast<CORBA::ULong>(1);
+        return request;
+    }
+
+    void run(size_t count, size_t iterations)
+    {
+        BenchDevice* device = new BenchDevice(count);
+
+        // Hold one unit throughout so that the device stays ACTIVE and the
+        // loop measures allocation rather than usage state events
+        device->allocateCapacity(makeRequest(0));
+
+        std::vector<CF::Properties> requests;
+        for (size_t ii = 0; ii < count; ++ii) {
+            requests.push_back(makeRequest(ii));
+        }
+
+        double start = now();
+        for (size_t ii = 0; ii < iterations; ++ii) {
+            const CF::Properties& request = requests[ii % count];
+            device->allocateCapacity(request);
+            device->deallocateCapacity(request);
+        }
+        report("in-place", count, iterations, now() - start);
+
+        start = now();
+        for (size_t ii = 0; ii < iterations; ++ii) {
+            const CF::Properties& request = requests[ii % count];
+            device->snapshotAllocate(request);
+            device->snapshotDeallocate(request);
+        }
+        report("snapshot", count, iterations, now() - start);
+
+        delete device;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t iterations = 1000;
+    if (argc > 1) {
+        iterations = strtoul(argv[1], 0, 10);
+    }
+
+    ossie::corba::CorbaInit(argc, argv);
+    ossie::logging::ConfigureDefault();
+
+    std::cout << "Legacy allocate/deallocate cycles, " << iterations << " iterations" << std::endl;
+    const size_t counts[] = { 10, 100, 1000 };
+    for (size_t ii = 0; ii < sizeof(counts) / sizeof(counts[0]); ++ii) {
+        run(counts[ii], iterations);
+    }
+
+    ossie::corba::OrbShutdown(true);
+    return 0;
+}
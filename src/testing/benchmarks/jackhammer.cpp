@@ -0,0 +1,778 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Native counterpart to the Python scripts in testing/jackhammer. Runs one
+ * core framework operation repeatedly from a number of threads and reports
+ * the latency distribution (p50/p99/p99.9) and throughput, optionally as JSON
+ * for regression tracking.
+ *
+ * By default the operation targets a running domain, found through the
+ * naming service. With --local=<dir>, the file system, allocation and
+ * load/unload operations instead target servants created in this process
+ * (a FileSystem rooted at <dir>, a Device and a LoadableDevice) and
+ * activated on the local ORB, so that the framework's own overhead can be
+ * measured without a domain.
+ *
+ * usage: jackhammer [options] <operation> [arguments]
+ *
+ *   app-create <sadfile>       create and release an application
+ *   allocate [propid [value]]  allocate and deallocate device capacity
+ *   alloc-iters                list allocations with an iterator
+ *   devlist-iters              list devices with an iterator
+ *   file-list <pattern>        list files
+ *   open-file <filename>       open, read and close a file
+ *   load-unload <filename>     load and unload a file on a LoadableDevice
+ *
+ * options:
+ *   --domainname=<name>   domain to attach to
+ *   --threads=<n>         number of concurrent callers (default 1)
+ *   --duration=<seconds>  how long to run (default 10)
+ *   --iterations=<n>      calls per thread, instead of a duration
+ *   --warmup=<n>          calls per thread to discard first (default 0)
+ *   --local=<dir>         use in-process servants rooted at <dir>
+ *   --json=<file>         write results as JSON to <file> ("-" for stdout)
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <getopt.h>
+#include <time.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <ossie/CorbaUtils.h>
+#include <ossie/ossieSupport.h>
+#include <ossie/Device_impl.h>
+#include <ossie/LoadableDevice_impl.h>
+#include <ossie/FileSystem_impl.h>
+#include <ossie/logging/loghelpers.h>
+
+namespace {
+
+    double now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + (ts.tv_nsec * 1e-9);
+    }
+
+    char* str(const char* value)
+    {
+        return const_cast<char*>(value);
+    }
+
+    // Identifier of the GPP's bogomips capacity, as used by allocate.py
+    const char* BOGOMIPS_ID = "DCE:5636c210-0346-4df7-a5a3-8fd34c5540a8";
+
+    struct Options {
+        Options() :
+            threads(1),
+            duration(10.0),
+            iterations(0),
+            warmup(0)
+        {
+        }
+
+        std::string domainName;
+        size_t threads;
+        double duration;
+        size_t iterations;
+        size_t warmup;
+        std::string localRoot;
+        std::string jsonFile;
+        std::string operation;
+        std::vector<std::string> arguments;
+    };
+
+    std::string argument(const Options& options, size_t index, const std::string& defval="")
+    {
+        if (index < options.arguments.size()) {
+            return options.arguments[index];
+        } else if (defval.empty()) {
+            throw std::invalid_argument(options.operation + " requires more arguments");
+        }
+        return defval;
+    }
+
+    //
+    // Everything the operations may need, either from the domain or created
+    // in this process
+    //
+    class Target {
+    public:
+        Target(const Options& options) :
+            _options(options)
+        {
+            if (!options.localRoot.empty()) {
+                createLocal();
+            } else {
+                attachDomain();
+            }
+        }
+
+        ~Target()
+        {
+            PortableServer::POA_var poa = ossie::corba::RootPOA();
+            for (std::vector<PortableServer::ServantBase*>::iterator servant = _servants.begin(); servant != _servants.end(); ++servant) {
+                try {
+                    PortableServer::ObjectId_var oid = poa->servant_to_id(*servant);
+                    poa->deactivate_object(oid);
+                } catch (...) {
+                }
+                (*servant)->_remove_ref();
+            }
+        }
+
+        bool isLocal() const
+        {
+            return !_options.localRoot.empty();
+        }
+
+        CF::DomainManager_ptr domain()
+        {
+            if (CORBA::is_nil(_domain)) {
+                throw std::runtime_error(_options.operation + " requires a domain");
+            }
+            return _domain;
+        }
+
+        CF::FileSystem_ptr fileSystem()
+        {
+            return _fileSystem;
+        }
+
+        // First registered device, or the first one that is a LoadableDevice
+        CF::Device_ptr device(bool loadable)
+        {
+            if (loadable) {
+                if (CORBA::is_nil(_loadable)) {
+                    throw std::runtime_error("No LoadableDevice available");
+                }
+                return _loadable;
+            }
+            if (CORBA::is_nil(_device)) {
+                throw std::runtime_error("No Device available");
+            }
+            return _device;
+        }
+
+    private:
+        void attachDomain()
+        {
+            if (_options.domainName.empty()) {
+                throw std::invalid_argument("Unable to determine domain name; use --domainname=<name>");
+            }
+            CORBA::Object_var obj = ossie::corba::objectFromName(_options.domainName + "/" + _options.domainName);
+            _domain = CF::DomainManager::_narrow(obj);
+            if (CORBA::is_nil(_domain)) {
+                throw std::runtime_error("Unable to connect to domain manager for domain " + _options.domainName);
+            }
+
+            _fileSystem = _domain->fileMgr();
+
+            CF::DomainManager::DeviceManagerSequence_var managers = _domain->deviceManagers();
+            for (CORBA::ULong ii = 0; ii < managers->length(); ++ii) {
+                CF::DeviceSequence_var devices = managers[ii]->registeredDevices();
+                for (CORBA::ULong jj = 0; jj < devices->length(); ++jj) {
+                    if (CORBA::is_nil(_device)) {
+                        _device = CF::Device::_duplicate(devices[jj]);
+                    }
+                    if (CORBA::is_nil(_loadable) && devices[jj]->_is_a(CF::LoadableDevice::_PD_repoId)) {
+                        _loadable = CF::Device::_duplicate(devices[jj]);
+                    }
+                }
+            }
+        }
+
+        void createLocal()
+        {
+            FileSystem_impl* fileSystem = new FileSystem_impl(_options.localRoot.c_str());
+            activate(fileSystem);
+            _fileSystem = fileSystem->_this();
+
+            CapacityDevice* device = new CapacityDevice();
+            activate(device);
+            _device = device->_this();
+
+            LoadableDevice_impl* loadable = new LoadableDevice_impl(str(""), str("jackhammer_loadable"), str("jackhammer_loadable"), str(""));
+            activate(loadable);
+            _loadable = loadable->_this();
+        }
+
+        void activate(PortableServer::ServantBase* servant)
+        {
+            PortableServer::POA_var poa = ossie::corba::RootPOA();
+            PortableServer::ObjectId_var oid = poa->activate_object(servant);
+            _servants.push_back(servant);
+        }
+
+        // Device with a single capacity, matching the property allocate.py
+        // requests from a GPP
+        class CapacityDevice : public Device_impl {
+        public:
+            CapacityDevice() :
+                Device_impl(str(""), str("jackhammer_device"), str("jackhammer_device"), str("")),
+                _bogomips(2000000000)
+            {
+                addProperty(_bogomips, _bogomips, BOGOMIPS_ID, "bogomips", "readwrite", "", "external", "allocation");
+                CF::Properties initial;
+                initial.length(1);
+                initial[0].id = BOGOMIPS_ID;
+                initial[0].value <<= _bogomips;
+                configure(initial);
+            }
+
+        private:
+            CORBA::Long _bogomips;
+        };
+
+        const Options& _options;
+        CF::DomainManager_var _domain;
+        CF::FileSystem_var _fileSystem;
+        CF::Device_var _device;
+        CF::Device_var _loadable;
+        std::vector<PortableServer::ServantBase*> _servants;
+    };
+
+    //
+    // Operations, one instance shared by all threads; test() must be thread
+    // safe
+    //
+    class Operation {
+    public:
+        virtual ~Operation() { }
+        virtual void test() = 0;
+    };
+
+    class CreateApp : public Operation {
+    public:
+        CreateApp(Target& target, const Options& options)
+        {
+            CF::DomainManager_ptr domain = target.domain();
+            const std::string sadFile = argument(options, 0);
+            try {
+                domain->installApplication(sadFile.c_str());
+            } catch (const CF::DomainManager::ApplicationAlreadyInstalled&) {
+            }
+            CF::DomainManager::ApplicationFactorySequence_var factories = domain->applicationFactories();
+            for (CORBA::ULong ii = 0; ii < factories->length(); ++ii) {
+                CORBA::String_var profile = factories[ii]->softwareProfile();
+                if (sadFile == static_cast<const char*>(profile)) {
+                    _factory = CF::ApplicationFactory::_duplicate(factories[ii]);
+                    _name = factories[ii]->name();
+                    return;
+                }
+            }
+            throw std::runtime_error("Couldn't find app factory for " + sadFile);
+        }
+
+        void test()
+        {
+            CF::Application_var app = _factory->create(_name, CF::Properties(), CF::DeviceAssignmentSequence());
+            app->releaseObject();
+        }
+
+    private:
+        CF::ApplicationFactory_var _factory;
+        CORBA::String_var _name;
+    };
+
+    class AllocDealloc : public Operation {
+    public:
+        AllocDealloc(Target& target, const Options& options)
+        {
+            _device = CF::Device::_duplicate(target.device(false));
+            _props.length(1);
+            _props[0].id = argument(options, 0, BOGOMIPS_ID).c_str();
+            _props[0].value <<= static_cast<CORBA::Long>(atol(argument(options, 1, "1000000").c_str()));
+        }
+
+        void test()
+        {
+            if (!_device->allocateCapacity(_props)) {
+                throw std::runtime_error("allocateCapacity returned false");
+            }
+            _device->deallocateCapacity(_props);
+        }
+
+    private:
+        CF::Device_var _device;
+        CF::Properties _props;
+    };
+
+    // Cycles through the scopes in the same way as the Python scripts
+    template <typename Scope>
+    class ScopeCycle {
+    public:
+        ScopeCycle(const Scope* scopes, size_t count) :
+            _scopes(scopes, scopes + count),
+            _index(0)
+        {
+        }
+
+        Scope next()
+        {
+            boost::mutex::scoped_lock lock(_lock);
+            Scope scope = _scopes[_index];
+            _index = (_index + 1) % _scopes.size();
+            return scope;
+        }
+
+    private:
+        std::vector<Scope> _scopes;
+        size_t _index;
+        boost::mutex _lock;
+    };
+
+    class AllocListIterators : public Operation {
+    public:
+        AllocListIterators(Target& target, const Options&) :
+            _scopes(SCOPES, sizeof(SCOPES) / sizeof(SCOPES[0]))
+        {
+            _allocMgr = target.domain()->allocationMgr();
+        }
+
+        void test()
+        {
+            CF::AllocationManager::AllocationStatusSequence_var items;
+            CF::AllocationStatusIterator_var iter;
+            _allocMgr->listAllocations(_scopes.next(), 0, items, iter);
+            if (!CORBA::is_nil(iter)) {
+                CF::AllocationManager::AllocationStatusType_var item;
+                while (iter->next_one(item)) {
+                }
+                iter->destroy();
+            }
+        }
+
+    private:
+        static const CF::AllocationManager::AllocationScopeType SCOPES[];
+        CF::AllocationManager_var _allocMgr;
+        ScopeCycle<CF::AllocationManager::AllocationScopeType> _scopes;
+    };
+
+    const CF::AllocationManager::AllocationScopeType AllocListIterators::SCOPES[] = {
+        CF::AllocationManager::LOCAL_ALLOCATIONS,
+        CF::AllocationManager::ALL_ALLOCATIONS
+    };
+
+    class DevListIterators : public Operation {
+    public:
+        DevListIterators(Target& target, const Options&) :
+            _scopes(SCOPES, sizeof(SCOPES) / sizeof(SCOPES[0]))
+        {
+            _allocMgr = target.domain()->allocationMgr();
+        }
+
+        void test()
+        {
+            CF::AllocationManager::DeviceLocationSequence_var items;
+            CF::DeviceLocationIterator_var iter;
+            _allocMgr->listDevices(_scopes.next(), 0, items, iter);
+            if (!CORBA::is_nil(iter)) {
+                CF::AllocationManager::DeviceLocationType_var item;
+                while (iter->next_one(item)) {
+                }
+                iter->destroy();
+            }
+        }
+
+    private:
+        static const CF::AllocationManager::DeviceScopeType SCOPES[];
+        CF::AllocationManager_var _allocMgr;
+        ScopeCycle<CF::AllocationManager::DeviceScopeType> _scopes;
+    };
+
+    const CF::AllocationManager::DeviceScopeType DevListIterators::SCOPES[] = {
+        CF::AllocationManager::LOCAL_DEVICES,
+        CF::AllocationManager::ALL_DEVICES,
+        CF::AllocationManager::AUTHORIZED_DEVICES
+    };
+
+    class ListFiles : public Operation {
+    public:
+        ListFiles(Target& target, const Options& options) :
+            _pattern(argument(options, 0))
+        {
+            _fileSystem = CF::FileSystem::_duplicate(target.fileSystem());
+        }
+
+        void test()
+        {
+            CF::FileSystem::FileInformationSequence_var files = _fileSystem->list(_pattern.c_str());
+        }
+
+    private:
+        CF::FileSystem_var _fileSystem;
+        std::string _pattern;
+    };
+
+    class OpenFile : public Operation {
+    public:
+        OpenFile(Target& target, const Options& options) :
+            _filename(argument(options, 0))
+        {
+            _fileSystem = CF::FileSystem::_duplicate(target.fileSystem());
+        }
+
+        void test()
+        {
+            CF::File_var file = _fileSystem->open(_filename.c_str(), true);
+            CORBA::ULong nbytes = file->sizeOf();
+            while (nbytes > 0) {
+                CORBA::ULong toRead = std::min(nbytes, CHUNK_SIZE);
+                CF::OctetSequence_var data;
+                file->read(data, toRead);
+                nbytes -= toRead;
+            }
+            file->close();
+        }
+
+    private:
+        static const CORBA::ULong CHUNK_SIZE = 2048000;
+        CF::FileSystem_var _fileSystem;
+        std::string _filename;
+    };
+
+    class LoadUnload : public Operation {
+    public:
+        LoadUnload(Target& target, const Options& options) :
+            _filename(argument(options, 0))
+        {
+            _fileSystem = CF::FileSystem::_duplicate(target.fileSystem());
+            _device = CF::LoadableDevice::_narrow(target.device(true));
+        }
+
+        void test()
+        {
+            _device->load(_fileSystem, _filename.c_str(), CF::LoadableDevice::EXECUTABLE);
+            _device->unload(_filename.c_str());
+        }
+
+    private:
+        CF::FileSystem_var _fileSystem;
+        CF::LoadableDevice_var _device;
+        std::string _filename;
+    };
+
+    Operation* createOperation(Target& target, const Options& options)
+    {
+        const std::string& name = options.operation;
+        if (name == "app-create") {
+            return new CreateApp(target, options);
+        } else if (name == "allocate") {
+            return new AllocDealloc(target, options);
+        } else if (name == "alloc-iters") {
+            return new AllocListIterators(target, options);
+        } else if (name == "devlist-iters") {
+            return new DevListIterators(target, options);
+        } else if (name == "file-list") {
+            return new ListFiles(target, options);
+        } else if (name == "open-file") {
+            return new OpenFile(target, options);
+        } else if (name == "load-unload") {
+            return new LoadUnload(target, options);
+        }
+        throw std::invalid_argument("Unknown operation '" + name + "'");
+    }
+
+    std::string describeException()
+    {
+        try {
+            throw;
+        } catch (const CORBA::Exception& ex) {
+            return ex._name();
+        } catch (const std::exception& ex) {
+            return ex.what();
+        } catch (...) {
+            return "unknown exception";
+        }
+    }
+
+    //
+    // Each thread records its own latencies; as in the Python scripts, a
+    // thread stops at its first error
+    //
+    class Worker {
+    public:
+        Worker(Operation& operation, const Options& options, boost::barrier& start, const volatile bool& stop) :
+            _operation(operation),
+            _options(options),
+            _start(start),
+            _stop(stop),
+            _failed(false)
+        {
+        }
+
+        void operator() ()
+        {
+            _start.wait();
+            try {
+                for (size_t ii = 0; ii < _options.warmup; ++ii) {
+                    _operation.test();
+                }
+                if (_options.iterations > 0) {
+                    _latencies.reserve(_options.iterations);
+                }
+                while (!_stop && (_options.iterations == 0 || _latencies.size() < _options.iterations)) {
+                    double begin = now();
+                    _operation.test();
+                    _latencies.push_back(now() - begin);
+                }
+            } catch (...) {
+                _failed = true;
+                _error = describeException();
+            }
+        }
+
+        const std::vector<double>& latencies() const
+        {
+            return _latencies;
+        }
+
+        bool failed() const
+        {
+            return _failed;
+        }
+
+        const std::string& error() const
+        {
+            return _error;
+        }
+
+    private:
+        Operation& _operation;
+        const Options& _options;
+        boost::barrier& _start;
+        const volatile bool& _stop;
+        std::vector<double> _latencies;
+        bool _failed;
+        std::string _error;
+    };
+
+    struct Results {
+        size_t calls;
+        size_t errors;
+        double elapsed;
+        double mean;
+        double p50;
+        double p99;
+        double p999;
+        double max;
+    };
+
+    // Nearest-rank percentile of sorted samples
+    double percentile(const std::vector<double>& sorted, double fraction)
+    {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+        return sorted[std::max(rank, static_cast<size_t>(1)) - 1];
+    }
+
+    Results run(Operation& operation, const Options& options)
+    {
+        boost::barrier start(options.threads + 1);
+        volatile bool stop = false;
+        std::vector<boost::shared_ptr<Worker> > workers;
+        boost::thread_group threads;
+        for (size_t ii = 0; ii < options.threads; ++ii) {
+            workers.push_back(boost::shared_ptr<Worker>(new Worker(operation, options, start, stop)));
+            threads.create_thread(boost::ref(*workers.back()));
+        }
+
+        start.wait();
+        double begin = now();
+        if (options.iterations == 0) {
+            boost::this_thread::sleep(boost::posix_time::microseconds(static_cast<long>(options.duration * 1e6)));
+            stop = true;
+        }
+        threads.join_all();
+
+        Results results;
+        results.elapsed = now() - begin;
+        results.errors = 0;
+
+        std::vector<double> latencies;
+        for (size_t ii = 0; ii < workers.size(); ++ii) {
+            const std::vector<double>& samples = workers[ii]->latencies();
+            latencies.insert(latencies.end(), samples.begin(), samples.end());
+            if (workers[ii]->failed()) {
+                ++results.errors;
+                std::cerr << "Error (thread " << ii << "): " << workers[ii]->error() << std::endl;
+            }
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        results.calls = latencies.size();
+        double total = 0.0;
+        for (std::vector<double>::iterator sample = latencies.begin(); sample != latencies.end(); ++sample) {
+            total += *sample;
+        }
+        results.mean = latencies.empty() ? 0.0 : (total / latencies.size());
+        results.p50 = percentile(latencies, 0.50);
+        results.p99 = percentile(latencies, 0.99);
+        results.p999 = percentile(latencies, 0.999);
+        results.max = latencies.empty() ? 0.0 : latencies.back();
+        return results;
+    }
+
+    void report(std::ostream& out, const Options& options, const Results& results)
+    {
+        out << options.operation << ": " << results.calls << " calls, "
+            << options.threads << " thread(s), " << results.errors << " error(s)" << std::endl;
+        out << std::fixed << std::setprecision(1)
+            << "  throughput " << (results.calls / results.elapsed) << " calls/s over "
+            << std::setprecision(2) << results.elapsed << " s" << std::endl;
+        out << std::setprecision(3)
+            << "  latency (ms): mean " << (results.mean * 1e3)
+            << "  p50 " << (results.p50 * 1e3)
+            << "  p99 " << (results.p99 * 1e3)
+            << "  p99.9 " << (results.p999 * 1e3)
+            << "  max " << (results.max * 1e3) << std::endl;
+    }
+
+    void writeJson(std::ostream& out, const Options& options, const Results& results)
+    {
+        out << "{" << std::endl;
+        out << "  \"operation\": " << ossie::helpers::jsonString(options.operation) << "," << std::endl;
+        out << "  \"arguments\": [";
+        for (size_t ii = 0; ii < options.arguments.size(); ++ii) {
+            out << (ii ? ", " : "") << ossie::helpers::jsonString(options.arguments[ii]);
+        }
+        out << "]," << std::endl;
+        out << "  \"target\": " << ossie::helpers::jsonString(options.localRoot.empty() ? "domain" : "local") << "," << std::endl;
+        out << "  \"threads\": " << options.threads << "," << std::endl;
+        out << "  \"calls\": " << results.calls << "," << std::endl;
+        out << "  \"errors\": " << results.errors << "," << std::endl;
+        out << std::setprecision(6) << std::fixed;
+        out << "  \"elapsed_s\": " << results.elapsed << "," << std::endl;
+        out << "  \"throughput_per_s\": " << (results.calls / results.elapsed) << "," << std::endl;
+        out << "  \"latency_us\": {"
+            << " \"mean\": " << (results.mean * 1e6) << ","
+            << " \"p50\": " << (results.p50 * 1e6) << ","
+            << " \"p99\": " << (results.p99 * 1e6) << ","
+            << " \"p99.9\": " << (results.p999 * 1e6) << ","
+            << " \"max\": " << (results.max * 1e6) << " }" << std::endl;
+        out << "}" << std::endl;
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options)
+    {
+        static struct option longopts[] = {
+            { "domainname", required_argument, 0, 'd' },
+            { "threads", required_argument, 0, 't' },
+            { "duration", required_argument, 0, 'D' },
+            { "iterations", required_argument, 0, 'i' },
+            { "warmup", required_argument, 0, 'w' },
+            { "local", required_argument, 0, 'l' },
+            { "json", required_argument, 0, 'j' },
+            { 0, 0, 0, 0 }
+        };
+
+        int opt;
+        while ((opt = getopt_long(argc, argv, "", longopts, 0)) != -1) {
+            switch (opt) {
+            case 'd':
+                options.domainName = optarg;
+                break;
+            case 't':
+                options.threads = std::max(strtoul(optarg, 0, 10), 1ul);
+                break;
+            case 'D':
+                options.duration = strtod(optarg, 0);
+                break;
+            case 'i':
+                options.iterations = strtoul(optarg, 0, 10);
+                break;
+            case 'w':
+                options.warmup = strtoul(optarg, 0, 10);
+                break;
+            case 'l':
+                options.localRoot = optarg;
+                break;
+            case 'j':
+                options.jsonFile = optarg;
+                break;
+            default:
+                return false;
+            }
+        }
+        if (optind >= argc) {
+            return false;
+        }
+        options.operation = argv[optind++];
+        options.arguments.assign(argv + optind, argv + argc);
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0] << " [--domainname=<name>] [--threads=<n>] [--duration=<s>|--iterations=<n>]"
+                  << " [--warmup=<n>] [--local=<dir>] [--json=<file>] <operation> [arguments]" << std::endl;
+        return 2;
+    }
+
+    // As with the Python scripts, do not limit the ORB to one call per
+    // connection, so that threads share connections to the servers
+    char* orbArgs[] = { argv[0], str("-ORBoneCallPerConnection"), str("0"), 0 };
+    ossie::corba::CorbaInit(3, orbArgs);
+    ossie::logging::ConfigureDefault();
+
+    int status = 0;
+    try {
+        Target target(options);
+        std::auto_ptr<Operation> operation(createOperation(target, options));
+
+        Results results = run(*operation, options);
+        report(std::cout, options, results);
+        if (options.jsonFile == "-") {
+            writeJson(std::cout, options, results);
+        } else if (!options.jsonFile.empty()) {
+            std::ofstream json(options.jsonFile.c_str());
+            writeJson(json, options, results);
+        }
+        if (results.errors) {
+            status = 1;
+        }
+    } catch (...) {
+        std::cerr << describeException() << std::endl;
+        status = 1;
+    }
+
+    ossie::corba::OrbShutdown(true);
+    return status;
+}
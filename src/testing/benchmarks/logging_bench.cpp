@@ -0,0 +1,108 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Measures the per-statement cost of log statements whose level is disabled,
+ * comparing the cached named-logger macros against an explicit logger and a
+ * lookup by name on every call (the previous RH_NL_XXX behavior).
+ *
+ * usage: logging_bench [iterations]
+ */
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <time.h>
+
+#include <ossie/debug.h>
+#include <ossie/logging/loghelpers.h>
+
+namespace {
+
+    double now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + (ts.tv_nsec * 1e-9);
+    }
+
+    void report(const std::string& name, size_t iterations, double elapsed)
+    {
+        std::cout << std::setw(24) << std::left << name
+                  << std::setw(12) << std::right << std::fixed << std::setprecision(2)
+                  << (elapsed * 1e9 / iterations) << " ns/stmt" << std::endl;
+    }
+
+    // Prevent the compiler from discarding the loop counter
+    volatile size_t sink = 0;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t iterations = 10000000;
+    if (argc > 1) {
+        iterations = strtoul(argv[1], 0, 10);
+    }
+
+    // Default configuration logs at INFO, so DEBUG and TRACE are disabled
+    ossie::logging::ConfigureDefault();
+    rh_logger::LoggerPtr logger = rh_logger::Logger::getLogger("bench");
+
+    std::cout << "Disabled log statement cost, " << iterations << " iterations";
+    if (RH_LOG_LEVEL_FLOOR > RH_LOG_LEVEL_ALL) {
+        std::cout << " (compile-time floor " << RH_LOG_LEVEL_FLOOR << ")";
+    }
+    std::cout << std::endl;
+
+    double start = now();
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        sink = ii;
+    }
+    report("empty loop", iterations, now() - start);
+
+    start = now();
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        RH_DEBUG(logger, "iteration " << ii);
+        sink = ii;
+    }
+    report("RH_DEBUG", iterations, now() - start);
+
+    start = now();
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        RH_NL_DEBUG("bench", "iteration " << ii);
+        sink = ii;
+    }
+    report("RH_NL_DEBUG", iterations, now() - start);
+
+    start = now();
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        RH_NL_TRACE("bench", "iteration " << ii);
+        sink = ii;
+    }
+    report("RH_NL_TRACE", iterations, now() - start);
+
+    start = now();
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        _RH_LOG(Debug, rh_logger::Logger::getLogger("bench"), "iteration " << ii);
+        sink = ii;
+    }
+    report("getLogger per call", iterations, now() - start);
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Measures the cost of evaluating matching allocation properties, comparing
+ * the per-request conversion and compare_anys path that AllocationManager
+ * used against matchers compiled once per device profile. Each round
+ * evaluates every property of every device, with dependency values given
+ * both as strings (as the ApplicationFactory sends them) and in their native
+ * types (as a remote allocation request may). String dependencies are also
+ * run with the conversions shared across the devices in a round, as they
+ * are within one allocation request.
+ *
+ * usage: matcher_bench [devices] [rounds]
+ */
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <time.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <ossie/prop_helpers.h>
+
+namespace {
+
+    double now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + (ts.tv_nsec * 1e-9);
+    }
+
+    void report(const std::string& name, size_t evaluations, size_t matches, double elapsed)
+    {
+        std::cout << std::setw(32) << std::left << name
+                  << std::setw(12) << std::right << std::fixed << std::setprecision(1)
+                  << (elapsed * 1e9 / evaluations) << " ns/eval"
+                  << std::setw(12) << matches << " matched" << std::endl;
+    }
+
+    // A device's matching property, as it appears in its PRF
+    struct DeviceProperty {
+        std::string type;
+        std::string value;
+        std::string action;
+    };
+
+    // A dependency on one device property, in string and native form
+    struct Dependency {
+        CORBA::Any asString;
+        CORBA::Any asNative;
+    };
+
+    std::string toString(long value)
+    {
+        std::ostringstream out;
+        out << value;
+        return out.str();
+    }
+
+    void makeDevice(size_t index, std::vector<DeviceProperty>& props)
+    {
+        const DeviceProperty device[] = {
+            { "string", (index % 2) ? "Linux" : "VxWorks", "eq" },
+            { "string", "x86_64", "eq" },
+            { "long", toString(index % 16), "ge" },
+            { "ulong", toString(1024 * (1 + index % 8)), "ge" },
+            { "double", "2.4e9", "ge" },
+            { "float", "0.5", "lt" },
+            { "short", toString(index % 4), "ne" },
+            { "ulonglong", "68719476736", "ge" },
+            { "boolean", (index % 3) ? "true" : "false", "eq" },
+            { "ushort", toString(index % 100), "le" }
+        };
+        props.assign(device, device + (sizeof(device) / sizeof(device[0])));
+    }
+
+    void makeDependencies(const std::vector<DeviceProperty>& props, std::vector<Dependency>& deps)
+    {
+        const char* values[] = { "Linux", "x86_64", "4", "2048", "1.0e9", "1.0", "2", "1073741824", "true", "50" };
+        deps.resize(props.size());
+        for (size_t ii = 0; ii < props.size(); ++ii) {
+            deps[ii].asString <<= values[ii];
+            CORBA::TypeCode_var type = ossie::getTypeCode(props[ii].type);
+            deps[ii].asNative = ossie::string_to_any(values[ii], type);
+        }
+    }
+
+    // The previous AllocationManager::checkMatchingProperty: convert both
+    // sides from their string forms on every evaluation
+    bool legacyMatch(const DeviceProperty& prop, const CORBA::Any& dependency)
+    {
+        CORBA::TypeCode_var type = ossie::getTypeCode(prop.type);
+        const CORBA::Any allocValue = ossie::string_to_any(prop.value, type);
+        const CORBA::Any depValue = ossie::string_to_any(ossie::any_to_string(dependency), type);
+        std::string action = prop.action;
+        return ossie::compare_anys(allocValue, depValue, action);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t devices = 1000;
+    size_t rounds = 10;
+    if (argc > 1) {
+        devices = strtoul(argv[1], 0, 10);
+    }
+    if (argc > 2) {
+        rounds = strtoul(argv[2], 0, 10);
+    }
+
+    CORBA::ORB_var orb = CORBA::ORB_init(argc, argv);
+
+    std::vector< std::vector<DeviceProperty> > profiles(devices);
+    std::vector< std::vector< boost::shared_ptr<ossie::PropertyMatcher> > > compiled(devices);
+    for (size_t dev = 0; dev < devices; ++dev) {
+        makeDevice(dev, profiles[dev]);
+        for (size_t ii = 0; ii < profiles[dev].size(); ++ii) {
+            const DeviceProperty& prop = profiles[dev][ii];
+            CORBA::TypeCode_var type = ossie::getTypeCode(prop.type);
+            const CORBA::Any value = ossie::string_to_any(prop.value, type);
+            compiled[dev].push_back(boost::shared_ptr<ossie::PropertyMatcher>(ossie::PropertyMatcher::Compile(value, prop.action)));
+        }
+    }
+    std::vector<Dependency> deps;
+    makeDependencies(profiles[0], deps);
+
+    const size_t evaluations = devices * deps.size() * rounds;
+    std::cout << "Matching property evaluation, " << devices << " devices x "
+              << deps.size() << " properties x " << rounds << " rounds" << std::endl;
+
+    size_t matches = 0;
+    double start = now();
+    for (size_t round = 0; round < rounds; ++round) {
+        for (size_t dev = 0; dev < devices; ++dev) {
+            for (size_t ii = 0; ii < deps.size(); ++ii) {
+                matches += legacyMatch(profiles[dev][ii], deps[ii].asString);
+            }
+        }
+    }
+    report("legacy, string deps", evaluations, matches, now() - start);
+
+    matches = 0;
+    start = now();
+    for (size_t round = 0; round < rounds; ++round) {
+        for (size_t dev = 0; dev < devices; ++dev) {
+            for (size_t ii = 0; ii < deps.size(); ++ii) {
+                matches += legacyMatch(profiles[dev][ii], deps[ii].asNative);
+            }
+        }
+    }
+    report("legacy, native deps", evaluations, matches, now() - start);
+
+    matches = 0;
+    start = now();
+    for (size_t round = 0; round < rounds; ++round) {
+        for (size_t dev = 0; dev < devices; ++dev) {
+            for (size_t ii = 0; ii < deps.size(); ++ii) {
+                matches += compiled[dev][ii]->match(deps[ii].asString);
+            }
+        }
+    }
+    report("compiled, string deps", evaluations, matches, now() - start);
+
+    // As AllocationManager does, one round being one allocation request
+    // checked against every device
+    matches = 0;
+    start = now();
+    for (size_t round = 0; round < rounds; ++round) {
+        ossie::PropertyMatcher::Conversions conversions;
+        for (size_t dev = 0; dev < devices; ++dev) {
+            for (size_t ii = 0; ii < deps.size(); ++ii) {
+                matches += compiled[dev][ii]->match(deps[ii].asString, &conversions);
+            }
+        }
+    }
+    report("compiled, string deps, cached", evaluations, matches, now() - start);
+
+    matches = 0;
+    start = now();
+    for (size_t round = 0; round < rounds; ++round) {
+        for (size_t dev = 0; dev < devices; ++dev) {
+            for (size_t ii = 0; ii < deps.size(); ++ii) {
+                matches += compiled[dev][ii]->match(deps[ii].asNative);
+            }
+        }
+    }
+    report("compiled, native deps", evaluations, matches, now() - start);
+
+    orb->destroy();
+    return 0;
+}
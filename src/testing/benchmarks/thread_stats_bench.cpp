@@ -0,0 +1,162 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Measures the cost of the ProcessThread service loop statistics by running
+ * an empty service function through ProcessThread, which counts every call
+ * and times one per sample period, and through the uninstrumented loop it
+ * used before. Both loops yield after each call, as ProcessThread does for
+ * NORMAL, so the overhead is reported against the real per-call cost of the
+ * loop.
+ *
+ * usage: thread_stats_bench [calls] [rounds]
+ */
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <ossie/ThreadedComponent.h>
+
+namespace {
+
+    double now()
+    {
+        return ossie::ThreadStatistics::now() * 1e-9;
+    }
+
+    class EmptyComponent : public ThreadedComponent {
+    public:
+        EmptyComponent(size_t calls) :
+            _limit(calls),
+            _calls(0),
+            _done(false)
+        {
+        }
+
+        int serviceFunction()
+        {
+            if (++_calls < _limit) {
+                return NORMAL;
+            }
+            boost::mutex::scoped_lock lock(_lock);
+            _done = true;
+            _cond.notify_all();
+            return FINISH;
+        }
+
+        void wait()
+        {
+            boost::mutex::scoped_lock lock(_lock);
+            while (!_done) {
+                _cond.wait(lock);
+            }
+        }
+
+    private:
+        size_t _limit;
+        size_t _calls;
+        boost::mutex _lock;
+        boost::condition_variable _cond;
+        bool _done;
+    };
+
+    // ProcessThread::run as it was before statistics were recorded
+    void uninstrumentedLoop(ThreadedComponent* target)
+    {
+        while (true) {
+            int state = target->serviceFunction();
+            if (state == FINISH) {
+                return;
+            } else if (state != NOOP) {
+                boost::this_thread::yield();
+            }
+        }
+    }
+
+    double runUninstrumented(size_t calls)
+    {
+        EmptyComponent component(calls);
+        double start = now();
+        boost::thread thread(&uninstrumentedLoop, &component);
+        thread.join();
+        return now() - start;
+    }
+
+    double runInstrumented(size_t calls, ossie::ThreadStatistics::Snapshot& snapshot)
+    {
+        EmptyComponent component(calls);
+        ossie::ProcessThread thread(&component, 0.0);
+        double start = now();
+        thread.start();
+        component.wait();
+        thread.release();
+        double elapsed = now() - start;
+        snapshot = thread.statistics()->snapshot();
+        return elapsed;
+    }
+
+    void report(const std::string& name, size_t calls, double elapsed)
+    {
+        std::cout << std::setw(16) << std::left << name
+                  << std::setw(10) << std::right << std::fixed << std::setprecision(1)
+                  << (elapsed * 1e9 / calls) << " ns/call" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t calls = 1000000;
+    size_t rounds = 5;
+    if (argc > 1) {
+        calls = strtoul(argv[1], 0, 10);
+    }
+    if (argc > 2) {
+        rounds = strtoul(argv[2], 0, 10);
+    }
+
+    std::cout << "Empty service function, " << calls << " calls, best of " << rounds << " rounds" << std::endl;
+
+    // Take the best of several rounds of each, alternating, to keep
+    // frequency scaling and scheduling noise out of the comparison
+    double plain = 0.0;
+    double instrumented = 0.0;
+    ossie::ThreadStatistics::Snapshot snapshot;
+    for (size_t round = 0; round < rounds; ++round) {
+        double elapsed = runUninstrumented(calls);
+        if (round == 0 || elapsed < plain) {
+            plain = elapsed;
+        }
+        elapsed = runInstrumented(calls, snapshot);
+        if (round == 0 || elapsed < instrumented) {
+            instrumented = elapsed;
+        }
+    }
+
+    report("uninstrumented", calls, plain);
+    report("instrumented", calls, instrumented);
+    std::cout << "overhead " << std::setprecision(2) << ((instrumented - plain) * 100.0 / plain) << "%" << std::endl;
+    std::cout << "recorded " << snapshot.calls << " calls, timed " << snapshot.timed << ", service p50 " << snapshot.service.percentile(50.0)
+              << " ns, p99 " << snapshot.service.percentile(99.0) << " ns, gap p99 "
+              << snapshot.gap.percentile(99.0) << " ns" << std::endl;
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef OSSIE_TESTING_CHECK_H
+#define OSSIE_TESTING_CHECK_H
+
+/*
+ * Checks shared by the native test programs run from "make check". Each
+ * failed check is reported on stderr and counted; main() returns result(),
+ * which prints PASS or the number of failures and gives the exit status
+ * automake expects (SKIPPED for a test that cannot run here).
+ */
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace ossie {
+
+    namespace testing {
+
+        // Exit status that automake reports as a skipped test
+        const int SKIPPED = 77;
+
+        inline int& failures()
+        {
+            static int count = 0;
+            return count;
+        }
+
+        inline void check(bool cond, const std::string& what)
+        {
+            if (!cond) {
+                std::cerr << "FAIL: " << what << std::endl;
+                ++failures();
+            }
+        }
+
+        template <typename Actual, typename Expected>
+        inline void checkEqual(const std::string& what, const Actual& actual, const Expected& expected)
+        {
+            if (!(actual == expected)) {
+                std::cerr << "FAIL: " << what << " = '" << actual << "', expected '" << expected << "'" << std::endl;
+                ++failures();
+            }
+        }
+
+        inline void checkClose(const std::string& what, double actual, double expected, double tolerance=1e-9)
+        {
+            if (std::fabs(actual - expected) > tolerance) {
+                std::cerr << "FAIL: " << what << " = " << actual << ", expected " << expected << std::endl;
+                ++failures();
+            }
+        }
+
+        inline int result()
+        {
+            if (failures()) {
+                std::cerr << failures() << " check(s) failed" << std::endl;
+                return 1;
+            }
+            std::cout << "PASS" << std::endl;
+            return 0;
+        }
+
+    }
+
+}
+
+#endif
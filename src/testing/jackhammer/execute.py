@@ -0,0 +1,122 @@
+#
+# This file is protected by Copyright. Please refer to the COPYRIGHT file 
+# distributed with this source distribution.
+# 
+# This file is part of REDHAWK core.
+# 
+# REDHAWK core is free software: you can redistribute it and/or modify it under 
+# the terms of the GNU Lesser General Public License as published by the Free 
+# Software Foundation, either version 3 of the License, or (at your option) any 
+# later version.
+# 
+# REDHAWK core is distributed in the hope that it will be useful, but WITHOUT 
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS 
+# FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+# details.
+# 
+# You should have received a copy of the GNU Lesser General Public License 
+# along with this program.  If not, see http://www.gnu.org/licenses/.
+#
+
+import threading
+import time
+
+from omniORB import CORBA
+
+from ossie.cf import CF, CF__POA
+
+import jackhammer
+
+class StubRegistrar(CF__POA.ApplicationRegistrar):
+    """
+    Minimal ApplicationRegistrar, so that execute() goes through the same
+    registrar and application lookups as a real deployment.
+    """
+    def __init__ (self, app):
+        self.app = app
+
+    def _get_app (self):
+        return self.app
+
+class Execute(jackhammer.Jackhammer):
+    """
+    Concurrent execute()/terminate() against a single ExecutableDevice. The
+    file must be in the domain file system, accept (and ignore) the usual
+    component arguments, and keep running until terminated; for example, a
+    shell script that runs "exec sleep 60".
+
+    usage: python execute.py --threads=100 [--device=<label>] <filename>
+    """
+    def options (self):
+        return "", [ "device=", "report=" ]
+
+    def setOption (self, key, value):
+        if key == "--device":
+            self.deviceLabel = value
+        elif key == "--report":
+            self.reportInterval = int(value)
+
+    def initialize (self, filename):
+        self.fileMgr = self.domMgr._get_fileMgr()
+        self.filename = filename
+        self.device = None
+        label = getattr(self, 'deviceLabel', None)
+        for devMgr in self.domMgr._get_deviceManagers():
+            for device in devMgr._get_registeredDevices():
+                if not device._is_a("IDL:CF/ExecutableDevice:1.0"):
+                    continue
+                if label is None or device._get_label() == label:
+                    self.device = device._narrow(CF.ExecutableDevice)
+                    break
+            if self.device is not None:
+                break
+        if self.device is None:
+            raise RuntimeError, "No ExecutableDevice available"
+
+        apps = self.domMgr._get_applications()
+        app = apps[0] if apps else None
+        poa = self.orb.resolve_initial_references("RootPOA")
+        poa._get_the_POAManager().activate()
+        self.registrar = StubRegistrar(app)
+        registrarIOR = self.orb.object_to_string(self.registrar._this())
+
+        self.params = [ CF.DataType("NAMING_CONTEXT_IOR", CORBA.Any(CORBA.TC_string, registrarIOR)),
+                        CF.DataType("NAME_BINDING", CORBA.Any(CORBA.TC_string, "jackhammer")) ]
+        self.device.load(self.fileMgr, self.filename, CF.LoadableDevice.EXECUTABLE)
+
+        self.lock = threading.Lock()
+        self.count = 0
+        self.counter = 0
+        self.elapsed = 0.0
+        if not hasattr(self, 'reportInterval'):
+            self.reportInterval = 100
+
+    def next_id (self):
+        self.lock.acquire()
+        try:
+            self.counter += 1
+            return self.counter
+        finally:
+            self.lock.release()
+
+    def record (self, elapsed):
+        self.lock.acquire()
+        try:
+            self.count += 1
+            self.elapsed += elapsed
+            if self.count == self.reportInterval:
+                print "execute: %d calls, %.2f ms average" % (self.count, 1e3*self.elapsed/self.count)
+                self.count = 0
+                self.elapsed = 0.0
+        finally:
+            self.lock.release()
+
+    def test (self):
+        params = self.params + [ CF.DataType("COMPONENT_IDENTIFIER", CORBA.Any(CORBA.TC_string, "jackhammer_%d:jackhammer" % self.next_id())) ]
+        start = time.time()
+        pid = self.device.execute(self.filename, [], params)
+        self.record(time.time() - start)
+        self.device.terminate(pid)
+
+if __name__ == '__main__':
+    jackhammer.run(Execute)
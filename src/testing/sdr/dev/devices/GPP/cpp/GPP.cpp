@@ -26,9 +26,12 @@
 
 **************************************************************************/
 #include <stdexcept>
+#include <set>
 #include <linux/limits.h>
 #include <sys/wait.h>
-#include <dirent.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
 #include <signal.h>
 #include <sys/signalfd.h>
 #include <sys/utsname.h>
@@ -104,6 +107,9 @@ GPP_i::~GPP_i()
 void GPP_i::_init() {
 
   sig_fd = -1;
+  screen_resolved = false;
+  reservation_load = 0.0;
+  process_usage.reset( new ProcessUsageStats() );
 
   //
   // add our local set affinity method that performs numa library calls
@@ -148,6 +154,11 @@ void GPP_i::_init() {
 
   // add property change listener
   addPropertyChangeListener("reserved_capacity_per_component", this, &GPP_i::reservedChanged);
+  addPropertyChangeListener("nic_throughput_statistic", this, &GPP_i::nicThroughputStatisticChanged);
+  addPropertyChangeListener("threshold_cycle_time", this, &GPP_i::thresholdCycleTimeChanged);
+  addPropertyChangeListener("thresholds", this, &GPP_i::thresholdsChanged);
+  addPropertyChangeListener("threshold_policy", this, &GPP_i::thresholdPolicyChanged);
+  addPropertyChangeListener("execute_launcher", this, &GPP_i::executeLauncherChanged);
 
   // tie allocation modifier callbacks to identifiers
 
@@ -175,6 +186,8 @@ void GPP_i::postConstruction (std::string &profile,
   // if sigfd > 0 then signalfd method was establish via command line USESIGFD
   if ( sigfd > 0 ) {
     sig_fd = sigfd;
+    child_exits = ChildExitTracker(sig_fd);
+    service_loop.open(sig_fd);
   }
   else {
     // require signalfd to be configured before orb init call.... 
@@ -217,8 +230,6 @@ int GPP_i::_setupExecPartitions( const CpuList &bl_cpus ) {
     std::string nodestr("all");
     struct bitmask *node_mask = numa_parse_nodestring((char *)nodestr.c_str());     
 
-    bitmask *cpu_mask = numa_allocate_cpumask(); 
-    
     // for each node bit set in the mask then get cpu list
     int nbytes = numa_bitmask_nbytes(node_mask);
     for (int i=0; i < nbytes*8; i++ ){
@@ -226,14 +237,12 @@ int GPP_i::_setupExecPartitions( const CpuList &bl_cpus ) {
       cpus.clear();
       if ( numa_bitmask_isbitset( node_mask, i ) ) {
         soc.id = i;
-        numa_node_to_cpus( i, cpu_mask );
-              
+        redhawk::affinity::CpuList node_cpus = redhawk::affinity::Topology::Instance().get_node_cpus( i );
+
         // foreach cpu identified add to list
-        int nb = numa_bitmask_nbytes(cpu_mask);
-        for (int j=0; j < nb*8; j++ ){
-          int count =  std::count( bl_cpus.begin(), bl_cpus.end(), j );
-          if ( numa_bitmask_isbitset( cpu_mask, j ) && count == 0 ) {
-            cpus.push_back( j );
+        for ( redhawk::affinity::CpuList::const_iterator citer = node_cpus.begin(); citer != node_cpus.end(); citer++ ) {
+          if ( std::count( bl_cpus.begin(), bl_cpus.end(), *citer ) == 0 ) {
+            cpus.push_back( *citer );
           }
         }
         CpuUsageStats cpu_usage(cpus);
@@ -246,6 +255,7 @@ int GPP_i::_setupExecPartitions( const CpuList &bl_cpus ) {
         execPartitions.push_back( soc );
       }
     }
+    numa_bitmask_free(node_mask);
 
 #endif
 
@@ -273,7 +283,7 @@ int GPP_i::_setupExecPartitions( const CpuList &bl_cpus ) {
 void  GPP_i::initializeMemoryMonitor()
 {
   // add available memory monitor, mem_free defaults to MB
-  addThresholdMonitor( new FreeMemoryThresholdMonitor(_identifier, MakeCref<CORBA::LongLong, float>(thresholds.mem_free), 
+  mem_monitor = addThresholdMonitor( new FreeMemoryThresholdMonitor(_identifier, MakeCref<CORBA::LongLong, float>(thresholds.mem_free), 
                                                       ConversionWrapper<CORBA::LongLong, float>(memCapacity, 1048576, std::divides<float>() ) ) );
 }
 
@@ -286,6 +296,9 @@ GPP_i::initializeNetworkMonitor()
                                     networkMonitor,
                                     nic_metrics,
                                     nic_allocation_status) );
+    if ( !nic_facade->set_throughput_statistic( nic_throughput_statistic ) ) {
+        LOG_WARN(GPP_i, __FUNCTION__ << ": Unknown nic_throughput_statistic (" << nic_throughput_statistic << "), using current throughput" );
+    }
 
     data_model.push_back( nic_facade );
 
@@ -323,15 +336,16 @@ GPP_i::initializeCpuMonitor()
   data_model.push_back( system_monitor );
 
   //  observer to monitor when cpu idle pass threshold value
-  addThresholdMonitor( new CpuThresholdMonitor(_identifier, &modified_thresholds.cpu_idle, *cpu_usage_stats, false ) );
+  cpu_monitor = addThresholdMonitor( new CpuThresholdMonitor(_identifier, &modified_thresholds.cpu_idle, *cpu_usage_stats, false ) );
 }
 
-void
+boost::shared_ptr<ThresholdMonitor>
 GPP_i::addThresholdMonitor( ThresholdMonitor* threshold_monitor )
 {
 	boost::shared_ptr<ThresholdMonitor> t( threshold_monitor );
 	t->attach_listener( boost::bind(&GPP_i::send_threshold_event, this, _1) );
 	threshold_monitors.push_back( t );
+	return t;
 }
 
 
@@ -372,6 +386,14 @@ void GPP_i::initialize() throw (CF::LifeCycle::InitializeError, CORBA::SystemExc
   initializeCpuMonitor();
   initializeMemoryMonitor();
   initializeNetworkMonitor();
+  _apply_threshold_policy();
+
+  if ( !_apply_execute_launcher( execute_launcher ) ) {
+    LOG_WARN(GPP_i, __FUNCTION__ << ": Unknown execute_launcher (" << execute_launcher << "), using fork" );
+  }
+
+  // per component resource usage
+  data_model.push_back( process_usage );
 
   std::for_each( data_model.begin(), data_model.end(), boost::bind( &Updateable::update, _1 ) );
   std::for_each( execPartitions.begin(), execPartitions.end(), boost::bind( &Updateable::update, _1 ) );
@@ -389,14 +411,25 @@ void GPP_i::initialize() throw (CF::LifeCycle::InitializeError, CORBA::SystemExc
     if  ( *iter ) (*iter)->enable_dispatch();
   }
 
-  // use by service function to mark update time for monitors, states, and stats
-  time_mark = boost::posix_time::microsec_clock::local_time();
+  // pace the updates of monitors, states, and stats
+  _arm_cycle();
 
   GPP_base::start();
   GPP_base::initialize();
 
 }
 
+void GPP_i::start() throw (CF::Resource::StartError, CORBA::SystemException) {
+    service_loop.resume();
+    GPP_base::start();
+}
+
+void GPP_i::stop() throw (CF::Resource::StopError, CORBA::SystemException) {
+    // the service thread may be blocked waiting for the next cycle
+    service_loop.interrupt();
+    GPP_base::stop();
+}
+
 void GPP_i::releaseObject() throw (CORBA::SystemException, CF::LifeCycle::ReleaseError) {
     if ( odm_consumer ) odm_consumer.reset();
     GPP_base::releaseObject();
@@ -408,20 +441,6 @@ CF::ExecutableDevice::ProcessID_Type GPP_i::execute (const char* name, const CF:
            CF::ExecutableDevice::InvalidParameters, CF::ExecutableDevice::InvalidOptions, 
            CF::InvalidFileName, CF::ExecutableDevice::ExecuteFail)
 {
-
-    boost::recursive_mutex::scoped_lock lock;
-    try
-    {
-        lock = boost::recursive_mutex::scoped_lock(load_execute_lock);
-    }
-    catch( const boost::thread_resource_error& e )
-    {
-        std::stringstream errstr;
-        errstr << "Error acquiring lock (errno=" << e.native_error() << " msg=\"" << e.what() << "\")";
-        LOG_ERROR(GPP_i, __FUNCTION__ << ": " << errstr.str() );
-        throw CF::Device::InvalidState(errstr.str().c_str());
-    }
-
     std::vector<std::string> prepend_args;
     std::string naming_context_ior;
     const redhawk::PropertyMap& tmp_params = redhawk::PropertyMap::cast(parameters);
@@ -429,52 +448,13 @@ CF::ExecutableDevice::ProcessID_Type GPP_i::execute (const char* name, const CF:
     std::string app_id;
     std::string component_id = tmp_params["COMPONENT_IDENTIFIER"].toString();
     std::string name_binding = tmp_params["NAME_BINDING"].toString();
-    CF::Application_var _app = CF::Application::_nil();
-    CORBA::Object_var obj = ossie::corba::Orb()->string_to_object(naming_context_ior.c_str());
-    if (CORBA::is_nil(obj)) {
-        LOG_WARN(GPP_i, "Invalid application registrar IOR");
-    } else {
-        CF::ApplicationRegistrar_var _appRegistrar = CF::ApplicationRegistrar::_nil();
-        _appRegistrar = CF::ApplicationRegistrar::_narrow(obj);
-        if (CORBA::is_nil(_appRegistrar)) {
-            LOG_WARN(GPP_i, "Invalid application registrar IOR");
-        } else {
-            _app = _appRegistrar->app();
-            if (not CORBA::is_nil(_app)) {
-                app_id = ossie::corba::returnString(_app->name());
-            }
-        }
-    }
+    // resolve the application before taking the execute lock, so that
+    // concurrent deployments do not serialize on the registrar round trips
+    app_id = _lookup_application(naming_context_ior);
     if (this->useScreen) {
-        std::string ld_lib_path(getenv("LD_LIBRARY_PATH"));
-        setenv("GPP_LD_LIBRARY_PATH",ld_lib_path.c_str(),1);
-        
-        DIR *dir;
-        struct dirent *ent;
-        std::string search_bin("screen");
-    
-        std::string path(getenv( "PATH" ));
-        bool foundScreen = false;
-        while (not foundScreen) {
-            size_t sub = path.find(":");
-            if (path.size() == 0)
-                break;
-            std::string substr = path.substr(0, sub);
-            if ((dir = opendir (substr.c_str())) != NULL) {
-                while ((ent = readdir (dir)) != NULL) {
-                    std::string filename(ent->d_name);
-                    if (filename == search_bin) {
-                        prepend_args.push_back(substr+"/"+filename);
-                        foundScreen = true;
-                        break;
-                    }
-                }
-                closedir (dir);
-            }
-            if (sub != std::string::npos)
-                path = path.substr(sub+1, std::string::npos);
-            else
-                path.clear();
+        std::string screen = _find_screen();
+        if (not screen.empty()) {
+            prepend_args.push_back(screen);
         }
         prepend_args.push_back("-D");
         prepend_args.push_back("-m");
@@ -494,17 +474,192 @@ CF::ExecutableDevice::ProcessID_Type GPP_i::execute (const char* name, const CF:
             prepend_args.push_back(waveform_name+"."+name_binding);
         }
     }
+
+    boost::recursive_mutex::scoped_lock lock;
+    try
+    {
+        lock = boost::recursive_mutex::scoped_lock(load_execute_lock);
+    }
+    catch( const boost::thread_resource_error& e )
+    {
+        std::stringstream errstr;
+        errstr << "Error acquiring lock (errno=" << e.native_error() << " msg=\"" << e.what() << "\")";
+        LOG_ERROR(GPP_i, __FUNCTION__ << ": " << errstr.str() );
+        throw CF::Device::InvalidState(errstr.str().c_str());
+    }
+
+    if (this->useScreen) {
+        const char *ld_lib_path = getenv("LD_LIBRARY_PATH");
+        setenv("GPP_LD_LIBRARY_PATH", ld_lib_path ? ld_lib_path : "", 1);
+    }
+
+    // the leaf exists before the fork so the child can join it ahead of exec
+    std::string cgroup_leaf;
+    if (cgroup.enabled) {
+        cgroup_leaf = _create_cgroup(component_id, options);
+        pending_cgroup_procs = CgroupManager::procs_path(cgroup_leaf);
+    }
+
     CF::ExecutableDevice::ProcessID_Type ret_pid;
     try {
         ret_pid = ExecutableDevice_impl::do_execute(name, options, parameters, prepend_args);
-        this->addPid(ret_pid, app_id, component_id);
-        this->addReservation( getComponentDescription(ret_pid) );
     } catch ( ... ) {
+        pending_cgroup_procs.clear();
+        if (not cgroup_leaf.empty()) {
+            cgroups.remove(cgroup_leaf);
+        }
         throw;
     }
+    pending_cgroup_procs.clear();
+    if (not cgroup_leaf.empty()) {
+        boost::mutex::scoped_lock pid_lock(pidLock);
+        cgroup_leaves[ret_pid] = cgroup_leaf;
+    }
+    this->addPid(ret_pid, app_id, component_id);
+    this->addReservation( getComponentDescription(ret_pid) );
     return ret_pid;
 }
 
+std::string GPP_i::_create_cgroup( const std::string &identifier, const CF::Properties &options )
+{
+    CgroupManager::Limits limits;
+    limits.cpu_cores = cgroup.cpu_limit;
+    limits.memory_bytes = cgroup.memory_limit * 1024 * 1024;
+    limits.pids = cgroup.pids_limit;
+
+    // the ApplicationFactory forwards what the component allocated against
+    // this device, which takes precedence over the GPP wide limits
+    const redhawk::PropertyMap& opts = redhawk::PropertyMap::cast(options);
+    if (opts.contains("ALLOCATION")) {
+        const redhawk::PropertyMap& alloc = opts["ALLOCATION"].asProperties();
+        const std::string load_id("DCE:72c1c4a9-2bcf-49c5-bafd-ae2c1d567056");
+        const std::string mem_id("DCE:8dcef419-b440-4bcf-b893-cab79b6024fb");
+        if (alloc.contains(load_id) and loadCapacityPerCore > 0.0) {
+            limits.cpu_cores = alloc[load_id].toDouble() / loadCapacityPerCore;
+        }
+        if (alloc.contains(mem_id)) {
+            limits.memory_bytes = alloc[mem_id].toLongLong() * 1024 * 1024;
+        }
+    }
+
+    std::string leaf;
+    try {
+        cgroups.set_root(cgroup.root);
+        leaf = cgroups.create(identifier, limits);
+    } catch ( const CgroupManager::CgroupError &e ) {
+        LOG_ERROR(GPP_i, "Unable to create cgroup for " << identifier << ": " << e.what());
+        throw CF::ExecutableDevice::ExecuteFail(CF::CF_EPERM, e.what());
+    }
+    LOG_DEBUG(GPP_i, "Created cgroup " << leaf << " cpu.max: " << CgroupManager::format_cpu_max(limits) <<
+              " memory.max: " << CgroupManager::format_memory_max(limits) <<
+              " pids.max: " << CgroupManager::format_pids_max(limits));
+    return leaf;
+}
+
+void GPP_i::_release_cgroup( int pid )
+{
+    std::string leaf;
+    {
+        boost::mutex::scoped_lock lock(pidLock);
+        std::map<int, std::string>::iterator it = cgroup_leaves.find(pid);
+        if (it == cgroup_leaves.end()) {
+            return;
+        }
+        leaf = it->second;
+    }
+
+    // a leaf that is still populated is retried when the child is reaped
+    if (not cgroups.remove(leaf)) {
+        LOG_DEBUG(GPP_i, "Unable to remove cgroup " << leaf << " yet: " << strerror(errno));
+        return;
+    }
+    boost::mutex::scoped_lock lock(pidLock);
+    cgroup_leaves.erase(pid);
+}
+
+std::string GPP_i::_lookup_application( const std::string &registrar_ior )
+{
+    {
+        boost::mutex::scoped_lock lock(registrarLock);
+        std::map<std::string, std::string>::const_iterator it = app_names.find(registrar_ior);
+        if (it != app_names.end()) {
+            return it->second;
+        }
+    }
+
+    std::string app_id;
+    CORBA::Object_var obj = ossie::corba::Orb()->string_to_object(registrar_ior.c_str());
+    if (CORBA::is_nil(obj)) {
+        LOG_WARN(GPP_i, "Invalid application registrar IOR");
+        return app_id;
+    }
+    CF::ApplicationRegistrar_var _appRegistrar = CF::ApplicationRegistrar::_narrow(obj);
+    if (CORBA::is_nil(_appRegistrar)) {
+        LOG_WARN(GPP_i, "Invalid application registrar IOR");
+        return app_id;
+    }
+    CF::Application_var _app = _appRegistrar->app();
+    if (CORBA::is_nil(_app)) {
+        return app_id;
+    }
+    app_id = ossie::corba::returnString(_app->name());
+
+    // the registrar belongs to a single application, so its name never
+    // changes for a given IOR
+    boost::mutex::scoped_lock lock(registrarLock);
+    app_names[registrar_ior] = app_id;
+    return app_id;
+}
+
+void GPP_i::_prune_application_cache()
+{
+    std::set<std::string> active;
+    {
+        boost::mutex::scoped_lock lock(pidLock);
+        for (ProcessMap::const_iterator it = pids.begin(); it != pids.end(); ++it) {
+            active.insert(it->second.appName);
+        }
+    }
+
+    boost::mutex::scoped_lock lock(registrarLock);
+    std::map<std::string, std::string>::iterator it = app_names.begin();
+    while (it != app_names.end()) {
+        if (active.find(it->second) == active.end()) {
+            app_names.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::string GPP_i::_find_screen()
+{
+    boost::mutex::scoped_lock lock(registrarLock);
+    if (screen_resolved) {
+        return screen_path;
+    }
+
+    const char *env_path = getenv("PATH");
+    std::string path(env_path ? env_path : "");
+    while (not path.empty()) {
+        size_t sub = path.find(":");
+        std::string candidate = path.substr(0, sub) + "/screen";
+        if (access(candidate.c_str(), X_OK) == 0) {
+            screen_path = candidate;
+            break;
+        }
+        if (sub != std::string::npos)
+            path = path.substr(sub+1, std::string::npos);
+        else
+            path.clear();
+    }
+    if (screen_path.empty()) {
+        LOG_WARN(GPP_i, "Unable to find screen on PATH");
+    }
+    screen_resolved = true;
+    return screen_path;
+}
+
 void GPP_i::terminate (CF::ExecutableDevice::ProcessID_Type processId) throw (CORBA::SystemException, CF::ExecutableDevice::InvalidProcess, CF::Device::InvalidState)
 {
     boost::recursive_mutex::scoped_lock lock(load_execute_lock);
@@ -515,6 +670,8 @@ void GPP_i::terminate (CF::ExecutableDevice::ProcessID_Type processId) throw (CO
     catch(...){
     }
     this->removePid(processId);
+    _release_cgroup(processId);
+    _prune_application_cache();
 }
 
 
@@ -526,11 +683,10 @@ void GPP_i::terminate (CF::ExecutableDevice::ProcessID_Type processId) throw (CO
 
 void GPP_i::updateUsageState()
 {
-  if (system_monitor->get_idle_percent() < modified_thresholds.cpu_idle) {
-    if ( system_monitor->get_idle_average() < modified_thresholds.cpu_idle) 
-      setUsageState(CF::Device::BUSY);
-  }
-  else if (system_monitor->get_mem_free() < (unsigned long)modified_thresholds.mem_free)
+  // BUSY follows the sustained state of the cpu and memory monitors, so a
+  // burst of samples on either side of a threshold does not flip it
+  if ( (cpu_monitor and cpu_monitor->is_threshold_exceeded()) or
+       (mem_monitor and mem_monitor->is_threshold_exceeded()) )
     setUsageState(CF::Device::BUSY);
   else if (this->getPids().size() == 0)
     setUsageState(CF::Device::IDLE);
@@ -539,11 +695,38 @@ void GPP_i::updateUsageState()
 }
 
 
+/**
+  override ExecutableDevice::spawned_resource to move a spawned component into its cgroup.
+ */
+void GPP_i::spawned_resource( const CF::Properties& options, const pid_t rsc_pid, const char *rsc_name )
+{
+  if ( pending_cgroup_procs.empty() ) return;
+
+  // the component is already running, anything it forks before this point
+  // stays in the GPP's cgroup
+  if ( !CgroupManager::attach( pending_cgroup_procs.c_str(), rsc_pid ) ) {
+    LOG_ERROR(GPP_i, "Unable to join cgroup " << pending_cgroup_procs << ", resource: " << rsc_name << " Reason: " << strerror(errno) );
+    throw CF::ExecutableDevice::ExecuteFail(CF::CF_EPERM, "Unable to join component cgroup");
+  }
+}
+
 /**
   override ExecutableDevice::set_resource_affinity to handle localized settings.
  */
 void GPP_i::set_resource_affinity( const CF::Properties& options, const pid_t rsc_pid, const char *rsc_name, const std::vector<int> &bl )
  {
+   // runs in the forked child before exec, so join the component's cgroup
+   // here and nothing the component starts escapes its limits.  A spawn
+   // launch calls this for the launching thread (pid 0) and joins the
+   // cgroup in spawned_resource instead.
+   if ( rsc_pid != 0 && !pending_cgroup_procs.empty() ) {
+     if ( !CgroupManager::attach( pending_cgroup_procs.c_str(), rsc_pid ) ) {
+       LOG_ERROR(GPP_i, "Unable to join cgroup " << pending_cgroup_procs << ", resource: " << rsc_name << " Reason: " << strerror(errno) );
+       ossie::corba::OrbShutdown(true);
+       exit(-1);
+     }
+   }
+
    // check if we override incoming affinity requests...
    if ( affinity.force_override ) {
      if ( redhawk::affinity::is_disabled() == false ) {
@@ -623,39 +806,28 @@ void GPP_i::set_resource_affinity( const CF::Properties& options, const pid_t rs
 
 int GPP_i::serviceFunction()
 {
+  // sleep until a child exits, the monitoring cycle is due or a property
+  // change asks for an early pass
+  unsigned int events = service_loop.wait();
+  if ( events & ServiceLoop::INTERRUPTED ) {
+    return FINISH;
+  }
 
   // Check if any children died....
-  fd_set readfds;
-  FD_ZERO(&readfds);
-  FD_SET(sig_fd, &readfds);
-  struct timeval tv = {0, 50};
-  struct signalfd_siginfo si;
-  ssize_t s;
-
-  if ( sig_fd > -1 ) {
-    // don't care about writefds and exceptfds:
-    select(sig_fd+1, &readfds, NULL, NULL, &tv);
-    if (FD_ISSET(sig_fd, &readfds)) {
-      LOG_TRACE(GPP_i, "Checking for signals from SIGNALFD......" << sig_fd);
-      s = read(sig_fd, &si, sizeof(struct signalfd_siginfo));
-      if (s != sizeof(struct signalfd_siginfo)){
-        LOG_ERROR(GPP_i, "SIGCHLD handling error ...");
-      }
- 
-      if ( si.ssi_signo == SIGCHLD) {
-        LOG_TRACE(GPP_i, "Child died , pid .................................." << si.ssi_pid);
-        sigchld_handler(si.ssi_signo);
-      }
-    }
+  if ( events & ServiceLoop::CHILD_EXIT ) {
+    LOG_TRACE(GPP_i, "Checking for signals from SIGNALFD......" << sig_fd);
+    sigchld_handler(SIGCHLD);
+    service_loop.handled( ServiceLoop::CHILD_EXIT );
   }
 
-  boost::posix_time::ptime now = boost::posix_time::microsec_clock::local_time();
-  boost::posix_time::time_duration dur = now -time_mark;
-  if ( dur.total_milliseconds() < threshold_cycle_time ) {
-    return NOOP;
+  if ( events & ServiceLoop::WAKEUP ) {
+    _arm_cycle();
+    _apply_threshold_policy();
+  }
+
+  if ( !( events & ( ServiceLoop::CYCLE | ServiceLoop::WAKEUP ) ) ) {
+    return NORMAL;
   }
-  
-  time_mark = now;
 
   //
   // update any threshold limits that are based on the current system state
@@ -667,6 +839,7 @@ int GPP_i::serviceFunction()
     std::for_each( data_model.begin(), data_model.end(), boost::bind( &Updateable::update, _1 ) );
     std::for_each( execPartitions.begin(), execPartitions.end(), boost::bind( &exec_socket::update, _1 ) );
     calculateSystemMemoryLoading();
+    updateComponentMonitor();
   }
   catch( const boost::thread_resource_error& e ){
     std::stringstream errstr;
@@ -692,21 +865,71 @@ int GPP_i::serviceFunction()
     }
   }
 
-  for( size_t i=0; i<threshold_monitors.size(); ++i ) {
-    threshold_monitors[i]->update();
-    LOG_TRACE(GPP_i, __FUNCTION__ << ": resource_id=" << threshold_monitors[i]->get_resource_id() << 
-              " threshold=" << threshold_monitors[i]->get_threshold() << " measured=" << threshold_monitors[i]->get_measured());
-  }
-
-  // update monitors to see if thresholds are exceeded
-  std::for_each( threshold_monitors.begin(), threshold_monitors.end(), boost::bind( &Updateable::update, _1 ) );
+  // update monitors to see if thresholds are exceeded, once per sample so
+  // the sustain counts stay in step with threshold_cycle_time
+  updateThresholdMonitors();
+  updateThresholdStatistics();
 
   // update device usages state for the GPP
   updateUsageState();
-    
+
+  service_loop.handled( events & ServiceLoop::CYCLE );
+  ServiceLoop::Stats stats = service_loop.get_stats();
+  service_statistics.wakeups = stats.wakeups;
+  service_statistics.child_exit_wakeups = stats.child_exit_wakeups;
+  service_statistics.cycle_wakeups = stats.cycle_wakeups;
+  service_statistics.property_wakeups = stats.property_wakeups;
+  service_statistics.missed_cycles = stats.missed_cycles;
+  service_statistics.cycle_lateness = stats.cycle_lateness;
+  service_statistics.max_cycle_lateness = stats.max_cycle_lateness;
+  service_statistics.child_exit_latency = stats.child_exit_latency;
+  service_statistics.max_child_exit_latency = stats.max_child_exit_latency;
+
   return NORMAL;
 }
 
+void GPP_i::_apply_threshold_policy()
+{
+  ThresholdMonitor::Policy policy;
+  policy.window = threshold_policy.window;
+  policy.sustain = threshold_policy.sustain;
+  policy.hysteresis = threshold_policy.hysteresis;
+  for ( MonitorSequence::iterator iter = threshold_monitors.begin(); iter != threshold_monitors.end(); ++iter ) {
+    (*iter)->set_policy( policy );
+  }
+}
+
+bool GPP_i::_apply_execute_launcher( const std::string &launcher )
+{
+  LaunchMode mode;
+  if ( launcher == "fork" ) {
+    mode = LAUNCH_FORK;
+  }
+  else if ( launcher == "spawn" ) {
+    mode = LAUNCH_SPAWN;
+  }
+  else {
+    return false;
+  }
+
+  // not while a component is part way through being launched
+  boost::recursive_mutex::scoped_lock lock(load_execute_lock);
+  setLaunchMode( mode );
+  return true;
+}
+
+void GPP_i::_arm_cycle()
+{
+  // a zero cycle time used to mean "every pass", the closest the timer gets
+  // is one millisecond
+  try {
+    service_loop.set_cycle( std::max( threshold_cycle_time, (CORBA::ULong)1 ) );
+  }
+  catch( const std::runtime_error &e ) {
+    LOG_ERROR(GPP_i, __FUNCTION__ << ": " << e.what() );
+  }
+}
+
 
 //
 //
@@ -724,6 +947,41 @@ void GPP_i::reservedChanged(const float *oldValue, const float *newValue)
     for( ; iter != execPartitions.end(); iter++ ) {
       iter->idle_cap_mod = 100.0 * reserved_capacity_per_component / ((float)iter->cpus.size());
     }
+    service_loop.wake();
+  }
+}
+
+void GPP_i::thresholdCycleTimeChanged(const CORBA::ULong *oldValue, const CORBA::ULong *newValue)
+{
+  // the service thread owns the timer, let it pick up the new period
+  service_loop.wake();
+}
+
+void GPP_i::thresholdsChanged(const thresholds_struct *oldValue, const thresholds_struct *newValue)
+{
+  // evaluate the new thresholds now rather than at the next cycle
+  service_loop.wake();
+}
+
+void GPP_i::thresholdPolicyChanged(const threshold_policy_struct *oldValue, const threshold_policy_struct *newValue)
+{
+  // the monitors belong to the service thread, it applies the new policy
+  service_loop.wake();
+}
+
+void GPP_i::executeLauncherChanged(const std::string *oldValue, const std::string *newValue)
+{
+  if ( newValue && !_apply_execute_launcher( *newValue ) ) {
+    LOG_WARN(GPP_i, "Unknown execute_launcher (" << *newValue << "), keeping the previous setting" );
+  }
+}
+
+void GPP_i::nicThroughputStatisticChanged(const std::string *oldValue, const std::string *newValue)
+{
+  if ( newValue && nic_facade ) {
+    if ( !nic_facade->set_throughput_statistic( *newValue ) ) {
+      LOG_WARN(GPP_i, "Unknown nic_throughput_statistic (" << *newValue << "), keeping the previous setting" );
+    }
   }
 }
 
@@ -964,7 +1222,9 @@ bool GPP_i::allocate_loadCapacity(const double &value) {
 
 void GPP_i::deallocate_loadCapacity(const double &value) {
   loadCapacity_counter += value;
-  updateThresholdMonitors();
+  // re-evaluate the thresholds on the service thread rather than feeding
+  // the monitors an extra sample from here
+  service_loop.wake();
   updateUsageState();
   return;
 }
@@ -1008,7 +1268,15 @@ void GPP_i::updateThresholdMonitors()
 void GPP_i::establishModifiedThresholds()
 {
   boost::mutex::scoped_lock lock(pidLock);
-  this->modified_thresholds.cpu_idle = this->thresholds.cpu_idle + (this->idle_capacity_modifier * this->reservations.size()) + this->loadCapacity_counter;
+
+  // a reservation is released as the component's measured load grows to
+  // cover it, since that load is then part of the system idle measurement
+  reservation_load = 0.0;
+  for ( ProcessList::const_iterator it = reservations.begin(); it != reservations.end(); ++it ) {
+    reservation_load += _outstanding_reservation( *it );
+  }
+
+  this->modified_thresholds.cpu_idle = this->thresholds.cpu_idle + (this->idle_capacity_modifier * this->reservation_load) + this->loadCapacity_counter;
   LOG_TRACE(GPP_i, __FUNCTION__ << "ModifyThreshold : " << std::endl << 
            " modified_threshold=" << modified_thresholds.cpu_idle << std::endl << 
            " system: idle: " << system_monitor->get_idle_percent() << std::endl << 
@@ -1016,9 +1284,79 @@ void GPP_i::establishModifiedThresholds()
            " threshold: " << thresholds.cpu_idle << std::endl <<
            " modifier: " << idle_capacity_modifier << std::endl <<
            " reservations: " << reservations.size() << std::endl <<
+           " outstanding reservations: " << reservation_load << std::endl <<
            " loadCapacity_counter: " << loadCapacity_counter );
 }
 
+double GPP_i::_outstanding_reservation( const component_description &component ) const
+{
+  // until a component has been sampled its full reservation applies
+  ProcessUsageStats::Usage usage;
+  if ( reserved_capacity_per_component <= 0.0 ||
+       !process_usage->get_usage( component.pid, usage ) || !usage.valid ) {
+    return 1.0;
+  }
+  return std::max( 0.0, 1.0 - (usage.cores / reserved_capacity_per_component) );
+}
+
+void GPP_i::updateComponentMonitor()
+{
+  boost::mutex::scoped_lock lock(pidLock);
+  std::vector<component_monitor_struct_struct> monitor;
+  monitor.reserve( pids.size() );
+  for ( ProcessMap::const_iterator it = pids.begin(); it != pids.end(); ++it ) {
+    const component_description &component = it->second;
+    component_monitor_struct_struct status;
+    status.component_id = component.identifier;
+    status.waveform_id = component.appName;
+    status.pid = it->first;
+
+    ProcessUsageStats::Usage usage;
+    if ( process_usage->get_usage( it->first, usage ) && usage.valid ) {
+      status.cores = usage.cores;
+      status.cpu_time = usage.cpu_time;
+      status.mem_rss = usage.rss / 1048576.0;
+      status.num_threads = usage.num_threads;
+      status.voluntary_context_switches = usage.voluntary_ctxt_switches;
+      status.nonvoluntary_context_switches = usage.nonvoluntary_ctxt_switches;
+      status.read_bytes = usage.read_bytes;
+      status.write_bytes = usage.write_bytes;
+    }
+
+    if ( std::find( reservations.begin(), reservations.end(), component ) != reservations.end() ) {
+      status.reserved = reserved_capacity_per_component * _outstanding_reservation( component );
+    }
+    monitor.push_back( status );
+  }
+  component_monitor.swap( monitor );
+}
+
+void GPP_i::updateThresholdStatistics()
+{
+  std::vector<threshold_statistics_struct_struct> statistics;
+  for ( MonitorSequence::const_iterator iter = threshold_monitors.begin(); iter != threshold_monitors.end(); ++iter ) {
+    const ThresholdMonitorPtr &monitor = *iter;
+    const MetricWindow &window = monitor->get_window();
+    threshold_statistics_struct_struct status;
+    status.resource_id = monitor->get_resource_id();
+    status.threshold_class = monitor->get_message_class();
+    status.exceeded = monitor->is_threshold_exceeded();
+    try {
+      status.threshold = boost::lexical_cast<double>( monitor->get_threshold() );
+    } catch ( const boost::bad_lexical_cast & ) {
+    }
+    status.current = window.last();
+    status.min = window.min();
+    status.max = window.max();
+    status.mean = window.mean();
+    status.p50 = window.percentile( 50.0 );
+    status.p95 = window.percentile( 95.0 );
+    status.samples = window.size();
+    statistics.push_back( status );
+  }
+  threshold_statistics.swap( statistics );
+}
+
 void GPP_i::calculateSystemMemoryLoading() {
   LOG_TRACE(GPP_i, __FUNCTION__ << ": memCapacity=" << memCapacity << " sys_monitor.get_mem_free=" << system_monitor->get_mem_free() );
   memCapacity = system_monitor->get_mem_free();
@@ -1027,32 +1365,54 @@ void GPP_i::calculateSystemMemoryLoading() {
 
 void GPP_i::sigchld_handler(int sig)
 {
-    int status;
-    pid_t child_pid;
-        
-    while( (child_pid = waitpid(-1, &status, WNOHANG)) > 0 )
-    {
+    // SIGCHLD is coalesced by the kernel, so consume every pending siginfo
+    // and reap every exited child rather than one child per signal
+    ChildExitTracker::ExitList exits;
+    size_t signals = child_exits.drain(exits);
+    LOG_TRACE(GPP_i, "SIGCHLD signals: " << signals << " children reaped: " << exits.size());
+
+    for ( ChildExitTracker::ExitList::const_iterator ex = exits.begin(); ex != exits.end(); ++ex ) {
+      component_description component;
+      bool tracked = releaseChild(ex->pid, component);
+      _release_cgroup(ex->pid);
       try {
-        component_description retval;
-        if ( devicePtr) {
-          retval = devicePtr->getComponentDescription(child_pid);
-          sendChildNotification(retval.identifier, retval.appName);
+        if ( tracked ) {
+          LOG_INFO(GPP_i, "Child exited, pid: " << ex->pid << " comp: " << component.identifier << " app: " << component.appName << " (" << ex->describe() << ")");
+          sendChildNotification(component.identifier, component.appName);
         }
-        break;
-      } catch ( ... ) {
-        try {
+        else {
+          LOG_DEBUG(GPP_i, "Untracked child exited, pid: " << ex->pid << " (" << ex->describe() << ")");
           sendChildNotification("Unknown", "Unknown");
-        } catch ( ... ) {
         }
+      } catch ( ... ) {
       }
     }
-    
-    if( child_pid == -1 && errno != ECHILD )
-    {
-        // Error
-        perror("waitpid");
+
+    if ( !exits.empty() ) {
+      _prune_application_cache();
     }
+}
 
+bool GPP_i::releaseChild( int pid, component_description &component )
+{
+    // drop the pid, its reservation and its usage tracking together so the
+    // thresholds never see a reservation for a process that is gone
+    boost::mutex::scoped_lock lock(pidLock);
+    ProcessMap::iterator it = pids.find(pid);
+    if (it == pids.end())
+        return false;
+    component = it->second;
+    pids.erase(it);
+    ProcessList::iterator res = std::find(reservations.begin(), reservations.end(), component);
+    if (res != reservations.end()) {
+        reservations.erase(res);
+    }
+    res = std::find(tabled_reservations.begin(), tabled_reservations.end(), component);
+    if (res != tabled_reservations.end()) {
+        tabled_reservations.erase(res);
+    }
+    process_usage->remove_pid(pid);
+    return true;
 }
 
 
@@ -1071,9 +1431,11 @@ void GPP_i::addPid(int pid, std::string appName, std::string identifier)
     boost::mutex::scoped_lock lock(pidLock);
     if (pids.find(pid) == pids.end()) {
         component_description tmp;
+        tmp.pid = pid;
         tmp.appName = appName;
         tmp.identifier = identifier;
         pids[pid] = tmp;
+        process_usage->add_pid(pid);
     }
 }
 
@@ -1093,6 +1455,7 @@ void GPP_i::removePid(int pid)
     if (it == pids.end())
         return;
     pids.erase(it);
+    process_usage->remove_pid(pid);
 }
 
 void GPP_i::addReservation( const component_description &component)
@@ -1216,7 +1579,7 @@ bool GPP_i::_check_exec_partition( const std::string &iface ){
       if ( (uint32_t)soc < execPartitions.size() ) {
         const exec_socket &ep = execPartitions[soc];
         // get modified idle threshold value
-        double m_idle_thresh = ep.idle_threshold + ( ep.idle_cap_mod * reservations.size()) + 
+        double m_idle_thresh = ep.idle_threshold + ( ep.idle_cap_mod * reservation_load) + 
           (float)loadCapacity_counter/(float)ep.cpus.size();
         RH_NL_DEBUG("GPP", " Checking Execution Partition for an NIC interface iface/socket " << iface << "/" << soc << ") IDLE: actual/avg/threshold limit/modified " <<  
                    ep.get_idle_percent() << "/" << ep.get_idle_average() << "/" << ep.idle_threshold << "/" << m_idle_thresh );
@@ -1239,7 +1602,7 @@ int  GPP_i::_get_deploy_on_partition() {
   ExecPartitionList::iterator  iter = execPartitions.begin();
   for( ;  iter != execPartitions.end(); iter++ ) {
     // get modified idle threshold value
-    double m_idle_thresh = iter->idle_threshold + ( iter->idle_cap_mod * reservations.size()) + 
+    double m_idle_thresh = iter->idle_threshold + ( iter->idle_cap_mod * reservation_load) + 
       (float)loadCapacity_counter/(float)iter->cpus.size();
     RH_NL_DEBUG("GPP", " Looking for execute partition (processor socket:" << iter->id << ") IDLE: actual/avg/threshold limit/modified " <<  
 		iter->get_idle_percent() << "/" << iter->get_idle_average() << "/" << iter->idle_threshold << "/" << m_idle_thresh );
@@ -28,6 +28,10 @@
 #include "states/State.h"
 #include "statistics/Statistics.h"
 #include "statistics/CpuUsageStats.h"
+#include "statistics/ProcessUsageStats.h"
+#include "utils/ChildExitTracker.h"
+#include "utils/CgroupManager.h"
+#include "utils/ServiceLoop.h"
 #include "reports/SystemMonitorReporting.h"
 #include "reports/CpuThresholdMonitor.h"
 #include "NicFacade.h"
@@ -52,7 +56,7 @@ class GPP_i : public GPP_base
         void initializeNetworkMonitor();
         void initializeMemoryMonitor();
         void initializeCpuMonitor();
-        void addThresholdMonitor( ThresholdMonitor* threshold_monitor );
+        boost::shared_ptr<ThresholdMonitor> addThresholdMonitor( ThresholdMonitor* threshold_monitor );
         void send_threshold_event(const threshold_event_struct& message);
         
         void initialize() throw (CF::LifeCycle::InitializeError, CORBA::SystemException);
@@ -76,6 +80,8 @@ class GPP_i : public GPP_base
         void deallocateCapacity_nic_allocation(const nic_allocation_struct &value);
         void deallocateCapacity (const CF::Properties& capacities) throw (CF::Device::InvalidState, CF::Device::InvalidCapacity, CORBA::SystemException);
         CORBA::Boolean allocateCapacity (const CF::Properties& capacities) throw (CF::Device::InvalidState, CF::Device::InvalidCapacity, CF::Device::InsufficientCapacity, CORBA::SystemException);
+        void start() throw (CF::Resource::StartError, CORBA::SystemException);
+        void stop() throw (CF::Resource::StopError, CORBA::SystemException);
         void releaseObject() throw (CORBA::SystemException, CF::LifeCycle::ReleaseError);
         void postConstruction( std::string &softwareProfile,
                           std::string &registrar_ior,
@@ -86,8 +92,10 @@ class GPP_i : public GPP_base
 
     protected:
 	struct component_description {
+	  int         pid;
 	  std::string appName;
 	  std::string identifier;
+	  component_description() : pid(-1) {};
 	};
 
         struct LoadCapacity {
@@ -141,9 +149,15 @@ class GPP_i : public GPP_base
                                       const char  *rsc_name,
                                       const std::vector<int> &bl);           
 
+         void  spawned_resource( const CF::Properties& options,
+                                 const pid_t rsc_pid,
+                                 const char  *rsc_name );
+
 
         void process_ODM(const CORBA::Any &data);
         void updateUsageState();
+        void updateComponentMonitor();
+        void updateThresholdStatistics();
 
 	typedef boost::shared_ptr<ThresholdMonitor>           ThresholdMonitorPtr;
         typedef std::vector< uint32_t >                       CpuList;
@@ -163,16 +177,34 @@ class GPP_i : public GPP_base
         void tableReservation(const component_description &component);
         void restoreReservation(const component_description &component);
         void reservedChanged(const float *oldValue, const float *newValue);
+        void nicThroughputStatisticChanged(const std::string *oldValue, const std::string *newValue);
+        void thresholdCycleTimeChanged(const CORBA::ULong *oldValue, const CORBA::ULong *newValue);
+        void thresholdsChanged(const thresholds_struct *oldValue, const thresholds_struct *newValue);
+        void thresholdPolicyChanged(const threshold_policy_struct *oldValue, const threshold_policy_struct *newValue);
+        void executeLauncherChanged(const std::string *oldValue, const std::string *newValue);
         void establishModifiedThresholds();
         void sigchld_handler( int sig );
+        bool releaseChild( int pid, component_description &component );
 
         ProcessList                                         reservations;
         ProcessList                                         tabled_reservations;
         ProcessMap                                          pids;
         boost::mutex                                        pidLock;
+        ChildExitTracker                                    child_exits;        // reaps launched components as they exit
+        boost::mutex                                        registrarLock;      // guards app_names and screen_path
+        std::map<std::string, std::string>                  app_names;          // application name, keyed by registrar IOR
+        std::string                                         screen_path;        // location of screen, resolved on first use
+        bool                                                screen_resolved;
+        ProcessUsageStatsPtr                                process_usage;      // measured usage of launched components
+        double                                              reservation_load;   // number of reservations not yet covered by measured usage
+        CgroupManager                                       cgroups;            // per-component cgroup v2 leaves
+        std::map<int, std::string>                          cgroup_leaves;      // leaf of each confined component, keyed by pid, guarded by pidLock
+        std::string                                         pending_cgroup_procs; // cgroup.procs the component being launched joins before exec
 
         NicFacadePtr                                        nic_facade;
         MonitorSequence                                     threshold_monitors;
+        ThresholdMonitorPtr                                 cpu_monitor;        // sustained cpu idle state, drives BUSY
+        ThresholdMonitorPtr                                 mem_monitor;        // sustained free memory state, drives BUSY
         SystemMonitorPtr                                    system_monitor;
         ExecPartitionList                                   execPartitions;
         double                                              loadCapacity_counter;
@@ -185,7 +217,7 @@ class GPP_i : public GPP_base
 
         std::string                                         binary_location;    // path to this program.
         
-        boost::posix_time::ptime                            time_mark;          // time marker for update
+        ServiceLoop                                         service_loop;       // wakes the service thread for child exits, cycles and property changes
         redhawk::events::SubscriberPtr                      odm_consumer;       // interface that receives ODM_Channel events
         redhawk::events::ManagerPtr                         mymgr;              // interface to manage event channel access
 
@@ -231,6 +263,52 @@ class GPP_i : public GPP_base
         //
         void _set_processor_monitor_list( const CpuList &cl );
 
+        //
+        // Name of the application behind an ApplicationRegistrar IOR, cached per IOR
+        //
+        std::string _lookup_application( const std::string &registrar_ior );
+
+        //
+        // Release cached application names that no launched component refers to
+        //
+        void _prune_application_cache();
+
+        //
+        // Location of the screen executable on $PATH, empty if not found
+        //
+        std::string _find_screen();
+
+        //
+        // Create the cgroup leaf for a component about to be launched, limits
+        // follow the loadCapacity/memCapacity it allocated
+        //
+        std::string _create_cgroup( const std::string &identifier, const CF::Properties &options );
+
+        //
+        // Remove a component's cgroup leaf once its processes are gone
+        //
+        void _release_cgroup( int pid );
+
+        //
+        // Portion of a component's reservation not covered by its measured cpu usage
+        //
+        double _outstanding_reservation( const component_description &component ) const;
+
+        //
+        // Arm the service loop timer with threshold_cycle_time
+        //
+        void _arm_cycle();
+
+        //
+        // Apply the threshold_policy property to every threshold monitor
+        //
+        void _apply_threshold_policy();
+
+        //
+        // Select the ExecutableDevice launcher named by execute_launcher
+        //
+        bool _apply_execute_launcher( const std::string &launcher );
+
         //
         // Common method called by all CTORs
         //
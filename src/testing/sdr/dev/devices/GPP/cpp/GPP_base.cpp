@@ -307,6 +307,14 @@ void GPP_base::loadProperties()
                 "external",
                 "configure");
 
+    addProperty(component_monitor,
+                "component_monitor",
+                "",
+                "readonly",
+                "",
+                "external",
+                "configure");
+
     addProperty(processor_monitor_list,
                 "processor_monitor_list",
                 "",
@@ -334,6 +342,59 @@ void GPP_base::loadProperties()
                 "external",
                 "property,configure");
 
+    addProperty(nic_throughput_statistic,
+                "current",
+                "nic_throughput_statistic",
+                "nic_throughput_statistic",
+                "readwrite",
+                "",
+                "external",
+                "property,configure");
+
+    addProperty(cgroup,
+                cgroup_struct(),
+                "cgroup",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "configure,property");
+
+    addProperty(service_statistics,
+                service_statistics_struct(),
+                "service_statistics",
+                "",
+                "readonly",
+                "",
+                "external",
+                "configure");
+
+    addProperty(threshold_policy,
+                threshold_policy_struct(),
+                "threshold_policy",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "configure,property");
+
+    addProperty(threshold_statistics,
+                "threshold_statistics",
+                "",
+                "readonly",
+                "",
+                "external",
+                "configure");
+
+    addProperty(execute_launcher,
+                "fork",
+                "execute_launcher",
+                "execute_launcher",
+                "readwrite",
+                "",
+                "external",
+                "property,configure");
+
 }
 
 
@@ -70,9 +70,16 @@ class GPP_base : public ExecutableDevice_impl, protected ThreadedComponent
         std::vector<nic_allocation_status_struct_struct> nic_allocation_status;
         std::vector<nic_metrics_struct_struct> nic_metrics;
         std::vector<interfaces_struct> networkMonitor;
+        std::vector<component_monitor_struct_struct> component_monitor;
         std::string processor_monitor_list;
         affinity_struct affinity;
         CORBA::ULong threshold_cycle_time;
+        std::string nic_throughput_statistic;
+        cgroup_struct cgroup;
+        service_statistics_struct service_statistics;
+        threshold_policy_struct threshold_policy;
+        std::vector<threshold_statistics_struct_struct> threshold_statistics;
+        std::string execute_launcher;
 
         // Ports
         PropertyEventSupplier *propEvent;
@@ -28,6 +28,7 @@
 #include <boost/bind.hpp>
 
 #include <net/if.h>
+#include <string.h>
 
 #if BOOST_FILESYSTEM_VERSION < 3
 #define BOOST_PATH_STRING(x) (x)
@@ -44,7 +45,9 @@ NicFacade::NicFacade( const double& max_throughput_percent,
                       std::vector<interfaces_struct>& reporting_data,
                       std::vector<nic_metrics_struct_struct>& nic_metrics_reporting_data,
                       std::vector<nic_allocation_status_struct_struct>& nic_allocation_status_reporting_data ):
+net_dev_(new ProcNetDev()),
 nic_interface_filter_(nic_interface_regexes, nic_states_, filtered_nic_states_),
+throughput_percentile_(0),
 filtered_nic_interfaces_reporting_data_(filtered_nic_interfaces_reporting_data),
 reporting_data_(reporting_data),
 nic_metrics_reporting_data_(nic_metrics_reporting_data),
@@ -114,7 +117,7 @@ NicFacade::get_or_insert_nic_state( const std::string& interface )
     if( nic_states_.end() == i )
     {
       RH_NL_DEBUG( "GPP", __FUNCTION__ << ": Adding NicState (" << interface << ")" );
-      i = nic_states_.insert( std::make_pair(interface, new NicState(interface)) ).first;
+      i = nic_states_.insert( std::make_pair(interface, new NicState(interface, net_dev_)) ).first;
     }
     return i->second;
 }
@@ -151,6 +154,16 @@ NicFacade::deallocate_capacity( const nic_allocation_struct& alloc )
 void 
 NicFacade::update_state()
 {
+    try
+    {
+        net_dev_->update_state();
+    }
+    catch( const std::exception& e )
+    {
+        // the nic states fall back to sysfs for the counters
+        RH_NL_DEBUG( "GPP", __FUNCTION__ << ": Unable to read /proc/net/dev (" << e.what() << ")" );
+    }
+
     for( NicStates::iterator i=nic_states_.begin(); i!=nic_states_.end(); ++i )
     {
         i->second->update_state();
@@ -257,7 +270,7 @@ NicFacade::write_nic_metrics_reporting_data()
         report->rate_allocated = nic_allocator_->get_allocated_device_throughput(nic_state->get_device()) * MBIT_PER_BIT;
         report->time_string_utc = time_str;
         report->time = t;
-        report->current_throughput =  get_throughput_by_device(nic_state->get_device()) * MBIT_PER_MB;
+        report->current_throughput =  get_current_throughput_by_device(nic_state->get_device()) * MBIT_PER_MB;
     }
 }
 
@@ -322,6 +335,20 @@ NicFacade::get_devices() const
 
 float 
 NicFacade::get_throughput_by_device( const std::string& device ) const
+{
+    NicAccumulators::const_iterator i = nic_accumulators_.find( device );
+    if( nic_accumulators_.end() == i )
+        return 0;
+    const double percentile = get_throughput_percentile();
+    if( percentile <= 0 )
+        return i->second->get_throughput_MB_per_sec();
+    if( percentile >= 100 )
+        return i->second->get_peak_throughput_MB_per_sec();
+    return i->second->get_percentile_throughput_MB_per_sec( percentile );
+}
+
+float 
+NicFacade::get_current_throughput_by_device( const std::string& device ) const
 {
     NicAccumulators::const_iterator i = nic_accumulators_.find( device );
     if( nic_accumulators_.end() != i )
@@ -330,6 +357,54 @@ NicFacade::get_throughput_by_device( const std::string& device ) const
         return 0;
 }
 
+bool
+NicFacade::set_throughput_statistic( const std::string& statistic )
+{
+    if( statistic == "current" )
+    {
+        set_throughput_percentile( 0 );
+        return true;
+    }
+    if( statistic == "peak" )
+    {
+        set_throughput_percentile( 100 );
+        return true;
+    }
+    if( statistic.size() > 1 && statistic[0] == 'p' )
+    {
+        try
+        {
+            double percentile = boost::lexical_cast<double>( statistic.substr(1) );
+            if( percentile > 0 && percentile <= 100 )
+            {
+                set_throughput_percentile( percentile );
+                return true;
+            }
+        }
+        catch( const boost::bad_lexical_cast& )
+        {
+        }
+    }
+    return false;
+}
+
+double
+NicFacade::get_throughput_percentile() const
+{
+    uint64_t bits = __sync_fetch_and_add( const_cast<volatile uint64_t*>(&throughput_percentile_), 0 );
+    double percentile;
+    memcpy( &percentile, &bits, sizeof(percentile) );
+    return percentile;
+}
+
+void
+NicFacade::set_throughput_percentile( double percentile )
+{
+    uint64_t bits;
+    memcpy( &bits, &percentile, sizeof(bits) );
+    __sync_lock_test_and_set( &throughput_percentile_, bits );
+}
+
 double 
 NicFacade::get_throughput_by_device_bps( const std::string& device ) const
 {
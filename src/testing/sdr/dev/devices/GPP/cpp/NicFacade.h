@@ -23,11 +23,13 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <stdint.h>
 #include <boost/shared_ptr.hpp>
 
 #include "NicInterfaceFilter.h"
 #include "NicAllocator.h"
 #include "states/NicState.h"
+#include "states/ProcNetDev.h"
 #include "reports/Reporting.h"
 #include "struct_props.h"
 
@@ -58,9 +60,24 @@ public:
     void report();
     
     std::vector<std::string> get_devices() const;
+
+    // throughput in MB/s (and bits/s) for the selected statistic, used by
+    // the allocator and the threshold monitors
     float get_throughput_by_device( const std::string& device ) const;
     double get_throughput_by_device_bps( const std::string& device ) const;
 
+    // throughput over the last sample interval
+    float get_current_throughput_by_device( const std::string& device ) const;
+
+    //
+    // Select the statistic reported by get_throughput_by_device:
+    //   "current"  last sample interval
+    //   "peak"     highest interval in the rate history
+    //   "pNN"      NN-th percentile of the rate history, e.g. "p95"
+    // Returns false, leaving the selection unchanged, if the name is not recognized.
+    //
+    bool set_throughput_statistic( const std::string& statistic );
+
 private:
     std::vector<std::string> poll_nic_interfaces() const;
     boost::shared_ptr<NicState> get_or_insert_nic_state( const std::string& interface );
@@ -73,17 +90,25 @@ private:
     void write_nic_allocation_status_reporting_data();
     
     std::string flags_to_str( unsigned int flags ) const;
+
+    double get_throughput_percentile() const;
+    void set_throughput_percentile( double percentile );
     
 private:
     typedef std::map<std::string, boost::shared_ptr<NicState> > NicStates;
     typedef std::map<std::string, boost::shared_ptr<NicAccumulator> > NicAccumulators;
     
+    ProcNetDevPtr net_dev_; // counters for every interface, read once per update
     NicStates nic_states_; // Indexed by nic interface
     NicStates filtered_nic_states_;
     NicAccumulators nic_accumulators_; // Indexed by nic device (interface without vlan)
     
     NicInterfaceFilter nic_interface_filter_;
     boost::shared_ptr<NicAllocator> nic_allocator_;
+    // 0 = current, 100 = peak; set from the property callback and read by
+    // the service thread and the allocator, so it holds the bits of the
+    // double and is only accessed atomically
+    volatile uint64_t throughput_percentile_;
     
     std::vector<std::string>& filtered_nic_interfaces_reporting_data_;
     std::vector<interfaces_struct>& reporting_data_;
@@ -0,0 +1,163 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Compares the two ExecutableDevice launchers, fork followed by execv and
+ * posix_spawn, from a process that carries a device sized heap.  Launches
+ * are issued from 1, 50 and 200 threads at once and serialized by a mutex,
+ * the same way load_execute_lock serializes execute() calls, and the
+ * per-launch latency seen by the calling thread is reported.
+ *
+ * usage: launch_bench [heap MiB] [executable]
+ */
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+static double elapsed( const struct timespec &start, const struct timespec &end )
+{
+  return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+static pid_t launch_fork( char **argv )
+{
+  pid_t pid = fork();
+  if ( pid == 0 ) {
+    setpgid( 0, 0 );
+    execv( argv[0], argv );
+    _exit( 127 );
+  }
+  return pid;
+}
+
+static pid_t launch_spawn( char **argv )
+{
+  posix_spawnattr_t attr;
+  posix_spawnattr_init( &attr );
+  posix_spawnattr_setpgroup( &attr, 0 );
+  posix_spawnattr_setflags( &attr, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_USEVFORK );
+  pid_t pid = -1;
+  int rc = posix_spawn( &pid, argv[0], 0, &attr, argv, environ );
+  posix_spawnattr_destroy( &attr );
+  if ( rc ) {
+    errno = rc;
+    return -1;
+  }
+  return pid;
+}
+
+struct Launcher {
+  typedef pid_t (*Function)( char ** );
+
+  Launcher( Function f, char **a, int n ) :
+    launch(f), argv(a), start(n), latency(n, 0.0), pids(n, -1) {}
+
+  void run( int index )
+  {
+    start.wait();
+    struct timespec begin, end;
+    clock_gettime( CLOCK_MONOTONIC, &begin );
+    {
+      boost::mutex::scoped_lock lock( execute_lock );
+      pids[index] = launch( argv );
+    }
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    latency[index] = elapsed( begin, end ) * 1e3;
+  }
+
+  Function             launch;
+  char               **argv;
+  boost::barrier       start;
+  boost::mutex         execute_lock;
+  std::vector<double>  latency;
+  std::vector<pid_t>   pids;
+};
+
+static bool measure( const char *label, Launcher::Function launch, char **argv, int concurrency )
+{
+  Launcher launcher( launch, argv, concurrency );
+  boost::thread_group threads;
+  for ( int i=0; i < concurrency; ++i ) {
+    threads.create_thread( boost::bind( &Launcher::run, &launcher, i ) );
+  }
+  threads.join_all();
+
+  int failed = 0;
+  for ( int i=0; i < concurrency; ++i ) {
+    int status = 0;
+    if ( launcher.pids[i] < 0 || waitpid( launcher.pids[i], &status, 0 ) < 0 ||
+         !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) {
+      ++failed;
+    }
+  }
+
+  std::vector<double> &lat = launcher.latency;
+  std::sort( lat.begin(), lat.end() );
+  double total = 0;
+  for ( size_t i=0; i < lat.size(); ++i ) total += lat[i];
+  size_t p95 = std::min( lat.size() - 1, (size_t)( lat.size() * 0.95 ) );
+  std::cout << std::left << std::setw(7) << label << std::right
+            << std::setw(6) << concurrency
+            << std::fixed << std::setprecision(3)
+            << std::setw(11) << total / lat.size()
+            << std::setw(11) << lat[lat.size() / 2]
+            << std::setw(11) << lat[p95]
+            << std::setw(11) << lat.back()
+            << std::setw(8) << failed << std::endl;
+  return failed == 0;
+}
+
+int main( int argc, char *argv[] )
+{
+  size_t heap_mib = 512;
+  const char *executable = "/bin/true";
+  if ( argc > 1 ) heap_mib = atoi( argv[1] );
+  if ( argc > 2 ) executable = argv[2];
+  if ( access( executable, X_OK ) != 0 ) {
+    std::cerr << "usage: " << argv[0] << " [heap MiB] [executable]" << std::endl;
+    return 1;
+  }
+
+  // touch every page so fork has a resident heap's page tables to copy
+  std::vector<char> heap( heap_mib * 1024 * 1024 );
+  for ( size_t i=0; i < heap.size(); i += 4096 ) heap[i] = 1;
+
+  char *child_argv[] = { const_cast<char*>(executable), 0 };
+  const int concurrency[] = { 1, 50, 200 };
+
+  std::cout << "heap: " << heap_mib << " MiB, executable: " << executable << std::endl
+            << "mode   launches   mean(ms)   p50(ms)    p95(ms)    max(ms) failed" << std::endl;
+  bool ok = true;
+  for ( size_t i=0; i < sizeof(concurrency)/sizeof(concurrency[0]); ++i ) {
+    ok &= measure( "fork", launch_fork, child_argv, concurrency[i] );
+    ok &= measure( "spawn", launch_spawn, child_argv, concurrency[i] );
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Measures the cost of a ProcessUsageStats sampling cycle with a large
+ * number of tracked processes. The benchmark forks idle children, tracks
+ * them the same way the GPP tracks launched components, and reports the
+ * time spent per cycle and per process.
+ *
+ * usage: pidstat_bench [children] [cycles]
+ */
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "statistics/ProcessUsageStats.h"
+
+static double elapsed( const struct timespec &start, const struct timespec &end )
+{
+  return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+int main( int argc, char *argv[] )
+{
+  int children = 500;
+  int cycles = 20;
+  if ( argc > 1 ) children = atoi( argv[1] );
+  if ( argc > 2 ) cycles = atoi( argv[2] );
+  if ( children < 1 || cycles < 1 ) {
+    std::cerr << "usage: " << argv[0] << " [children] [cycles]" << std::endl;
+    return 1;
+  }
+
+  std::vector< pid_t > pids;
+  ProcessUsageStats stats;
+  for ( int i=0; i < children; ++i ) {
+    pid_t pid = fork();
+    if ( pid == 0 ) {
+      for (;;) pause();
+    }
+    if ( pid < 0 ) {
+      perror("fork");
+      break;
+    }
+    pids.push_back( pid );
+    stats.add_pid( pid );
+  }
+
+  // first pass establishes the baseline for each process
+  stats.compute_statistics();
+
+  struct timespec start, end;
+  clock_gettime( CLOCK_MONOTONIC, &start );
+  for ( int i=0; i < cycles; ++i ) {
+    stats.compute_statistics();
+  }
+  clock_gettime( CLOCK_MONOTONIC, &end );
+
+  ProcessUsageStats::UsageList usage;
+  stats.get_usage( usage );
+  size_t valid = 0;
+  for ( size_t i=0; i < usage.size(); ++i ) {
+    if ( usage[i].valid ) ++valid;
+  }
+
+  for ( size_t i=0; i < pids.size(); ++i ) {
+    kill( pids[i], SIGKILL );
+  }
+  for ( size_t i=0; i < pids.size(); ++i ) {
+    waitpid( pids[i], NULL, 0 );
+  }
+
+  double per_cycle = elapsed( start, end ) / cycles * 1e6;
+  std::cout << std::fixed << std::setprecision(1)
+            << "processes: " << pids.size() << " (" << valid << " sampled)" << std::endl
+            << "cycle:     " << per_cycle << " us" << std::endl
+            << "process:   " << std::setprecision(2) << per_cycle / pids.size() << " us" << std::endl;
+  return valid == pids.size() ? 0 : 1;
+}
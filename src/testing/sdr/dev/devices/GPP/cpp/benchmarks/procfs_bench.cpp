@@ -0,0 +1,222 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Compares the ProcStat and ProcMeminfo parsers against the previous
+ * stream based implementation using captured /proc files, checking that
+ * both produce the same contents and reporting the time per sample.
+ *
+ * usage: procfs_bench [fixture directory] [iterations]
+ */
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include "parsers/ProcStatParser.h"
+#include "parsers/ProcMeminfoParser.h"
+
+namespace legacy {
+
+  // Reference implementations, equivalent to the stream parsers that
+  // ProcStatParser and ProcMeminfoParser replaced
+
+  void parse_stat( const std::string &fname, ProcStat::Contents &data )
+  {
+    std::ifstream procstat_file( fname.c_str() );
+    std::string line;
+    data.time_stamp = time(NULL);
+    while ( std::getline( procstat_file, line ) ) {
+      std::vector<std::string> values;
+      boost::split( values, line, boost::is_any_of(std::string(" ")), boost::algorithm::token_compress_on );
+      if ( boost::starts_with( values[0], "cpu" ) ) {
+        ProcStat::CpuStat cstat;
+        cstat.id = values[0];
+        cstat.idx = -1;
+        try {
+          if ( values[0].size() > 3 ) cstat.idx = boost::lexical_cast<int>( values[0].substr(3) );
+        } catch ( const boost::bad_lexical_cast& ) {
+        }
+        cstat.jiffies.resize( values.size()-1 );
+        for ( uint32_t i=1; i<values.size(); ++i ) {
+          try {
+            cstat.jiffies[i-1] = boost::lexical_cast<ProcStat::Counter>( values[i] );
+          } catch ( const boost::bad_lexical_cast& ) {
+          }
+        }
+        if ( cstat.idx == -1 ) data.all = cstat;
+        else data.cpus.push_back( cstat );
+      }
+      ProcStat::CounterList *list = 0;
+      if ( boost::starts_with( values[0], "intr" ) ) list = &data.interrupts;
+      if ( boost::starts_with( values[0], "softirq" ) ) list = &data.soft_irqs;
+      if ( list ) {
+        ProcStat::CounterList stat_list;
+        for ( uint32_t i=1; i<values.size(); ++i ) {
+          try {
+            stat_list.push_back( boost::lexical_cast<ProcStat::Counter>( values[i] ) );
+          } catch ( const boost::bad_lexical_cast& ) {
+          }
+        }
+        list->swap( stat_list );
+      }
+      if ( boost::starts_with( values[0], "btime" ) ) data.boot_time = boost::lexical_cast<ProcStat::Counter>( values[1] );
+      if ( boost::starts_with( values[0], "ctxt" ) ) data.context_switches = boost::lexical_cast<ProcStat::Counter>( values[1] );
+      if ( boost::starts_with( values[0], "processes" ) ) data.processes_started = boost::lexical_cast<ProcStat::Counter>( values[1] );
+    }
+  }
+
+  void parse_meminfo( const std::string &fname, ProcMeminfo::Contents &data )
+  {
+    std::ifstream procmeminfo_file( fname.c_str() );
+    std::string line;
+    while ( std::getline( procmeminfo_file, line ) ) {
+      std::vector<std::string> values;
+      boost::split( values, line, boost::is_any_of(std::string(" ")), boost::algorithm::token_compress_on );
+      std::string key = values[0].substr(0, values[0].find(":"));
+      ProcMeminfo::Counter metric = 0;
+      if ( values.size() >= 2 ) {
+        try {
+          metric = boost::lexical_cast<ProcMeminfo::Counter>( values[1] );
+        } catch ( const boost::bad_lexical_cast& ) {
+        }
+      }
+      ProcMeminfo::Counter unit_m = 1;
+      if ( values.size() >= 3 ) {
+        std::string units(values[2]);
+        boost::to_upper(units);
+        if ( units == "KB" ) unit_m = 1e3;
+        if ( units == "MB" ) unit_m = 1e6;
+        if ( units == "GB" ) unit_m = 1e9;
+        if ( units == "TB" ) unit_m = 1e12;
+      }
+      data[key] = metric * unit_m;
+    }
+  }
+
+};
+
+
+static bool operator==( const ProcStat::CpuStat &lhs, const ProcStat::CpuStat &rhs )
+{
+  return (lhs.id == rhs.id) && (lhs.idx == rhs.idx) && (lhs.jiffies == rhs.jiffies);
+}
+
+static bool same_contents( const ProcStat::Contents &lhs, const ProcStat::Contents &rhs )
+{
+  return (lhs.all == rhs.all) && (lhs.cpus == rhs.cpus) &&
+    (lhs.interrupts == rhs.interrupts) && (lhs.soft_irqs == rhs.soft_irqs) &&
+    (lhs.context_switches == rhs.context_switches) && (lhs.boot_time == rhs.boot_time) &&
+    (lhs.processes_started == rhs.processes_started);
+}
+
+static ProcStat::Contents empty_stat()
+{
+  ProcStat::Contents contents = ProcStat::Contents();
+  return contents;
+}
+
+static double now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+static void report( const std::string &name, const std::string &impl, size_t iterations, double elapsed )
+{
+  std::cout << std::setw(20) << std::left << name << std::setw(10) << impl
+            << std::setw(12) << std::right << std::fixed << std::setprecision(2)
+            << (elapsed * 1e6 / iterations) << " us/sample" << std::endl;
+}
+
+static bool bench_stat( const std::string &fname, size_t iterations )
+{
+  ProcStat::Contents expected = empty_stat();
+  legacy::parse_stat( fname, expected );
+
+  ProcStatParser parser( fname );
+  ProcStat::Contents contents = empty_stat();
+  parser.parse( contents );
+  if ( !same_contents( expected, contents ) ) {
+    std::cerr << "MISMATCH: " << fname << std::endl;
+    return false;
+  }
+
+  double start = now();
+  for ( size_t ii = 0; ii < iterations; ++ii ) {
+    ProcStat::Contents tmp = empty_stat();
+    legacy::parse_stat( fname, tmp );
+  }
+  report( fname.substr(fname.rfind('/')+1), "stream", iterations, now() - start );
+
+  start = now();
+  for ( size_t ii = 0; ii < iterations; ++ii ) {
+    parser.parse( contents );
+  }
+  report( fname.substr(fname.rfind('/')+1), "pread", iterations, now() - start );
+  return true;
+}
+
+static bool bench_meminfo( const std::string &fname, size_t iterations )
+{
+  ProcMeminfo::Contents expected;
+  legacy::parse_meminfo( fname, expected );
+
+  ProcMeminfoParser parser( fname );
+  ProcMeminfo::Contents contents;
+  parser.parse( contents );
+  if ( expected != contents ) {
+    std::cerr << "MISMATCH: " << fname << std::endl;
+    return false;
+  }
+
+  double start = now();
+  for ( size_t ii = 0; ii < iterations; ++ii ) {
+    ProcMeminfo::Contents tmp;
+    legacy::parse_meminfo( fname, tmp );
+  }
+  report( fname.substr(fname.rfind('/')+1), "stream", iterations, now() - start );
+
+  start = now();
+  for ( size_t ii = 0; ii < iterations; ++ii ) {
+    parser.parse( contents );
+  }
+  report( fname.substr(fname.rfind('/')+1), "pread", iterations, now() - start );
+  return true;
+}
+
+int main( int argc, char* argv[] )
+{
+  std::string fixtures = "benchmarks/fixtures";
+  size_t iterations = 1000;
+  if ( argc > 1 ) fixtures = argv[1];
+  if ( argc > 2 ) iterations = strtoul( argv[2], 0, 10 );
+
+  bool success = true;
+  success &= bench_stat( fixtures + "/proc_stat_8cpu", iterations );
+  success &= bench_stat( fixtures + "/proc_stat_64cpu", iterations );
+  success &= bench_stat( fixtures + "/proc_stat_256cpu", iterations );
+  success &= bench_meminfo( fixtures + "/proc_meminfo", iterations );
+  return success ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+
+#include "ProcFileReader.h"
+
+// Initial buffer size, large enough for /proc/stat on most hosts
+static const size_t INITIAL_BUFFER_SIZE = 16384;
+
+
+ProcFileReader::ProcFileReader( const std::string &fname ) :
+  fname(fname),
+  fd(-1),
+  buffer(INITIAL_BUFFER_SIZE)
+{
+  fd = ::open(fname.c_str(), O_RDONLY | O_CLOEXEC);
+  if ( fd < 0 ) throw std::ifstream::failure("unable to open " + fname );
+}
+
+
+ProcFileReader::~ProcFileReader()
+{
+  if ( fd >= 0 ) {
+    ::close(fd);
+  }
+}
+
+
+size_t ProcFileReader::read()
+{
+  size_t total = 0;
+  while ( true ) {
+    // Always leave room to detect end of file; procfs generates the whole
+    // file on each read, so a short read does not imply the end.
+    if ( total == buffer.size() ) {
+      buffer.resize(buffer.size() * 2);
+    }
+    ssize_t count = ::pread(fd, &buffer[total], buffer.size() - total, total);
+    if ( count < 0 ) {
+      if ( errno == EINTR ) continue;
+      throw std::ifstream::failure("unable to read " + fname + ": " + strerror(errno));
+    } else if ( count == 0 ) {
+      break;
+    }
+    total += count;
+  }
+  return total;
+}
+
+
+namespace procfs {
+
+  const char *line_end( const char *pos, const char *end )
+  {
+    const char *eol = static_cast<const char*>(memchr(pos, '\n', end - pos));
+    return eol ? eol : end;
+  }
+
+  bool next_token( const char *&pos, const char *end, const char *&token, size_t &length )
+  {
+    while ( pos < end && *pos == ' ' ) ++pos;
+    if ( pos == end ) return false;
+    token = pos;
+    while ( pos < end && *pos != ' ' ) ++pos;
+    length = pos - token;
+    return true;
+  }
+
+  bool to_counter( const char *token, size_t length, uint64_t &value )
+  {
+    if ( length == 0 ) return false;
+    uint64_t result = 0;
+    for ( size_t ii = 0; ii < length; ++ii ) {
+      const unsigned int digit = token[ii] - '0';
+      if ( digit > 9 ) return false;
+      result = (result * 10) + digit;
+    }
+    value = result;
+    return true;
+  }
+
+  bool starts_with( const char *token, size_t length, const char *prefix )
+  {
+    const size_t prefix_length = strlen(prefix);
+    return (length >= prefix_length) && (strncmp(token, prefix, prefix_length) == 0);
+  }
+
+};
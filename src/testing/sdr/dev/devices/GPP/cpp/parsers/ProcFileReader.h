@@ -0,0 +1,80 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef _PROCFILEREADER_H_
+#define _PROCFILEREADER_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+//
+// ProcFileReader
+//
+// Keeps a /proc file open and re-reads its full contents with pread into a
+// buffer that is reused between samples.  The buffer only grows when the
+// file outgrows it, so steady state sampling does not allocate.
+//
+class ProcFileReader {
+
+public:
+
+  ProcFileReader( const std::string &fname );
+
+  virtual ~ProcFileReader();
+
+  // read the current file contents, returns the number of bytes in data()
+  size_t read();
+
+  const char *data() const { return &buffer[0]; };
+
+  const std::string &filename() const { return fname; };
+
+private:
+
+  // Non-copyable
+  ProcFileReader( const ProcFileReader& );
+  ProcFileReader& operator=( const ProcFileReader& );
+
+  std::string        fname;
+  int                fd;
+  std::vector<char>  buffer;
+};
+
+
+//
+// Helpers for tokenizing a buffer in place, tokens are delimited by
+// spaces and lines by newlines.
+//
+namespace procfs {
+
+  // return the end of the line that starts at pos
+  const char *line_end( const char *pos, const char *end );
+
+  // return the next token in [pos, end), or false if there are no more
+  bool next_token( const char *&pos, const char *end, const char *&token, size_t &length );
+
+  // convert a token of decimal digits, returns false if any other character is present
+  bool to_counter( const char *token, size_t length, uint64_t &value );
+
+  bool starts_with( const char *token, size_t length, const char *prefix );
+
+};
+
+#endif
@@ -18,11 +18,9 @@
  * along with this program.  If not, see http://www.gnu.org/licenses/.
  */
 #include <iostream>
-#include <fstream>
-#include <sstream>
-#include <boost/lexical_cast.hpp>
-#include <boost/algorithm/string.hpp>
-#include <boost/format.hpp>
+#include <string>
+#include <cstring>
+#include <strings.h>
 
 #include "ProcMeminfoParser.h"
 #include "ParserExceptions.h"
@@ -35,19 +33,27 @@
 #endif
 
 
+static ProcMeminfo::Counter unit_multiplier( const char *units, size_t length )
+{
+  if ( length == 2 ) {
+    if ( strncasecmp( units, "KB", 2 ) == 0 ) return 1e3;
+    if ( strncasecmp( units, "MB", 2 ) == 0 ) return 1e6;
+    if ( strncasecmp( units, "GB", 2 ) == 0 ) return 1e9;
+    if ( strncasecmp( units, "TB", 2 ) == 0 ) return 1e12;
+  }
+  return 1;
+}
+
+
 ProcMeminfoParser::ProcMeminfoParser() :
-  fname("/proc/meminfo" )
+  reader("/proc/meminfo")
 {
-  std::ifstream input( fname.c_str() );
-  if ( !input.good()) throw std::ifstream::failure("unable to open " + fname );
 }
 
 
 ProcMeminfoParser::ProcMeminfoParser( const std::string &fname ) :
-  fname(fname)
+  reader(fname)
 {
-  std::ifstream input( fname.c_str() );
-  if ( !input.good()) throw std::ifstream::failure("unable to open " + fname );
 }
 
 
@@ -59,53 +65,61 @@ ProcMeminfoParser::~ProcMeminfoParser()
 
 void   ProcMeminfoParser::parse( ProcMeminfo::Contents & data )
 {
+  // read first, the buffer may be reallocated if the file has grown
+  const size_t length = reader.read();
+  const char *pos = reader.data();
+  const char *end = pos + length;
+
+  entries.clear();
+  while ( pos < end ) {
+    const char *line = pos;
+    const char *eol = procfs::line_end( pos, end );
+    pos = eol + 1;
+    if ( line == eol ) {
+      continue;
+    }
 
-  try {
-    std::ifstream procmeminfo_file( fname.c_str() );
-    if ( !procmeminfo_file.good()) throw std::ifstream::failure("unable to open " + fname );
-    DEBUG(std::cout << " opened up the file..."<< std::endl);
-
-    std::string line;
-    while (  std::getline( procmeminfo_file, line ) ) {
-      std::vector<std::string> values;
-      boost::split( values, line, boost::is_any_of(std::string(" ")), boost::algorithm::token_compress_on );
-      DEBUG(std::cout << " line(tokens) " << values.size() << ":" << line << std::endl);
-
-      // key:  value [unit]
-      std::string key;
-      ProcMeminfo::Counter     metric = 0;
-      key = values[0].substr(0, values[0].find(":"));
-        
-      if ( values.size() >= 2 ) {
-        try {
-          metric = boost::lexical_cast<ProcMeminfo::Counter>( values[1] );
-        }
-        catch( boost::bad_lexical_cast ){
-        }
-      }
+    // key:  value [unit]
+    const char *token;
+    size_t length;
+    const char *fields = line;
+    if ( !procfs::next_token( fields, eol, token, length ) ) {
+      continue;
+    }
+    const char *colon = static_cast<const char*>(memchr( token, ':', length ));
+    key.assign( token, colon ? (colon - token) : length );
 
+    ProcMeminfo::Counter metric = 0;
+    if ( procfs::next_token( fields, eol, token, length ) ) {
+      if ( !procfs::to_counter( token, length, metric ) ) {
+        metric = 0;
+      }
       // handle units
-      ProcMeminfo::Counter  unit_m=1;
-      if ( values.size() >= 3 ) {
-          std::string units(values[2]);
-          boost::to_upper(units);
-          if ( units == "KB" ) unit_m = 1e3;
-          if ( units == "MB" ) unit_m = 1e6;
-          if ( units == "GB" ) unit_m = 1e9;
-          if ( units == "TB" ) unit_m = 1e12;
+      if ( procfs::next_token( fields, eol, token, length ) ) {
+        metric = metric * unit_multiplier( token, length );
       }
-        
-      metric = metric * unit_m;
-        
-      data[key]=metric;
     }
-
+    DEBUG(std::cout << " key/metric " << key << "/" << metric << std::endl);
+
+    // Look up existing entries without building a new key string
+    ProcMeminfo::Contents::iterator entry = data.find( key );
+    if ( entry == data.end() ) {
+      entry = data.insert( std::make_pair( key, metric ) ).first;
+    } else {
+      entry->second = metric;
+    }
+    entries.push_back( entry );
   }
-  catch(...){
-    throw;
-  }  
-
 
+  // Drop entries that are no longer reported (or were never reported, if
+  // the caller passed in a populated map), so that the result matches a
+  // fresh parse
+  if ( data.size() != entries.size() ) {
+    ProcMeminfo::Contents current;
+    for ( EntryList::iterator ii = entries.begin(); ii != entries.end(); ++ii ) {
+      current[(*ii)->first] = (*ii)->second;
+    }
+    data.swap( current );
+  }
 }
 
-
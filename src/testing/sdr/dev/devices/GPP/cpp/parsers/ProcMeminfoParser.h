@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 #include "states/ProcMeminfo.h"
+#include "ProcFileReader.h"
 
 class ProcMeminfoParser {
 
@@ -41,7 +42,13 @@ public:
     
 private:
 
-  std::string  fname;
+  typedef std::vector< ProcMeminfo::Contents::iterator >  EntryList;
+
+  ProcFileReader  reader;
+
+  // scratch space reused between calls to parse
+  std::string     key;
+  EntryList       entries;
 };
 
 
@@ -0,0 +1,109 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#include <cstring>
+
+#include "ProcNetDevParser.h"
+
+// counter columns after "iface:", in /proc/net/dev order
+static ProcNetDev::Counter ProcNetDev::Counters::* const COLUMNS[] = {
+  &ProcNetDev::Counters::rx_bytes,
+  &ProcNetDev::Counters::rx_packets,
+  &ProcNetDev::Counters::rx_errors,
+  &ProcNetDev::Counters::rx_dropped,
+  &ProcNetDev::Counters::rx_fifo,
+  &ProcNetDev::Counters::rx_frame,
+  &ProcNetDev::Counters::rx_compressed,
+  &ProcNetDev::Counters::rx_multicast,
+  &ProcNetDev::Counters::tx_bytes,
+  &ProcNetDev::Counters::tx_packets,
+  &ProcNetDev::Counters::tx_errors,
+  &ProcNetDev::Counters::tx_dropped,
+  &ProcNetDev::Counters::tx_fifo,
+  &ProcNetDev::Counters::tx_collisions,
+  &ProcNetDev::Counters::tx_carrier,
+  &ProcNetDev::Counters::tx_compressed
+};
+
+static const size_t NUM_COLUMNS = sizeof(COLUMNS)/sizeof(COLUMNS[0]);
+
+
+ProcNetDevParser::ProcNetDevParser( const std::string &fname ) :
+  reader(fname)
+{
+}
+
+
+ProcNetDevParser::~ProcNetDevParser()
+{
+}
+
+
+void ProcNetDevParser::parse( ProcNetDev::Contents &data )
+{
+  // read first, the buffer may be reallocated if the file has grown
+  const size_t length = reader.read();
+  const char *pos = reader.data();
+  const char *end = pos + length;
+
+  entries.clear();
+  while ( pos < end ) {
+    const char *line = pos;
+    const char *eol = procfs::line_end( pos, end );
+    pos = eol + 1;
+
+    // the two header lines have no colon; counters may follow the colon
+    // without a space when the values are wide
+    const char *colon = static_cast<const char*>(memchr( line, ':', eol - line ));
+    if ( !colon ) {
+      continue;
+    }
+    const char *first = line;
+    while ( first < colon && *first == ' ' ) ++first;
+    name.assign( first, colon - first );
+
+    ProcNetDev::Contents::iterator entry = data.find( name );
+    if ( entry == data.end() ) {
+      entry = data.insert( std::make_pair( name, ProcNetDev::Counters() ) ).first;
+    }
+
+    const char *fields = colon + 1;
+    const char *token;
+    size_t toklen;
+    for ( size_t col=0; col < NUM_COLUMNS; ++col ) {
+      ProcNetDev::Counter value = 0;
+      if ( procfs::next_token( fields, eol, token, toklen ) ) {
+        if ( !procfs::to_counter( token, toklen, value ) ) {
+          value = 0;
+        }
+      }
+      entry->second.*COLUMNS[col] = value;
+    }
+    entries.push_back( entry );
+  }
+
+  // drop interfaces that have gone away
+  if ( data.size() != entries.size() ) {
+    ProcNetDev::Contents current;
+    for ( EntryList::iterator ii = entries.begin(); ii != entries.end(); ++ii ) {
+      current[(*ii)->first] = (*ii)->second;
+    }
+    data.swap( current );
+  }
+}
@@ -0,0 +1,49 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef _PROCNETDEVPARSER_H_
+#define _PROCNETDEVPARSER_H_
+
+#include <string>
+#include <vector>
+#include "states/ProcNetDev.h"
+#include "ProcFileReader.h"
+
+class ProcNetDevParser {
+
+public:
+
+  ProcNetDevParser( const std::string &fname="/proc/net/dev" );
+
+  virtual ~ProcNetDevParser();
+
+  void parse( ProcNetDev::Contents &data );
+
+private:
+
+  typedef std::vector< ProcNetDev::Contents::iterator >  EntryList;
+
+  ProcFileReader  reader;
+
+  // scratch space reused between calls to parse
+  std::string     name;
+  EntryList       entries;
+};
+
+#endif
@@ -0,0 +1,220 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <cstring>
+
+#include "ProcPidParser.h"
+#include "ProcFileReader.h"
+
+// Large enough for /proc/<pid>/status, the largest of the files read
+static const size_t BUFFER_SIZE = 8192;
+
+
+ProcPidParser::Contents::Contents() :
+  pid(0),
+  utime(0),
+  stime(0),
+  cutime(0),
+  cstime(0),
+  start_time(0),
+  num_threads(0),
+  rss(0),
+  voluntary_ctxt_switches(0),
+  nonvoluntary_ctxt_switches(0),
+  read_bytes(0),
+  write_bytes(0),
+  io_valid(false)
+{
+}
+
+
+ProcPidParser::ProcPidParser( const char *proc_root ) :
+  proc_root(proc_root),
+  buffer(BUFFER_SIZE)
+{
+}
+
+
+ProcPidParser::~ProcPidParser()
+{
+}
+
+
+bool ProcPidParser::parse( pid_t pid, Contents &data )
+{
+  data = Contents();
+  data.pid = pid;
+
+  ssize_t length = read_file( pid, "stat" );
+  if ( length < 0 || !parse_stat( length, data ) ) {
+    return false;
+  }
+
+  length = read_file( pid, "statm" );
+  if ( length < 0 || !parse_statm( length, data ) ) {
+    return false;
+  }
+
+  length = read_file( pid, "status" );
+  if ( length >= 0 ) {
+    parse_status( length, data );
+  }
+
+  // io requires ptrace access to the process, which may not be granted
+  length = read_file( pid, "io" );
+  data.io_valid = (length >= 0);
+  if ( data.io_valid ) {
+    parse_io( length, data );
+  }
+  return true;
+}
+
+
+ssize_t ProcPidParser::read_file( pid_t pid, const char *name )
+{
+  char path[64];
+  snprintf( path, sizeof(path), "%s/%d/%s", proc_root, pid, name );
+  int fd = ::open( path, O_RDONLY | O_CLOEXEC );
+  if ( fd < 0 ) {
+    return -1;
+  }
+
+  size_t total = 0;
+  while ( total < buffer.size() ) {
+    ssize_t count = ::read( fd, &buffer[total], buffer.size() - total );
+    if ( count < 0 ) {
+      if ( errno == EINTR ) continue;
+      ::close( fd );
+      return -1;
+    } else if ( count == 0 ) {
+      break;
+    }
+    total += count;
+  }
+  ::close( fd );
+  return total;
+}
+
+
+bool ProcPidParser::parse_stat( size_t length, Contents &data )
+{
+  // pid (comm) state ppid ... ; comm may contain spaces or parentheses, so
+  // the fixed fields start after the last closing parenthesis
+  const char *begin = &buffer[0];
+  const char *end = begin + length;
+  const char *pos = end;
+  while ( pos > begin && *(pos-1) != ')' ) --pos;
+  if ( pos == begin ) {
+    return false;
+  }
+
+  end = procfs::line_end( pos, end );
+  const char *token;
+  size_t token_length;
+  ProcPidParser::Counter value;
+  // field indices relative to state, see proc(5)
+  for ( int field = 0; procfs::next_token( pos, end, token, token_length ); ++field ) {
+    if ( field < 11 ) continue;
+    if ( !procfs::to_counter( token, token_length, value ) ) {
+      // negative values (priority, nice) are not used
+      value = 0;
+    }
+    switch ( field ) {
+    case 11: data.utime = value; break;
+    case 12: data.stime = value; break;
+    case 13: data.cutime = value; break;
+    case 14: data.cstime = value; break;
+    case 17: data.num_threads = value; break;
+    case 19: data.start_time = value; return true;
+    default: break;
+    }
+  }
+  return false;
+}
+
+
+bool ProcPidParser::parse_statm( size_t length, Contents &data )
+{
+  // size resident shared text lib data dt, in pages
+  const char *pos = &buffer[0];
+  const char *end = procfs::line_end( pos, pos + length );
+  const char *token;
+  size_t token_length;
+  if ( !procfs::next_token( pos, end, token, token_length ) ) {
+    return false;
+  }
+  if ( !procfs::next_token( pos, end, token, token_length ) ) {
+    return false;
+  }
+  return procfs::to_counter( token, token_length, data.rss );
+}
+
+
+static void parse_key_values( const char *pos, const char *end,
+                              const char *key1, ProcPidParser::Counter &value1,
+                              const char *key2, ProcPidParser::Counter &value2 )
+{
+  while ( pos < end ) {
+    const char *eol = procfs::line_end( pos, end );
+    const char *token;
+    size_t length;
+    const char *key = pos;
+    const char *colon = static_cast<const char*>(memchr( pos, ':', eol - pos ));
+    pos = eol + 1;
+    if ( !colon ) continue;
+
+    ProcPidParser::Counter *value = 0;
+    const size_t key_length = colon - key;
+    if ( key_length == strlen(key1) && strncmp( key, key1, key_length ) == 0 ) {
+      value = &value1;
+    } else if ( key_length == strlen(key2) && strncmp( key, key2, key_length ) == 0 ) {
+      value = &value2;
+    } else {
+      continue;
+    }
+
+    const char *fields = colon + 1;
+    while ( fields < eol && *fields == '\t' ) ++fields;
+    if ( procfs::next_token( fields, eol, token, length ) ) {
+      procfs::to_counter( token, length, *value );
+    }
+  }
+}
+
+
+void ProcPidParser::parse_status( size_t length, Contents &data )
+{
+  const char *begin = &buffer[0];
+  parse_key_values( begin, begin + length,
+                    "voluntary_ctxt_switches", data.voluntary_ctxt_switches,
+                    "nonvoluntary_ctxt_switches", data.nonvoluntary_ctxt_switches );
+}
+
+
+void ProcPidParser::parse_io( size_t length, Contents &data )
+{
+  const char *begin = &buffer[0];
+  parse_key_values( begin, begin + length,
+                    "read_bytes", data.read_bytes,
+                    "write_bytes", data.write_bytes );
+}
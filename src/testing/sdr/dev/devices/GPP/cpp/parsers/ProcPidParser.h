@@ -0,0 +1,79 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef _PROCPIDPARSER_H_
+#define _PROCPIDPARSER_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <vector>
+
+//
+// ProcPidParser
+//
+// Reads the per process accounting files, /proc/<pid>/stat, statm, status
+// and io, for a single process. CPU times and memory sizes include all of
+// the threads in the process's thread group.  A single read buffer is
+// reused for every file and process.
+//
+class ProcPidParser {
+
+public:
+  typedef uint64_t   Counter;
+
+  struct Contents {
+    pid_t      pid;
+    Counter    utime;                        // clock ticks
+    Counter    stime;                        // clock ticks
+    Counter    cutime;                       // clock ticks, waited-for children
+    Counter    cstime;                       // clock ticks, waited-for children
+    Counter    start_time;                   // clock ticks after boot
+    uint32_t   num_threads;
+    Counter    rss;                          // pages
+    Counter    voluntary_ctxt_switches;
+    Counter    nonvoluntary_ctxt_switches;
+    Counter    read_bytes;                   // storage I/O
+    Counter    write_bytes;                  // storage I/O
+    bool       io_valid;                     // false if /proc/<pid>/io is not readable
+
+    Contents();
+  };
+
+  ProcPidParser( const char *proc_root="/proc" );
+
+  virtual ~ProcPidParser();
+
+  // returns false if the process no longer exists
+  bool parse( pid_t pid, Contents &data );
+
+private:
+
+  // read a file into the buffer, returns -1 on failure
+  ssize_t read_file( pid_t pid, const char *name );
+
+  bool parse_stat( size_t length, Contents &data );
+  bool parse_statm( size_t length, Contents &data );
+  void parse_status( size_t length, Contents &data );
+  void parse_io( size_t length, Contents &data );
+
+  const char          *proc_root;
+  std::vector<char>    buffer;
+};
+
+#endif
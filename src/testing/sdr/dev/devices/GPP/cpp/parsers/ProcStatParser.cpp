@@ -18,11 +18,7 @@
  * along with this program.  If not, see http://www.gnu.org/licenses/.
  */
 #include <iostream>
-#include <fstream>
-#include <sstream>
-#include <boost/lexical_cast.hpp>
-#include <boost/algorithm/string.hpp>
-#include <boost/format.hpp>
+#include <string>
 
 #include "ProcStatParser.h"
 #include "ParserExceptions.h"
@@ -35,19 +31,41 @@
 #endif
 
 
+static void parse_counter_list( const char *pos, const char *end, ProcStat::CounterList &list )
+{
+  list.clear();
+  const char *token;
+  size_t length;
+  ProcStat::Counter value;
+  while ( procfs::next_token( pos, end, token, length ) ) {
+    if ( procfs::to_counter( token, length, value ) ) {
+      list.push_back( value );
+    }
+  }
+}
+
+
+static ProcStat::Counter parse_counter( const char *line, const char *pos, const char *end )
+{
+  const char *token;
+  size_t length;
+  ProcStat::Counter value;
+  if ( !procfs::next_token( pos, end, token, length ) || !procfs::to_counter( token, length, value ) ) {
+    throw ParserExceptions::ParseError( "Error parsing /proc/stat line (" + std::string( line, end ) + ")" );
+  }
+  return value;
+}
+
+
 ProcStatParser::ProcStatParser() :
-  fname("/proc/stat" )
+  reader("/proc/stat")
 {
-  std::ifstream input( fname.c_str() );
-  if ( !input.good()) throw std::ifstream::failure("unable to open " + fname );
 }
 
 
 ProcStatParser::ProcStatParser( const std::string &fname ) :
-  fname(fname)
+  reader(fname)
 {
-  std::ifstream input( fname.c_str() );
-  if ( !input.good()) throw std::ifstream::failure("unable to open " + fname );
 }
 
 
@@ -59,154 +77,103 @@ ProcStatParser::~ProcStatParser()
 
 void   ProcStatParser::parse( ProcStat::Contents & data )
 {
-
-  try {
-    std::ifstream procstat_file( fname.c_str() );
-    if ( !procstat_file.good()) throw std::ifstream::failure("unable to open " + fname );
-    DEBUG(std::cout << " opened up the file..."<< std::endl);
-
-    std::string line;
-    data.time_stamp = time(NULL);
-    while (  std::getline( procstat_file, line ) ) {
-      std::vector<std::string> values;
-      boost::split( values, line, boost::is_any_of(std::string(" ")), boost::algorithm::token_compress_on );
-      DEBUG(std::cout << " line: " << line << std::endl);
-
-      try {
-        
-        // handle different line types...
-        
-	if( boost::starts_with( values[0], "cpu" ) ) {
-            ProcStat::CpuStat cstat;
-            cstat.id = values[0];
-            cstat.idx = -1;   // default to all
-            try {
-              if ( values[0].size() > 3 ) {
-                std::string ids = values[0].substr(3);
-                cstat.idx= boost::lexical_cast<int>( ids );
-              }
-            }
-            catch( boost::bad_lexical_cast ){
-            }
-            // save off stat line for this cpu
-            cstat.jiffies.resize( values.size()-1 );
-            for( uint32_t i=1; i<values.size(); ++i )
-            {
-              try {
-                cstat.jiffies[i-1] = boost::lexical_cast<ProcStat::Counter>( values[i] );
-              }
-              catch( boost::bad_lexical_cast ){
-              }
-            }
-
-            std::stringstream ss;
-            ss << boost::format("%-5s:%-2d ") % cstat.id % cstat.idx;
-            for ( uint32_t j=0; j < cstat.jiffies.size(); j++ ) ss  << boost::format("%-7lld  ") % cstat.jiffies[j];
-            DEBUG(std::cout << ss.str() << std::endl);
-
-            if ( cstat.idx == -1 ) {
-              data.all = cstat;
-            }
-            else {
-              data.cpus.push_back(cstat);
-            }
-
-
-        
-        }
-
-	if( boost::starts_with( values[0], "intr" ) ) {
-            ProcStat::CounterList stat_list;
-            for( uint32_t i=1; i<values.size(); ++i )
-            {
-              try {
-                stat_list.push_back( boost::lexical_cast<ProcStat::Counter>( values[i] ) );
-              }
-              catch( boost::bad_lexical_cast ){
-              }
-            }
-            data.interrupts.swap( stat_list );
+  // read first, the buffer may be reallocated if the file has grown
+  const size_t length = reader.read();
+  const char *pos = reader.data();
+  const char *end = pos + length;
+
+  // Reuse the existing cpu entries so that their id strings and jiffie
+  // lists keep their storage from the previous sample
+  size_t ncpus = 0;
+  data.interrupts.clear();
+  data.soft_irqs.clear();
+  data.context_switches = 0;
+  data.boot_time = 0;
+  data.processes_started = 0;
+  data.processes_running = 0;
+  data.processes_blocked = 0;
+  data.time_stamp = time(NULL);
+
+  while ( pos < end ) {
+    const char *line = pos;
+    const char *eol = procfs::line_end( pos, end );
+    pos = eol + 1;
+
+    const char *key;
+    size_t key_length;
+    const char *fields = line;
+    if ( !procfs::next_token( fields, eol, key, key_length ) ) {
+      continue;
+    }
+    DEBUG(std::cout << " line: " << std::string( line, eol ) << std::endl);
+
+    // handle different line types...
+    if ( procfs::starts_with( key, key_length, "cpu" ) ) {
+      int idx = -1;   // default to all
+      ProcStat::Counter value;
+      if ( (key_length > 3) && procfs::to_counter( key+3, key_length-3, value ) ) {
+        idx = value;
+      }
+
+      ProcStat::CpuStat *cstat;
+      if ( idx == -1 ) {
+        cstat = &data.all;
+      } else {
+        if ( ncpus == data.cpus.size() ) {
+          data.cpus.push_back( ProcStat::CpuStat() );
         }
-
-	if( boost::starts_with( values[0], "softirq" ) ){
-            ProcStat::CounterList stat_list;
-            for( uint32_t i=1; i<values.size(); ++i )
-            {
-              try {
-                stat_list.push_back( boost::lexical_cast<ProcStat::Counter>( values[i] ) );
-              }
-              catch( boost::bad_lexical_cast ){
-              }
-            }
-            data.soft_irqs.swap( stat_list );
+        cstat = &data.cpus[ncpus++];
+      }
+      cstat->id.assign( key, key_length );
+      cstat->idx = idx;
+
+      // save off stat line for this cpu, unparseable fields are zero
+      size_t njiffies = 0;
+      const char *token;
+      size_t length;
+      while ( procfs::next_token( fields, eol, token, length ) ) {
+        if ( !procfs::to_counter( token, length, value ) ) {
+          value = 0;
         }
-          
-
-        if( boost::starts_with( values[0], "btime" ) ) {        
-          try {
-            data.boot_time = boost::lexical_cast<ProcStat::Counter>( values[1] );
-          }
-          catch( const boost::bad_lexical_cast& )
-            {
-              throw ParserExceptions::ParseError( "Error parsing /proc/stat line (" + line + ")" );
-            }
+        if ( njiffies < cstat->jiffies.size() ) {
+          cstat->jiffies[njiffies] = value;
+        } else {
+          cstat->jiffies.push_back( value );
         }
+        ++njiffies;
+      }
+      cstat->jiffies.resize( njiffies );
+    }
 
-	if( boost::starts_with( values[0], "ctxt" ) ) {        
-          try {
-            data.context_switches = boost::lexical_cast<ProcStat::Counter>( values[1] );
-          }
-          catch( const boost::bad_lexical_cast& )
-            {
-              throw ParserExceptions::ParseError( "Error parsing /proc/stat line (" + line + ")" );
-            }
-        }
+    if ( procfs::starts_with( key, key_length, "intr" ) ) {
+      parse_counter_list( fields, eol, data.interrupts );
+    }
 
-	if( boost::starts_with( values[0], "processes" ) ){        
-          try {
-            data.processes_started = boost::lexical_cast<ProcStat::Counter>( values[1] );
-          }
-          catch( const boost::bad_lexical_cast& )
-            {
-              throw ParserExceptions::ParseError( "Error parsing /proc/stat line (" + line + ")" );
-            }
-        }
+    if ( procfs::starts_with( key, key_length, "softirq" ) ) {
+      parse_counter_list( fields, eol, data.soft_irqs );
+    }
 
+    if ( procfs::starts_with( key, key_length, "btime" ) ) {
+      data.boot_time = parse_counter( line, fields, eol );
+    }
 
-	if( boost::starts_with( values[0], "processes_running" ) ) {        
-          try {
-            data.processes_running = boost::lexical_cast<ProcStat::Counter>( values[1] );
-          }
-          catch( const boost::bad_lexical_cast& )
-            {
-              throw ParserExceptions::ParseError( "Error parsing /proc/stat line (" + line + ")" );
-            }
-        }
+    if ( procfs::starts_with( key, key_length, "ctxt" ) ) {
+      data.context_switches = parse_counter( line, fields, eol );
+    }
 
-	if( boost::starts_with( values[0], "processes_blocked" ) ) {        
-          try {
-            data.processes_blocked = boost::lexical_cast<ProcStat::Counter>( values[1] );
-          }
-          catch( const boost::bad_lexical_cast& )
-            {
-              throw ParserExceptions::ParseError( "Error parsing /proc/stat line (" + line + ")" );
-            }
-        }
+    if ( procfs::starts_with( key, key_length, "processes" ) ) {
+      data.processes_started = parse_counter( line, fields, eol );
+    }
 
+    if ( procfs::starts_with( key, key_length, "processes_running" ) ) {
+      data.processes_running = parse_counter( line, fields, eol );
+    }
 
-        }
-      catch( const boost::bad_lexical_cast& )
-        {
-          throw ParserExceptions::ParseError( "Error parsing /proc/stat line (" + line + ")" );
-        }
+    if ( procfs::starts_with( key, key_length, "processes_blocked" ) ) {
+      data.processes_blocked = parse_counter( line, fields, eol );
     }
-    
   }
-  catch(...){
-    throw;
-  }  
-
 
+  data.cpus.resize( ncpus );
 }
 
-
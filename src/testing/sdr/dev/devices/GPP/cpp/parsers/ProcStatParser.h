@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 #include "states/ProcStat.h"
+#include "ProcFileReader.h"
 
 
 class ProcStatParser {
@@ -42,7 +43,7 @@ public:
     
 private:
 
-  std::string  fname;
+  ProcFileReader  reader;
 };
 
 
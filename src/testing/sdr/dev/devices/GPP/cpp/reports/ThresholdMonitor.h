@@ -22,11 +22,13 @@
 #include <string>
 #include <functional>
 #include <sstream>
+#include <cmath>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "utils/Updateable.h"
 #include "utils/EventDispatcher.h"
+#include "statistics/MetricWindow.h"
 #include "Reporting.h"
 #include "struct_props.h"
 
@@ -34,6 +36,22 @@
 class ThresholdMonitor :  public Updateable, public EventDispatcherMixin<threshold_event_struct>
 {
 public:
+    //
+    // How measurements are turned into threshold events. A transition is
+    // only reported once the new state has held for sustain consecutive
+    // samples, and an exceeded threshold only clears once the measurement
+    // is back past it by hysteresis percent of the threshold. The most
+    // recent window samples are kept for statistics. The defaults report
+    // every change, as single samples.
+    //
+    struct Policy {
+        size_t window;
+        size_t sustain;
+        double hysteresis;
+
+        Policy() : window(1), sustain(1), hysteresis(0.0) {}
+    };
+
  ThresholdMonitor( const std::string& message_class, const std::string& resource_id, const bool enableDispatch=true):
   _enable_dispatch( enableDispatch),
     resource_id_(resource_id),
@@ -53,6 +71,15 @@ public:
     virtual std::string get_threshold() const = 0;
     virtual std::string get_measured() const = 0;
     virtual bool is_threshold_exceeded() const = 0;
+    void    set_policy( const Policy &policy )
+    {
+        policy_ = policy;
+        if ( policy_.sustain < 1 ) policy_.sustain = 1;
+        if ( policy_.hysteresis < 0.0 ) policy_.hysteresis = 0.0;
+        window_.set_length( policy_.window );
+    }
+    const Policy &get_policy() const { return policy_; }
+    const MetricWindow &get_window() const { return window_; }
     void    enable_dispatch() { _enable_dispatch=true;}
     void    disable_dispatch() { _enable_dispatch=false;}
     std::string get_source_id() const{ return source_id_; }
@@ -94,6 +121,8 @@ protected:
     }
 
     bool  _enable_dispatch;
+    Policy policy_;
+    MetricWindow window_;
 
 private:
     const std::string source_id_;
@@ -116,7 +145,8 @@ ThresholdMonitor(message_class, resource_id, enableDispatch),
     measured_(measured),
     threshold_value_( threshold() ),
     measured_value_( measured() ),
-    prev_threshold_exceeded_(false)
+    exceeded_(false),
+    pending_(0)
     {
     }
 
@@ -126,7 +156,8 @@ ThresholdMonitor(source_id, resource_id, message_class, enableDispatch ),
     measured_(measured),
     threshold_value_( threshold() ),
     measured_value_( measured() ),
-    prev_threshold_exceeded_(false)
+    exceeded_(false),
+    pending_(0)
     {
     }
 
@@ -134,32 +165,51 @@ ThresholdMonitor(source_id, resource_id, message_class, enableDispatch ),
     {
         threshold_value_ = threshold_();
         measured_value_ = measured_();
-        if( prev_threshold_exceeded_ != is_threshold_exceeded() )
+        window_.add( measured_value_ );
+
+        bool exceeded = exceeded_ ? !is_cleared() : COMPARISON_FUNCTION()( measured_value_, threshold_value_ );
+        if( exceeded == exceeded_ )
         {
-            dispatch_message();
+            pending_ = 0;
+            return;
         }
+        if( ++pending_ < policy_.sustain )
+            return;
 
-        prev_threshold_exceeded_ = is_threshold_exceeded();
+        pending_ = 0;
+        exceeded_ = exceeded;
+        dispatch_message();
     }
 
     std::string get_threshold() const{ return boost::lexical_cast<std::string>(threshold_value_); }
     std::string get_measured() const{ return boost::lexical_cast<std::string>(measured_value_); }
 
+    // sustained state, see Policy
     bool is_threshold_exceeded() const
     {
-        return COMPARISON_FUNCTION()( get_measured_value(), get_threshold_value() );
+        return exceeded_;
     }
 
     DataType get_threshold_value() const { return threshold_value_; }
     DataType get_measured_value() const { return measured_value_; }
 
 private:
+    // true once the measurement is back past the threshold, moved away from
+    // the exceeded side by the hysteresis band
+    bool is_cleared() const
+    {
+        DataType band = static_cast<DataType>( std::fabs( (double)threshold_value_ ) * policy_.hysteresis / 100.0 );
+        DataType clear_at = COMPARISON_FUNCTION()( threshold_value_, threshold_value_ + band ) ? threshold_value_ + band : threshold_value_ - band;
+        return !COMPARISON_FUNCTION()( measured_value_, clear_at );
+    }
+
     QueryFunction threshold_;
     QueryFunction measured_;
 
     DataType threshold_value_;
     DataType measured_value_;
-    bool prev_threshold_exceeded_;
+    bool exceeded_;
+    size_t pending_;
 };
 
 
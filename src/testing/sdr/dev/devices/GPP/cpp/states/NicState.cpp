@@ -38,20 +38,33 @@
 NicState::NicState( const std::string& interface )
 {
     data_.interface = interface;
-    data_.device = interface;
+    initialize();
+}
+
+NicState::NicState( const std::string& interface, const ProcNetDevPtr& net_dev ):
+net_dev_(net_dev)
+{
+    data_.interface = interface;
+    initialize();
+}
+
+void
+NicState::initialize()
+{
+    data_.device = data_.interface;
     extract_device_and_vlan_from_interface();
     
-    bind_data_to_file( data_.rx_bytes, nic_file_path("/statistics/rx_bytes") );
-    bind_data_to_file( data_.rx_compressed, nic_file_path("/statistics/rx_compressed") );
+    bind_counter_to_file( data_.rx_bytes, nic_file_path("/statistics/rx_bytes") );
+    bind_counter_to_file( data_.rx_compressed, nic_file_path("/statistics/rx_compressed") );
     bind_data_to_file( data_.rx_crc_errors, nic_file_path("/statistics/rx_crc_errors") );
-    bind_data_to_file( data_.rx_dropped, nic_file_path("/statistics/rx_dropped") );
-    bind_data_to_file( data_.rx_errors, nic_file_path("/statistics/rx_errors") );
-    bind_data_to_file( data_.rx_packets, nic_file_path("/statistics/rx_packets") );
-    bind_data_to_file( data_.tx_bytes, nic_file_path("/statistics/tx_bytes") );
-    bind_data_to_file( data_.tx_compressed, nic_file_path("/statistics/tx_compressed") );
-    bind_data_to_file( data_.tx_dropped, nic_file_path("/statistics/tx_dropped") );
-    bind_data_to_file( data_.tx_errors, nic_file_path("/statistics/tx_errors") );
-    bind_data_to_file( data_.tx_packets, nic_file_path("/statistics/tx_packets") );
+    bind_counter_to_file( data_.rx_dropped, nic_file_path("/statistics/rx_dropped") );
+    bind_counter_to_file( data_.rx_errors, nic_file_path("/statistics/rx_errors") );
+    bind_counter_to_file( data_.rx_packets, nic_file_path("/statistics/rx_packets") );
+    bind_counter_to_file( data_.tx_bytes, nic_file_path("/statistics/tx_bytes") );
+    bind_counter_to_file( data_.tx_compressed, nic_file_path("/statistics/tx_compressed") );
+    bind_counter_to_file( data_.tx_dropped, nic_file_path("/statistics/tx_dropped") );
+    bind_counter_to_file( data_.tx_errors, nic_file_path("/statistics/tx_errors") );
+    bind_counter_to_file( data_.tx_packets, nic_file_path("/statistics/tx_packets") );
     bind_data_to_file( data_.tx_queue_len, nic_file_path("/tx_queue_len") );
     bind_data_to_file( data_.mac_address, nic_file_path("/address") );
     bind_data_to_file( data_.speed, nic_file_path("/speed") );
@@ -86,6 +99,16 @@ NicState::bind_data_to_file( T& data, const std::string& filename )
                                             filename ) );
 }
 
+template<typename T> 
+void 
+NicState::bind_counter_to_file( T& data, const std::string& filename )
+{
+    counter_update_functions.push_back( boost::bind(&NicState::extract_file_contents<T>, 
+                                                    this, 
+                                                    boost::ref(data),
+                                                    filename ) );
+}
+
 template<typename T>
 void NicState::extract_file_contents( T& data, const std::string& filename )
 {
@@ -103,6 +126,8 @@ void NicState::extract_file_contents( T& data, const std::string& filename )
 void
 NicState::update_state()
 {
+    update_counters();
+
     for( size_t i=0; i<update_functions.size(); ++i )
     {
         update_functions[i]();
@@ -114,6 +139,33 @@ NicState::update_state()
     }
 }
 
+void
+NicState::update_counters()
+{
+    const ProcNetDev::Counters *counters = net_dev_ ? net_dev_->find(data_.interface) : NULL;
+    if( counters )
+    {
+        data_.rx_bytes = counters->rx_bytes;
+        data_.rx_compressed = counters->rx_compressed;
+        data_.rx_dropped = counters->rx_dropped;
+        data_.rx_errors = counters->rx_errors;
+        data_.rx_packets = counters->rx_packets;
+        data_.tx_bytes = counters->tx_bytes;
+        data_.tx_compressed = counters->tx_compressed;
+        data_.tx_dropped = counters->tx_dropped;
+        data_.tx_errors = counters->tx_errors;
+        data_.tx_packets = counters->tx_packets;
+        data_.sample_time = net_dev_->get_sample_time();
+        return;
+    }
+
+    for( size_t i=0; i<counter_update_functions.size(); ++i )
+    {
+        counter_update_functions[i]();
+    }
+    data_.sample_time = ProcNetDev::MonotonicTime();
+}
+
 void
 NicState::update_addresses()
 {
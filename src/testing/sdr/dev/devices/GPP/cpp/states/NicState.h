@@ -26,6 +26,7 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/function.hpp>
 #include "State.h"
+#include "ProcNetDev.h"
 
 class NicState;
 
@@ -48,6 +49,7 @@ struct NicStateData
     tx_packets(0),
     tx_queue_len(0),
     speed(0),
+    sample_time(0),
     flags(0),
     v6_scope_id(0),
     mtu(0)
@@ -69,6 +71,7 @@ struct NicStateData
     uint64_t tx_packets;
     uint64_t tx_queue_len;
     uint64_t speed;
+    double sample_time;
     unsigned int flags;
     std::string mac_address;
     std::string v4_address;
@@ -86,6 +89,10 @@ class NicState : public State
 public:
     NicState( const std::string& interface );
 
+    // counters are taken from net_dev when it lists the interface, the
+    // caller is responsible for updating net_dev before this state
+    NicState( const std::string& interface, const ProcNetDevPtr& net_dev );
+
     void update_state();
 
     std::string get_interface() const { return data_.interface; }
@@ -115,10 +122,16 @@ public:
     unsigned int get_mtu() const { return data_.mtu; }
     std::string get_state() const { return data_.state; }
 
+    // CLOCK_MONOTONIC time the counters were read, in seconds
+    double get_sample_time() const { return data_.sample_time; }
+
 private:
+    void initialize();
+    void update_counters();
     void extract_device_and_vlan_from_interface();
     std::string nic_file_path( const std::string& suffix ) const;
     template<typename T> void bind_data_to_file( T& data, const std::string& filename );
+    template<typename T> void bind_counter_to_file( T& data, const std::string& filename );
     template<typename T> void extract_file_contents( T& data, const std::string& filename );
     void update_addresses();
 
@@ -128,6 +141,8 @@ protected:
 private:
     typedef boost::function< void() > StateVariableUpdateFunction;
     std::vector<StateVariableUpdateFunction> update_functions;
+    std::vector<StateVariableUpdateFunction> counter_update_functions;  // sysfs fallback for the net_dev counters
+    ProcNetDevPtr net_dev_;
 };
 
 
@@ -30,10 +30,10 @@ ProcMeminfo::~ProcMeminfo()
 
 void ProcMeminfo::update_state()
 {
-  ProcMeminfoParser parser;
-  Contents tmp;
-  parser.parse( tmp );
-  contents = tmp;
+  if ( !parser ) {
+    parser.reset( new ProcMeminfoParser() );
+  }
+  parser->parse( contents );
 }
 
 const ProcMeminfo::Counter ProcMeminfo::getMetric( const std::string &metric ) const {
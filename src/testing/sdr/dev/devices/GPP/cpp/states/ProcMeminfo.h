@@ -27,6 +27,7 @@
 #include "states/State.h"
 
 class ProcMeminfo;
+class ProcMeminfoParser;
 typedef  boost::shared_ptr< ProcMeminfo>  ProcMeminfoPtr;
 
 
@@ -53,6 +54,9 @@ class ProcMeminfo : public State
 
     Contents        contents;
 
+    // opened on first update, and kept open between updates
+    boost::shared_ptr< ProcMeminfoParser >  parser;
+
  private:
 
 };
@@ -0,0 +1,70 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#include <time.h>
+#include "ProcNetDev.h"
+#include "parsers/ProcNetDevParser.h"
+
+ProcNetDev::Counters::Counters() :
+  rx_bytes(0), rx_packets(0), rx_errors(0), rx_dropped(0),
+  rx_fifo(0), rx_frame(0), rx_compressed(0), rx_multicast(0),
+  tx_bytes(0), tx_packets(0), tx_errors(0), tx_dropped(0),
+  tx_fifo(0), tx_collisions(0), tx_carrier(0), tx_compressed(0)
+{
+}
+
+ProcNetDev::ProcNetDev( const std::string &fname ) :
+  fname(fname),
+  sample_time(0)
+{
+}
+
+ProcNetDev::~ProcNetDev()
+{
+}
+
+void ProcNetDev::update_state()
+{
+  if ( !parser ) {
+    parser.reset( new ProcNetDevParser( fname ) );
+  }
+  parser->parse( contents );
+  sample_time = MonotonicTime();
+}
+
+const ProcNetDev::Contents &
+ProcNetDev::get() const
+{
+  return contents;
+}
+
+const ProcNetDev::Counters *
+ProcNetDev::find( const std::string &iface ) const
+{
+  Contents::const_iterator it = contents.find( iface );
+  if ( it == contents.end() ) return NULL;
+  return &it->second;
+}
+
+double ProcNetDev::MonotonicTime()
+{
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
+}
@@ -0,0 +1,98 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef _PROCNETDEV_H_
+#define _PROCNETDEV_H_
+#include <stdint.h>
+#include <string>
+#include <map>
+#include <boost/shared_ptr.hpp>
+#include "states/State.h"
+
+class ProcNetDev;
+class ProcNetDevParser;
+typedef  boost::shared_ptr< ProcNetDev >  ProcNetDevPtr;
+
+//
+// ProcNetDev
+//
+// Interface counters for every network interface, read from /proc/net/dev
+// in a single pass.  The sample time is taken from CLOCK_MONOTONIC when the
+// file is read, so rates derived from consecutive samples are not affected
+// by changes to the wall clock.
+//
+class ProcNetDev : public State
+{
+
+ public:
+  typedef  uint64_t                           Counter;
+
+  struct Counters {
+    Counter  rx_bytes;
+    Counter  rx_packets;
+    Counter  rx_errors;
+    Counter  rx_dropped;
+    Counter  rx_fifo;
+    Counter  rx_frame;
+    Counter  rx_compressed;
+    Counter  rx_multicast;
+    Counter  tx_bytes;
+    Counter  tx_packets;
+    Counter  tx_errors;
+    Counter  tx_dropped;
+    Counter  tx_fifo;
+    Counter  tx_collisions;
+    Counter  tx_carrier;
+    Counter  tx_compressed;
+
+    Counters();
+  };
+
+  typedef std::map< std::string, Counters >   Contents;
+
+  ProcNetDev( const std::string &fname="/proc/net/dev" );
+
+  virtual ~ProcNetDev();
+
+  // update counters for all interfaces by processing /proc/net/dev
+  void              update_state();
+
+  const Contents   &get() const;
+
+  // counters for an interface, or NULL if the interface is not listed
+  const Counters   *find( const std::string &iface ) const;
+
+  // CLOCK_MONOTONIC time of the last update, in seconds
+  double            get_sample_time() const { return sample_time; }
+
+  static double     MonotonicTime();
+
+ protected:
+
+    std::string     fname;
+    Contents        contents;
+    double          sample_time;
+
+    // opened on first update, and kept open between updates
+    boost::shared_ptr< ProcNetDevParser >  parser;
+
+};
+
+
+#endif
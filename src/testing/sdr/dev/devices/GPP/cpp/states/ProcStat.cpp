@@ -30,10 +30,10 @@ ProcStat::~ProcStat()
 
 void ProcStat::update_state()
 {
-  ProcStatParser stat_parser;
-  Contents tmp;
-  stat_parser.parse( tmp );
-  contents = tmp;
+  if ( !parser ) {
+    parser.reset( new ProcStatParser() );
+  }
+  parser->parse( contents );
 }
 
 
@@ -27,6 +27,7 @@
 #include "states/State.h"
 
 class ProcStat;
+class ProcStatParser;
 typedef  boost::shared_ptr<ProcStat>  ProcStatPtr;
 
 
@@ -97,6 +98,9 @@ class ProcStat : public State
 
     Contents        contents;
 
+    // opened on first update, and kept open between updates
+    boost::shared_ptr< ProcStatParser >  parser;
+
  private:
 
 };
@@ -0,0 +1,110 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "MetricWindow.h"
+
+MetricWindow::MetricWindow( size_t length ) :
+    length_( std::max( length, (size_t)1 ) )
+{
+}
+
+void
+MetricWindow::set_length( size_t length )
+{
+    length_ = std::max( length, (size_t)1 );
+    while( samples_.size() > length_ )
+        samples_.pop_front();
+}
+
+size_t
+MetricWindow::get_length() const
+{
+    return length_;
+}
+
+void
+MetricWindow::add( double sample )
+{
+    samples_.push_back( sample );
+    if( samples_.size() > length_ )
+        samples_.pop_front();
+}
+
+void
+MetricWindow::clear()
+{
+    samples_.clear();
+}
+
+size_t
+MetricWindow::size() const
+{
+    return samples_.size();
+}
+
+bool
+MetricWindow::empty() const
+{
+    return samples_.empty();
+}
+
+double
+MetricWindow::last() const
+{
+    return samples_.empty() ? 0.0 : samples_.back();
+}
+
+double
+MetricWindow::min() const
+{
+    return samples_.empty() ? 0.0 : *std::min_element( samples_.begin(), samples_.end() );
+}
+
+double
+MetricWindow::max() const
+{
+    return samples_.empty() ? 0.0 : *std::max_element( samples_.begin(), samples_.end() );
+}
+
+double
+MetricWindow::mean() const
+{
+    return samples_.empty() ? 0.0 : std::accumulate( samples_.begin(), samples_.end(), 0.0 ) / samples_.size();
+}
+
+double
+MetricWindow::percentile( double percentile ) const
+{
+    if( samples_.empty() )
+        return 0.0;
+
+    // nearest rank
+    std::vector<double> sorted( samples_.begin(), samples_.end() );
+    std::sort( sorted.begin(), sorted.end() );
+    percentile = std::max( 0.0, std::min( 100.0, percentile ) );
+    size_t rank = (size_t)std::ceil( percentile / 100.0 * sorted.size() );
+    if( rank > 0 )
+        --rank;
+    return sorted[rank];
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef METRIC_WINDOW_H_
+#define METRIC_WINDOW_H_
+
+#include <deque>
+#include <cstddef>
+
+//
+// MetricWindow
+//
+// Rolling window over the most recent samples of a metric, with the
+// min/max/mean and nearest rank percentiles of the samples it holds.
+//
+class MetricWindow
+{
+public:
+    explicit MetricWindow( size_t length=1 );
+
+    // samples kept, at least one; shrinking drops the oldest samples
+    void set_length( size_t length );
+    size_t get_length() const;
+
+    void add( double sample );
+    void clear();
+
+    size_t size() const;
+    bool empty() const;
+
+    // statistics of the samples in the window, 0 when it is empty
+    double last() const;
+    double min() const;
+    double max() const;
+    double mean() const;
+    double percentile( double percentile ) const;
+
+private:
+    std::deque<double> samples_;
+    size_t length_;
+};
+
+#endif
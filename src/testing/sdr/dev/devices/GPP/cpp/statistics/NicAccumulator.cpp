@@ -21,29 +21,29 @@
 #include <sstream>
 #include <stdexcept>
 #include <numeric>
+#include <algorithm>
+#include <cmath>
 
-#include <sys/time.h>
+#include <time.h>
 #include "NicAccumulator.h"
 #include "../states/NicState.h"
 
 
 static const double BYTES_PER_MEGABYTE = 1024*1024;
 
+const size_t NicAccumulator::DEFAULT_HISTORY_LENGTH;
+
 NicAccumulator::NicAccumulator():
-prev_rx_bytes_(0),
-prev_tx_bytes_(0),
 prev_time_(std::numeric_limits<double>::max()),
 throughput_(0),
-current_time_(CurrentTime)
+history_length_(DEFAULT_HISTORY_LENGTH)
 {
 }
 
 NicAccumulator::NicAccumulator( const NicStatePtr &nicState):
-prev_rx_bytes_(0),
-prev_tx_bytes_(0),
 prev_time_(std::numeric_limits<double>::max()),
 throughput_(0),
-current_time_(CurrentTime)
+history_length_(DEFAULT_HISTORY_LENGTH)
 {
   add_nic(nicState);
 }
@@ -54,6 +54,8 @@ NicAccumulator::add_nic( const NicStatePtr & nic_state )
     validate_device( nic_state->get_device() );
     
     nic_states_.push_back( nic_state );
+    prev_samples_.push_back( Sample() );
+    prev_time_ = std::numeric_limits<double>::max();
     
     add_vlan( nic_state->get_vlan() );
 }
@@ -88,32 +90,89 @@ NicAccumulator::add_vlan( const std::string& vlan )
 
 void NicAccumulator::compute_statistics()
 {
-	double current_time = current_time_();
-	double delta_time = current_time - prev_time_;
+    double current_time = 0;
+    uint64_t delta_bytes = 0;
+    bool sampled = false;
 
-    double current_rx_bytes = 0;
-    double current_tx_bytes = 0;
-    
-    for( NicStates::const_iterator i=nic_states_.begin(); i!=nic_states_.end(); ++i )
+    for( size_t i=0; i<nic_states_.size(); ++i )
     {
+        const NicState& nic_state( *nic_states_[i] );
+
         // Ignore vlans when computing statistics
-        if( (*i)->get_vlan().empty() )
+        if( !nic_state.get_vlan().empty() )
+            continue;
+
+        Sample& prev( prev_samples_[i] );
+        delta_bytes += CounterDelta( prev.rx_bytes, nic_state.get_rx_bytes() );
+        delta_bytes += CounterDelta( prev.tx_bytes, nic_state.get_tx_bytes() );
+        prev.rx_bytes = nic_state.get_rx_bytes();
+        prev.tx_bytes = nic_state.get_tx_bytes();
+
+        // the counters are read together, so the first sample time stands for all
+        if( !sampled )
         {
-            current_rx_bytes += (*i)->get_rx_bytes();
-            current_tx_bytes += (*i)->get_tx_bytes();
+            current_time = nic_state.get_sample_time();
+            sampled = true;
         }
     }
-    
-	if( delta_time > 0 )
-	{
-        double delta_rx_bytes = current_rx_bytes - prev_rx_bytes_;
-        double delta_tx_bytes = current_tx_bytes - prev_tx_bytes_;
-		throughput_ = (delta_rx_bytes + delta_tx_bytes) / (delta_time * BYTES_PER_MEGABYTE);
-	}
-
-    prev_rx_bytes_ = current_rx_bytes;
-    prev_tx_bytes_ = current_tx_bytes;
-	prev_time_ = current_time;
+
+    if( current_time_ )
+        current_time = current_time_();
+
+    double delta_time = current_time - prev_time_;
+    if( delta_time > 0 )
+    {
+        throughput_ = delta_bytes / (delta_time * BYTES_PER_MEGABYTE);
+
+        history_.push_back( throughput_ );
+        while( history_.size() > history_length_ )
+            history_.pop_front();
+    }
+
+    prev_time_ = current_time;
+}
+
+uint64_t
+NicAccumulator::CounterDelta( uint64_t previous, uint64_t current )
+{
+    // Some drivers (and 32 bit kernels) keep 32 bit counters; if the
+    // previous value fit in 32 bits assume the counter wrapped there.
+    // Otherwise unsigned arithmetic gives the delta across a 64 bit wrap.
+    if( current < previous && previous <= 0xFFFFFFFFULL )
+        return (0x100000000ULL - previous) + current;
+    return current - previous;
+}
+
+double
+NicAccumulator::get_peak_throughput_MB_per_sec() const
+{
+    if( history_.empty() )
+        return throughput_;
+    return *std::max_element( history_.begin(), history_.end() );
+}
+
+double
+NicAccumulator::get_percentile_throughput_MB_per_sec( double percentile ) const
+{
+    if( history_.empty() )
+        return throughput_;
+
+    // nearest rank
+    std::vector<double> sorted( history_.begin(), history_.end() );
+    std::sort( sorted.begin(), sorted.end() );
+    percentile = std::max( 0.0, std::min( 100.0, percentile ) );
+    size_t rank = (size_t)std::ceil( percentile / 100.0 * sorted.size() );
+    if( rank > 0 )
+        --rank;
+    return sorted[rank];
+}
+
+void
+NicAccumulator::set_history_length( size_t length )
+{
+    history_length_ = std::max( length, (size_t)1 );
+    while( history_.size() > history_length_ )
+        history_.pop_front();
 }
 
 std::string
@@ -134,9 +193,7 @@ NicAccumulator::set_current_time_function( NicAccumulator::CurrentTimeFunction c
 double
 NicAccumulator::CurrentTime()
 {
-    struct timeval tmp_time;
-    struct timezone tmp_tz;
-    gettimeofday(&tmp_time, &tmp_tz);
-    return (double)tmp_time.tv_sec + (double)tmp_time.tv_usec*1e-6;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
 }
-
@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include <vector>
+#include <deque>
 #include <string>
 #include <boost/shared_ptr.hpp>
 #include <boost/function.hpp>
@@ -52,20 +53,43 @@ public:
     std::string get_vlans_string() const { return vlans_string_; }
     double get_throughput_MB_per_sec() const { return throughput_; }
 
+    // statistics over the last get_history_length() samples
+    double get_peak_throughput_MB_per_sec() const;
+    double get_percentile_throughput_MB_per_sec( double percentile ) const;
+    const std::deque<double>& get_throughput_history() const { return history_; }
+
+    void set_history_length( size_t length );
+    size_t get_history_length() const { return history_length_; }
+
+    // overrides the sample times reported by the nic states
     void set_current_time_function( CurrentTimeFunction current_time );
     static double CurrentTime();
 
+    // change in a counter between samples, allowing for 32 and 64 bit wrap
+    static uint64_t CounterDelta( uint64_t previous, uint64_t current );
+
+    static const size_t DEFAULT_HISTORY_LENGTH = 60;
+
 private:
     void validate_device( const std::string& device ) const;
     void add_vlan( const std::string& vlan );
 
 private:
     typedef std::vector<boost::shared_ptr<const NicState> > NicStates;
-    
-    uint64_t prev_rx_bytes_;
-    uint64_t prev_tx_bytes_;
+
+    struct Sample
+    {
+        Sample(): rx_bytes(0), tx_bytes(0) {}
+        uint64_t rx_bytes;
+        uint64_t tx_bytes;
+    };
+    typedef std::vector<Sample> Samples;
+
+    Samples prev_samples_;  // parallel to nic_states_
     double prev_time_;
     double throughput_;
+    std::deque<double> history_;
+    size_t history_length_;
 
     NicStates nic_states_;
     Vlans vlans_;
@@ -0,0 +1,148 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#include <time.h>
+#include <unistd.h>
+
+#include "ProcessUsageStats.h"
+
+static double monotonic_time()
+{
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+
+ProcessUsageStats::Usage::Usage() :
+  pid(0),
+  valid(false),
+  cores(0.0),
+  cpu_time(0.0),
+  rss(0),
+  num_threads(0),
+  voluntary_ctxt_switches(0),
+  nonvoluntary_ctxt_switches(0),
+  read_bytes(0),
+  write_bytes(0)
+{
+}
+
+
+ProcessUsageStats::ProcessUsageStats( const char *proc_root ) :
+  parser_(proc_root),
+  ticks_per_sec_(sysconf(_SC_CLK_TCK)),
+  page_size_(sysconf(_SC_PAGESIZE))
+{
+}
+
+
+void ProcessUsageStats::add_pid( pid_t pid )
+{
+  boost::mutex::scoped_lock lock(lock_);
+  Sample &sample = samples_[pid];
+  sample.usage.pid = pid;
+}
+
+
+void ProcessUsageStats::remove_pid( pid_t pid )
+{
+  boost::mutex::scoped_lock lock(lock_);
+  samples_.erase(pid);
+}
+
+
+void ProcessUsageStats::compute_statistics()
+{
+  // Sample outside of the lock so that launching or terminating a process
+  // is not held up by a sampling pass over many processes
+  pids_.clear();
+  {
+    boost::mutex::scoped_lock lock(lock_);
+    for ( SampleMap::const_iterator iter = samples_.begin(); iter != samples_.end(); ++iter ) {
+      pids_.push_back( iter->first );
+    }
+  }
+
+  for ( PidList::const_iterator pid = pids_.begin(); pid != pids_.end(); ++pid ) {
+    if ( !parser_.parse( *pid, contents_ ) ) {
+      // process has exited but has not yet been removed
+      continue;
+    }
+    const double now = monotonic_time();
+
+    boost::mutex::scoped_lock lock(lock_);
+    SampleMap::iterator sample = samples_.find( *pid );
+    if ( sample != samples_.end() ) {
+      _update( sample->second, contents_, now );
+    }
+  }
+}
+
+
+void ProcessUsageStats::_update( Sample &sample, const ProcPidParser::Contents &contents, double now )
+{
+  Usage &usage = sample.usage;
+  const ProcPidParser::Counter ticks = contents.utime + contents.stime;
+
+  // the cpu load needs two samples from the same process; a different start
+  // time means the pid was reused
+  if ( usage.valid && (sample.contents.start_time == contents.start_time) && (now > sample.time) ) {
+    const ProcPidParser::Counter last_ticks = sample.contents.utime + sample.contents.stime;
+    const double elapsed = now - sample.time;
+    usage.cores = (ticks >= last_ticks) ? ((ticks - last_ticks) / ticks_per_sec_) / elapsed : 0.0;
+  } else {
+    usage.cores = 0.0;
+  }
+
+  usage.valid = true;
+  usage.cpu_time = ticks / ticks_per_sec_;
+  usage.rss = contents.rss * page_size_;
+  usage.num_threads = contents.num_threads;
+  usage.voluntary_ctxt_switches = contents.voluntary_ctxt_switches;
+  usage.nonvoluntary_ctxt_switches = contents.nonvoluntary_ctxt_switches;
+  usage.read_bytes = contents.read_bytes;
+  usage.write_bytes = contents.write_bytes;
+
+  sample.contents = contents;
+  sample.time = now;
+}
+
+
+bool ProcessUsageStats::get_usage( pid_t pid, Usage &usage ) const
+{
+  boost::mutex::scoped_lock lock(lock_);
+  SampleMap::const_iterator sample = samples_.find( pid );
+  if ( sample == samples_.end() ) {
+    return false;
+  }
+  usage = sample->second.usage;
+  return true;
+}
+
+
+void ProcessUsageStats::get_usage( UsageList &usage ) const
+{
+  boost::mutex::scoped_lock lock(lock_);
+  usage.resize( samples_.size() );
+  UsageList::iterator out = usage.begin();
+  for ( SampleMap::const_iterator sample = samples_.begin(); sample != samples_.end(); ++sample, ++out ) {
+    *out = sample->second.usage;
+  }
+}
@@ -0,0 +1,103 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef _PROCESS_USAGE_STATS_H_
+#define _PROCESS_USAGE_STATS_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <map>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "Statistics.h"
+#include "parsers/ProcPidParser.h"
+
+class ProcessUsageStats;
+typedef boost::shared_ptr< ProcessUsageStats > ProcessUsageStatsPtr;
+
+//
+// ProcessUsageStats
+//
+// Samples resource usage for a set of tracked processes (e.g. components
+// launched by the GPP) on each update, and derives the CPU load of each
+// process over the last sample interval.
+//
+class ProcessUsageStats : public Statistics
+{
+ public:
+
+  struct Usage {
+    pid_t       pid;
+    bool        valid;                  // false until the process has been sampled
+    double      cores;                  // CPU load over the last interval, in cores
+    double      cpu_time;               // total user + system time, in seconds
+    uint64_t    rss;                    // resident memory, in bytes
+    uint32_t    num_threads;
+    uint64_t    voluntary_ctxt_switches;
+    uint64_t    nonvoluntary_ctxt_switches;
+    uint64_t    read_bytes;
+    uint64_t    write_bytes;
+
+    Usage();
+  };
+
+  typedef std::vector< Usage >   UsageList;
+
+  ProcessUsageStats( const char *proc_root="/proc" );
+
+  virtual ~ProcessUsageStats() {}
+
+  void add_pid( pid_t pid );
+  void remove_pid( pid_t pid );
+
+  virtual void compute_statistics();
+
+  // returns false if the pid is not tracked
+  bool get_usage( pid_t pid, Usage &usage ) const;
+
+  // fill usage with the current values for every tracked pid
+  void get_usage( UsageList &usage ) const;
+
+ private:
+
+  struct Sample {
+    ProcPidParser::Contents  contents;
+    double                   time;
+    Usage                    usage;
+  };
+
+  typedef std::map< pid_t, Sample >   SampleMap;
+  typedef std::vector< pid_t >        PidList;
+
+  void _update( Sample &sample, const ProcPidParser::Contents &contents, double now );
+
+  mutable boost::mutex     lock_;
+  SampleMap                samples_;
+
+  // owned by the sampling thread
+  ProcPidParser            parser_;
+  PidList                  pids_;
+  ProcPidParser::Contents  contents_;
+  double                   ticks_per_sec_;
+  uint64_t                 page_size_;
+};
+
+#endif
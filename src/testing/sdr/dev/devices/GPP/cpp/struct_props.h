@@ -193,6 +193,235 @@ inline bool operator!= (const advanced_struct& s1, const advanced_struct& s2) {
     return !(s1==s2);
 };
 
+struct cgroup_struct {
+    cgroup_struct ()
+    {
+        enabled = false;
+        root = "/sys/fs/cgroup/redhawk";
+        cpu_limit = 0.0;
+        memory_limit = 0;
+        pids_limit = 0;
+    };
+
+    static std::string getId() {
+        return std::string("cgroup");
+    };
+
+    bool enabled;
+    std::string root;
+    double cpu_limit;
+    CORBA::LongLong memory_limit;
+    CORBA::Long pids_limit;
+};
+
+inline bool operator>>= (const CORBA::Any& a, cgroup_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("cgroup::enabled")) {
+        if (!(props["cgroup::enabled"] >>= s.enabled)) return false;
+    }
+    if (props.contains("cgroup::root")) {
+        if (!(props["cgroup::root"] >>= s.root)) return false;
+    }
+    if (props.contains("cgroup::cpu_limit")) {
+        if (!(props["cgroup::cpu_limit"] >>= s.cpu_limit)) return false;
+    }
+    if (props.contains("cgroup::memory_limit")) {
+        if (!(props["cgroup::memory_limit"] >>= s.memory_limit)) return false;
+    }
+    if (props.contains("cgroup::pids_limit")) {
+        if (!(props["cgroup::pids_limit"] >>= s.pids_limit)) return false;
+    }
+    return true;
+};
+
+inline void operator<<= (CORBA::Any& a, const cgroup_struct& s) {
+    redhawk::PropertyMap props;
+    props["cgroup::enabled"] = s.enabled;
+    props["cgroup::root"] = s.root;
+    props["cgroup::cpu_limit"] = s.cpu_limit;
+    props["cgroup::memory_limit"] = s.memory_limit;
+    props["cgroup::pids_limit"] = s.pids_limit;
+    a <<= props;
+};
+
+inline bool operator== (const cgroup_struct& s1, const cgroup_struct& s2) {
+    if (s1.enabled!=s2.enabled)
+        return false;
+    if (s1.root!=s2.root)
+        return false;
+    if (s1.cpu_limit!=s2.cpu_limit)
+        return false;
+    if (s1.memory_limit!=s2.memory_limit)
+        return false;
+    if (s1.pids_limit!=s2.pids_limit)
+        return false;
+    return true;
+};
+
+inline bool operator!= (const cgroup_struct& s1, const cgroup_struct& s2) {
+    return !(s1==s2);
+};
+
+struct service_statistics_struct {
+    service_statistics_struct ()
+    {
+        wakeups = 0;
+        child_exit_wakeups = 0;
+        cycle_wakeups = 0;
+        property_wakeups = 0;
+        missed_cycles = 0;
+        cycle_lateness = 0.0;
+        max_cycle_lateness = 0.0;
+        child_exit_latency = 0.0;
+        max_child_exit_latency = 0.0;
+    };
+
+    static std::string getId() {
+        return std::string("service_statistics");
+    };
+
+    CORBA::ULongLong wakeups;
+    CORBA::ULongLong child_exit_wakeups;
+    CORBA::ULongLong cycle_wakeups;
+    CORBA::ULongLong property_wakeups;
+    CORBA::ULongLong missed_cycles;
+    double cycle_lateness;
+    double max_cycle_lateness;
+    double child_exit_latency;
+    double max_child_exit_latency;
+};
+
+inline bool operator>>= (const CORBA::Any& a, service_statistics_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("service_statistics::wakeups")) {
+        if (!(props["service_statistics::wakeups"] >>= s.wakeups)) return false;
+    }
+    if (props.contains("service_statistics::child_exit_wakeups")) {
+        if (!(props["service_statistics::child_exit_wakeups"] >>= s.child_exit_wakeups)) return false;
+    }
+    if (props.contains("service_statistics::cycle_wakeups")) {
+        if (!(props["service_statistics::cycle_wakeups"] >>= s.cycle_wakeups)) return false;
+    }
+    if (props.contains("service_statistics::property_wakeups")) {
+        if (!(props["service_statistics::property_wakeups"] >>= s.property_wakeups)) return false;
+    }
+    if (props.contains("service_statistics::missed_cycles")) {
+        if (!(props["service_statistics::missed_cycles"] >>= s.missed_cycles)) return false;
+    }
+    if (props.contains("service_statistics::cycle_lateness")) {
+        if (!(props["service_statistics::cycle_lateness"] >>= s.cycle_lateness)) return false;
+    }
+    if (props.contains("service_statistics::max_cycle_lateness")) {
+        if (!(props["service_statistics::max_cycle_lateness"] >>= s.max_cycle_lateness)) return false;
+    }
+    if (props.contains("service_statistics::child_exit_latency")) {
+        if (!(props["service_statistics::child_exit_latency"] >>= s.child_exit_latency)) return false;
+    }
+    if (props.contains("service_statistics::max_child_exit_latency")) {
+        if (!(props["service_statistics::max_child_exit_latency"] >>= s.max_child_exit_latency)) return false;
+    }
+    return true;
+};
+
+inline void operator<<= (CORBA::Any& a, const service_statistics_struct& s) {
+    redhawk::PropertyMap props;
+    props["service_statistics::wakeups"] = s.wakeups;
+    props["service_statistics::child_exit_wakeups"] = s.child_exit_wakeups;
+    props["service_statistics::cycle_wakeups"] = s.cycle_wakeups;
+    props["service_statistics::property_wakeups"] = s.property_wakeups;
+    props["service_statistics::missed_cycles"] = s.missed_cycles;
+    props["service_statistics::cycle_lateness"] = s.cycle_lateness;
+    props["service_statistics::max_cycle_lateness"] = s.max_cycle_lateness;
+    props["service_statistics::child_exit_latency"] = s.child_exit_latency;
+    props["service_statistics::max_child_exit_latency"] = s.max_child_exit_latency;
+    a <<= props;
+};
+
+inline bool operator== (const service_statistics_struct& s1, const service_statistics_struct& s2) {
+    if (s1.wakeups!=s2.wakeups)
+        return false;
+    if (s1.child_exit_wakeups!=s2.child_exit_wakeups)
+        return false;
+    if (s1.cycle_wakeups!=s2.cycle_wakeups)
+        return false;
+    if (s1.property_wakeups!=s2.property_wakeups)
+        return false;
+    if (s1.missed_cycles!=s2.missed_cycles)
+        return false;
+    if (s1.cycle_lateness!=s2.cycle_lateness)
+        return false;
+    if (s1.max_cycle_lateness!=s2.max_cycle_lateness)
+        return false;
+    if (s1.child_exit_latency!=s2.child_exit_latency)
+        return false;
+    if (s1.max_child_exit_latency!=s2.max_child_exit_latency)
+        return false;
+    return true;
+};
+
+inline bool operator!= (const service_statistics_struct& s1, const service_statistics_struct& s2) {
+    return !(s1==s2);
+};
+
+struct threshold_policy_struct {
+    threshold_policy_struct ()
+    {
+        window = 120;
+        sustain = 3;
+        hysteresis = 5.0;
+    };
+
+    static std::string getId() {
+        return std::string("threshold_policy");
+    };
+
+    CORBA::ULong window;
+    CORBA::ULong sustain;
+    double hysteresis;
+};
+
+inline bool operator>>= (const CORBA::Any& a, threshold_policy_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("threshold_policy::window")) {
+        if (!(props["threshold_policy::window"] >>= s.window)) return false;
+    }
+    if (props.contains("threshold_policy::sustain")) {
+        if (!(props["threshold_policy::sustain"] >>= s.sustain)) return false;
+    }
+    if (props.contains("threshold_policy::hysteresis")) {
+        if (!(props["threshold_policy::hysteresis"] >>= s.hysteresis)) return false;
+    }
+    return true;
+};
+
+inline void operator<<= (CORBA::Any& a, const threshold_policy_struct& s) {
+    redhawk::PropertyMap props;
+    props["threshold_policy::window"] = s.window;
+    props["threshold_policy::sustain"] = s.sustain;
+    props["threshold_policy::hysteresis"] = s.hysteresis;
+    a <<= props;
+};
+
+inline bool operator== (const threshold_policy_struct& s1, const threshold_policy_struct& s2) {
+    if (s1.window!=s2.window)
+        return false;
+    if (s1.sustain!=s2.sustain)
+        return false;
+    if (s1.hysteresis!=s2.hysteresis)
+        return false;
+    return true;
+};
+
+inline bool operator!= (const threshold_policy_struct& s1, const threshold_policy_struct& s2) {
+    return !(s1==s2);
+};
+
 struct threshold_event_struct {
     threshold_event_struct ()
     {
@@ -1034,4 +1263,321 @@ inline bool operator!= (const interfaces_struct& s1, const interfaces_struct& s2
     return !(s1==s2);
 };
 
+struct component_monitor_struct_struct {
+    component_monitor_struct_struct ()
+    {
+        pid = 0;
+        cores = 0.0;
+        cpu_time = 0.0;
+        mem_rss = 0.0;
+        num_threads = 0;
+        voluntary_context_switches = 0;
+        nonvoluntary_context_switches = 0;
+        read_bytes = 0;
+        write_bytes = 0;
+        reserved = 0.0;
+    };
+
+    static std::string getId() {
+        return std::string("component_monitor_struct");
+    };
+
+    std::string component_id;
+    std::string waveform_id;
+    CORBA::ULong pid;
+    float cores;
+    double cpu_time;
+    double mem_rss;
+    CORBA::ULong num_threads;
+    CORBA::ULongLong voluntary_context_switches;
+    CORBA::ULongLong nonvoluntary_context_switches;
+    CORBA::ULongLong read_bytes;
+    CORBA::ULongLong write_bytes;
+    float reserved;
+};
+
+inline bool operator>>= (const CORBA::Any& a, component_monitor_struct_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    CF::Properties& props = *temp;
+    for (unsigned int idx = 0; idx < props.length(); idx++) {
+        if (!strcmp("component_monitor::component_id", props[idx].id)) {
+            if (!(props[idx].value >>= s.component_id)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::waveform_id", props[idx].id)) {
+            if (!(props[idx].value >>= s.waveform_id)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::pid", props[idx].id)) {
+            if (!(props[idx].value >>= s.pid)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::cores", props[idx].id)) {
+            if (!(props[idx].value >>= s.cores)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::cpu_time", props[idx].id)) {
+            if (!(props[idx].value >>= s.cpu_time)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::mem_rss", props[idx].id)) {
+            if (!(props[idx].value >>= s.mem_rss)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::num_threads", props[idx].id)) {
+            if (!(props[idx].value >>= s.num_threads)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::voluntary_context_switches", props[idx].id)) {
+            if (!(props[idx].value >>= s.voluntary_context_switches)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::nonvoluntary_context_switches", props[idx].id)) {
+            if (!(props[idx].value >>= s.nonvoluntary_context_switches)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::read_bytes", props[idx].id)) {
+            if (!(props[idx].value >>= s.read_bytes)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::write_bytes", props[idx].id)) {
+            if (!(props[idx].value >>= s.write_bytes)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+        else if (!strcmp("component_monitor::reserved", props[idx].id)) {
+            if (!(props[idx].value >>= s.reserved)) {
+                CORBA::TypeCode_var typecode = props[idx].value.type();
+                if (typecode->kind() != CORBA::tk_null) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+};
+
+inline void operator<<= (CORBA::Any& a, const component_monitor_struct_struct& s) {
+    CF::Properties props;
+    props.length(12);
+    props[0].id = CORBA::string_dup("component_monitor::component_id");
+    props[0].value <<= s.component_id;
+    props[1].id = CORBA::string_dup("component_monitor::waveform_id");
+    props[1].value <<= s.waveform_id;
+    props[2].id = CORBA::string_dup("component_monitor::pid");
+    props[2].value <<= s.pid;
+    props[3].id = CORBA::string_dup("component_monitor::cores");
+    props[3].value <<= s.cores;
+    props[4].id = CORBA::string_dup("component_monitor::cpu_time");
+    props[4].value <<= s.cpu_time;
+    props[5].id = CORBA::string_dup("component_monitor::mem_rss");
+    props[5].value <<= s.mem_rss;
+    props[6].id = CORBA::string_dup("component_monitor::num_threads");
+    props[6].value <<= s.num_threads;
+    props[7].id = CORBA::string_dup("component_monitor::voluntary_context_switches");
+    props[7].value <<= s.voluntary_context_switches;
+    props[8].id = CORBA::string_dup("component_monitor::nonvoluntary_context_switches");
+    props[8].value <<= s.nonvoluntary_context_switches;
+    props[9].id = CORBA::string_dup("component_monitor::read_bytes");
+    props[9].value <<= s.read_bytes;
+    props[10].id = CORBA::string_dup("component_monitor::write_bytes");
+    props[10].value <<= s.write_bytes;
+    props[11].id = CORBA::string_dup("component_monitor::reserved");
+    props[11].value <<= s.reserved;
+    a <<= props;
+};
+
+inline bool operator== (const component_monitor_struct_struct& s1, const component_monitor_struct_struct& s2) {
+    if (s1.component_id!=s2.component_id)
+        return false;
+    if (s1.waveform_id!=s2.waveform_id)
+        return false;
+    if (s1.pid!=s2.pid)
+        return false;
+    if (s1.cores!=s2.cores)
+        return false;
+    if (s1.cpu_time!=s2.cpu_time)
+        return false;
+    if (s1.mem_rss!=s2.mem_rss)
+        return false;
+    if (s1.num_threads!=s2.num_threads)
+        return false;
+    if (s1.voluntary_context_switches!=s2.voluntary_context_switches)
+        return false;
+    if (s1.nonvoluntary_context_switches!=s2.nonvoluntary_context_switches)
+        return false;
+    if (s1.read_bytes!=s2.read_bytes)
+        return false;
+    if (s1.write_bytes!=s2.write_bytes)
+        return false;
+    if (s1.reserved!=s2.reserved)
+        return false;
+    return true;
+};
+
+inline bool operator!= (const component_monitor_struct_struct& s1, const component_monitor_struct_struct& s2) {
+    return !(s1==s2);
+};
+
+struct threshold_statistics_struct_struct {
+    threshold_statistics_struct_struct ()
+    {
+        exceeded = false;
+        threshold = 0.0;
+        current = 0.0;
+        min = 0.0;
+        max = 0.0;
+        mean = 0.0;
+        p50 = 0.0;
+        p95 = 0.0;
+        samples = 0;
+    };
+
+    static std::string getId() {
+        return std::string("threshold_statistics_struct");
+    };
+
+    std::string resource_id;
+    std::string threshold_class;
+    bool exceeded;
+    double threshold;
+    double current;
+    double min;
+    double max;
+    double mean;
+    double p50;
+    double p95;
+    CORBA::ULong samples;
+};
+
+inline bool operator>>= (const CORBA::Any& a, threshold_statistics_struct_struct& s) {
+    CF::Properties* temp;
+    if (!(a >>= temp)) return false;
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(*temp);
+    if (props.contains("threshold_statistics::resource_id")) {
+        if (!(props["threshold_statistics::resource_id"] >>= s.resource_id)) return false;
+    }
+    if (props.contains("threshold_statistics::threshold_class")) {
+        if (!(props["threshold_statistics::threshold_class"] >>= s.threshold_class)) return false;
+    }
+    if (props.contains("threshold_statistics::exceeded")) {
+        if (!(props["threshold_statistics::exceeded"] >>= s.exceeded)) return false;
+    }
+    if (props.contains("threshold_statistics::threshold")) {
+        if (!(props["threshold_statistics::threshold"] >>= s.threshold)) return false;
+    }
+    if (props.contains("threshold_statistics::current")) {
+        if (!(props["threshold_statistics::current"] >>= s.current)) return false;
+    }
+    if (props.contains("threshold_statistics::min")) {
+        if (!(props["threshold_statistics::min"] >>= s.min)) return false;
+    }
+    if (props.contains("threshold_statistics::max")) {
+        if (!(props["threshold_statistics::max"] >>= s.max)) return false;
+    }
+    if (props.contains("threshold_statistics::mean")) {
+        if (!(props["threshold_statistics::mean"] >>= s.mean)) return false;
+    }
+    if (props.contains("threshold_statistics::p50")) {
+        if (!(props["threshold_statistics::p50"] >>= s.p50)) return false;
+    }
+    if (props.contains("threshold_statistics::p95")) {
+        if (!(props["threshold_statistics::p95"] >>= s.p95)) return false;
+    }
+    if (props.contains("threshold_statistics::samples")) {
+        if (!(props["threshold_statistics::samples"] >>= s.samples)) return false;
+    }
+    return true;
+};
+
+inline void operator<<= (CORBA::Any& a, const threshold_statistics_struct_struct& s) {
+    redhawk::PropertyMap props;
+    props["threshold_statistics::resource_id"] = s.resource_id;
+    props["threshold_statistics::threshold_class"] = s.threshold_class;
+    props["threshold_statistics::exceeded"] = s.exceeded;
+    props["threshold_statistics::threshold"] = s.threshold;
+    props["threshold_statistics::current"] = s.current;
+    props["threshold_statistics::min"] = s.min;
+    props["threshold_statistics::max"] = s.max;
+    props["threshold_statistics::mean"] = s.mean;
+    props["threshold_statistics::p50"] = s.p50;
+    props["threshold_statistics::p95"] = s.p95;
+    props["threshold_statistics::samples"] = s.samples;
+    a <<= props;
+};
+
+inline bool operator== (const threshold_statistics_struct_struct& s1, const threshold_statistics_struct_struct& s2) {
+    if (s1.resource_id!=s2.resource_id)
+        return false;
+    if (s1.threshold_class!=s2.threshold_class)
+        return false;
+    if (s1.exceeded!=s2.exceeded)
+        return false;
+    if (s1.threshold!=s2.threshold)
+        return false;
+    if (s1.current!=s2.current)
+        return false;
+    if (s1.min!=s2.min)
+        return false;
+    if (s1.max!=s2.max)
+        return false;
+    if (s1.mean!=s2.mean)
+        return false;
+    if (s1.p50!=s2.p50)
+        return false;
+    if (s1.p95!=s2.p95)
+        return false;
+    if (s1.samples!=s2.samples)
+        return false;
+    return true;
+};
+
+inline bool operator!= (const threshold_statistics_struct_struct& s1, const threshold_statistics_struct_struct& s2) {
+    return !(s1==s2);
+};
+
 #endif // STRUCTPROPS_H
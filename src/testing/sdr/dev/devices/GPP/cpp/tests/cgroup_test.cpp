@@ -0,0 +1,124 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Test for CgroupManager against a scratch directory standing in for a
+ * delegated cgroup v2 root. Checks the leaf naming, the interface file
+ * contents written for a set of limits, attaching a pid and removing the
+ * leaf again.
+ *
+ * usage: cgroup_test
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "utils/CgroupManager.h"
+#include <ossie/testing/check.h>
+
+using namespace ossie::testing;
+
+static std::string contents( const std::string &path )
+{
+  std::ifstream in( path.c_str() );
+  std::string value;
+  std::getline( in, value );
+  return value;
+}
+
+static bool exists( const std::string &path )
+{
+  struct stat st;
+  return stat( path.c_str(), &st ) == 0;
+}
+
+int main()
+{
+  char scratch[] = "/tmp/cgroup_test.XXXXXX";
+  if ( mkdtemp( scratch ) == NULL ) {
+    perror("mkdtemp");
+    return 1;
+  }
+  std::string root = std::string(scratch) + "/redhawk";
+
+  check( CgroupManager::leaf_name("comp_1:waveform_1") == "comp_1_waveform_1", "leaf name of a component identifier" );
+  check( CgroupManager::leaf_name("DCE:cpu.max") == "DCE_cpu_max", "leaf name cannot collide with an interface file" );
+  check( CgroupManager::leaf_name("") == "component", "leaf name of an empty identifier" );
+
+  CgroupManager::Limits unlimited;
+  check( CgroupManager::format_cpu_max(unlimited) == "max 100000", "unlimited cpu.max" );
+  check( CgroupManager::format_memory_max(unlimited) == "max", "unlimited memory.max" );
+  check( CgroupManager::format_pids_max(unlimited) == "max", "unlimited pids.max" );
+
+  CgroupManager::Limits tiny;
+  tiny.cpu_cores = 0.001;
+  check( CgroupManager::format_cpu_max(tiny) == "1000 100000", "cpu.max quota is clamped to the kernel minimum" );
+
+  CgroupManager::Limits limits;
+  limits.cpu_cores = 1.5;
+  limits.memory_bytes = 256LL * 1024 * 1024;
+  limits.pids = 64;
+
+  CgroupManager cgroups( root );
+  std::string leaf;
+  try {
+    leaf = cgroups.create( "comp_1:waveform_1", limits );
+  } catch ( const CgroupManager::CgroupError &e ) {
+    std::cerr << "FAIL: create: " << e.what() << std::endl;
+    rmdir( root.c_str() );
+    rmdir( scratch );
+    return 1;
+  }
+  check( leaf == root + "/comp_1_waveform_1", "leaf path" );
+  check( contents( leaf + "/cpu.max" ) == "150000 100000", "cpu.max" );
+  check( contents( leaf + "/memory.max" ) == "268435456", "memory.max" );
+  check( contents( leaf + "/pids.max" ) == "64", "pids.max" );
+
+  // a leaf left behind by an earlier launch is replaced
+  try {
+    leaf = cgroups.create( "comp_1:waveform_1", unlimited );
+    check( contents( leaf + "/cpu.max" ) == "max 100000", "stale leaf replaced" );
+  } catch ( const CgroupManager::CgroupError &e ) {
+    check( false, std::string("recreate: ") + e.what() );
+  }
+
+  check( CgroupManager::attach( CgroupManager::procs_path(leaf).c_str(), 4242 ), "attach" );
+  check( contents( leaf + "/cgroup.procs" ) == "4242", "cgroup.procs" );
+
+  check( cgroups.remove( leaf ), "remove" );
+  check( !exists( leaf ), "leaf removed" );
+  check( cgroups.remove( leaf ), "removing a missing leaf" );
+
+  CgroupManager disabled;
+  try {
+    disabled.create( "comp_2", limits );
+    check( false, "create without a root" );
+  } catch ( const CgroupManager::CgroupError & ) {
+  }
+
+  rmdir( root.c_str() );
+  rmdir( scratch );
+
+  return result();
+}
@@ -0,0 +1,115 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Stress test for ChildExitTracker. Forks a group of idle children, kills
+ * the whole process group at once so that their SIGCHLD signals coalesce,
+ * and checks that every child is reaped and reported exactly once.
+ *
+ * usage: child_exit_stress [children]
+ */
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/signalfd.h>
+
+#include "utils/ChildExitTracker.h"
+
+int main( int argc, char *argv[] )
+{
+  int children = 200;
+  if ( argc > 1 ) children = atoi( argv[1] );
+  if ( children < 1 ) {
+    std::cerr << "usage: " << argv[0] << " [children]" << std::endl;
+    return 1;
+  }
+
+  // same setup as Device_impl::start_device
+  sigset_t sigset;
+  sigemptyset( &sigset );
+  sigaddset( &sigset, SIGCHLD );
+  sigprocmask( SIG_BLOCK, &sigset, NULL );
+  int sig_fd = signalfd( -1, &sigset, 0 );
+  if ( sig_fd == -1 ) {
+    perror("signalfd");
+    return 1;
+  }
+
+  std::map< pid_t, int > notified;
+  pid_t pgroup = 0;
+  for ( int i=0; i < children; ++i ) {
+    pid_t pid = fork();
+    if ( pid == 0 ) {
+      for (;;) pause();
+    }
+    if ( pid < 0 ) {
+      perror("fork");
+      killpg( pgroup, SIGKILL );
+      return 1;
+    }
+    if ( pgroup == 0 ) pgroup = pid;
+    setpgid( pid, pgroup );
+    notified[pid] = 0;
+  }
+
+  if ( killpg( pgroup, SIGKILL ) != 0 ) {
+    perror("killpg");
+    return 1;
+  }
+
+  ChildExitTracker tracker( sig_fd );
+  ChildExitTracker::ExitList exits;
+  size_t signals = 0;
+  size_t wakeups = 0;
+  int failures = 0;
+  for ( int waits=0; exits.size() < (size_t)children && waits < 100; ++waits ) {
+    if ( !tracker.wait(100) ) continue;
+    ++wakeups;
+    signals += tracker.drain( exits );
+  }
+
+  for ( size_t i=0; i < exits.size(); ++i ) {
+    std::map< pid_t, int >::iterator it = notified.find( exits[i].pid );
+    if ( it == notified.end() ) {
+      std::cerr << "FAIL: unexpected pid " << exits[i].pid << std::endl;
+      ++failures;
+      continue;
+    }
+    ++it->second;
+    if ( !exits[i].signaled || exits[i].signal != SIGKILL ) {
+      std::cerr << "FAIL: pid " << exits[i].pid << " reported " << exits[i].describe() << std::endl;
+      ++failures;
+    }
+  }
+
+  for ( std::map< pid_t, int >::const_iterator it=notified.begin(); it != notified.end(); ++it ) {
+    if ( it->second != 1 ) {
+      std::cerr << "FAIL: pid " << it->first << " notified " << it->second << " times" << std::endl;
+      ++failures;
+    }
+  }
+
+  std::cout << "children: " << children << " reaped: " << exits.size()
+            << " siginfo: " << signals << " wakeups: " << wakeups << std::endl;
+  close( sig_fd );
+  return failures == 0 ? 0 : 1;
+}
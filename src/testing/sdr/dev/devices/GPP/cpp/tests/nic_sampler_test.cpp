@@ -0,0 +1,127 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Checks the /proc/net/dev parser against a captured file
+ * (tests/fixtures/net/proc_net_dev) and the NicAccumulator rate
+ * calculation, including counter wrap and the rate history statistics.
+ *
+ * usage: nic_sampler_test [fixture directory]
+ */
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <boost/bind.hpp>
+
+#include "states/ProcNetDev.h"
+#include "states/NicState.h"
+#include "statistics/NicAccumulator.h"
+#include <ossie/testing/check.h>
+
+using namespace ossie::testing;
+
+#ifndef NET_FIXTURE
+#define NET_FIXTURE "tests/fixtures/net"
+#endif
+
+// NicState with counters set by the test instead of read from the system
+class TestNicState : public NicState
+{
+public:
+  TestNicState( const std::string &iface ) : NicState(iface) {}
+
+  void set( uint64_t rx, uint64_t tx ) {
+    data_.rx_bytes = rx;
+    data_.tx_bytes = tx;
+  }
+};
+
+static double now = 0;
+static double test_time() { return now; }
+
+static const double MB = 1024*1024;
+
+int main( int argc, char *argv[] )
+{
+  std::string fixtures = argc > 1 ? argv[1] : NET_FIXTURE;
+
+  ProcNetDev net_dev( fixtures + "/proc_net_dev" );
+  net_dev.update_state();
+  checkEqual( "interfaces", net_dev.get().size(), 3u );
+
+  const ProcNetDev::Counters *lo = net_dev.find("lo");
+  checkEqual( "lo found", lo != NULL, true );
+  if ( lo ) {
+    checkEqual( "lo rx_bytes", lo->rx_bytes, 123456u );
+    checkEqual( "lo tx_packets", lo->tx_packets, 789u );
+  }
+
+  // counters run into the colon when they are wide
+  const ProcNetDev::Counters *eth0 = net_dev.find("eth0");
+  checkEqual( "eth0 found", eth0 != NULL, true );
+  if ( eth0 ) {
+    checkEqual( "eth0 rx_bytes", eth0->rx_bytes, 18446744073709551000ULL );
+    checkEqual( "eth0 rx_multicast", eth0->rx_multicast, 6u );
+    checkEqual( "eth0 tx_bytes", eth0->tx_bytes, 4294967290ULL );
+    checkEqual( "eth0 tx_compressed", eth0->tx_compressed, 12u );
+  }
+  checkEqual( "eth0.100 found", net_dev.find("eth0.100") != NULL, true );
+  checkEqual( "eth1 missing", net_dev.find("eth1") == NULL, true );
+
+  // counter wrap
+  checkEqual( "no wrap", NicAccumulator::CounterDelta( 100, 250 ), 150u );
+  checkEqual( "32 bit wrap", NicAccumulator::CounterDelta( 0xFFFFFFF0ULL, 0x10 ), 0x20u );
+  checkEqual( "64 bit wrap", NicAccumulator::CounterDelta( 0xFFFFFFFFFFFFFFF0ULL, 0x10 ), 0x20u );
+
+  // rates
+  boost::shared_ptr<TestNicState> nic( new TestNicState("eth0") );
+  NicAccumulator accumulator( nic );
+  accumulator.set_current_time_function( test_time );
+  accumulator.set_history_length( 4 );
+
+  now = 10.0;
+  nic->set( 0, 0 );
+  accumulator.compute_statistics();
+  checkClose( "first sample", accumulator.get_throughput_MB_per_sec(), 0.0 );
+
+  const double rates[] = { 1, 4, 2, 3, 5 };  // MB/s, over half second intervals
+  uint64_t rx = 0xFFFFFFFFFFF00000ULL;       // wraps during the run
+  nic->set( rx, 0 );
+  now += 0.5;
+  accumulator.compute_statistics();
+  for ( size_t i=0; i < sizeof(rates)/sizeof(rates[0]); ++i ) {
+    rx += (uint64_t)(rates[i] * MB * 0.5);
+    nic->set( rx, 0 );
+    now += 0.5;
+    accumulator.compute_statistics();
+    std::ostringstream what;
+    what << "rate " << i;
+    checkClose( what.str(), accumulator.get_throughput_MB_per_sec(), rates[i] );
+  }
+
+  // history holds the last four intervals: 4, 2, 3, 5
+  checkEqual( "history length", accumulator.get_throughput_history().size(), 4u );
+  checkClose( "peak", accumulator.get_peak_throughput_MB_per_sec(), 5.0 );
+  checkClose( "p50", accumulator.get_percentile_throughput_MB_per_sec(50), 3.0 );
+  checkClose( "p75", accumulator.get_percentile_throughput_MB_per_sec(75), 4.0 );
+  checkClose( "p100", accumulator.get_percentile_throughput_MB_per_sec(100), 5.0 );
+
+  return result();
+}
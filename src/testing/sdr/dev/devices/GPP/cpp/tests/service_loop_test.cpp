@@ -0,0 +1,123 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Test for ServiceLoop. Runs a 50 ms cycle for half a second and checks
+ * that the loop wakes once per cycle and no more, that a child exit is
+ * reported as soon as it happens rather than at the next cycle, and that
+ * wake() and interrupt() are delivered.
+ *
+ * usage: service_loop_test
+ */
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <signal.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/signalfd.h>
+#include <sys/wait.h>
+
+#include "utils/ServiceLoop.h"
+#include <ossie/testing/check.h>
+
+using namespace ossie::testing;
+
+static double now_ms()
+{
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+int main()
+{
+  // same setup as Device_impl::start_device
+  sigset_t sigset;
+  sigemptyset( &sigset );
+  sigaddset( &sigset, SIGCHLD );
+  sigprocmask( SIG_BLOCK, &sigset, NULL );
+  int sig_fd = signalfd( -1, &sigset, SFD_NONBLOCK );
+  if ( sig_fd == -1 ) {
+    perror("signalfd");
+    return 1;
+  }
+
+  ServiceLoop loop;
+  loop.open( sig_fd );
+  loop.set_cycle( 50 );
+
+  // only the timer should wake the loop
+  double start = now_ms();
+  int cycles = 0;
+  int other = 0;
+  while ( now_ms() - start < 510 ) {
+    unsigned int events = loop.wait( 100 );
+    if ( events & ServiceLoop::CYCLE ) {
+      ++cycles;
+      loop.handled( events );
+    }
+    if ( events & ~ServiceLoop::CYCLE ) ++other;
+  }
+  check( cycles >= 9 && cycles <= 12, "about ten cycles in 500 ms" );
+  check( other == 0, "no wakeups besides the cycle" );
+
+  // a child exiting midway through a cycle is seen right away
+  loop.set_cycle( 1000 );
+  pid_t pid = fork();
+  if ( pid == 0 ) {
+    usleep( 20000 );
+    _exit( 0 );
+  }
+  double forked = now_ms();
+  unsigned int events = 0;
+  while ( !( events & ServiceLoop::CHILD_EXIT ) && now_ms() - forked < 2000 ) {
+    events = loop.wait( 2000 );
+  }
+  double seen = now_ms() - forked;
+  check( events & ServiceLoop::CHILD_EXIT, "child exit reported" );
+  check( seen < 500, "child exit reported before the next cycle" );
+  struct signalfd_siginfo info;
+  while ( read( sig_fd, &info, sizeof(info) ) == sizeof(info) ) ;
+  waitpid( pid, NULL, 0 );
+  loop.handled( ServiceLoop::CHILD_EXIT );
+
+  loop.wake();
+  events = loop.wait( 0 );
+  check( events & ServiceLoop::WAKEUP, "wake" );
+
+  loop.interrupt();
+  check( loop.wait( 0 ) & ServiceLoop::INTERRUPTED, "interrupt" );
+  check( loop.wait( 0 ) & ServiceLoop::INTERRUPTED, "interrupt holds until resume" );
+  loop.resume();
+  loop.wait( 0 );   // drains the eventfd poke from interrupt()
+  check( !( loop.wait( 0 ) & ServiceLoop::INTERRUPTED ), "resume" );
+
+  ServiceLoop::Stats stats = loop.get_stats();
+  check( stats.cycle_wakeups >= (uint64_t)cycles, "cycle wakeups counted" );
+  check( stats.child_exit_wakeups >= 1, "child exit wakeups counted" );
+  check( stats.property_wakeups >= 1, "property wakeups counted" );
+  check( stats.max_cycle_lateness < 50.0, "cycles handled on schedule" );
+
+  std::cout << "cycles: " << cycles << " child exit seen after: " << seen << " ms"
+            << " max cycle lateness: " << stats.max_cycle_lateness << " ms" << std::endl;
+  return result();
+}
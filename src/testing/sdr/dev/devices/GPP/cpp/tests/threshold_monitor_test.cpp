@@ -0,0 +1,141 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Deterministic test for the threshold monitor policy. Feeds synthetic
+ * sample traces through GenericThresholdMonitor and checks which samples
+ * produce threshold events with and without sustain and hysteresis, and
+ * the rolling window statistics.
+ *
+ * usage: threshold_monitor_test
+ */
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/ref.hpp>
+
+#include "reports/ThresholdMonitor.h"
+#include <ossie/testing/check.h>
+
+using namespace ossie::testing;
+
+// plays back a trace one sample per update()
+class Trace
+{
+public:
+  Trace( const float *samples, size_t count ) : samples_(samples, samples+count), next_(0) {}
+  float operator()() { return samples_[ std::min(next_++, samples_.size()-1) ]; }
+  size_t position() const { return next_; }
+private:
+  std::vector<float> samples_;
+  size_t next_;
+};
+
+struct Recorder
+{
+  std::vector<size_t> at;
+  std::vector<std::string> types;
+  const Trace *trace;
+  void operator()( const threshold_event_struct &message )
+  {
+    // position() has already moved past the sample that caused the event
+    at.push_back( trace->position() - 1 );
+    types.push_back( message.type );
+  }
+};
+
+static float constant_threshold() { return 10.0; }
+
+typedef GenericThresholdMonitor<float> IdleMonitor;                              // exceeded below 10
+typedef GenericThresholdMonitor<float, std::greater<float> > ThroughputMonitor;  // exceeded above 10
+
+// idle percentage dipping under a threshold of 10 for single samples, then
+// for good, then recovering just past the threshold, then well past it
+static const float BURSTY[] = { 50, 8, 50, 9, 50, 5, 5, 5, 5, 10.2f, 9, 10.3f, 10.4f, 10.4f, 12, 12, 12, 12 };
+static const size_t BURSTY_LEN = sizeof(BURSTY)/sizeof(BURSTY[0]);
+
+template<class MONITOR>
+static Recorder run( const float *samples, size_t count, const ThresholdMonitor::Policy &policy, MONITOR **out=0 )
+{
+  // the constructor takes the first sample from the trace
+  Trace *trace = new Trace( samples, count );
+  MONITOR *monitor = new MONITOR( "test", "cpu", "CPU_IDLE", &constant_threshold, boost::ref(*trace) );
+  monitor->set_policy( policy );
+  Recorder recorder;
+  recorder.trace = trace;
+  monitor->attach_listener( boost::ref(recorder) );
+  for ( size_t i=1; i < count; ++i ) {
+    monitor->update();
+  }
+  Recorder result = recorder;
+  if ( out ) *out = monitor; else delete monitor;
+  delete trace;
+  return result;
+}
+
+int main()
+{
+  // single samples, every crossing is an event
+  ThresholdMonitor::Policy legacy;
+  Recorder flapping = run<IdleMonitor>( BURSTY, BURSTY_LEN, legacy );
+  check( flapping.at.size() == 8, "every crossing reported without sustain" );
+
+  // sustained crossings with hysteresis: one exceeded event once the dip
+  // holds for three samples, one clear event once idle is past 10.5 for
+  // three samples
+  ThresholdMonitor::Policy sustained;
+  sustained.window = 8;
+  sustained.sustain = 3;
+  sustained.hysteresis = 5.0;
+  IdleMonitor *monitor = 0;
+  Recorder steady = run<IdleMonitor>( BURSTY, BURSTY_LEN, sustained, &monitor );
+  check( steady.at.size() == 2, "only sustained transitions reported" );
+  if ( steady.at.size() == 2 ) {
+    check( steady.at[0] == 7 && steady.types[0] == "THRESHOLD_EXCEEDED", "exceeded after three low samples" );
+    check( steady.at[1] == 16 && steady.types[1] == "THRESHOLD_NOT_EXCEEDED", "cleared after three samples past the band" );
+  }
+  check( !monitor->is_threshold_exceeded(), "sustained state cleared" );
+
+  // statistics over the last eight samples: 9 10.3 10.4 10.4 12 12 12 12
+  const MetricWindow &window = monitor->get_window();
+  check( window.size() == 8, "window length" );
+  check( window.last() == 12.0f, "window last" );
+  check( window.min() == 9.0f, "window min" );
+  check( window.max() == 12.0f, "window max" );
+  check( std::fabs( window.mean() - 88.1/8 ) < 1e-3, "window mean" );
+  check( std::fabs( window.percentile(50) - 10.4 ) < 1e-3, "window median" );
+  check( window.percentile(95) == 12.0f, "window p95" );
+  delete monitor;
+
+  // the hysteresis band sits below the threshold for monitors that are
+  // exceeded above it
+  static const float THROUGHPUT[] = { 0, 11, 9.8f, 11, 9.4f, 11 };
+  ThresholdMonitor::Policy banded;
+  banded.hysteresis = 5.0;
+  Recorder nic = run<ThroughputMonitor>( THROUGHPUT, sizeof(THROUGHPUT)/sizeof(THROUGHPUT[0]), banded );
+  check( nic.at.size() == 3, "throughput transitions" );
+  if ( nic.at.size() == 3 ) {
+    check( nic.at[0] == 1 && nic.at[1] == 4 && nic.at[2] == 5, "throughput clears below 9.5" );
+  }
+
+  return result();
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+/*
+ * Checks redhawk::affinity::Topology and the GPP affinity lookups against
+ * a captured /proc and /sys tree (tests/fixtures/topology). The fixture
+ * has four online cpus, 0, 1, 2 and 4, on two numa nodes.
+ *
+ * usage: topology_test [fixture root]
+ */
+#include <iostream>
+#include <sstream>
+
+#include "ossie/affinity.h"
+#include "utils/affinity.h"
+#include <ossie/testing/check.h>
+
+using namespace ossie::testing;
+
+#ifndef TOPOLOGY_FIXTURE
+#define TOPOLOGY_FIXTURE "tests/fixtures/topology"
+#endif
+
+static std::string to_string( const redhawk::affinity::CpuList &cpus )
+{
+  std::ostringstream os;
+  for ( size_t i=0; i < cpus.size(); ++i ) {
+    if ( i ) os << ",";
+    os << cpus[i];
+  }
+  return os.str();
+}
+
+int main( int argc, char *argv[] )
+{
+  std::string root = argc > 1 ? argv[1] : TOPOLOGY_FIXTURE;
+  redhawk::affinity::Topology &topology = redhawk::affinity::Topology::Instance();
+  topology.set_root( root );
+  topology.set_refresh_interval( 0 );
+
+  // per queue vectors are included with their interface, and the column
+  // index is mapped through the header so cpu 3 (offline) is skipped
+  checkEqual( "eth0 cpus", to_string( topology.get_interface_cpus("eth0") ), "1,4" );
+  checkEqual( "eth1 cpus", to_string( topology.get_interface_cpus("eth1") ), "0" );
+  checkEqual( "eth2 cpus", to_string( topology.get_interface_cpus("eth2") ), "" );
+  checkEqual( "missing cpus", to_string( topology.get_interface_cpus("ib0") ), "" );
+
+  checkEqual( "node of cpu 1", topology.get_node_of_cpu(1), 0 );
+  checkEqual( "node of cpu 4", topology.get_node_of_cpu(4), 1 );
+  checkEqual( "node of cpu 3", topology.get_node_of_cpu(3), -1 );
+  checkEqual( "node 1 cpus", to_string( topology.get_node_cpus(1) ), "2,4" );
+
+#ifdef HAVE_LIBNUMA
+  checkEqual( "eth0 socket", gpp::affinity::find_socket_for_interface("eth0"), -1 );
+  checkEqual( "eth0 first socket", gpp::affinity::find_socket_for_interface("eth0", true), 0 );
+  checkEqual( "eth1 socket", gpp::affinity::find_socket_for_interface("eth1"), 0 );
+  redhawk::affinity::CpuList blacklist(1, 1);
+  checkEqual( "eth0 socket, cpu 1 blacklisted", gpp::affinity::find_socket_for_interface("eth0", false, blacklist), 1 );
+#endif
+
+  // moving the root forces the map to be rebuilt
+  topology.set_root( root + "/missing" );
+  checkEqual( "eth0 cpus after set_root", to_string( topology.get_interface_cpus("eth0") ), "" );
+
+  return result();
+}
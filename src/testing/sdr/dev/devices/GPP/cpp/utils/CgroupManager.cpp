@@ -0,0 +1,223 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <sstream>
+
+#include "CgroupManager.h"
+
+const unsigned long CgroupManager::DEFAULT_CPU_PERIOD_US;
+
+// the kernel rejects cpu.max quotas below one millisecond
+static const long long MIN_CPU_QUOTA_US = 1000;
+
+// controllers the leaves are limited by
+static const char *CONTROLLERS = "+cpu +memory +pids";
+
+// interface files written into each leaf
+static const char *LEAF_FILES[] = { "cpu.max", "memory.max", "pids.max", "cgroup.procs", 0 };
+
+static std::string _error( const std::string &what, const std::string &path, int err )
+{
+  std::ostringstream os;
+  os << what << " " << path << ": " << strerror(err);
+  return os.str();
+}
+
+static void _write_file( const std::string &path, const std::string &value )
+{
+  // cgroupfs validates the value on write, so report the write error
+  // rather than relying on a buffered stream
+  int fd = open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  if ( fd < 0 ) {
+    throw CgroupManager::CgroupError( _error("Unable to open", path, errno) );
+  }
+  ssize_t rc;
+  do {
+    rc = write( fd, value.data(), value.size() );
+  } while ( rc < 0 && errno == EINTR );
+  int err = errno;
+  close( fd );
+  if ( rc != (ssize_t)value.size() ) {
+    throw CgroupManager::CgroupError( _error("Unable to write '" + value + "' to", path, rc < 0 ? err : EIO) );
+  }
+}
+
+CgroupManager::Limits::Limits() :
+  cpu_cores(0.0),
+  cpu_period_us(DEFAULT_CPU_PERIOD_US),
+  memory_bytes(0),
+  pids(0)
+{}
+
+CgroupManager::CgroupManager( const std::string &root ) :
+  root_(root),
+  controllers_enabled_(false)
+{}
+
+void CgroupManager::set_root( const std::string &root )
+{
+  if ( root != root_ ) {
+    root_ = root;
+    controllers_enabled_ = false;
+  }
+}
+
+const std::string &CgroupManager::get_root() const
+{
+  return root_;
+}
+
+std::string CgroupManager::create( const std::string &identifier, const Limits &limits )
+{
+  if ( root_.empty() ) {
+    throw CgroupError("No cgroup root configured");
+  }
+  if ( mkdir( root_.c_str(), 0755 ) != 0 && errno != EEXIST ) {
+    throw CgroupError( _error("Unable to create cgroup root", root_, errno) );
+  }
+  _enable_controllers();
+
+  std::string leaf = root_ + "/" + leaf_name(identifier);
+  if ( mkdir( leaf.c_str(), 0755 ) != 0 ) {
+    if ( errno != EEXIST || !remove(leaf) || mkdir( leaf.c_str(), 0755 ) != 0 ) {
+      throw CgroupError( _error("Unable to create cgroup", leaf, errno) );
+    }
+  }
+
+  try {
+    _write_file( leaf + "/cpu.max", format_cpu_max(limits) );
+    _write_file( leaf + "/memory.max", format_memory_max(limits) );
+    _write_file( leaf + "/pids.max", format_pids_max(limits) );
+  }
+  catch( ... ) {
+    remove(leaf);
+    throw;
+  }
+  return leaf;
+}
+
+bool CgroupManager::remove( const std::string &leaf )
+{
+  if ( rmdir( leaf.c_str() ) == 0 || errno == ENOENT ) {
+    return true;
+  }
+  if ( errno != ENOTEMPTY ) {
+    return false;
+  }
+
+  // cgroupfs removes a leaf with its interface files in place; anywhere
+  // else the files written by create() have to go first
+  for ( const char **file = LEAF_FILES; *file; ++file ) {
+    unlink( (leaf + "/" + *file).c_str() );
+  }
+  return rmdir( leaf.c_str() ) == 0;
+}
+
+bool CgroupManager::attach( const char *procs_path, pid_t pid )
+{
+  char buf[32];
+  int len = snprintf( buf, sizeof(buf), "%d", (int)pid );
+  int fd = open( procs_path, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  if ( fd < 0 ) return false;
+  ssize_t rc;
+  do {
+    rc = write( fd, buf, len );
+  } while ( rc < 0 && errno == EINTR );
+  int err = errno;
+  close( fd );
+  errno = err;
+  return rc == len;
+}
+
+std::string CgroupManager::procs_path( const std::string &leaf )
+{
+  return leaf + "/cgroup.procs";
+}
+
+std::string CgroupManager::leaf_name( const std::string &identifier )
+{
+  // component identifiers carry ':' separators, and a '.' could collide
+  // with an interface file name, so keep only a conservative character set
+  std::string name;
+  for ( std::string::const_iterator c = identifier.begin(); c != identifier.end(); ++c ) {
+    if ( isalnum(static_cast<unsigned char>(*c)) || *c == '-' || *c == '_' ) {
+      name += *c;
+    }
+    else {
+      name += '_';
+    }
+  }
+  if ( name.empty() ) {
+    name = "component";
+  }
+  return name;
+}
+
+std::string CgroupManager::format_cpu_max( const Limits &limits )
+{
+  std::ostringstream os;
+  if ( limits.cpu_cores > 0.0 ) {
+    long long quota = static_cast<long long>( ::llround( limits.cpu_cores * limits.cpu_period_us ) );
+    os << std::max( quota, MIN_CPU_QUOTA_US );
+  }
+  else {
+    os << "max";
+  }
+  os << " " << limits.cpu_period_us;
+  return os.str();
+}
+
+std::string CgroupManager::format_memory_max( const Limits &limits )
+{
+  if ( limits.memory_bytes <= 0 ) return "max";
+  std::ostringstream os;
+  os << limits.memory_bytes;
+  return os.str();
+}
+
+std::string CgroupManager::format_pids_max( const Limits &limits )
+{
+  if ( limits.pids <= 0 ) return "max";
+  std::ostringstream os;
+  os << limits.pids;
+  return os.str();
+}
+
+void CgroupManager::_enable_controllers()
+{
+  if ( controllers_enabled_ ) return;
+
+  // the controllers must be enabled on the root before its leaves get the
+  // cpu.max, memory.max and pids.max files; a scratch root has no
+  // subtree_control and needs nothing
+  std::string subtree = root_ + "/cgroup.subtree_control";
+  if ( access( subtree.c_str(), F_OK ) == 0 ) {
+    _write_file( subtree, CONTROLLERS );
+  }
+  controllers_enabled_ = true;
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef _CGROUPMANAGER_H_
+#define _CGROUPMANAGER_H_
+
+#include <sys/types.h>
+#include <string>
+#include <stdexcept>
+
+//
+// CgroupManager
+//
+// Creates one cgroup v2 leaf per launched component under a delegated root
+// directory, applies the cpu.max, memory.max and pids.max limits to it and
+// removes it once the component is gone. The root is a plain path so the
+// manager can be pointed at a scratch directory instead of cgroupfs.
+//
+class CgroupManager {
+
+public:
+
+  class CgroupError : public std::runtime_error {
+  public:
+    explicit CgroupError( const std::string &msg ) : std::runtime_error(msg) {};
+  };
+
+  struct Limits {
+    double        cpu_cores;       // cores of cpu time per period, <= 0 for no limit
+    unsigned long cpu_period_us;   // cpu.max accounting period
+    long long     memory_bytes;    // <= 0 for no limit
+    long          pids;            // <= 0 for no limit
+
+    Limits();
+  };
+
+  // default cpu.max period used by the kernel
+  static const unsigned long DEFAULT_CPU_PERIOD_US = 100000;
+
+  CgroupManager( const std::string &root="" );
+
+  void set_root( const std::string &root );
+  const std::string &get_root() const;
+
+  //
+  // Create the leaf for a component and write its limits, returning the
+  // leaf's path. A stale leaf with the same name is removed first.
+  // Throws CgroupError if the leaf cannot be created or configured.
+  //
+  std::string create( const std::string &identifier, const Limits &limits );
+
+  //
+  // Remove a leaf created by create(). Returns false if the leaf is still
+  // populated and must be retried once its processes are reaped.
+  //
+  bool remove( const std::string &leaf );
+
+  //
+  // Move pid into the leaf. Only uses open/write so it may be called
+  // between fork and exec; returns false and leaves errno set on failure.
+  //
+  static bool attach( const char *procs_path, pid_t pid );
+
+  // path of the cgroup.procs file of a leaf
+  static std::string procs_path( const std::string &leaf );
+
+  // leaf directory name for a component identifier
+  static std::string leaf_name( const std::string &identifier );
+
+  // interface file contents for a set of limits
+  static std::string format_cpu_max( const Limits &limits );
+  static std::string format_memory_max( const Limits &limits );
+  static std::string format_pids_max( const Limits &limits );
+
+private:
+
+  void _enable_controllers();
+
+  std::string   root_;
+  bool          controllers_enabled_;
+};
+
+#endif
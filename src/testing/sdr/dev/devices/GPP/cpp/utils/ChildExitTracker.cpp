@@ -0,0 +1,134 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <sys/signalfd.h>
+#include <sstream>
+
+#include "ChildExitTracker.h"
+
+// siginfo structures consumed per read on the signalfd
+static const size_t SIGINFO_BATCH = 32;
+
+ChildExitTracker::Exit::Exit() :
+  pid(-1),
+  exited(false),
+  exit_status(0),
+  signaled(false),
+  signal(0),
+  core_dumped(false)
+{}
+
+std::string ChildExitTracker::Exit::describe() const
+{
+  std::ostringstream os;
+  if ( exited ) {
+    os << "exit status " << exit_status;
+  }
+  else if ( signaled ) {
+    os << "signal " << signal;
+    if ( core_dumped ) os << " (core dumped)";
+  }
+  else {
+    os << "unknown status";
+  }
+  return os.str();
+}
+
+ChildExitTracker::ChildExitTracker( int sig_fd ) :
+  sig_fd_(sig_fd)
+{}
+
+bool ChildExitTracker::wait( int timeout_ms ) const
+{
+  if ( sig_fd_ < 0 ) return false;
+  struct pollfd pfd;
+  pfd.fd = sig_fd_;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  int rc;
+  do {
+    rc = poll( &pfd, 1, timeout_ms );
+  } while ( rc == -1 && errno == EINTR );
+  return rc > 0 && ( pfd.revents & POLLIN );
+}
+
+size_t ChildExitTracker::drain( ExitList &exits )
+{
+  size_t sigchld = 0;
+
+  // the signalfd may be blocking, so only read while data is pending; a
+  // single read returns as many queued siginfo as fit in the buffer
+  struct signalfd_siginfo si[SIGINFO_BATCH];
+  while ( wait(0) ) {
+    ssize_t s = read( sig_fd_, si, sizeof(si) );
+    if ( s < 0 ) {
+      if ( errno == EINTR ) continue;
+      break;
+    }
+    size_t count = s / sizeof(struct signalfd_siginfo);
+    if ( count == 0 ) break;
+    for ( size_t i=0; i < count; ++i ) {
+      if ( si[i].ssi_signo == SIGCHLD ) ++sigchld;
+    }
+  }
+
+  reap( exits );
+  return sigchld;
+}
+
+size_t ChildExitTracker::reap( ExitList &exits )
+{
+  size_t reaped = 0;
+  int status;
+  pid_t pid;
+  for (;;) {
+    pid = waitpid( -1, &status, WNOHANG );
+    if ( pid > 0 ) {
+      Exit ex;
+      ex.pid = pid;
+      if ( WIFEXITED(status) ) {
+        ex.exited = true;
+        ex.exit_status = WEXITSTATUS(status);
+      }
+      else if ( WIFSIGNALED(status) ) {
+        ex.signaled = true;
+        ex.signal = WTERMSIG(status);
+#ifdef WCOREDUMP
+        ex.core_dumped = WCOREDUMP(status);
+#endif
+      }
+      exits.push_back( ex );
+      ++reaped;
+      continue;
+    }
+    if ( pid == -1 && errno == EINTR ) continue;
+    break;
+  }
+
+  if ( pid == -1 && errno != ECHILD ) {
+    perror("waitpid");
+  }
+  return reaped;
+}
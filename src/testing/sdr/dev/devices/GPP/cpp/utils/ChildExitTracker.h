@@ -0,0 +1,80 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef _CHILDEXITTRACKER_H_
+#define _CHILDEXITTRACKER_H_
+
+#include <sys/types.h>
+#include <string>
+#include <vector>
+
+//
+// ChildExitTracker
+//
+// Collects child process exits signalled through a signalfd. The kernel
+// coalesces SIGCHLD, so a single siginfo can stand for any number of exited
+// children; drain() consumes every pending siginfo and then reaps every
+// child that has exited, not just the one named in the siginfo.
+//
+class ChildExitTracker {
+
+public:
+
+  struct Exit {
+    pid_t   pid;
+    bool    exited;          // terminated normally, see exit_status
+    int     exit_status;
+    bool    signaled;        // terminated by a signal, see signal
+    int     signal;
+    bool    core_dumped;
+
+    Exit();
+
+    // short description, e.g. "exit status 0" or "signal 9 (core dumped)"
+    std::string describe() const;
+  };
+
+  typedef std::vector< Exit >   ExitList;
+
+  //
+  // sig_fd is a signalfd that includes SIGCHLD in its mask, or -1 to only
+  // reap children. The descriptor is not owned by the tracker.
+  //
+  ChildExitTracker( int sig_fd=-1 );
+
+  // returns true if at least one siginfo is pending on the signalfd,
+  // waiting up to timeout_ms milliseconds
+  bool wait( int timeout_ms ) const;
+
+  //
+  // Consume every pending siginfo from the signalfd and reap every exited
+  // child. Reaped children are appended to exits. Returns the number of
+  // SIGCHLD siginfo structures consumed.
+  //
+  size_t drain( ExitList &exits );
+
+  // reap every exited child without touching the signalfd, returns the
+  // number of children reaped
+  size_t reap( ExitList &exits );
+
+private:
+  int   sig_fd_;
+};
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "ServiceLoop.h"
+
+// descriptors in the epoll set: signalfd, timerfd and eventfd
+static const int MAX_EVENTS = 3;
+
+static void _watch( int epoll_fd, int fd )
+{
+  struct epoll_event ev;
+  memset( &ev, 0, sizeof(ev) );
+  ev.events = EPOLLIN;
+  ev.data.fd = fd;
+  if ( epoll_ctl( epoll_fd, EPOLL_CTL_ADD, fd, &ev ) != 0 ) {
+    throw std::runtime_error( std::string("Unable to add descriptor to epoll set: ") + strerror(errno) );
+  }
+}
+
+// drain a timerfd or eventfd, returning its counter
+static uint64_t _consume( int fd )
+{
+  uint64_t count = 0;
+  ssize_t rc;
+  do {
+    rc = read( fd, &count, sizeof(count) );
+  } while ( rc < 0 && errno == EINTR );
+  return rc == sizeof(count) ? count : 0;
+}
+
+ServiceLoop::Stats::Stats() :
+  wakeups(0),
+  child_exit_wakeups(0),
+  cycle_wakeups(0),
+  property_wakeups(0),
+  missed_cycles(0),
+  cycle_lateness(0.0),
+  max_cycle_lateness(0.0),
+  child_exit_latency(0.0),
+  max_child_exit_latency(0.0)
+{}
+
+ServiceLoop::ServiceLoop() :
+  epoll_fd_(-1),
+  timer_fd_(-1),
+  event_fd_(-1),
+  sig_fd_(-1),
+  period_ms_(0),
+  interrupted_(false),
+  cycle_lateness_(0.0)
+{
+  woke_.tv_sec = 0;
+  woke_.tv_nsec = 0;
+}
+
+ServiceLoop::~ServiceLoop()
+{
+  if ( epoll_fd_ >= 0 ) close( epoll_fd_ );
+  if ( timer_fd_ >= 0 ) close( timer_fd_ );
+  if ( event_fd_ >= 0 ) close( event_fd_ );
+}
+
+void ServiceLoop::open( int sig_fd )
+{
+  if ( is_open() ) return;
+
+  // close-on-exec keeps the descriptors out of launched components
+  int epoll_fd = epoll_create1( EPOLL_CLOEXEC );
+  int timer_fd = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+  int event_fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+  int err = errno;
+  if ( epoll_fd < 0 || timer_fd < 0 || event_fd < 0 ) {
+    if ( epoll_fd >= 0 ) close( epoll_fd );
+    if ( timer_fd >= 0 ) close( timer_fd );
+    if ( event_fd >= 0 ) close( event_fd );
+    throw std::runtime_error( std::string("Unable to create service loop descriptors: ") + strerror(err) );
+  }
+  epoll_fd_ = epoll_fd;
+  timer_fd_ = timer_fd;
+  event_fd_ = event_fd;
+  sig_fd_ = sig_fd;
+
+  _watch( epoll_fd_, timer_fd_ );
+  _watch( epoll_fd_, event_fd_ );
+  if ( sig_fd_ >= 0 ) {
+    _watch( epoll_fd_, sig_fd_ );
+  }
+}
+
+bool ServiceLoop::is_open() const
+{
+  return epoll_fd_ >= 0;
+}
+
+void ServiceLoop::set_cycle( unsigned int period_ms )
+{
+  if ( !is_open() || period_ms == period_ms_ ) return;
+
+  struct itimerspec spec;
+  spec.it_interval.tv_sec = period_ms / 1000;
+  spec.it_interval.tv_nsec = (period_ms % 1000) * 1000000L;
+  spec.it_value = spec.it_interval;
+  if ( timerfd_settime( timer_fd_, 0, &spec, NULL ) != 0 ) {
+    throw std::runtime_error( std::string("Unable to arm cycle timer: ") + strerror(errno) );
+  }
+  period_ms_ = period_ms;
+}
+
+unsigned int ServiceLoop::get_cycle() const
+{
+  return period_ms_;
+}
+
+void ServiceLoop::wake()
+{
+  if ( event_fd_ < 0 ) return;
+  uint64_t one = 1;
+  ssize_t rc;
+  do {
+    rc = write( event_fd_, &one, sizeof(one) );
+  } while ( rc < 0 && errno == EINTR );
+}
+
+void ServiceLoop::interrupt()
+{
+  {
+    boost::mutex::scoped_lock lock(lock_);
+    interrupted_ = true;
+  }
+  wake();
+}
+
+void ServiceLoop::resume()
+{
+  boost::mutex::scoped_lock lock(lock_);
+  interrupted_ = false;
+}
+
+unsigned int ServiceLoop::wait( int timeout_ms )
+{
+  {
+    boost::mutex::scoped_lock lock(lock_);
+    if ( interrupted_ ) return INTERRUPTED;
+  }
+  if ( !is_open() ) return 0;
+
+  struct epoll_event events[MAX_EVENTS];
+  int nready = epoll_wait( epoll_fd_, events, MAX_EVENTS, timeout_ms );
+  if ( nready <= 0 ) {
+    return 0;
+  }
+  clock_gettime( CLOCK_MONOTONIC, &woke_ );
+
+  unsigned int ready = 0;
+  uint64_t missed = 0;
+  for ( int i=0; i < nready; ++i ) {
+    int fd = events[i].data.fd;
+    if ( fd == sig_fd_ ) {
+      ready |= CHILD_EXIT;
+    }
+    else if ( fd == timer_fd_ ) {
+      uint64_t expirations = _consume( timer_fd_ );
+      if ( expirations > 0 ) {
+        ready |= CYCLE;
+        missed = expirations - 1;
+
+        // the timer is periodic, so the time left until the next expiry
+        // tells how long ago the one being serviced fired
+        struct itimerspec spec;
+        cycle_lateness_ = 0.0;
+        if ( timerfd_gettime( timer_fd_, &spec ) == 0 ) {
+          double remaining = spec.it_value.tv_sec * 1e3 + spec.it_value.tv_nsec / 1e6;
+          cycle_lateness_ = std::max( 0.0, period_ms_ - remaining );
+        }
+      }
+    }
+    else if ( fd == event_fd_ ) {
+      if ( _consume( event_fd_ ) > 0 ) {
+        ready |= WAKEUP;
+      }
+    }
+  }
+
+  boost::mutex::scoped_lock lock(lock_);
+  if ( interrupted_ ) ready |= INTERRUPTED;
+  if ( ready ) ++stats_.wakeups;
+  if ( ready & CHILD_EXIT ) ++stats_.child_exit_wakeups;
+  if ( ready & CYCLE ) ++stats_.cycle_wakeups;
+  if ( ready & WAKEUP ) ++stats_.property_wakeups;
+  stats_.missed_cycles += missed;
+  return ready;
+}
+
+void ServiceLoop::handled( unsigned int events )
+{
+  struct timespec now;
+  clock_gettime( CLOCK_MONOTONIC, &now );
+  double elapsed = _elapsed_ms( woke_, now );
+
+  boost::mutex::scoped_lock lock(lock_);
+  if ( events & CYCLE ) {
+    stats_.cycle_lateness = cycle_lateness_ + elapsed;
+    stats_.max_cycle_lateness = std::max( stats_.max_cycle_lateness, stats_.cycle_lateness );
+  }
+  if ( events & CHILD_EXIT ) {
+    stats_.child_exit_latency = elapsed;
+    stats_.max_child_exit_latency = std::max( stats_.max_child_exit_latency, elapsed );
+  }
+}
+
+ServiceLoop::Stats ServiceLoop::get_stats() const
+{
+  boost::mutex::scoped_lock lock(lock_);
+  return stats_;
+}
+
+double ServiceLoop::_elapsed_ms( const struct timespec &from, const struct timespec &to )
+{
+  return (to.tv_sec - from.tv_sec) * 1e3 + (to.tv_nsec - from.tv_nsec) / 1e6;
+}
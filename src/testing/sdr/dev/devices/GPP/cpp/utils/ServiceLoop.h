@@ -0,0 +1,124 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK GPP.
+ *
+ * REDHAWK GPP is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK GPP is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef _SERVICELOOP_H_
+#define _SERVICELOOP_H_
+
+#include <stdint.h>
+#include <time.h>
+#include <boost/thread/mutex.hpp>
+
+//
+// ServiceLoop
+//
+// Blocks the GPP service thread on a single epoll set until there is work:
+// a child exit on the device's signalfd, the expiry of a periodic timerfd
+// that paces the monitoring cycle, or an eventfd poke after a property
+// change. Keeps counts of the wakeups and how late each one was handled.
+//
+class ServiceLoop {
+
+public:
+
+  enum Event {
+    CHILD_EXIT   = 0x1,     // siginfo pending on the signalfd, not consumed
+    CYCLE        = 0x2,     // monitoring cycle is due
+    WAKEUP       = 0x4,     // wake() was called
+    INTERRUPTED  = 0x8      // interrupt() was called, the thread should exit
+  };
+
+  struct Stats {
+    uint64_t  wakeups;                // returns from wait() with at least one event
+    uint64_t  child_exit_wakeups;
+    uint64_t  cycle_wakeups;
+    uint64_t  property_wakeups;
+    uint64_t  missed_cycles;          // timer expirations that were never serviced
+    double    cycle_lateness;         // milliseconds from the scheduled cycle until it was handled
+    double    max_cycle_lateness;
+    double    child_exit_latency;     // milliseconds from wakeup until child exits were handled
+    double    max_child_exit_latency;
+
+    Stats();
+  };
+
+  ServiceLoop();
+  ~ServiceLoop();
+
+  //
+  // Create the epoll set, the timerfd and the eventfd, and watch sig_fd
+  // for child exits. The signalfd is not owned by the loop. Throws
+  // std::runtime_error if any descriptor cannot be created.
+  //
+  void open( int sig_fd );
+
+  // true once open() succeeded
+  bool is_open() const;
+
+  //
+  // Fire the CYCLE event every period_ms milliseconds, starting one period
+  // from now; 0 disarms the timer. Re-arming with the current period is a
+  // no-op so the schedule does not slip.
+  //
+  void set_cycle( unsigned int period_ms );
+
+  unsigned int get_cycle() const;
+
+  // wake the loop with a WAKEUP event, safe to call from any thread
+  void wake();
+
+  // wake the loop with INTERRUPTED until resume() is called
+  void interrupt();
+  void resume();
+
+  //
+  // Wait up to timeout_ms milliseconds (-1 waits forever) and return the
+  // Event mask that is ready. The timerfd and eventfd are consumed here; the
+  // signalfd is left for the caller to drain.
+  //
+  unsigned int wait( int timeout_ms=-1 );
+
+  //
+  // Record that the events returned by the last wait() have been handled,
+  // used for the latency statistics.
+  //
+  void handled( unsigned int events );
+
+  Stats get_stats() const;
+
+private:
+
+  static double _elapsed_ms( const struct timespec &from, const struct timespec &to );
+
+  int               epoll_fd_;
+  int               timer_fd_;
+  int               event_fd_;
+  int               sig_fd_;
+  unsigned int      period_ms_;
+  bool              interrupted_;
+  struct timespec   woke_;              // when the last wait() returned
+  double            cycle_lateness_;    // lateness of the cycle at wakeup
+  Stats             stats_;
+  mutable boost::mutex  lock_;          // guards interrupted_ and stats_
+
+  // not copyable, owns descriptors
+  ServiceLoop( const ServiceLoop & );
+  ServiceLoop &operator=( const ServiceLoop & );
+};
+
+#endif
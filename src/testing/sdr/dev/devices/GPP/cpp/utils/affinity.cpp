@@ -51,47 +51,8 @@ namespace  gpp {
 
      */
     redhawk::affinity::CpuList identify_cpus( const std::string &iface ) {
-
-      redhawk::affinity::CpuList  cpus;
-      std::string pintr("/proc/interrupts");
-      std::ifstream in(pintr.c_str(), std::ifstream::in );
-      if ( in.fail() ) {
-        RH_NL_ERROR("gpp::affinity", "Unable to access /proc/interrupts");
-        return cpus;
-      }
-
-      std::string line;
-      while( std::getline( in, line ) ) {
-        // check if the device is our interface
-        RH_NL_TRACE("gpp::affinity", "Processing /proc/interrupts.... line:" << line);
-        if ( line.rfind(iface) != std::string::npos ) {
-          std::istringstream iss(line);
-          int parts=0;
-          do {
-            std::string tok;
-            iss>>tok;
-            // skip interrupt number and iface
-            if ( parts > 0 and tok != iface ) {
-              std::istringstream iss(tok);
-              int icnt;
-              iss >> icnt;
-              if ( icnt > 0 ) {
-                RH_NL_TRACE("gpp::affinity", "identify cpus: Adding CPU : " << parts-1);
-                cpus.push_back(parts-1);
-              }
-            }
-            parts++;
-          }while(iss);
-
-        }
-      }
-
-      redhawk::affinity::CpuList::iterator citer=cpus.begin();
-      for (; citer != cpus.end(); citer++) {
-        RH_NL_DEBUG("gpp::affinity", "identified CPUS iface/cpu ...:" << iface << "/" << *citer);
-      }
-
-      return cpus;
+      // shares the cached interrupt map with redhawk::affinity
+      return redhawk::affinity::Topology::Instance().get_interface_cpus(iface);
     }
 
 
@@ -106,9 +67,13 @@ namespace  gpp {
 #ifdef HAVE_LIBNUMA
         int soc=-1;
         for( int i=0; i < (int)cpulist.size();i++ ) {
-          RH_NL_DEBUG("gpp::affinity", "Finding (processor socket) for NIC:" << iface << " socket :" << numa_node_of_cpu(cpulist[i]) );
+          RH_NL_DEBUG("gpp::affinity", "Finding (processor socket) for NIC:" << iface << " socket :" << redhawk::affinity::Topology::Instance().get_node_of_cpu(cpulist[i]) );
           if ( std::count(  bl.begin(), bl.end(), cpulist[i] ) != 0 ) continue;
-          soc = numa_node_of_cpu(cpulist[i]);
+          soc = redhawk::affinity::Topology::Instance().get_node_of_cpu(cpulist[i]);
+          if ( soc < 0 ) {
+            RH_NL_WARN("gpp::affinity", "Unable to determine socket of cpu:" << cpulist[i] << " servicing NIC:" << iface);
+            continue;
+          }
           if ( soc != psoc && psoc != -1 && !findFirst ) {
             RH_NL_WARN("gpp::affinity", "More than 1 socket servicing NIC:" << iface);
             psoc=-1;
@@ -143,26 +108,15 @@ namespace  gpp {
             throw redhawk::affinity::AffinityFailed("Processor Socket affinity failed, unable to parse:  " + nodestr);
           }
 
-          bitmask *cpu_mask = numa_allocate_cpumask(); 
-          if ( !cpu_mask ) {
-            throw redhawk::affinity::AffinityFailed("Unable to allocate cpu mask");
-          } 
-
           // for each bit set in the mask then get cpu list
           int nbytes = numa_bitmask_nbytes(node_mask);
           for (int i=0; i < nbytes*8; i++ ){
             if ( numa_bitmask_isbitset( node_mask, i ) ) {
-              numa_node_to_cpus( i, cpu_mask );
-              
-              // foreach cpu identified add to list
-              int nb = numa_bitmask_nbytes(cpu_mask);
-              for (int j=0; j < nb*8; j++ ){
-                if ( numa_bitmask_isbitset( cpu_mask, j ) ) {
-                  cpu_list.push_back( j );
-                }
-              }
+              redhawk::affinity::CpuList node_cpus = redhawk::affinity::Topology::Instance().get_node_cpus( i );
+              cpu_list.insert( cpu_list.end(), node_cpus.begin(), node_cpus.end() );
             }
           }
+          numa_bitmask_free(node_mask);
 
       }
 
@@ -220,9 +174,23 @@ namespace  gpp {
                 throw redhawk::affinity::AffinityFailed("Unable to allocate node mask");
               }
 
+              int nodes=0;
               for( int i=0; i < (int)cpulist.size();i++ ) {
-                RH_NL_DEBUG("gpp::affinity", "Setting NIC (processor socket select) available sockets :" << numa_node_of_cpu(cpulist[i]) );
-                numa_bitmask_setbit(node_mask, numa_node_of_cpu(cpulist[i]) );
+                int node = redhawk::affinity::Topology::Instance().get_node_of_cpu(cpulist[i]);
+                if ( node < 0 ) {
+                  RH_NL_WARN("gpp::affinity", "Setting NIC (processor socket select), unable to determine socket of cpu:" << cpulist[i] );
+                  continue;
+                }
+                RH_NL_DEBUG("gpp::affinity", "Setting NIC (processor socket select) available sockets :" << node );
+                numa_bitmask_setbit(node_mask, node );
+                nodes++;
+              }
+
+              if ( nodes == 0 ) {
+                numa_bitmask_free(node_mask);
+                std::ostringstream e;
+                e << "Binding to NIC, unable to determine processor socket for any cpu servicing interface:" << iface;
+                throw redhawk::affinity::AffinityFailed(e.str());
               }
 
               RH_NL_DEBUG("gpp::affinity", "Setting NIC (processor socket select) affinity constraint: :" << iface );
@@ -257,14 +225,18 @@ namespace  gpp {
               //
               if ( (cpulist.size() == 1 && get_nic_promotion() ) || ( cpus == 0 && get_nic_promotion() ) ) {
                 int cpuid = cpulist[0];
-                std::ostringstream os;
-                os << numa_node_of_cpu( cpuid );
-                redhawk::affinity::CpuList tlist = get_cpu_list( "socket", os.str() );
-                RH_NL_INFO("gpp::affinity", "Promoting NIC affinity to PID:" << pid << " SOCKET:" << os.str() );
-                cpulist.clear();
-                for( int i=0; i < (int)tlist.size();i++ ) {
-                  if ( tlist[i] == cpuid ) continue;
-                  cpulist.push_back( tlist[i] );
+                int node = redhawk::affinity::Topology::Instance().get_node_of_cpu( cpuid );
+                if ( node < 0 ) {
+                  RH_NL_WARN("gpp::affinity", "Unable to promote NIC affinity, no socket for cpu:" << cpuid );
+                }
+                else {
+                  redhawk::affinity::CpuList tlist = redhawk::affinity::Topology::Instance().get_node_cpus( node );
+                  RH_NL_INFO("gpp::affinity", "Promoting NIC affinity to PID:" << pid << " SOCKET:" << node );
+                  cpulist.clear();
+                  for( int i=0; i < (int)tlist.size();i++ ) {
+                    if ( tlist[i] == cpuid ) continue;
+                    cpulist.push_back( tlist[i] );
+                  }
                 }
               }
               
@@ -332,11 +304,14 @@ namespace  gpp {
               throw redhawk::affinity::AffinityFailed("Unable to allocate cpu mask");
             } 
 
-            // check if node is active, if so then get a cpu id
+            // add the cpus of every node in the constraint
             int nbytes = numa_bitmask_nbytes(node_mask);
             for (int i=0; i < nbytes*8; i++ ){
               if ( numa_bitmask_isbitset( node_mask, i ) ) {
-                numa_node_to_cpus( i, cpu_mask );
+                redhawk::affinity::CpuList node_cpus = redhawk::affinity::Topology::Instance().get_node_cpus( i );
+                for ( redhawk::affinity::CpuList::const_iterator citer = node_cpus.begin(); citer != node_cpus.end(); citer++ ) {
+                  numa_bitmask_setbit(cpu_mask, *citer);
+                }
               }
             }
 
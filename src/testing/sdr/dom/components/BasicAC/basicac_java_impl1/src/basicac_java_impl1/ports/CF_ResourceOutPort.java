@@ -209,6 +209,12 @@ public class CF_ResourceOutPort extends UsesPort<ResourceOperations> implements
         return retval;
     }
 
+    public CF.PortSetPackage.PortInfoType[] getPorts(String[] names) throws CF.PortSupplierPackage.UnknownPort
+    {
+        CF.PortSetPackage.PortInfoType[] retval = new CF.PortSetPackage.PortInfoType[names.length];
+        return retval;
+    }
+
     /**
      * @generated
      */
@@ -0,0 +1,135 @@
+#
+# This file is protected by Copyright. Please refer to the COPYRIGHT file
+# distributed with this source distribution.
+#
+# This file is part of REDHAWK core.
+#
+# REDHAWK core is free software: you can redistribute it and/or modify it under
+# the terms of the GNU Lesser General Public License as published by the Free
+# Software Foundation, either version 3 of the License, or (at your option) any
+# later version.
+#
+# REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+# details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program.  If not, see http://www.gnu.org/licenses/.
+#
+
+import unittest, os, shutil, tempfile
+import json
+from _unitTestHelpers import scatest
+from omniORB import any
+from ossie.cf import CF, ExtendedCF
+
+# Writes every DomainManager message, without decoration, to a file so that
+# the trace logged for a failed create can be read back
+LOG_CONFIG = \
+    "log4j.rootLogger=DEBUG,FILE\n" + \
+    "log4j.appender.FILE=org.apache.log4j.FileAppender\n" + \
+    "log4j.appender.FILE.File=%s\n" + \
+    "log4j.appender.FILE.layout=org.apache.log4j.PatternLayout\n" + \
+    "log4j.appender.FILE.layout.ConversionPattern=%%m%%n\n"
+
+FAILED_TRACE = "Deployment trace for failed create of "
+
+class DeploymentTraceTest(scatest.CorbaTestCase):
+    def setUp(self):
+        self._tempdir = tempfile.mkdtemp()
+        self._logfile = os.path.join(self._tempdir, 'DomainManager.log')
+        logconfig = os.path.join(self._tempdir, 'log.cfg')
+        fp = open(logconfig, 'w')
+        fp.write(LOG_CONFIG % self._logfile)
+        fp.close()
+
+        domBooter, self._domMgr = self.launchDomainManager(loggingURI='file://' + logconfig)
+        devBooter, self._devMgr = self.launchDeviceManager("/nodes/test_PortTestDevice_node/DeviceManager.dcd.xml")
+        self._app = None
+
+    def tearDown(self):
+        if self._app:
+            self._app.releaseObject()
+
+        # Do all application shutdown before calling the base class tearDown,
+        # or failures will probably occur.
+        scatest.CorbaTestCase.tearDown(self)
+        shutil.rmtree(self._tempdir, ignore_errors=True)
+
+    def _getFactory(self, name):
+        self.assertNotEqual(self._domMgr, None)
+        self.assertNotEqual(self._devMgr, None)
+        self._domMgr.installApplication("/waveforms/%s/%s.sad.xml" % (name, name))
+        self.assertEqual(len(self._domMgr._get_applicationFactories()), 1)
+        return self._domMgr._get_applicationFactories()[0]
+
+    def _findSpans(self, spans, phase):
+        return [span for span in spans if span['phase'] == phase]
+
+    def test_CreateTrace(self):
+        appFact = self._getFactory('PortConnectProvidesPort')
+        self._app = appFact.create(appFact._get_name(), [], [])
+
+        props = self._app.query([CF.DataType(id=ExtendedCF.WKP.DEPLOYMENT_TRACE_JSON, value=any.to_any(None))])
+        self.assertEqual(len(props), 1)
+        trace = json.loads(any.from_any(props[0].value))
+        self.assertEqual(trace['dropped'], 0)
+        spans = trace['spans']
+
+        for phase in ('loadAndExecuteComponents', 'waitForComponentRegistration', 'initializeComponents',
+                      'connectComponents', 'configureComponents'):
+            found = self._findSpans(spans, phase)
+            self.assertEqual(len(found), 1, "missing span for phase '%s'" % phase)
+            self.assertFalse(found[0]['failed'])
+            self.assertTrue(found[0]['seconds'] >= 0.0)
+
+        # One span for each remote call on each component
+        components = len(self._app._get_componentDevices())
+        for phase in ('execute', 'initialize'):
+            found = self._findSpans(spans, phase)
+            self.assertEqual(len(found), components)
+            self.assertEqual(len(set(span['component'] for span in found)), components)
+
+        connects = self._findSpans(spans, 'connect')
+        self.assertEqual(len(connects), 1)
+        self.assertFalse(connects[0]['failed'])
+
+        # The struct sequence form holds the same spans
+        props = self._app.query([CF.DataType(id=ExtendedCF.WKP.DEPLOYMENT_TRACE, value=any.to_any(None))])
+        self.assertEqual(len(props), 1)
+        self.assertEqual(len(any.from_any(props[0].value)), len(spans))
+
+        # An empty query is answered by the components alone
+        ids = [prop.id for prop in self._app.query([])]
+        self.assertFalse(ExtendedCF.WKP.DEPLOYMENT_TRACE in ids)
+        self.assertFalse(ExtendedCF.WKP.DEPLOYMENT_TRACE_JSON in ids)
+
+    def test_FailedConnectTrace(self):
+        # The uses port expects a DomainManager, so connectPort is refused
+        appFact = self._getFactory('PortConnectWrongInterface')
+        self.assertRaises(CF.ApplicationFactory.CreateApplicationError, appFact.create, appFact._get_name(), [], [])
+        self.assertEqual(len(self._domMgr._get_applications()), 0)
+
+        trace = None
+        for line in open(self._logfile, 'r'):
+            if line.startswith(FAILED_TRACE):
+                trace = json.loads(line[line.index('{'):])
+        self.assertNotEqual(trace, None, "no trace logged for the failed create")
+        spans = trace['spans']
+
+        connects = self._findSpans(spans, 'connect')
+        self.assertEqual(len(connects), 1)
+        self.assertEqual(connects[0]['component'], 'wrong_interface')
+        self.assertTrue(connects[0]['failed'])
+
+        found = self._findSpans(spans, 'connectComponents')
+        self.assertEqual(len(found), 1)
+        self.assertTrue(found[0]['failed'])
+
+        # Nothing after the connections was attempted
+        self.assertEqual(self._findSpans(spans, 'configureComponents'), [])
+        for phase in ('loadAndExecuteComponents', 'initializeComponents'):
+            found = self._findSpans(spans, phase)
+            self.assertEqual(len(found), 1)
+            self.assertFalse(found[0]['failed'])
@@ -455,6 +455,59 @@ class FileManagerTest(scatest.CorbaTestCase):
         new_file_list.sort()
         self.assertEqual(dir_file_list_hidden, new_file_list)
 
+    def test_ListFiles(self):
+        fileSys = self._devMgr._get_fileSys()
+        fileMgr = self._domMgr._get_fileMgr()
+
+        # Page through the DeviceManager's root one file at a time; the result
+        # should match the full list
+        expected = [fi.name for fi in fileSys.list("/")]
+        files, iterator = fileSys.listFiles("/", True, 1)
+        self.assertEqual(len(files), 1)
+        self.assertNotEqual(iterator, None)
+        names = [fi.name for fi in files]
+        while True:
+            status, fi = iterator.next_one()
+            if not status:
+                break
+            names.append(fi.name)
+        iterator.destroy()
+        self.assertEqual(sorted(names), sorted(expected))
+
+        # Asking for everything at once should not return an iterator
+        files, iterator = fileSys.listFiles("/", True, len(expected))
+        self.assertEqual(len(files), len(expected))
+        self.assertEqual(iterator, None)
+
+        # Without details, no file properties should be returned
+        files, iterator = fileSys.listFiles("/", False, len(expected))
+        self.assertEqual(len(files), len(expected))
+        for fi in files:
+            self.assertEqual(len(fi.fileProperties), 0)
+
+        # The FileManager includes mount points at the end of the listing
+        expected = dict((fi.name, fi.kind) for fi in fileMgr.list("/"))
+        files, iterator = fileMgr.listFiles("/", True, 2)
+        self.assertEqual(len(files), 2)
+        self.assertNotEqual(iterator, None)
+        status, remaining = iterator.next_n(len(expected))
+        self.assertEqual(status, True)
+        files.extend(remaining)
+        self.assertEqual(dict((fi.name, fi.kind) for fi in files), expected)
+        self.assertEqual(files[-1].kind, CF.FileSystem.FILE_SYSTEM)
+        status, remaining = iterator.next_n(1)
+        self.assertEqual(status, False)
+        self.assertEqual(len(remaining), 0)
+
+        # Listing within a mount point is forwarded to the mounted file system
+        devlistdir = "/ExecutableDevice_node/nodes/test_ExecutableDevice_node/"
+        expected = sorted(fi.name for fi in fileMgr.list(devlistdir))
+        files, iterator = fileMgr.listFiles(devlistdir, True, 1)
+        if iterator:
+            status, remaining = iterator.next_n(len(expected))
+            files.extend(remaining)
+        self.assertEqual(sorted(fi.name for fi in files), expected)
+
     def test_DirectoryOperation(self):
         #################
         # test mkdir
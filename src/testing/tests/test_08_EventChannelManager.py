@@ -20,8 +20,10 @@
 
 import unittest
 from _unitTestHelpers import scatest
-from omniORB import URI, any
-from ossie.cf import CF
+from omniORB import URI, any, CORBA
+from ossie.cf import CF, ExtendedEvent
+from ossie.events import Subscriber
+from ossie.utils.sandbox.events import EventChannel
 from ossie.properties import *
 import threading
 import time
@@ -288,3 +290,33 @@ class EventChannelManagerRedhawkUtils(scatest.CorbaTestCase):
         self.assertRaises( CF.EventChannelManager.ChannelDoesNotExist, self.ecm.release, 'ecm_test')
 
 
+class EventSubscriberBatch(scatest.CorbaTestCase):
+    def setUp(self):
+        # A local channel is enough to deliver pushes to the subscriber
+        self._channel = EventChannel('batch_channel')
+        self._sub = Subscriber(self._channel._this())
+
+    def tearDown(self):
+        self._sub.terminate()
+        self._channel.destroy()
+        scatest.CorbaTestCase.tearDown(self)
+
+    def _pushBatch(self, values):
+        batch = ExtendedEvent.EventBatchType([any.to_any(value) for value in values])
+        self._channel.push(CORBA.Any(ExtendedEvent._tc_EventBatchType, batch))
+
+    def test_BatchQueued(self):
+        # A batch from a C++ publisher in BATCH_SEQUENCE mode is queued as
+        # separate events, in order, around unbatched ones
+        self._channel.push(any.to_any('first'))
+        self._pushBatch(['second', 'third', 'fourth'])
+        self._channel.push(any.to_any('fifth'))
+        for expected in ('first', 'second', 'third', 'fourth', 'fifth'):
+            self.assertEqual(self._sub.getData(), expected)
+        self.assertEqual(self._sub.getData(), None)
+
+    def test_BatchCallback(self):
+        received = []
+        self._sub.setDataArrivedCB(lambda data: received.append(any.from_any(data)))
+        self._pushBatch(['first', 'second'])
+        self.assertEqual(received, ['first', 'second'])
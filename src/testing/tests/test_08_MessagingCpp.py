@@ -103,3 +103,28 @@ class EventPortConnectionsTest(scatest.CorbaTestCase):
         for val in recval:
             self.assertEquals('test_message' in val, True)
         app.releaseObject() # kill producer/consumer
+
+    def test_ExternalPortOverriddenGetPort(self):
+        # MessageSenderCpp overrides getPort() to serve a port it never
+        # registers, which must still be usable as an external port
+        self._devBooter, self._devMgr = self.launchDeviceManager("/nodes/test_BasicTestDevice_node/DeviceManager.dcd.xml", self._domMgr)
+        self.assertNotEqual(self._devBooter, None)
+        self._domMgr.installApplication("/waveforms/MessageTestCppExternalPort/MessageTestCppExternalPort.sad.xml")
+        appFact = self._domMgr._get_applicationFactories()[0]
+        self.assertNotEqual(appFact, None)
+        self._app = appFact.create(appFact._get_name(), [], [])
+        self.assertNotEqual(self._app, None)
+
+        self.assertFalse(self._app.getPort('message_out')._non_existent())
+        self.assertFalse(self._app.getPort('message_in')._non_existent())
+
+        sender = None
+        for component in self._app._get_registeredComponents():
+            if 'DCE:f7e0ac7c-5d4c-45b2-910f-a937bf7625b5' in component.componentObject._get_identifier():
+                sender = component.componentObject
+        self.assertNotEqual(sender, None)
+        ports = sender.getPorts(['message_out'])
+        self.assertEqual(len(ports), 1)
+        self.assertEqual(ports[0].name, 'message_out')
+        self.assertFalse(ports[0].obj_ptr._non_existent())
+        self.assertRaises(CF.PortSupplier.UnknownPort, sender.getPorts, ['message_out', 'no_such_port'])